@@ -12,5 +12,5 @@
 #include"Intro/ImGui/ImGuiLayer.h"
 #include"Intro/Renderer/RendererLayer.h"
 
-//-------------------
+//进入点-------------------
 #include "Intro/EntryPoint.h"
\ No newline at end of file
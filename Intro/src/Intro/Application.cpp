@@ -7,6 +7,9 @@
 #include "Intro/Config/RendererConfigUtils.h"
 #include "Intro/RecourceManager/ResourceManager.h"
 #include "Intro/Physics/PhysicsSystem.h"
+#include "Intro/Renderer/GPUProfiler.h"
+#include "Intro/Renderer/ShaderCache.h"
+#include "Intro/Jobs/JobSystem.h"
 #include "glm/glm.hpp"
 #include <GLFW/glfw3.h>
 
@@ -25,40 +28,43 @@ namespace Intro {
 		m_Window = std::unique_ptr<Window>(Window::Create());
 		m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
 
-		// 
+		// 任务系统：hardware_concurrency - 1 个工作线程，主线程占 0 号队列并在等待时参与执行
+		JobSystem::Initialize();
+
+		// 加载配置
 		Config& config = Config::Get();
 		if (!config.Load()) {
 			ITR_WARN("Failed to load config, using defaults");
 		}
 		config.Get().GetGraphicsConfig().EnableGammaCorrection = false;
 
-		// ָȷ assets ʹþ·ľ·ٳʼ ResourceManager
+		// 先指定正确的 assets 根（使用绝对路径或构造出的绝对路径），再初始化 ResourceManager
 		std::string assetsPath = "E:/MyEngine/Intro/Intro/src/Intro/assets/";
 
-		//  SetAssetsRoot ʹı߼ֻø
+		// 如果有 SetAssetsRoot 函数，优先使用它（不改变现有逻辑，只设置根）
 		ResourceManager::Get().SetAssetsRoot(assetsPath);
 
-		// ȻʼԴڲ m_AssetsRoot ɨ裩
+		// 然后初始化资源管理器（内部会根据 m_AssetsRoot 扫描）
 		ResourceManager::Get().Initialize();
 
-		// ļ»ص
+		// 设置文件树更新回调
 		ResourceManager::Get().SetFileTreeUpdatedCallback([]() {
 			ITR_INFO("Resource file tree updated");
 			});
 
 		s_SceneManager = new SceneManager;
 
-		// ʹóʼȾ
+		// 使用配置初始化渲染器
 		auto& graphicsConfig = config.GetGraphicsConfig();
 		RendererConfig rendererConfig = RendererConfigUtils::ToRendererConfig(graphicsConfig);
 
-		// ӿڴСΪʵʴСҪ
+		// 覆盖视口大小为窗口实际大小（如果需要）
 		rendererConfig.viewportWidth = m_Window->GetWidth();
 		rendererConfig.viewportHeight = m_Window->GetHeight();
 
 		if (!RendererConfigUtils::ValidateRendererConfig(rendererConfig)) {
 			ITR_WARN("Invalid renderer config, using defaults");
-			// ðȫĬֵ
+			// 可以在这里设置安全的默认值
 			rendererConfig.viewportWidth = m_Window->GetWidth();
 			rendererConfig.viewportHeight = m_Window->GetHeight();
 			rendererConfig.enableMSAA = true;
@@ -88,30 +94,67 @@ namespace Intro {
 		);
 		s_ShaderLibrary->Add("pbrShader", PBRShader);
 
+		auto shadowDepthShader = std::make_shared<Shader>(
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/shadowDepth.vert",
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/shadowDepth.frag"
+		);
+		s_ShaderLibrary->Add("shadowDepthShader", shadowDepthShader);
+
+		// 深度预通道只写深度（LOD 淡化时与主通道丢弃相同的片元）
+		auto depthPrepassShader = std::make_shared<Shader>(
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/depthPrepass.vert",
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/depthPrepass.frag"
+		);
+		s_ShaderLibrary->Add("depthPrepassShader", depthPrepassShader);
+
+		// 加权混合 OIT 的合成（全屏三角形）
+		auto oitCompositeShader = std::make_shared<Shader>(
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/fullscreen.vert",
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/oitComposite.frag"
+		);
+		s_ShaderLibrary->Add("oitCompositeShader", oitCompositeShader);
+
+		// 动态分辨率的上采样（双三次 + 锐化）
+		auto upscaleShader = std::make_shared<Shader>(
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/fullscreen.vert",
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/upscale.frag"
+		);
+		s_ShaderLibrary->Add("upscaleShader", upscaleShader);
+
+		// 调试绘制（位置 + 顶点颜色）
+		auto debugDrawShader = std::make_shared<Shader>(
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/debugDraw.vert",
+			"E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/debugDraw.frag"
+		);
+		s_ShaderLibrary->Add("debugDrawShader", debugDrawShader);
+
+		// 启动阶段的着色器都已创建，输出缓存命中情况与节省的时间
+		ShaderCache::LogStatistics();
+
 		defaultMaterial = std::make_shared<Material>(defaultShader);
 
 		Scene& defaultScene = s_SceneManager->CreateScene<Scene>("defaultScene");
-		//ʱģ
+		//临时模型
 		//std::shared_ptr<Model> model;
 		//model = std::make_shared<Model>("E:/MyEngine/Intro/Intro/src/Intro/Assert/models/backpack.obj");
 		//GameObject backpack = defaultScene.CreateGameObject("defaultModel");
 		//backpack.AddComponent<ModelComponent>(model);
 		//backpack.AddComponent<MaterialComponent>(defaultMaterial);
 
-		// ȷĬϷ
+		// 创建明确的默认方向光
 		entt::entity lightEntity = defaultScene.CreateEntity();
 		defaultScene.GetECS().AddComponent<TagComponent>(lightEntity, "Main Directional Light");
 
-		// ÷ı任 - ȷָ·
+		// 设置方向光的变换 - 明确指向下方
 		TransformComponent lightTransform;
-		lightTransform.transform.rotation = glm::angleAxis(glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)); // ָ·
+		lightTransform.transform.rotation = glm::angleAxis(glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f)); // 指向下方
 		defaultScene.GetECS().AddComponent<TransformComponent>(lightEntity, lightTransform);
 
 		LightComponent light;
 		light.Type = LightType::Directional;
-		light.Color = glm::vec3(1.0f, 1.0f, 1.0f); // ɫ
+		light.Color = glm::vec3(1.0f, 1.0f, 1.0f); // 白色
 		light.Intensity = 0.5f;
-		light.Direction = glm::vec3(0.0f, 0.0f, -1.0f); // ֲռǰ
+		light.Direction = glm::vec3(0.0f, 0.0f, -1.0f); // 局部空间向前
 		defaultScene.GetECS().AddComponent<LightComponent>(lightEntity, light);
 
 		defaultScene.SetActive(true);
@@ -127,6 +170,7 @@ namespace Intro {
 			delete s_SceneManager;
 			s_SceneManager = nullptr;
 		}
+		JobSystem::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -142,15 +186,16 @@ namespace Intro {
 	}
 
 	void Application::Run() {
-		float lastFrameTime = 0.0f; // һ֡ʱ
+		float lastFrameTime = 0.0f; // 上一帧的时间
 
 		while (m_Running)
 		{
-			float currentTime = (float)glfwGetTime(); // ʹ GLFWҪ GLFW/glfw3.h
+			float currentTime = (float)glfwGetTime(); // 假设使用 GLFW，需要包含 GLFW/glfw3.h
 			float deltaTime = currentTime - lastFrameTime;
 			lastFrameTime = currentTime;
 
 			Input::Update();
+			GPUProfiler::BeginFrame();
 
 			if (s_SceneManager)
 			{
@@ -158,8 +203,10 @@ namespace Intro {
 			}
 
 			for (Layer* layer : m_LayerStack)
-				layer->OnUpdate(deltaTime); //  deltaTime
+				layer->OnUpdate(deltaTime); // 传递 deltaTime
 
+			// 在交换缓冲前结束本帧的 GPU 计时（结果在之后的帧中读取）
+			GPUProfiler::EndFrame();
 			m_Window->OnUpdate();
 		}
 	}
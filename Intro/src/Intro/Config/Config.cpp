@@ -254,6 +254,71 @@ namespace Intro {
             valid = false;
         }
 
+        // shadows
+        if (m_GraphicsConfig.ShadowCascadeCount < 1 || m_GraphicsConfig.ShadowCascadeCount > 4) {
+            ITR_WARN("Shadow cascade count out of range ({}), clamping to 1-4", m_GraphicsConfig.ShadowCascadeCount);
+            m_GraphicsConfig.ShadowCascadeCount = glm::clamp(m_GraphicsConfig.ShadowCascadeCount, 1u, 4u);
+            valid = false;
+        }
+        if (m_GraphicsConfig.ShadowSplitLambda < 0.0f || m_GraphicsConfig.ShadowSplitLambda > 1.0f) {
+            m_GraphicsConfig.ShadowSplitLambda = glm::clamp(m_GraphicsConfig.ShadowSplitLambda, 0.0f, 1.0f);
+            valid = false;
+        }
+        if (m_GraphicsConfig.ShadowMapSize < 256 || m_GraphicsConfig.ShadowMapSize > 8192) {
+            ITR_WARN("Shadow map size out of range ({}), clamping to 256-8192", m_GraphicsConfig.ShadowMapSize);
+            m_GraphicsConfig.ShadowMapSize = glm::clamp(m_GraphicsConfig.ShadowMapSize, 256u, 8192u);
+            valid = false;
+        }
+        if (m_GraphicsConfig.ShadowAtlasSize < 1024 || m_GraphicsConfig.ShadowAtlasSize > 8192) {
+            ITR_WARN("Shadow atlas size out of range ({}), clamping to 1024-8192", m_GraphicsConfig.ShadowAtlasSize);
+            m_GraphicsConfig.ShadowAtlasSize = glm::clamp(m_GraphicsConfig.ShadowAtlasSize, 1024u, 8192u);
+            valid = false;
+        }
+
+        // LOD
+        if (m_GraphicsConfig.LodLevels < 1 || m_GraphicsConfig.LodLevels > 8) {
+            ITR_WARN("LOD level count out of range ({}), clamping to 1-8", m_GraphicsConfig.LodLevels);
+            m_GraphicsConfig.LodLevels = glm::clamp(m_GraphicsConfig.LodLevels, 1u, 8u);
+            valid = false;
+        }
+        if (m_GraphicsConfig.LodTriangleRatio < 0.05f || m_GraphicsConfig.LodTriangleRatio > 0.95f) {
+            m_GraphicsConfig.LodTriangleRatio = glm::clamp(m_GraphicsConfig.LodTriangleRatio, 0.05f, 0.95f);
+            valid = false;
+        }
+        if (m_GraphicsConfig.LodPixelError <= 0.0f) {
+            m_GraphicsConfig.LodPixelError = 1.0f;
+            valid = false;
+        }
+        if (m_GraphicsConfig.LodHysteresis < 0.0f || m_GraphicsConfig.LodHysteresis > 0.9f) {
+            m_GraphicsConfig.LodHysteresis = glm::clamp(m_GraphicsConfig.LodHysteresis, 0.0f, 0.9f);
+            valid = false;
+        }
+
+        // 调试绘制
+        if (m_GraphicsConfig.DebugDrawVertexBudget < 1024 || m_GraphicsConfig.DebugDrawVertexBudget > (1u << 22)) {
+            ITR_WARN("Debug draw vertex budget out of range ({}), clamping to 1024-4194304", m_GraphicsConfig.DebugDrawVertexBudget);
+            m_GraphicsConfig.DebugDrawVertexBudget = glm::clamp(m_GraphicsConfig.DebugDrawVertexBudget, 1024u, 1u << 22);
+            valid = false;
+        }
+
+        // 动态分辨率
+        if (m_GraphicsConfig.DynamicResolutionTargetMs < 1.0f || m_GraphicsConfig.DynamicResolutionTargetMs > 100.0f) {
+            m_GraphicsConfig.DynamicResolutionTargetMs = glm::clamp(m_GraphicsConfig.DynamicResolutionTargetMs, 1.0f, 100.0f);
+            valid = false;
+        }
+        if (m_GraphicsConfig.DynamicResolutionMaxScale < 0.25f || m_GraphicsConfig.DynamicResolutionMaxScale > 1.0f) {
+            m_GraphicsConfig.DynamicResolutionMaxScale = glm::clamp(m_GraphicsConfig.DynamicResolutionMaxScale, 0.25f, 1.0f);
+            valid = false;
+        }
+        if (m_GraphicsConfig.DynamicResolutionMinScale < 0.25f || m_GraphicsConfig.DynamicResolutionMinScale > m_GraphicsConfig.DynamicResolutionMaxScale) {
+            m_GraphicsConfig.DynamicResolutionMinScale = glm::clamp(m_GraphicsConfig.DynamicResolutionMinScale, 0.25f, m_GraphicsConfig.DynamicResolutionMaxScale);
+            valid = false;
+        }
+        if (m_GraphicsConfig.UpscaleSharpness < 0.0f || m_GraphicsConfig.UpscaleSharpness > 1.0f) {
+            m_GraphicsConfig.UpscaleSharpness = glm::clamp(m_GraphicsConfig.UpscaleSharpness, 0.0f, 1.0f);
+            valid = false;
+        }
+
         // mouse sensitivity
         if (m_InputConfig.MouseSensitivity < 0.001f) { m_InputConfig.MouseSensitivity = 0.001f; valid = false; }
         if (m_InputConfig.MouseSensitivity > 10.0f) { m_InputConfig.MouseSensitivity = 10.0f; valid = false; }
@@ -285,7 +350,7 @@ namespace Intro {
         if (!ifs.is_open()) {
             ITR_WARN("Config file '{}' not found - using defaults", path);
             
-            ResetToDefaultsInternal();  // ʹڲظ
+            ResetToDefaultsInternal();  // 使用内部方法，不重复加锁
 
             return false;
         }
@@ -326,10 +391,39 @@ namespace Intro {
                 m_GraphicsConfig.MSaaSamples = g.value("MSaaSamples", m_GraphicsConfig.MSaaSamples);
                 m_GraphicsConfig.EnableHDR = g.value("EnableHDR", m_GraphicsConfig.EnableHDR);
                 m_GraphicsConfig.EnableGammaCorrection = g.value("EnableGammaCorrection", m_GraphicsConfig.EnableGammaCorrection);
+                m_GraphicsConfig.EnableMultiDrawIndirect = g.value("EnableMultiDrawIndirect", m_GraphicsConfig.EnableMultiDrawIndirect);
+                m_GraphicsConfig.EnableDepthPrepass = g.value("EnableDepthPrepass", m_GraphicsConfig.EnableDepthPrepass);
+                m_GraphicsConfig.EnableOcclusionCulling = g.value("EnableOcclusionCulling", m_GraphicsConfig.EnableOcclusionCulling);
                 m_GraphicsConfig.ViewportWidth = g.value("ViewportWidth", m_GraphicsConfig.ViewportWidth);
                 m_GraphicsConfig.ViewportHeight = g.value("ViewportHeight", m_GraphicsConfig.ViewportHeight);
 
-                // ڴ
+                // 阴影配置
+                m_GraphicsConfig.ShadowCascadeCount = g.value("ShadowCascadeCount", m_GraphicsConfig.ShadowCascadeCount);
+                m_GraphicsConfig.ShadowSplitLambda = g.value("ShadowSplitLambda", m_GraphicsConfig.ShadowSplitLambda);
+                m_GraphicsConfig.ShadowDistance = g.value("ShadowDistance", m_GraphicsConfig.ShadowDistance);
+                m_GraphicsConfig.ShadowMapSize = g.value("ShadowMapSize", m_GraphicsConfig.ShadowMapSize);
+                m_GraphicsConfig.ShadowAtlasSize = g.value("ShadowAtlasSize", m_GraphicsConfig.ShadowAtlasSize);
+                m_GraphicsConfig.ShadowUpdateBudget = g.value("ShadowUpdateBudget", m_GraphicsConfig.ShadowUpdateBudget);
+
+                // LOD 配置
+                m_GraphicsConfig.EnableLod = g.value("EnableLod", m_GraphicsConfig.EnableLod);
+                m_GraphicsConfig.LodLevels = g.value("LodLevels", m_GraphicsConfig.LodLevels);
+                m_GraphicsConfig.LodTriangleRatio = g.value("LodTriangleRatio", m_GraphicsConfig.LodTriangleRatio);
+                m_GraphicsConfig.LodMaxError = g.value("LodMaxError", m_GraphicsConfig.LodMaxError);
+                m_GraphicsConfig.LodPixelError = g.value("LodPixelError", m_GraphicsConfig.LodPixelError);
+                m_GraphicsConfig.LodHysteresis = g.value("LodHysteresis", m_GraphicsConfig.LodHysteresis);
+                m_GraphicsConfig.LodCrossFade = g.value("LodCrossFade", m_GraphicsConfig.LodCrossFade);
+                m_GraphicsConfig.DebugDrawVertexBudget = g.value("DebugDrawVertexBudget", m_GraphicsConfig.DebugDrawVertexBudget);
+                m_GraphicsConfig.EnableShaderCache = g.value("EnableShaderCache", m_GraphicsConfig.EnableShaderCache);
+
+                // 动态分辨率配置
+                m_GraphicsConfig.EnableDynamicResolution = g.value("EnableDynamicResolution", m_GraphicsConfig.EnableDynamicResolution);
+                m_GraphicsConfig.DynamicResolutionTargetMs = g.value("DynamicResolutionTargetMs", m_GraphicsConfig.DynamicResolutionTargetMs);
+                m_GraphicsConfig.DynamicResolutionMinScale = g.value("DynamicResolutionMinScale", m_GraphicsConfig.DynamicResolutionMinScale);
+                m_GraphicsConfig.DynamicResolutionMaxScale = g.value("DynamicResolutionMaxScale", m_GraphicsConfig.DynamicResolutionMaxScale);
+                m_GraphicsConfig.UpscaleSharpness = g.value("UpscaleSharpness", m_GraphicsConfig.UpscaleSharpness);
+
+                // 后期处理配置
                 m_GraphicsConfig.EnablePostProcessing = g.value("EnablePostProcessing", m_GraphicsConfig.EnablePostProcessing);
                 m_GraphicsConfig.BloomThreshold = g.value("BloomThreshold", m_GraphicsConfig.BloomThreshold);
                 m_GraphicsConfig.BloomIntensity = g.value("BloomIntensity", m_GraphicsConfig.BloomIntensity);
@@ -392,7 +486,7 @@ namespace Intro {
             ITR_ERROR("Failed parsing config '{}' : {}", path, e.what());
             // backup corrupt file
             BackupCorruptFile(path);
-            ResetToDefaultsInternal();  // ʹڲ
+            ResetToDefaultsInternal();  // 使用内部方法
             return false;
         }
     }
@@ -402,9 +496,9 @@ namespace Intro {
         return SaveInternal(filepath);
     }
 
-    // Config.cpp -  SaveInternal ʵ
+    // Config.cpp - 完整的 SaveInternal 实现
     bool Config::SaveInternal(const std::string& filepath) {
-        // ʵʵı߼Ѿ
+        // 实际的保存逻辑，假设已经持有锁
         std::string path = filepath.empty() ?
             (m_Impl->CurrentFilepath.empty() ? GetDefaultConfigPathPreferCwd() : m_Impl->CurrentFilepath)
             : filepath;
@@ -414,7 +508,7 @@ namespace Intro {
             json j;
             j["ConfigVersion"] = m_Impl->ConfigVersion;
 
-            // Window 
+            // Window 配置
             j["Window"] = {
                 {"Width", m_WindowConfig.Width},
                 {"Height", m_WindowConfig.Height},
@@ -424,7 +518,7 @@ namespace Intro {
                 {"Title", m_WindowConfig.Title}
             };
 
-            // Graphics 
+            // Graphics 配置
             j["Graphics"] = {
                 {"Quality", static_cast<int>(m_GraphicsConfig.Quality)},
                 {"AntiAliasing", static_cast<int>(m_GraphicsConfig.AA)},
@@ -434,14 +528,40 @@ namespace Intro {
                 {"Gamma", m_GraphicsConfig.Gamma},
                 {"Exposure", m_GraphicsConfig.Exposure},
                 {"MaxFPS", m_GraphicsConfig.MaxFPS},
-                // Ⱦֶ
+                // 新增渲染器配置字段
                 {"EnableMSAA", m_GraphicsConfig.EnableMSAA},
                 {"MSaaSamples", m_GraphicsConfig.MSaaSamples},
                 {"EnableHDR", m_GraphicsConfig.EnableHDR},
                 {"EnableGammaCorrection", m_GraphicsConfig.EnableGammaCorrection},
+                {"EnableMultiDrawIndirect", m_GraphicsConfig.EnableMultiDrawIndirect},
+                {"EnableDepthPrepass", m_GraphicsConfig.EnableDepthPrepass},
+                {"EnableOcclusionCulling", m_GraphicsConfig.EnableOcclusionCulling},
                 {"ViewportWidth", m_GraphicsConfig.ViewportWidth},
                 {"ViewportHeight", m_GraphicsConfig.ViewportHeight},
-                // ڴ
+                // 阴影配置
+                {"ShadowCascadeCount", m_GraphicsConfig.ShadowCascadeCount},
+                {"ShadowSplitLambda", m_GraphicsConfig.ShadowSplitLambda},
+                {"ShadowDistance", m_GraphicsConfig.ShadowDistance},
+                {"ShadowMapSize", m_GraphicsConfig.ShadowMapSize},
+                {"ShadowAtlasSize", m_GraphicsConfig.ShadowAtlasSize},
+                {"ShadowUpdateBudget", m_GraphicsConfig.ShadowUpdateBudget},
+                // LOD 配置
+                {"EnableLod", m_GraphicsConfig.EnableLod},
+                {"LodLevels", m_GraphicsConfig.LodLevels},
+                {"LodTriangleRatio", m_GraphicsConfig.LodTriangleRatio},
+                {"LodMaxError", m_GraphicsConfig.LodMaxError},
+                {"LodPixelError", m_GraphicsConfig.LodPixelError},
+                {"LodHysteresis", m_GraphicsConfig.LodHysteresis},
+                {"LodCrossFade", m_GraphicsConfig.LodCrossFade},
+                {"DebugDrawVertexBudget", m_GraphicsConfig.DebugDrawVertexBudget},
+                {"EnableShaderCache", m_GraphicsConfig.EnableShaderCache},
+                // 动态分辨率配置
+                {"EnableDynamicResolution", m_GraphicsConfig.EnableDynamicResolution},
+                {"DynamicResolutionTargetMs", m_GraphicsConfig.DynamicResolutionTargetMs},
+                {"DynamicResolutionMinScale", m_GraphicsConfig.DynamicResolutionMinScale},
+                {"DynamicResolutionMaxScale", m_GraphicsConfig.DynamicResolutionMaxScale},
+                {"UpscaleSharpness", m_GraphicsConfig.UpscaleSharpness},
+                // 后期处理配置
                 {"EnablePostProcessing", m_GraphicsConfig.EnablePostProcessing},
                 {"BloomThreshold", m_GraphicsConfig.BloomThreshold},
                 {"BloomIntensity", m_GraphicsConfig.BloomIntensity},
@@ -449,12 +569,12 @@ namespace Intro {
                 {"ChromaticAberration", m_GraphicsConfig.ChromaticAberration}
             };
 
-            // Input ӳ䣺ʹü
+            // Input 映射：尽可能使用键名
             json actionMap = json::object();
             for (auto& kv : m_InputConfig.ActionMappings) {
                 const std::string& action = kv.first;
                 int keycode = kv.second;
-                // ʹѺƱʾĸ//֪д
+                // 优先使用友好名称表示字母/数字/已知键，否则写数字
                 std::string name = KeyCodeToName(keycode);
                 actionMap[action] = name;
             }
@@ -464,7 +584,7 @@ namespace Intro {
                 {"ActionMappings", actionMap}
             };
 
-            // Editor 
+            // Editor 配置
             j["Editor"] = {
                 {"ShowGrid", m_EditorConfig.ShowGrid},
                 {"ShowGizmos", m_EditorConfig.ShowGizmos},
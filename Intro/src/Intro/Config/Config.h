@@ -45,15 +45,45 @@ namespace Intro {
         float Exposure = 1.0f;
         int MaxFPS = 0; // 0 = unlimited
 
-        // Ⱦ
+        // 新增渲染器配置
         bool EnableMSAA = true;
         uint32_t MSaaSamples = 4;
         bool EnableHDR = false;
         bool EnableGammaCorrection = true;
+        bool EnableMultiDrawIndirect = true;
+        bool EnableDepthPrepass = false;    // 不透明物体先画一遍只写深度的预通道，主通道只着色可见片元
+        bool EnableOcclusionCulling = true; // 遮挡体（OccluderComponent）在 CPU 上光栅化后剔除被挡住的物体
         uint32_t ViewportWidth = 1920;
         uint32_t ViewportHeight = 1080;
 
-        // ڴ
+        // 阴影配置
+        uint32_t ShadowCascadeCount = 4;
+        float ShadowSplitLambda = 0.75f;    // 级联划分：0 = 均匀划分，1 = 对数划分，中间为两者插值
+        float ShadowDistance = 150.0f;      // 方向光阴影覆盖的最远视图距离
+        uint32_t ShadowMapSize = 2048;      // 每级联的分辨率
+        uint32_t ShadowAtlasSize = 4096;    // 点光源/聚光灯阴影图集的分辨率
+        uint32_t ShadowUpdateBudget = 8;    // 每帧最多更新的图集块数
+
+        // 细节层次（LOD）配置
+        bool EnableLod = true;
+        uint32_t LodLevels = 4;             // 含原网格在内的级数（导入模型时生成）
+        float LodTriangleRatio = 0.5f;      // 相邻两级的三角形数之比
+        float LodMaxError = 0.02f;          // 简化允许的最大误差（相对包围球半径）
+        float LodPixelError = 1.0f;         // 运行时允许的屏幕误差（像素）
+        float LodHysteresis = 0.2f;         // 变粗时额外要求的误差余量（比例）
+        bool LodCrossFade = false;          // 切换 LOD 时抖动交叉淡化
+
+        uint32_t DebugDrawVertexBudget = 65536; // 调试绘制每帧的顶点预算
+        bool EnableShaderCache = true;          // 缓存链接后的着色器程序二进制（下次启动生效）
+
+        // 动态分辨率配置
+        bool EnableDynamicResolution = false;
+        float DynamicResolutionTargetMs = 12.0f;  // 场景渲染的 GPU 时间目标（毫秒）
+        float DynamicResolutionMinScale = 0.5f;   // 每个轴的最小缩放
+        float DynamicResolutionMaxScale = 1.0f;
+        float UpscaleSharpness = 0.25f;           // 上采样后的锐化强度，0 为只做双三次插值
+
+        // 后期处理配置
         bool EnablePostProcessing = true;
         float BloomThreshold = 1.0f;
         float BloomIntensity = 0.8f;
@@ -89,31 +119,31 @@ namespace Intro {
 
     class ITR_API Config {
     public:
-        // ȡ
+        // 获取单例
         static Config& Get();
 
         // Load/Save
-        //  filepath ΪգLoad() ᳢Ĭ·Ŀ¼ȣʹûĿ¼
+        // 如果 filepath 为空，Load() 会尝试默认路径（工作目录优先，若不存在则使用用户目录）
         bool Load(const std::string& filepath = "");
-        // Save: filepath 򱣴浽ϴμ/Ĭ·
+        // Save: filepath 空则保存到上次加载/默认路径
         bool Save(const std::string& filepath = "");
 
         // Defaults / reset
         void ResetToDefaults();
 
-        // Accessors (ñ UI ޸ֱЧ)
+        // Accessors (引用便于 UI 修改直接生效)
         WindowConfig& GetWindowConfig() { return m_WindowConfig; }
         GraphicsConfig& GetGraphicsConfig() { return m_GraphicsConfig; }
         InputConfig& GetInputConfig() { return m_InputConfig; }
         EditorConfig& GetEditorConfig() { return m_EditorConfig; }
 
         // Key mapping helpers
-        //  keycodeδҵ -1
+        // 返回 keycode，如果未找到返回 -1
         int  GetKeyMapping(const std::string& action) const;
         void SetKeyMapping(const std::string& action, int keycode);
-        //  keycode Ϊɶƣ 87 -> "W"
+        // 将 keycode 翻译为可读名称（例如 87 -> "W"）
         std::string GetKeyName(int keycode) const;
-        // ûѺַ keycode "W" -> 87, "Space" -> 32
+        // 解析用户友好字符串到 keycode（例如 "W" -> 87, "Space" -> 32）
         std::optional<int> ParseKeyString(const std::string& keyStr) const;
 
         // Validate settings and clamp/fix invalid values
@@ -137,7 +167,7 @@ namespace Intro {
         Config();
         ~Config();
 
-        // ֹ/ƶ
+        // 禁止拷贝/移动
         Config(const Config&) = delete;
         Config& operator=(const Config&) = delete;
         Config(Config&&) = delete;
@@ -147,7 +177,7 @@ namespace Intro {
         bool SaveInternal(const std::string& filepath);
 
     private:
-        // 
+        // 数据
         WindowConfig m_WindowConfig;
         GraphicsConfig m_GraphicsConfig;
         InputConfig m_InputConfig;
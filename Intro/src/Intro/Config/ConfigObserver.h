@@ -15,21 +15,21 @@ namespace Intro {
             return instance;
         }
 
-        // עñص
+        // 注册配置变更回调
         void RegisterGraphicsConfigCallback(std::function<void(const GraphicsConfig&)> callback) {
             m_GraphicsCallbacks.push_back(callback);
         }
 
-        // ñʱãͨUIʱ
+        // 当配置变更时调用（通常在UI或配置重载时）
         void OnGraphicsConfigChanged(const GraphicsConfig& newConfig) {
-            // Ⱦ
+            // 更新渲染器配置
             RendererConfig rendererConfig = RendererConfigUtils::ToRendererConfig(newConfig);
             if (RendererConfigUtils::ValidateRendererConfig(rendererConfig)) {
                 Renderer::SetConfig(rendererConfig);
                 ITR_INFO("Renderer config updated");
             }
 
-            // ֪ͨעĻص
+            // 通知所有注册的回调
             for (auto& callback : m_GraphicsCallbacks) {
                 callback(newConfig);
             }
@@ -9,7 +9,7 @@ namespace Intro {
 
     class ITR_API RendererConfigUtils {
     public:
-        //  GraphicsConfig תΪ RendererConfig
+        // 将 GraphicsConfig 转换为 RendererConfig
         static RendererConfig ToRendererConfig(const GraphicsConfig& graphicsConfig) {
             RendererConfig config;
             config.viewportWidth = graphicsConfig.ViewportWidth;
@@ -18,10 +18,34 @@ namespace Intro {
             config.msaaSamples = graphicsConfig.MSaaSamples;
             config.enableHDR = graphicsConfig.EnableHDR;
             config.enableGammaCorrection = graphicsConfig.EnableGammaCorrection;
+            config.enableMultiDrawIndirect = graphicsConfig.EnableMultiDrawIndirect;
+            config.enableDepthPrepass = graphicsConfig.EnableDepthPrepass;
+            config.enableOcclusionCulling = graphicsConfig.EnableOcclusionCulling;
+            config.enableShadows = graphicsConfig.Shadows;
+            config.shadowCascadeCount = graphicsConfig.ShadowCascadeCount;
+            config.shadowSplitLambda = graphicsConfig.ShadowSplitLambda;
+            config.shadowDistance = graphicsConfig.ShadowDistance;
+            config.shadowMapSize = graphicsConfig.ShadowMapSize;
+            config.shadowAtlasSize = graphicsConfig.ShadowAtlasSize;
+            config.shadowUpdateBudget = graphicsConfig.ShadowUpdateBudget;
+            config.enableLod = graphicsConfig.EnableLod;
+            config.lodLevels = graphicsConfig.LodLevels;
+            config.lodTriangleRatio = graphicsConfig.LodTriangleRatio;
+            config.lodMaxError = graphicsConfig.LodMaxError;
+            config.lodPixelError = graphicsConfig.LodPixelError;
+            config.lodHysteresis = graphicsConfig.LodHysteresis;
+            config.lodCrossFade = graphicsConfig.LodCrossFade;
+            config.debugDrawVertexBudget = graphicsConfig.DebugDrawVertexBudget;
+            config.enableShaderCache = graphicsConfig.EnableShaderCache;
+            config.enableDynamicResolution = graphicsConfig.EnableDynamicResolution;
+            config.dynamicResolutionTargetMs = graphicsConfig.DynamicResolutionTargetMs;
+            config.dynamicResolutionMinScale = graphicsConfig.DynamicResolutionMinScale;
+            config.dynamicResolutionMaxScale = graphicsConfig.DynamicResolutionMaxScale;
+            config.upscaleSharpness = graphicsConfig.UpscaleSharpness;
             return config;
         }
 
-        // ֤ȾõЧ
+        // 验证渲染器配置的有效性
         static bool ValidateRendererConfig(const RendererConfig& config) {
             bool valid = true;
 
@@ -6,6 +6,8 @@
 #include <memory>
 #include <string>
 #include "Intro/Math/Transform.h"
+#include "Intro/Renderer/Bounds.h"
+#include "Intro/Renderer/Cameras/Camera.h"
 
 namespace Intro {
 
@@ -16,9 +18,9 @@ namespace Intro {
     class Mesh;
     class Transform;
 
-    // 任ʵ嶼
+    // 变换组件：所有实体都可以有
     struct TransformComponent {
-        Transform transform; // ֱе Transform 
+        Transform transform; // 直接用你现有的 Transform 类
 
         TransformComponent(
             const glm::vec3& pos = glm::vec3(0.0f),
@@ -29,18 +31,41 @@ namespace Intro {
     };
 
 
-    // ֻҪȾʵ
+    // 缓存的世界矩阵与世界空间包围体：拥有 TransformComponent 的实体自动获得，由 TransformSystem 每帧只重算 dirty 的条目
+    // 直接改写 TransformComponent 之后需要标记 dirty：GameObject::GetTransform、ECS::MarkTransformDirty，
+    // 或通过 registry.patch / replace 修改（on_update 信号会自动标记）
+    struct LocalToWorldComponent {
+        glm::mat4 matrix = glm::mat4(1.0f);
+        BoundingBox worldBounds;            // Mesh/Model 的世界空间包围盒，没有几何时无效
+        BoundingSphere worldSphere;
+        bool dirty = true;
+
+        glm::vec3 GetPosition() const { return glm::vec3(matrix[3]); }
+        // 局部方向只按世界旋转变换到世界空间并归一化（与原来的 rotation * dir 一致）：
+        // 使用矩阵归一化后的列，非均匀缩放不会让方向偏转
+        glm::vec3 TransformDirection(const glm::vec3& direction) const {
+            glm::mat3 rotation(matrix);
+            for (int i = 0; i < 3; ++i) {
+                float length = glm::length(rotation[i]);
+                if (length > 0.0f) rotation[i] /= length;
+            }
+            return glm::normalize(rotation * direction);
+        }
+    };
+
+
+    // 网格组件：只有需要被渲染的实体才有
     struct MeshComponent {
-        std::shared_ptr<Mesh> mesh; //  Mesh ָ
+        std::shared_ptr<Mesh> mesh; // 持有 Mesh 的智能指针
 
         MeshComponent(std::shared_ptr<Mesh> meshPtr = nullptr)
             : mesh(std::move(meshPtr)) {
         }
     };
 
-    // ģҪⲿģͣѡ
+    // 模型组件：如果你需要加载外部模型（可选）
     struct ModelComponent {
-        std::shared_ptr<Model> model; //  Model ָ
+        std::shared_ptr<Model> model; // 持有 Model 的智能指针
 
         ModelComponent(std::shared_ptr<Model> modelPtr = nullptr)
             : model(std::move(modelPtr)) {
@@ -84,11 +109,12 @@ namespace Intro {
     };
 
     struct CameraComponent {
-        // 
+        // 相机参数
         float fov = 60.0f;
         float nearClip = 0.1f;
         float farClip = 1000.0f;
         bool isMainCamera = false;
+        TransparencyMode transparency = TransparencyMode::Sorted;
 
         CameraComponent() = default;
         CameraComponent(float fov, float nearClip = 0.1f, float farClip = 1000.0f)
@@ -96,7 +122,7 @@ namespace Intro {
         }
     };
 
-    // 򵥲
+    // 简单材质组件
     struct MaterialComponent {
         std::shared_ptr<Material> material;
         bool Transparent = false;
@@ -104,7 +130,7 @@ namespace Intro {
             : material(std::move(mat)), Transparent(transparent) {
         }
     };
-    //PBR
+    //PBR材质
     struct PBRMaterialComponent {
         std::shared_ptr<PBRMaterial> material;
         bool Transparent = false;
@@ -113,21 +139,32 @@ namespace Intro {
             : material(std::move(mat)), Transparent(transparent) {
         }
 
-        // ֻҪıݷֱͨ material 
+        // 只保留必要的便捷方法，其他直接通过 material 访问
         bool HasMaterial() const { return material != nullptr; }
 
     };
 
-// ײ
+    // 遮挡体组件：标记大型遮挡物（墙、地形、大型静态模型），参与 CPU 遮挡剔除
+    // 遮挡几何必须位于渲染几何内部：没有指定 mesh 时使用局部空间的盒子，盒子需手动放在几何内部（size 为 0 时不参与遮挡）
+    struct OccluderComponent {
+        std::shared_ptr<Mesh> mesh;             // 简化的遮挡网格（可选）
+        glm::vec3 size = glm::vec3(0.0f);
+        glm::vec3 offset = glm::vec3(0.0f);
+        bool enabled = true;
+
+        OccluderComponent() = default;
+    };
+
+// 碰撞体类型
     enum class ColliderType {
         None = 0,
         Box,
         Sphere,
         Capsule,
-        Mesh  // ڸģ
+        Mesh  // 用于复杂模型
     };
 
-    // ײ
+    // 基础碰撞体组件
     struct RigidbodyComponent {
         float mass = 1.0f;
         glm::vec3 velocity = glm::vec3(0.0f);
@@ -135,18 +172,18 @@ namespace Intro {
         glm::vec3 force = glm::vec3(0.0f);
         glm::vec3 torque = glm::vec3(0.0f);
 
-        float drag = 0.0f;                    // 
-        float angularDrag = 0.05f;            // 
+        float drag = 0.0f;                    // 线性阻力
+        float angularDrag = 0.05f;            // 角阻力
 
         bool useGravity = true;
-        bool isKinematic = false;             // ǷɴƣӰ죩
-        bool freezeRotation = false;          // ת
+        bool isKinematic = false;             // 是否由代码控制（不受物理影响）
+        bool freezeRotation = false;          // 冻结旋转
 
-        // 
-        bool isSleeping = false;              // ״̬
-        float sleepTimer = 0.0f;              // ߼ʱ
+        // 新增特性
+        bool isSleeping = false;              // 休眠状态
+        float sleepTimer = 0.0f;              // 休眠计时器
 
-        // ģʽ֧
+        // 力模式支持
         enum class ForceMode {
             Force, Impulse, Velocity, Acceleration
         };
@@ -156,19 +193,19 @@ namespace Intro {
 
     struct ColliderComponent {
         ColliderType type = ColliderType::Box;
-        glm::vec3 size = glm::vec3(1.0f);      // Box
-        float radius = 0.5f;                   // Sphere/Capsule뾶
-        float height = 2.0f;                   // Capsule߶
-        glm::vec3 offset = glm::vec3(0.0f);    // ĵƫ
+        glm::vec3 size = glm::vec3(1.0f);      // 对于Box：长宽高
+        float radius = 0.5f;                   // 对于Sphere/Capsule：半径
+        float height = 2.0f;                   // 对于Capsule：高度
+        glm::vec3 offset = glm::vec3(0.0f);    // 相对于物体中心的偏移
 
-        bool isTrigger = false;                // ǷǴ
+        bool isTrigger = false;                // 是否是触发器
         bool enabled = true;
 
-        // 
-        uint32_t layerMask = 0xFFFFFFFF;       // ײ
-        float bounciness = 0.0f;               // 
-        float staticFriction = 0.5f;           // Ħ
-        float dynamicFriction = 0.3f;          // Ħ
+        // 新增特性
+        uint32_t layerMask = 0xFFFFFFFF;       // 碰撞层掩码
+        float bounciness = 0.0f;               // 弹性
+        float staticFriction = 0.5f;           // 静摩擦
+        float dynamicFriction = 0.3f;          // 动摩擦
 
         ColliderComponent() = default;
         ColliderComponent(ColliderType colliderType) : type(colliderType) {}
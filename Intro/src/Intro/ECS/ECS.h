@@ -3,47 +3,74 @@
 
 #include <entt/entt.hpp>
 #include "Components.h"
+#include "TagIndex.h"
 #include <utility> // for std::forward
 #include <type_traits>
+#include <atomic>
+#include <vector>
 #include "Intro/Core.h"
 
 namespace Intro {
 
     class ITR_API ECS {
     public:
-        using Entity = entt::entity; // ʵ
-
-        ECS() = default;
+        using Entity = entt::entity; // 实体类型
+
+        // 未被消费的渲染变化 / 移动超过这个数量时改为整体重建（场景不被渲染时不会无限增长）
+        static constexpr size_t MaxPendingRenderableChanges = 16384;
+
+        ECS() : m_InstanceID(NextInstanceID()) {
+            // 变换或渲染几何变化时让 LocalToWorldComponent 在下一次 TransformSystem::Update 中重算
+            m_Registry.on_construct<TransformComponent>().connect<&ECS::OnTransformChanged>();
+            m_Registry.on_update<TransformComponent>().connect<&ECS::OnTransformChanged>();
+            m_Registry.on_destroy<TransformComponent>().connect<&ECS::OnTransformDestroyed>();
+            m_Registry.on_construct<MeshComponent>().connect<&ECS::OnBoundsChanged>();
+            m_Registry.on_update<MeshComponent>().connect<&ECS::OnBoundsChanged>();
+            m_Registry.on_destroy<MeshComponent>().connect<&ECS::OnBoundsChanged>();
+            m_Registry.on_construct<ModelComponent>().connect<&ECS::OnBoundsChanged>();
+            m_Registry.on_update<ModelComponent>().connect<&ECS::OnBoundsChanged>();
+            m_Registry.on_destroy<ModelComponent>().connect<&ECS::OnBoundsChanged>();
+
+            // 影响渲染代理的结构变化（几何、材质、遮挡标记、是否有世界矩阵）由 RenderWorld 在下一帧增量同步
+            ConnectRenderable<LocalToWorldComponent>();
+            ConnectRenderable<MeshComponent>();
+            ConnectRenderable<ModelComponent>();
+            ConnectRenderable<MaterialComponent>();
+            ConnectRenderable<PBRMaterialComponent>();
+            ConnectRenderable<OccluderComponent>();
+
+            m_TagIndex.Connect(m_Registry);
+        }
         ~ECS() = default;
 
-        // ÿentt::registry ɿ
+        // 禁用拷贝（entt::registry 不可拷贝）
         ECS(const ECS&) = delete;
         ECS& operator=(const ECS&) = delete;
 
         ECS(ECS&&) = delete;
         ECS& operator=(ECS&&) = delete;
 
-        // ʵ
+        // 创建实体
         Entity CreateEntity() {
             return m_Registry.create();
         }
 
-        // ʵ
+        // 销毁实体
         void DestroyEntity(Entity entity) {
             m_Registry.destroy(entity);
         }
 
-        // 
+        // 添加组件
         template <typename Component, typename... Args>
         Component& AddComponent(Entity entity, Args&&... args) {
-            // emplace_or_replace ᴴ滻
+            // emplace_or_replace 会创建或替换现有组件并返回引用
             
             if constexpr (std::is_invocable_v<decltype(&entt::registry::template emplace_or_replace<Component>), entt::registry, Entity, Args...>) {
                 m_Registry.emplace_or_replace<Component>(entity, std::forward<Args>(args)...);
                 return m_Registry.get<Component>(entity);
             }
             else {
-                // ݾɰ棺Ƴ emplace
+                // 兼容旧版：先移除再 emplace
                 if (m_Registry.all_of<Component>(entity)) {
                     m_Registry.remove<Component>(entity);
                 }
@@ -52,19 +79,19 @@ namespace Intro {
             }
         }
 
-        // ȡ
+        // 获取组件
         template <typename Component>
         Component& GetComponent(Entity entity) {
             return m_Registry.get<Component>(entity);
         }
 
-        // ȡֻconst 汾
+        // 获取只读组件（const 版本）
         template <typename Component>
         const Component& GetComponent(Entity entity) const {
             return m_Registry.get<Component>(entity);
         }
 
-        // Իȡȫڷ nullptr
+        // 尝试获取组件（安全，不存在返回 nullptr）
         template <typename Component>
         Component* TryGetComponent(Entity entity) {
             return m_Registry.try_get<Component>(entity);
@@ -87,14 +114,108 @@ namespace Intro {
             }
         }
 
-        //  const עʣϵͳҪ
+        // 直接改写 TransformComponent（不经过 patch / replace）后调用
+        void MarkTransformDirty(Entity entity) {
+            MarkDirty(m_Registry, entity);
+        }
+
+        // 直接改写 Mesh/Model/材质组件的字段（不经过 patch / replace）后调用
+        void MarkRenderableDirty(Entity entity) {
+            if (m_RenderableChanges.size() >= MaxPendingRenderableChanges) {
+                m_RenderableChanges.clear();
+                m_MovedEntities.clear();
+                m_RebuildAllRenderables = true;
+            }
+            if (!m_RebuildAllRenderables) {
+                m_RenderableChanges.push_back(entity);
+            }
+        }
+
+        // 取出上次消费之后发生结构变化的实体（可能重复，也可能已被销毁）；返回 true 表示需要整体重建
+        bool ConsumeRenderableChanges(std::vector<Entity>& changed) {
+            changed.clear();
+            changed.swap(m_RenderableChanges);
+            bool rebuildAll = m_RebuildAllRenderables;
+            m_RebuildAllRenderables = false;
+            return rebuildAll;
+        }
+
+        // TransformSystem 记录本次更新过世界矩阵的实体，RenderWorld 据此只刷新移动过的代理
+        void RecordMovedEntities(const std::vector<Entity>& entities) {
+            if (m_RebuildAllRenderables) return;
+            if (m_MovedEntities.size() + entities.size() > MaxPendingRenderableChanges) {
+                m_MovedEntities.clear();
+                m_RenderableChanges.clear();
+                m_RebuildAllRenderables = true;
+                return;
+            }
+            m_MovedEntities.insert(m_MovedEntities.end(), entities.begin(), entities.end());
+        }
+
+        void ConsumeMovedEntities(std::vector<Entity>& moved) {
+            moved.clear();
+            moved.swap(m_MovedEntities);
+        }
+
+        // 按名称 / 标签查找实体（GameObject::Find、FindWithTag 使用）
+        const TagIndex& GetTagIndex() const { return m_TagIndex; }
+
+        // 每个 ECS 实例唯一（地址可能被新场景复用，消费者用它判断是否换了注册表）
+        uint64_t GetInstanceID() const { return m_InstanceID; }
+
+        // 非 const 注册表访问（大多数系统需要）
         entt::registry& GetRegistry() { return m_Registry; }
 
-        // const עʣֻ
+        // const 注册表访问（只读）
         const entt::registry& GetRegistry() const { return m_Registry; }
 
     private:
-        entt::registry m_Registry; // EnTT ĺע
+        static void MarkDirty(entt::registry& registry, Entity entity) {
+            if (auto* localToWorld = registry.try_get<LocalToWorldComponent>(entity)) {
+                localToWorld->dirty = true;
+            }
+            else if (registry.all_of<TransformComponent>(entity)) {
+                registry.emplace<LocalToWorldComponent>(entity);
+            }
+        }
+
+        static void OnTransformChanged(entt::registry& registry, Entity entity) {
+            MarkDirty(registry, entity);
+        }
+
+        static void OnTransformDestroyed(entt::registry& registry, Entity entity) {
+            registry.remove<LocalToWorldComponent>(entity);
+        }
+
+        // Mesh/Model 变化只影响世界包围体
+        static void OnBoundsChanged(entt::registry& registry, Entity entity) {
+            if (auto* localToWorld = registry.try_get<LocalToWorldComponent>(entity)) {
+                localToWorld->dirty = true;
+            }
+        }
+
+        template <typename Component>
+        void ConnectRenderable() {
+            m_Registry.on_construct<Component>().template connect<&ECS::OnRenderableChanged>(*this);
+            m_Registry.on_update<Component>().template connect<&ECS::OnRenderableChanged>(*this);
+            m_Registry.on_destroy<Component>().template connect<&ECS::OnRenderableChanged>(*this);
+        }
+
+        void OnRenderableChanged(entt::registry&, Entity entity) {
+            MarkRenderableDirty(entity);
+        }
+
+        static uint64_t NextInstanceID() {
+            static std::atomic<uint64_t> s_NextID{ 1 };
+            return s_NextID++;
+        }
+
+        entt::registry m_Registry; // EnTT 的核心注册表
+        uint64_t m_InstanceID;
+        TagIndex m_TagIndex;
+        std::vector<Entity> m_RenderableChanges;
+        std::vector<Entity> m_MovedEntities;
+        bool m_RebuildAllRenderables = true;    // 第一次消费时整体建立
     };
 
 } // namespace Intro
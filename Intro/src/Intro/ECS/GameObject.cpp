@@ -32,7 +32,8 @@ namespace Intro {
         if (!IsValid()) return;
 
         if (HasComponent<TagComponent>()) {
-            GetComponent<TagComponent>().Tag = name;
+            // patch 触发 on_update，名称索引随之更新
+            m_ECS->GetRegistry().patch<TagComponent>(m_Entity, [&name](TagComponent& tag) { tag.Tag = name; });
         }
         else {
             AddComponent<TagComponent>(name);
@@ -42,6 +43,8 @@ namespace Intro {
     Transform& GameObject::GetTransform() {
         ITR_CORE_ASSERT(IsValid(), "Cannot get transform from invalid GameObject!");
         ITR_CORE_ASSERT(HasComponent<TransformComponent>(), "GameObject must have TransformComponent!");
+        // 非 const 访问视为写入：缓存的世界矩阵在下一次 TransformSystem::Update 中重算
+        m_ECS->MarkTransformDirty(m_Entity);
         return GetComponent<TransformComponent>().transform;
     }
 
@@ -66,14 +69,14 @@ namespace Intro {
             if (HasComponent<ActiveComponent>()) {
                 GetComponent<ActiveComponent>().active = false;
             }
-            // ActiveComponentĬΪ״̬
+            // 如果不包含ActiveComponent，默认为激活状态
         }
     }
 
     bool GameObject::IsActive() const {
         if (!IsValid()) return false;
 
-        // ûActiveComponentĬΪ״̬
+        // 如果没有ActiveComponent，默认为激活状态
         if (!HasComponent<ActiveComponent>()) {
             return true;
         }
@@ -88,20 +91,17 @@ namespace Intro {
     // Static methods
     // -------------------------------------------------------------------------
 
+    // 名称与标签都保存在 TagComponent 中，查找走 ECS 维护的散列索引，不再遍历所有实体
+
     GameObject GameObject::Find(Scene* scene, const std::string& name) {
         if (!scene) return GameObject();
 
-        auto& registry = scene->GetECS().GetRegistry();
-        auto view = registry.view<TagComponent>();
-
-        for (auto entity : view) {
-            const auto& tag = view.get<TagComponent>(entity);
-            if (tag.Tag == name) {
-                return GameObject(entity, &scene->GetECS());
-            }
+        ECS& ecs = scene->GetECS();
+        auto entity = ecs.GetTagIndex().FindFirst(ecs.GetRegistry(), name);
+        if (entity == entt::null) {
+            return GameObject(); // 返回无效的GameObject
         }
-
-        return GameObject(); // ЧGameObject
+        return GameObject(entity, &ecs);
     }
 
     std::vector<GameObject> GameObject::FindGameObjectsWithTag(Scene* scene, const std::string& tag) {
@@ -109,22 +109,19 @@ namespace Intro {
 
         if (!scene) return result;
 
-        auto& registry = scene->GetECS().GetRegistry();
-        auto view = registry.view<TagComponent>();
+        ECS& ecs = scene->GetECS();
+        std::vector<ECS::Entity> entities;
+        ecs.GetTagIndex().FindAll(ecs.GetRegistry(), tag, entities);
 
-        for (auto entity : view) {
-            const auto& tagComp = view.get<TagComponent>(entity);
-            if (tagComp.Tag == tag) {
-                result.emplace_back(entity, &scene->GetECS());
-            }
+        result.reserve(entities.size());
+        for (auto entity : entities) {
+            result.emplace_back(entity, &ecs);
         }
-
         return result;
     }
 
     GameObject GameObject::FindWithTag(Scene* scene, const std::string& tag) {
-        auto objects = FindGameObjectsWithTag(scene, tag);
-        return objects.empty() ? GameObject() : objects[0];
+        return Find(scene, tag);
     }
 
 } // namespace Intro
\ No newline at end of file
@@ -10,34 +10,34 @@
 
 namespace Intro {
 
-    // ǰ - ֻ
+    // 前置声明 - 只声明不包含
     class Scene;
     class ECS;
-    struct Transform;  // ޸ƴд
+    struct Transform;  // 修复拼写错误
 
     using Entity = entt::entity;
 
-    // ״̬
+    // 激活状态组件
     struct ActiveComponent {
         bool active = true;
     };
 
     class ITR_API GameObject {
     public:
-        // /
+        // 构造/析构
         GameObject();
         GameObject(Entity entity, ECS* ecs);
         ~GameObject() = default;
 
-        // ʹĬʵ֣
+        // 允许拷贝（使用默认实现）
         GameObject(const GameObject&) = default;
         GameObject& operator=(const GameObject&) = default;
 
-        // ƶ
+        // 允许移动
         GameObject(GameObject&&) = default;
         GameObject& operator=(GameObject&&) = default;
 
-        // 
+        // 组件管理
         template<typename T, typename... Args>
         T& AddComponent(Args&&... args);
 
@@ -53,26 +53,28 @@ namespace Intro {
         template<typename T>
         void RemoveComponent();
 
-        // 
+        // 基础属性
         std::string GetName() const;
         void SetName(const std::string& name);
 
+        // 非 const 版本会把 LocalToWorldComponent 标记为 dirty；只读时使用 const 版本
         Transform& GetTransform();
         const Transform& GetTransform() const;
 
         void SetActive(bool active);
         bool IsActive() const;
 
-        // ʵ
-        Entity GetEntity() const { return m_Entity; }  // Ϊ Entity
+        // 实体操作
+        Entity GetEntity() const { return m_Entity; }  // 改为 Entity
+        ECS* GetECS() const { return m_ECS; }
         bool IsValid() const;
 
-        // ̬ҷ
+        // 静态查找方法
         static GameObject Find(Scene* scene, const std::string& name);
         static std::vector<GameObject> FindGameObjectsWithTag(Scene* scene, const std::string& tag);
         static GameObject FindWithTag(Scene* scene, const std::string& tag);
 
-        // Ƚϲ
+        // 比较操作
         bool operator==(const GameObject& other) const {
             return m_Entity == other.m_Entity && m_ECS == other.m_ECS;
         }
@@ -87,7 +89,7 @@ namespace Intro {
 
 } // namespace Intro
 
-// ģ巽ʵ
+// 模板方法实现
 namespace Intro {
 
     template<typename T, typename... Args>
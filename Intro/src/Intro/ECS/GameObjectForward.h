@@ -14,5 +14,5 @@ namespace Intro {
     struct ActiveComponent;
     struct TagComponent;
     struct LightComponent;
-    // ... ǰ
+    // ... 其他组件的前置声明
 }
\ No newline at end of file
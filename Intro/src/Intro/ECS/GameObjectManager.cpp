@@ -2,6 +2,8 @@
 #include "GameObjectManager.h"
 #include "Intro/ECS/Scene.h"
 #include "Intro/Log.h"
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
 
 namespace Intro {
 
@@ -12,11 +14,53 @@ namespace Intro {
     GameObjectManager::GameObjectManager(Scene* scene)
         : m_Scene(scene), m_NeedsRefresh(true)
     {
+        ConnectHierarchy();
+    }
+
+    GameObjectManager::~GameObjectManager() {
+        DisconnectHierarchy();
     }
 
     void GameObjectManager::SetScene(Scene* scene) {
+        if (scene == m_Scene) return;
+
+        DisconnectHierarchy();
         m_Scene = scene;
         m_NeedsRefresh = true;
+        ConnectHierarchy();
+    }
+
+    void GameObjectManager::ConnectHierarchy() {
+        if (!m_Scene) return;
+
+        auto& registry = m_Scene->GetECS().GetRegistry();
+        m_Hierarchy = std::make_unique<TransformHierarchy>(registry);
+        registry.on_destroy<HierarchyComponent>().connect<&GameObjectManager::OnHierarchyNodeDestroyed>(*this);
+    }
+
+    void GameObjectManager::DisconnectHierarchy() {
+        if (!m_Scene || !m_Hierarchy) return;
+
+        auto& registry = m_Scene->GetECS().GetRegistry();
+        registry.on_destroy<HierarchyComponent>().disconnect<&GameObjectManager::OnHierarchyNodeDestroyed>(*this);
+        m_Hierarchy->Clear();
+        m_Hierarchy.reset();
+    }
+
+    void GameObjectManager::OnHierarchyNodeDestroyed(entt::registry&, entt::entity entity) {
+        // RemoveSubtree / Clear 先截断数组再移除组件，这里查不到下标，直接忽略
+        if (m_Hierarchy) {
+            m_Hierarchy->RemoveNode(entity);
+        }
+    }
+
+    GameObject GameObjectManager::MakeGameObject(entt::entity entity) const {
+        if (!m_Scene || entity == entt::null) return GameObject();
+        return GameObject(entity, &m_Scene->GetECS());
+    }
+
+    ECS* GameObjectManager::GetECS() const {
+        return m_Scene ? &m_Scene->GetECS() : nullptr;
     }
 
     GameObject GameObjectManager::CreateGameObject(const std::string& name) {
@@ -27,10 +71,10 @@ namespace Intro {
 
         GameObject go = m_Scene->CreateGameObject(name);
 
-        // ˢ»
+        // 刷新缓存
         m_NeedsRefresh = true;
 
-        // ص
+        // 触发回调
         if (onGameObjectCreated) {
             onGameObjectCreated(go);
         }
@@ -52,27 +96,31 @@ namespace Intro {
     void GameObjectManager::DestroyGameObject(GameObject& gameObject) {
         if (!gameObject.IsValid() || !m_Scene) return;
 
-        // Ӷ
-        auto children = GetChildren(gameObject);
-        for (auto& child : children) {
-            DestroyGameObject(child);
-        }
+        std::string name = gameObject.GetName();
 
-        // ǰص
-        if (onGameObjectDestroyed) {
-            onGameObjectDestroyed(gameObject);
+        // 整个子树在层级数组中是一段连续区间，一次性摘出（先序：父在前）
+        std::vector<entt::entity> subtree;
+        if (m_Hierarchy) {
+            subtree = m_Hierarchy->RemoveSubtree(gameObject.GetEntity());
         }
-
-        // ӸƳ
-        auto parent = GetParent(gameObject);
-        if (parent.IsValid()) {
-            // ҪʵִӸHierarchyComponentƳӶ
+        if (subtree.empty()) {
+            subtree.push_back(gameObject.GetEntity());
         }
 
-        m_Scene->Destroy(gameObject);
+        // 逆序销毁：子对象先于父对象，与原来的递归顺序一致
+        for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+            GameObject go = MakeGameObject(*it);
+            if (!go.IsValid()) continue;
+
+            // 触发销毁前回调
+            if (onGameObjectDestroyed) {
+                onGameObjectDestroyed(go);
+            }
+            m_Scene->Destroy(go);
+        }
         m_NeedsRefresh = true;
 
-        ITR_INFO("Destroyed GameObject: {}", gameObject.GetName());
+        ITR_INFO("Destroyed GameObject: {} ({} objects)", name, subtree.size());
     }
 
     void GameObjectManager::DestroyGameObjectImmediate(GameObject& gameObject) {
@@ -97,7 +145,7 @@ namespace Intro {
     std::vector<GameObject> GameObjectManager::GetAllGameObjects() const {
         if (!m_Scene) return {};
 
-        // Ҫˢ£»ȡGameObject
+        // 如果缓存需要刷新，重新获取所有GameObject
         if (m_NeedsRefresh) {
             const_cast<GameObjectManager*>(this)->RefreshGameObjectList();
         }
@@ -117,43 +165,70 @@ namespace Intro {
         m_NeedsRefresh = false;
     }
 
-    void GameObjectManager::SetParent(GameObject child, GameObject parent) {
-        if (!child.IsValid() || !parent.IsValid()) return;
-        if (child == parent) return; // ԼΪ
+    void GameObjectManager::SetParent(GameObject child, GameObject parent, bool keepWorldTransform) {
+        if (!child.IsValid() || !m_Hierarchy) return;
+        if (child == parent) return; // 不能设置自己为父对象
 
-        // ѭ
-        if (IsInHierarchy(child, parent)) {
+        // 检查循环引用
+        if (parent.IsValid() && IsInHierarchy(child, parent)) {
             ITR_ERROR("Cannot set parent: Circular hierarchy detected!");
             return;
         }
+        if (GetParent(child) == parent) return;
 
-        // ӵǰƳ
-        auto currentParent = GetParent(child);
-        if (currentParent.IsValid()) {
-            // ӵǰchildrenбƳ
-            // ҪʵHierarchyComponentchildren
+        glm::mat4 childWorld = GetWorldMatrix(child);
+        entt::entity parentEntity = parent.IsValid() ? parent.GetEntity() : entt::null;
+        if (!m_Hierarchy->SetParent(child.GetEntity(), parentEntity)) {
+            ITR_ERROR("Cannot set parent: {} -> {}", child.GetName(), parent.IsValid() ? parent.GetName() : "<root>");
+            return;
         }
 
-        // µĸ
-        // ҪʵHierarchyComponentparent
+        if (keepWorldTransform && child.HasComponent<TransformComponent>()) {
+            glm::mat4 parentWorld = parent.IsValid() ? GetWorldMatrix(parent) : glm::mat4(1.0f);
+            glm::mat4 local = glm::inverse(parentWorld) * childWorld;
+
+            glm::vec3 scale, translation, skew;
+            glm::vec4 perspective;
+            glm::quat rotation;
+            if (glm::decompose(local, scale, rotation, translation, skew, perspective)) {
+                // GetTransform 同时标记 LocalToWorld 为 dirty
+                Transform& transform = child.GetTransform();
+                transform.position = translation;
+                transform.rotation = glm::normalize(rotation);
+                transform.scale = scale;
+            }
+        }
+        else {
+            // 局部变换不变，但父对象变了：世界矩阵需要重算
+            m_Scene->GetECS().MarkTransformDirty(child.GetEntity());
+        }
 
-        ITR_INFO("Set parent: {} -> {}", child.GetName(), parent.GetName());
+        ITR_INFO("Set parent: {} -> {}", child.GetName(), parent.IsValid() ? parent.GetName() : "<root>");
     }
 
     GameObject GameObjectManager::GetParent(GameObject gameObject) const {
-        if (!gameObject.IsValid()) return GameObject();
-
-        // ǷHierarchyComponentparent
-        // ҪʵHierarchyComponentparentȡ
-        return GameObject();
+        if (!gameObject.IsValid() || !m_Hierarchy) return GameObject();
+        return MakeGameObject(m_Hierarchy->GetParent(gameObject.GetEntity()));
     }
 
     std::vector<GameObject> GameObjectManager::GetChildren(GameObject parent) const {
-        if (!parent.IsValid()) return {};
+        if (!parent.IsValid() || !m_Hierarchy) return {};
 
-        // HierarchyComponentлȡchildrenб
-        // ҪʵHierarchyComponentchildrenȡ
-        return {};
+        std::vector<GameObject> children;
+        for (entt::entity entity : m_Hierarchy->GetChildren(parent.GetEntity())) {
+            children.push_back(MakeGameObject(entity));
+        }
+        return children;
+    }
+
+    glm::mat4 GameObjectManager::GetWorldMatrix(GameObject gameObject) const {
+        if (!gameObject.IsValid()) return glm::mat4(1.0f);
+        if (m_Hierarchy) {
+            return m_Hierarchy->ComputeWorldMatrix(gameObject.GetEntity());
+        }
+        return gameObject.HasComponent<TransformComponent>()
+            ? gameObject.GetComponent<TransformComponent>().transform.GetModelMatrix()
+            : glm::mat4(1.0f);
     }
 
     void GameObjectManager::SetActive(GameObject gameObject, bool active) {
@@ -172,12 +247,17 @@ namespace Intro {
     void GameObjectManager::SetActiveRecursive(GameObject gameObject, bool active) {
         if (!gameObject.IsValid()) return;
 
-        SetActive(gameObject, active);
+        uint32_t index = m_Hierarchy ? m_Hierarchy->IndexOf(gameObject.GetEntity()) : TransformHierarchy::InvalidIndex;
+        if (index == TransformHierarchy::InvalidIndex) {
+            SetActive(gameObject, active);
+            return;
+        }
 
-        // ݹӶ
-        auto children = GetChildren(gameObject);
-        for (auto& child : children) {
-            SetActiveRecursive(child, active);
+        // 子树是层级数组中的连续区间 [index, index + size)；先拷贝，回调中修改层级也不受影响
+        const auto& entities = m_Hierarchy->GetEntities();
+        std::vector<entt::entity> subtree(entities.begin() + index, entities.begin() + index + m_Hierarchy->GetSubtreeSizes()[index]);
+        for (entt::entity entity : subtree) {
+            SetActive(MakeGameObject(entity), active);
         }
     }
 
@@ -212,15 +292,9 @@ namespace Intro {
     bool GameObjectManager::IsInHierarchy(GameObject parent, GameObject child) const {
         if (!parent.IsValid() || !child.IsValid()) return false;
         if (parent == child) return true;
+        if (!m_Hierarchy) return false;
 
-        auto children = GetChildren(parent);
-        for (const auto& c : children) {
-            if (IsInHierarchy(c, child)) {
-                return true;
-            }
-        }
-
-        return false;
+        return m_Hierarchy->IsDescendantOf(child.GetEntity(), parent.GetEntity());
     }
 
 } // namespace Intro
\ No newline at end of file
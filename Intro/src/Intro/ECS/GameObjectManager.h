@@ -2,7 +2,9 @@
 #pragma once
 
 #include "Intro/Core.h"
-#include "GameObject.h"  //  GameObjectΪҪ
+#include "GameObject.h"  // 包含 GameObject，因为需要它的完整定义
+#include "ECS.h"
+#include "TransformHierarchy.h"
 #include <vector>
 #include <string>
 #include <functional>
@@ -10,57 +12,99 @@
 
 namespace Intro {
 
-    // ǰ
+    // 前置声明
     class Scene;
 
+    // 拥有组件 T 的对象的惰性视图：直接遍历 entt 存储，解引用时才构造 GameObject，不复制实体列表。
+    // 遍历期间不要给 T 增删组件或销毁实体
+    template<typename T>
+    class GameObjectView {
+    public:
+        using View = decltype(std::declval<entt::registry&>().view<T>());
+
+        class Iterator {
+        public:
+            Iterator(typename View::iterator it, ECS* ecs) : m_It(it), m_ECS(ecs) {}
+
+            GameObject operator*() const { return GameObject(*m_It, m_ECS); }
+            Iterator& operator++() { ++m_It; return *this; }
+            bool operator==(const Iterator& other) const { return m_It == other.m_It; }
+            bool operator!=(const Iterator& other) const { return m_It != other.m_It; }
+
+        private:
+            typename View::iterator m_It;
+            ECS* m_ECS;
+        };
+
+        GameObjectView() = default;
+        GameObjectView(View view, ECS* ecs) : m_View(view), m_ECS(ecs) {}
+
+        Iterator begin() const { return Iterator(m_View.begin(), m_ECS); }
+        Iterator end() const { return Iterator(m_View.end(), m_ECS); }
+        size_t size() const { return m_View.size(); }
+        bool empty() const { return m_View.empty(); }
+
+        // 底层 entt 视图，可以直接 get<T>(entity)
+        const View& GetView() const { return m_View; }
+
+    private:
+        View m_View;
+        ECS* m_ECS = nullptr;
+    };
+
     class ITR_API GameObjectManager {
     public:
         GameObjectManager(Scene* scene = nullptr);
-        ~GameObjectManager() = default;
+        ~GameObjectManager();
 
-        // ÿƶ
+        // 禁用拷贝和移动
         GameObjectManager(const GameObjectManager&) = delete;
         GameObjectManager& operator=(const GameObjectManager&) = delete;
         GameObjectManager(GameObjectManager&&) = delete;
         GameObjectManager& operator=(GameObjectManager&&) = delete;
 
-        // ùĳ
+        // 设置关联的场景
         void SetScene(Scene* scene);
         Scene* GetScene() const { return m_Scene; }
 
-        // GameObject ͹
+        // GameObject 创建和管理
         GameObject CreateGameObject(const std::string& name = "GameObject");
         GameObject CreateGameObjectWithParent(const std::string& name, GameObject parent);
 
         void DestroyGameObject(GameObject& gameObject);
         void DestroyGameObjectImmediate(GameObject& gameObject);
 
-        // ҷ
+        // 查找方法
         GameObject Find(const std::string& name) const;
         GameObject FindWithTag(const std::string& tag) const;
         std::vector<GameObject> FindAllWithTag(const std::string& tag) const;
 
+        // 返回惰性视图而不是复制的数组：for (GameObject go : manager.FindAllWithComponent<MeshComponent>())
         template<typename T>
-        std::vector<GameObject> FindAllWithComponent() const;
+        GameObjectView<T> FindAllWithComponent() const;
 
-        // 
+        // 批量操作
         std::vector<GameObject> GetAllGameObjects() const;
         void DestroyAllGameObjects();
 
-        // 㼶ϵ
-        void SetParent(GameObject child, GameObject parent);
+        // 层级关系（parent 无效时变为根节点）
+        // keepWorldTransform 为 true 时重新计算局部变换，使对象的世界变换保持不变
+        void SetParent(GameObject child, GameObject parent, bool keepWorldTransform = true);
         GameObject GetParent(GameObject gameObject) const;
         std::vector<GameObject> GetChildren(GameObject parent) const;
+        // 沿父链计算的当前世界矩阵（TransformComponent 保存的是相对父对象的局部变换）
+        glm::mat4 GetWorldMatrix(GameObject gameObject) const;
+        const TransformHierarchy* GetHierarchy() const { return m_Hierarchy.get(); }
 
-        // ״̬
+        // 激活状态管理
         void SetActive(GameObject gameObject, bool active);
         void SetActiveRecursive(GameObject gameObject, bool active);
 
-        // ͳϢ
+        // 统计信息
         size_t GetGameObjectCount() const;
         size_t GetActiveGameObjectCount() const;
 
-        // ص
+        // 回调函数
         std::function<void(GameObject)> onGameObjectCreated;
         std::function<void(GameObject)> onGameObjectDestroyed;
         std::function<void(GameObject, bool)> onGameObjectActiveChanged;
@@ -68,33 +112,34 @@ namespace Intro {
         void MarkNeedsRefresh() { m_NeedsRefresh = true; }
 
     private:
-        // ڲ
+        // 内部辅助方法
         void RefreshGameObjectList();
         bool IsInHierarchy(GameObject parent, GameObject child) const;
+        GameObject MakeGameObject(entt::entity entity) const;
+        ECS* GetECS() const;
 
-        // 㼶ϵ
-        struct HierarchyComponent {
-            GameObject parent{};
-            std::vector<GameObject> children;
-        };
+        void ConnectHierarchy();
+        void DisconnectHierarchy();
+        // 实体不经过 DestroyGameObject 被销毁时，把它从层级中摘除（子对象变为根）
+        void OnHierarchyNodeDestroyed(entt::registry& registry, entt::entity entity);
 
     private:
         Scene* m_Scene = nullptr;
+        std::unique_ptr<TransformHierarchy> m_Hierarchy;
         std::vector<GameObject> m_CachedGameObjects;
         bool m_NeedsRefresh = true;
     };
 
 } // namespace Intro
 
-// ģ巽ʵ
+// 模板方法实现
 namespace Intro {
 
     template<typename T>
-    std::vector<GameObject> GameObjectManager::FindAllWithComponent() const {
-        if (!m_Scene) return {};
-        // Ҫ Scene жӦķûҪʵ
-        return m_Scene->FindGameObjectsWithComponent<T>();
-
+    GameObjectView<T> GameObjectManager::FindAllWithComponent() const {
+        ECS* ecs = GetECS();
+        if (!ecs) return {};
+        return GameObjectView<T>(ecs->GetRegistry().view<T>(), ecs);
     }
 
 } // namespace Intro
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "itrpch.h"
+#include "Prefab.h"
+#include "ECS.h"
+#include "Components.h"
+#include "TransformHierarchy.h"
+#include "Intro/Log.h"
+
+namespace Intro {
+
+    namespace {
+
+        // 不从模板复制的存储：变换单独按实例写入，其余是派生或结构性数据
+        bool IsExcludedStorage(entt::id_type id) {
+            return id == entt::type_hash<TransformComponent>::value()
+                || id == entt::type_hash<LocalToWorldComponent>::value()
+                || id == entt::type_hash<HierarchyComponent>::value();
+        }
+
+        struct StoragePair {
+            const entt::sparse_set* source;
+            entt::sparse_set* destination;
+        };
+
+    }
+
+    Transform Prefab::GetTransform() const {
+        if (m_HasTransform) return m_Transform;
+        if (m_Template.HasComponent<TransformComponent>()) {
+            return m_Template.GetComponent<TransformComponent>().transform;
+        }
+        return Transform();
+    }
+
+    bool Prefab::HasOverride(entt::id_type id) const {
+        for (const auto& component : m_Overrides) {
+            if (component.id == id) return true;
+        }
+        return false;
+    }
+
+    void Prefab::Spawn(ECS& ecs, const entt::entity* first, const entt::entity* last, const Transform* transforms) const {
+        const size_t count = (size_t)(last - first);
+        if (count == 0) return;
+
+        auto& registry = ecs.GetRegistry();
+        const bool hasTemplate = m_Template.IsValid();
+        const entt::entity templateEntity = m_Template.GetEntity();
+
+        // 1. 收集模板上需要复制的存储（在创建任何新存储之前完成，避免遍历期间存储表变化）
+        std::vector<StoragePair> storages;
+        uint32_t missingStorages = 0;
+        if (hasTemplate) {
+            const entt::registry& source = m_Template.GetECS()->GetRegistry();
+            for (auto [id, storage] : source.storage()) {
+                if (IsExcludedStorage(id) || HasOverride(id) || !storage.contains(templateEntity)) continue;
+
+                entt::sparse_set* destination = registry.storage(id);
+                if (!destination) {
+                    missingStorages++;
+                    continue;
+                }
+                storages.push_back({ &storage, destination });
+            }
+        }
+        if (missingStorages > 0) {
+            ITR_WARN("Prefab: {} component types of '{}' have no storage in the target scene and were skipped",
+                missingStorages, m_Template.GetName());
+        }
+
+        // 2. 预留全部存储，插入过程中各个池只增长一次
+        for (const auto& pair : storages) {
+            pair.destination->reserve(pair.destination->size() + count);
+        }
+        for (const auto& component : m_Overrides) {
+            component.reserve(registry, count);
+        }
+
+        const bool hasTransform = m_HasTransform || transforms || (hasTemplate && m_Template.HasComponent<TransformComponent>());
+        if (hasTransform) {
+            auto& transformStorage = registry.storage<TransformComponent>();
+            transformStorage.reserve(transformStorage.size() + count);
+            // TransformComponent 的 on_construct 会为每个实例添加 LocalToWorldComponent
+            auto& localToWorldStorage = registry.storage<LocalToWorldComponent>();
+            localToWorldStorage.reserve(localToWorldStorage.size() + count);
+
+            if (transforms) {
+                std::vector<TransformComponent> values(count);
+                for (size_t i = 0; i < count; ++i) {
+                    values[i].transform = transforms[i];
+                }
+                registry.insert<TransformComponent>(first, last, values.begin());
+            }
+            else {
+                TransformComponent value;
+                value.transform = GetTransform();
+                registry.insert<TransformComponent>(first, last, value);
+            }
+        }
+
+        // 3. 按存储批量复制模板组件（存储按页分配，预留之后模板元素的地址不会变化）
+        for (const auto& pair : storages) {
+            const void* value = pair.source->value(templateEntity);
+            for (const entt::entity* entity = first; entity != last; ++entity) {
+                pair.destination->push(*entity, value);
+            }
+        }
+
+        for (const auto& component : m_Overrides) {
+            component.insert(registry, first, last, component.value.get());
+        }
+
+        // 场景只有一个主相机，实例不继承主相机标记
+        if (auto* cameras = registry.storage(entt::type_hash<CameraComponent>::value()); cameras && cameras->contains(*first)) {
+            auto& cameraStorage = registry.storage<CameraComponent>();
+            for (const entt::entity* entity = first; entity != last; ++entity) {
+                cameraStorage.get(*entity).isMainCamera = false;
+            }
+        }
+    }
+
+} // namespace Intro
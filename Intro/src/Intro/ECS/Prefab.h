@@ -0,0 +1,81 @@
+// Prefab.h
+#pragma once
+
+#include "Intro/Core.h"
+#include "Intro/Math/Transform.h"
+#include "ECS.h"
+#include "GameObject.h"
+#include <entt/entt.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Intro {
+
+    // 预制体：批量实例化的模板
+    // - 从 GameObject 构造时引用该对象（模板对象，通常是停用或放在单独场景里的对象），实例化时复制它当时的全部组件：
+    //   遍历模板 registry 的每个组件存储，按实例数预留后整批写入，包括引擎之外自定义的组件类型
+    // - 不复制 LocalToWorld / Hierarchy 这类派生或结构性组件：实例都是根节点，世界矩阵由 TransformSystem 重算；子对象也不复制
+    // - Set<T> / SetTransform 给出的值覆盖模板上的同类组件；没有模板对象时只写入这些值
+    // - 目标 registry 与模板不同时，只能复制目标中已经存在存储的组件类型，其余类型会输出警告
+    // 模板对象在实例化时必须仍然有效
+    class ITR_API Prefab {
+    public:
+        Prefab() = default;
+        explicit Prefab(const GameObject& templateObject) : m_Template(templateObject) {}
+
+        // 设置 / 覆盖一个组件的值（TransformComponent 请使用 SetTransform）
+        template<typename T>
+        Prefab& Set(const T& value);
+
+        void SetTransform(const Transform& transform) { m_Transform = transform; m_HasTransform = true; }
+        // 覆盖值优先，其次是模板对象当前的变换
+        Transform GetTransform() const;
+
+        const GameObject& GetTemplate() const { return m_Template; }
+        bool IsValid() const { return m_Template.IsValid() || m_HasTransform || !m_Overrides.empty(); }
+
+        // 给 [first, last) 中已创建的实体写入组件副本；transforms 不为空时提供每个实例的变换（数量与实体相同）
+        void Spawn(ECS& ecs, const entt::entity* first, const entt::entity* last, const Transform* transforms = nullptr) const;
+
+    private:
+        struct ComponentData {
+            entt::id_type id = 0;
+            std::shared_ptr<const void> value;
+            void (*insert)(entt::registry&, const entt::entity*, const entt::entity*, const void*) = nullptr;
+            void (*reserve)(entt::registry&, size_t) = nullptr;
+        };
+
+        bool HasOverride(entt::id_type id) const;
+
+        GameObject m_Template;
+        std::vector<ComponentData> m_Overrides;
+        Transform m_Transform;
+        bool m_HasTransform = false;
+    };
+
+    template<typename T>
+    Prefab& Prefab::Set(const T& value) {
+        ComponentData data;
+        data.id = entt::type_hash<T>::value();
+        data.value = std::make_shared<const T>(value);
+        data.insert = [](entt::registry& registry, const entt::entity* first, const entt::entity* last, const void* component) {
+            registry.insert<T>(first, last, *static_cast<const T*>(component));
+        };
+        data.reserve = [](entt::registry& registry, size_t count) {
+            auto& storage = registry.storage<T>();
+            storage.reserve(storage.size() + count);
+        };
+
+        for (auto& component : m_Overrides) {
+            if (component.id == data.id) {
+                component = std::move(data);
+                return *this;
+            }
+        }
+        m_Overrides.push_back(std::move(data));
+        return *this;
+    }
+
+} // namespace Intro
@@ -4,6 +4,8 @@
 #include "GameObjectManager.h"
 #include "GameObject.h"
 #include "Components.h"
+#include "TransformSystem.h"
+#include "Intro/Physics/PhysicsSystem.h"
 
 namespace Intro {
 
@@ -12,6 +14,24 @@ namespace Intro {
         , m_Active(true)
     {
         m_GameObjectManager = std::make_unique<GameObjectManager>(this);
+        RegisterDefaultSystems();
+    }
+
+    // 注册顺序决定冲突系统的先后：物理写变换，变换系统在其后重算世界矩阵
+    void Scene::RegisterDefaultSystems() {
+        using Access = SystemScheduler::Access;
+
+        m_Systems.AddSystem("Physics",
+            Access().Read<ColliderComponent, HierarchyComponent>().Write<TransformComponent, RigidbodyComponent, LocalToWorldComponent>(),
+            [this](ECS& ecs, float dt, bool isPlaying) {
+                PhysicsSystem::OnUpdate(dt, ecs, isPlaying, m_GameObjectManager->GetHierarchy());
+            });
+
+        m_Systems.AddSystem("Transforms",
+            Access().Read<TransformComponent, MeshComponent, ModelComponent, HierarchyComponent>().Write<LocalToWorldComponent>(),
+            [this](ECS& ecs, float, bool) {
+                TransformSystem::Update(ecs, m_GameObjectManager->GetHierarchy());
+            });
     }
 
     Scene::~Scene() = default;
@@ -27,7 +47,7 @@ namespace Intro {
     void Scene::OnUnload() {}
 
     void Scene::OnUpdate(float dt, bool isPlaying) {
-        // ʵ...
+        m_Systems.Run(m_ECS, dt, isPlaying);
     }
 
     void Scene::OnUpdate(float dt) {
@@ -50,7 +70,7 @@ namespace Intro {
 
     void Scene::DestroyGameObject(GameObject& gameObject) {
         if (gameObject.IsValid()) {
-            // ٵ
+            // 如果销毁的是主相机，清除引用
             if (gameObject.GetEntity() == m_MainCameraEntity) {
                 m_MainCameraEntity = entt::null;
             }
@@ -77,9 +97,33 @@ namespace Intro {
     }
 
     GameObject Scene::Instantiate(const GameObject& original, const glm::vec3& position) {
-        auto newEntity = m_ECS.CreateEntity();
-        // TODO: 
-        return GameObject(newEntity, &m_ECS);
+        if (!original.IsValid()) return GameObject();
+
+        Prefab prefab(original);
+        Transform transform = prefab.GetTransform();
+        transform.position = position;
+
+        auto instances = Instantiate(prefab, 1, &transform);
+        return instances.empty() ? GameObject() : instances.front();
+    }
+
+    std::vector<GameObject> Scene::Instantiate(const Prefab& prefab, uint32_t count, const Transform* transforms) {
+        if (!prefab.IsValid() || count == 0) return {};
+
+        std::vector<ECS::Entity> entities(count);
+        m_ECS.GetRegistry().create(entities.begin(), entities.end());
+        prefab.Spawn(m_ECS, entities.data(), entities.data() + entities.size(), transforms);
+
+        if (m_GameObjectManager) {
+            m_GameObjectManager->MarkNeedsRefresh();
+        }
+
+        std::vector<GameObject> result;
+        result.reserve(count);
+        for (auto entity : entities) {
+            result.emplace_back(entity, &m_ECS);
+        }
+        return result;
     }
 
     void Scene::Destroy(GameObject& gameObject) {
@@ -89,14 +133,14 @@ namespace Intro {
         }
     }
 
-    // µ Entity 
+    // 新的 Entity 方法
     ECS::Entity Scene::GetMainCameraEntity() const {
         return m_MainCameraEntity;
     }
 
     void Scene::SetMainCameraEntity(ECS::Entity cameraEntity) {
         if (cameraEntity != entt::null && m_ECS.HasComponent<CameraComponent>(cameraEntity)) {
-            // ֮ǰı־
+            // 清除之前主相机的标志
             if (m_MainCameraEntity != entt::null && m_ECS.HasComponent<CameraComponent>(m_MainCameraEntity)) {
                 m_ECS.GetComponent<CameraComponent>(m_MainCameraEntity).isMainCamera = false;
             }
@@ -117,7 +161,7 @@ namespace Intro {
         return entt::null;
     }
 
-    // ݵ GameObject 
+    // 兼容的 GameObject 方法
     GameObject Scene::GetMainCamera() {
         return GameObject(m_MainCameraEntity, &m_ECS);
     }
@@ -136,7 +180,7 @@ namespace Intro {
     void Scene::CreateDefaultMainCamera() {
         GameObject mainCamera = CreateGameObject("Main Camera");
 
-        // óʼλ
+        // 设置初始位置
         auto& transform = mainCamera.GetComponent<TransformComponent>();
         transform.transform.position = glm::vec3(0.0f, 2.0f, 5.0f);
         transform.transform.rotation = glm::quatLookAt(
@@ -144,7 +188,7 @@ namespace Intro {
             glm::vec3(0.0f, 1.0f, 0.0f)
         );
 
-        // Ϊ
+        // 添加相机组件并设为主相机
         CameraComponent cameraComp;
         cameraComp.fov = 60.0f;
         cameraComp.nearClip = 0.1f;
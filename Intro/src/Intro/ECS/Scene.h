@@ -5,56 +5,66 @@
 #include <memory>
 #include <vector>
 #include "ECS.h"
+#include "SystemScheduler.h"
+#include "Prefab.h"
 #include "Intro/Core.h"
 #include <glm/glm.hpp>
 
 namespace Intro {
 
-    // ǰ
+    // 前置声明
     class GameObjectManager;
     class GameObject;
 
-    // Scene ʾһ / ӵԼ ECS/registry ȣ
+    // Scene 表示一个独立的世界 / 场景（拥有自己的 ECS/registry 等）
     class ITR_API Scene {
     public:
         explicit Scene(std::string name = "Untitled Scene");
         virtual ~Scene();
 
-        // ÿƶentt::registry ǵ ECS вɿ/ƶ
+        // 禁用拷贝与移动（entt::registry 在我们的 ECS 中不可拷贝/移动）
         Scene(const Scene&) = delete;
         Scene& operator=(const Scene&) = delete;
         Scene(Scene&&) = delete;
         Scene& operator=(Scene&&) = delete;
 
-        // ڹ
+        // 生命周期钩子
         virtual void OnLoad();
         virtual void OnUnload();
         virtual void OnUpdate(float dt, bool isPlaying);
 
-        // 
+        // 保持向后兼容
         virtual void OnUpdate(float dt);
 
-        //  ECS
+        // 每帧在 OnUpdate 中按依赖图执行的 ECS 系统
+        SystemScheduler& GetSystems() { return m_Systems; }
+        const SystemScheduler& GetSystems() const { return m_Systems; }
+
+        // 访问 ECS
         ECS& GetECS() { return m_ECS; }
         const ECS& GetECS() const { return m_ECS; }
 
-        //  API ת
+        // 便捷 API 转发
         ECS::Entity CreateEntity() { return m_ECS.CreateEntity(); }
         void DestroyEntity(ECS::Entity e) { m_ECS.DestroyEntity(e); }
 
-        // 
+        // 名称
         const std::string& GetName() const { return m_Name; }
         void SetName(const std::string& name) { m_Name = name; }
 
-        // /ͣ
+        // 激活/停用
         void SetActive(bool active) { m_Active = active; }
         bool IsActive() const { return m_Active; }
 
+        // 复制 original 的组件（不含子对象），放到 position
         GameObject Instantiate(const GameObject& original, const glm::vec3& position = glm::vec3(0.0f));
+        // 批量实例化：一次创建 count 个实体，每种组件批量写入存储，只通知一次对象列表刷新，不逐个记录日志。
+        // transforms 为空时所有实例使用预制体的变换，否则必须包含 count 个变换
+        std::vector<GameObject> Instantiate(const Prefab& prefab, uint32_t count, const Transform* transforms = nullptr);
         void Destroy(GameObject& gameObject);
         std::vector<GameObject> GetAllGameObjects();
 
-        // GameObjectManager ʣԼд룩
+        // GameObjectManager 访问（返回引用以兼容现有代码）
         GameObjectManager& GetGameObjectManager();
         const GameObjectManager& GetGameObjectManager() const;
 
@@ -62,13 +72,13 @@ namespace Intro {
         GameObject CreateGameObject(const std::string& name = "GameObject");
         void DestroyGameObject(GameObject& gameObject);
 
-        // ޸ģʹ Entity  GameObject 洢
+        // 修改：使用 Entity 而不是 GameObject 来存储主相机
         ECS::Entity GetMainCameraEntity() const;
         void SetMainCameraEntity(ECS::Entity cameraEntity);
         ECS::Entity FindMainCameraEntity();
         void CreateDefaultMainCamera();
 
-        // ӻȡ GameObject ķ
+        // 添加获取 GameObject 的方法
         GameObject GetMainCamera();
         void SetMainCamera(GameObject camera);
         GameObject FindMainCamera();
@@ -80,10 +90,13 @@ namespace Intro {
         std::string m_Name;
         bool m_Active;
 
-        // ʹ unique_ptr Աͷļѭʼ
+        // 使用 unique_ptr 以避免头文件循环依赖与初始化问题
         std::unique_ptr<GameObjectManager> m_GameObjectManager;
 
-        // ޸ģʹ Entity  GameObject ͷļ
+        SystemScheduler m_Systems;
+        void RegisterDefaultSystems();
+
+        // 修改：使用 Entity 而不是 GameObject 来避免头文件依赖
         ECS::Entity m_MainCameraEntity{ entt::null };
     };
 
@@ -79,7 +79,7 @@ namespace Intro {
         auto& ecs = activeScene->GetECS();
         auto& registry = ecs.GetRegistry();
 
-        // ʵı任͸״̬
+        // 保存所有实体的变换和刚体状态
         auto transformView = registry.view<TransformComponent>();
         for (auto entity : transformView) {
             m_SavedTransforms[entity] = transformView.get<TransformComponent>(entity);
@@ -99,14 +99,14 @@ namespace Intro {
         auto& ecs = activeScene->GetECS();
         auto& registry = ecs.GetRegistry();
 
-        // ָ任״̬
+        // 恢复变换状态
         for (auto& [entity, transform] : m_SavedTransforms) {
             if (registry.valid(entity) && registry.all_of<TransformComponent>(entity)) {
-                registry.get<TransformComponent>(entity) = transform;
+                registry.replace<TransformComponent>(entity, transform);
             }
         }
 
-        // ָ״̬ٶȺ
+        // 恢复刚体状态（重置速度和力）
         for (auto& [entity, rigidbody] : m_SavedRigidbodies) {
             if (registry.valid(entity) && registry.all_of<RigidbodyComponent>(entity)) {
                 auto& currentRb = registry.get<RigidbodyComponent>(entity);
@@ -114,7 +114,7 @@ namespace Intro {
                 currentRb.angularVelocity = glm::vec3(0.0f);
                 currentRb.force = glm::vec3(0.0f);
                 currentRb.torque = glm::vec3(0.0f);
-                // Բ䣨ȣ
+                // 保持其他属性不变（质量、阻力等）
             }
         }
     }
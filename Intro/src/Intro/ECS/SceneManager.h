@@ -16,13 +16,13 @@ namespace Intro {
         SceneManager();
         ~SceneManager();
 
-        // ÿ/ƶ
+        // 禁用拷贝/移动
         SceneManager(const SceneManager&) = delete;
         SceneManager& operator=(const SceneManager&) = delete;
         SceneManager(SceneManager&&) = delete;
         SceneManager& operator=(SceneManager&&) = delete;
 
-        // עһ
+        // 创建并注册一个场景
         template<typename T, typename... Args>
         T& CreateScene(std::string name, Args&&... args) {
             static_assert(std::is_base_of_v<Scene, T>, "T must derive from Scene");
@@ -33,15 +33,15 @@ namespace Intro {
             return *ptr;
         }
         
-        //Ƴscene
+        //添加与移除scene
         void AddScene(std::unique_ptr<Scene> scene);
         void RemoveScene(size_t index);
 
-        //ͨScene
+        //通过索引启动Scene
         bool SetActiveSceneByIndex(size_t index);
         bool SetActiveSceneByName(const std::string& name);
 
-        //ȡǰScene
+        //获取当前Scene
         Scene* GetActiveScene();
         const Scene* GetActiveScene() const;
 
@@ -50,12 +50,12 @@ namespace Intro {
 
         size_t FindIndexByName(const std::string& name) const;
 
-        // ״̬
+        // 运行状态控制
         bool IsPlaying() const { return m_IsPlaying; }
         void StartRuntime() {
             if (!m_IsPlaying) {
                 m_IsPlaying = true;
-                // 泡״̬
+                // 保存场景状态
                 SaveSceneState();
                 ITR_INFO("Entering Play Mode");
             }
@@ -64,7 +64,7 @@ namespace Intro {
         void StopRuntime() {
             if (m_IsPlaying) {
                 m_IsPlaying = false;
-                // ָ״̬
+                // 恢复场景状态
                 RestoreSceneState();
                 ITR_INFO("Exiting Play Mode");
             }
@@ -76,14 +76,14 @@ namespace Intro {
         }
 
 
-        // ص
+        // 回调
         std::function<void(const Scene&)> onSceneLoaded;
         std::function<void(const Scene&)> onSceneUnloaded;
 
         static constexpr size_t npos = static_cast<size_t>(-1);
 
     private:
-        // ״̬
+        // 场景状态保存
         void SaveSceneState();
         void RestoreSceneState();
 
@@ -4,8 +4,13 @@
 #include "ECS.h"
 #include "Components.h"
 #include "Intro/Renderer/RenderQueue.h"
+#include "Intro/Renderer/Cameras/Frustum.h"
+#include "Intro/Renderer/OcclusionCuller.h"
+#include "Intro/Renderer/LodSelector.h"
+#include "Intro/Renderer/RenderWorld.h"
 #include <vector>
 #include <memory>
+#include <chrono>
 #include "Intro/Core.h"
 
 namespace Intro {
@@ -13,33 +18,33 @@ namespace Intro {
     class ITR_API RenderSystem {
     public:
         struct RenderableData {
-            Transform transform;                // ֵȾ׶ΰȫ
-            std::shared_ptr<Mesh> mesh;         // Դ֤ Mesh Ⱦڼ
+            Transform transform;                // 值拷贝（在渲染阶段安全）
+            std::shared_ptr<Mesh> mesh;         // 持有资源，保证 Mesh 在渲染期间存活
         };
 
-        // ע⣺ܷ const ECS&Ҫ÷ const registry API
+        // 注意：接受非 const ECS&（需要调用非 const registry API）
         static std::vector<RenderableData> GetRenderables(ECS& ecs) {
             std::vector<RenderableData> result;
-            auto& reg = ecs.GetRegistry(); //  const
+            auto& reg = ecs.GetRegistry(); // 非 const
 
             result.reserve(256);
 
-            // 1) ӵ TransformComponent  MeshComponent ʵ
-            // ʹ view.each() ýṹȡ entity ã
-            //  EnTT ͨҲıʽ
+            // 1) 遍历拥有 TransformComponent 和 MeshComponent 的实体
+            // 使用 view.each() 并用结构化绑定取得 entity 与组件引用，
+            // 这是 EnTT 上下文中最通用也最清晰的遍历方式。
             auto meshView = reg.view<TransformComponent, MeshComponent>();
             for (auto [entity, tfComp, meshComp] : meshView.each()) {
-                // tfComp, meshComp ã proxy ãֱʹ
+                // tfComp, meshComp 是引用（或 proxy 引用），直接使用
                 if (meshComp.mesh) {
                     result.push_back({ tfComp.transform, meshComp.mesh });
                 }
             }
 
-            // 2) ӵ TransformComponent  ModelComponent ʵ
+            // 2) 遍历拥有 TransformComponent 和 ModelComponent 的实体
             auto modelView = reg.view<TransformComponent, ModelComponent>();
             for (auto [entity, tfComp, modelComp] : modelView.each()) {
                 if (modelComp.model) {
-                    //  Model::GetMeshes()  of shared_ptr<Mesh>
+                    // 假设 Model::GetMeshes() 返回容器 of shared_ptr<Mesh>
                     for (const auto& meshPtr : modelComp.model->GetMeshes()) {
                         if (meshPtr) {
                             result.push_back({ tfComp.transform, meshPtr });
@@ -51,78 +56,145 @@ namespace Intro {
             return result;
         }
 
-        static void CollectRenderables(ECS& ecs, RenderQueue& queue, const glm::vec3& cameraPos) {
-            // ͨ
-            auto meshView = ecs.GetRegistry().view<TransformComponent, MeshComponent, MaterialComponent>();
-            for (auto [entity, tf, meshComp, matComp] : meshView.each()) {
-                if (!meshComp.mesh || !matComp.material) continue;
-                RenderItem item;
-                item.mesh = meshComp.mesh;
-                item.material = matComp.material;
-                item.transform = tf.transform.GetModelMatrix();
-                item.transparent = matComp.Transparent;
-                item.isPBR = false;  // ΪPBR
-
-                if (item.transparent)
-                    queue.transparent.push_back(item);
-                else
-                    queue.opaque.push_back(item);
+        // 收集可见渲染项：先用包围球、再用包围盒做视锥剔除，通过后再做遮挡剔除（occlusion 为空时跳过），
+        // 被剔除的物体不会构建 RenderItem，也不会拷贝 shared_ptr。
+        // lod 不为空时，带 LOD 链的 Mesh 按屏幕误差选择细节层次，淡化期间额外提交正在淡出的一级
+        // 数据来自 RenderWorld 的代理表（调用前需要先执行本帧的 RenderWorld::Sync），不访问 registry
+        static void CollectRenderables(RenderWorld& world, RenderQueue& queue, const glm::vec3& cameraPos, const Frustum& frustum,
+            const OcclusionCuller* occlusion = nullptr, LodSelector* lod = nullptr) {
+            auto start = std::chrono::steady_clock::now();
+            if (occlusion && !occlusion->HasOccluders()) occlusion = nullptr;
+
+            for (const RenderWorld::Proxy& proxy : world.GetProxies()) {
+                // 遮挡体自己不参与遮挡测试
+                const OcclusionCuller* proxyOcclusion = proxy.occluder ? nullptr : occlusion;
+                uint32_t objectID = (uint32_t)proxy.entity;
+
+                if (proxy.model) {
+                    CollectModel(queue, frustum, proxyOcclusion, lod, *proxy.model, proxy,
+                        proxy.material, proxy.transparent, proxy.isPBR, objectID);
+                    continue;
+                }
+
+                CullResult result = CullWorld(frustum, proxyOcclusion, proxy.worldSphere, proxy.worldBounds);
+                if (result != CullResult::Visible) {
+                    CountCulled(queue, result, 1);
+                    continue;
+                }
+                PushItem(queue, lod, proxy.mesh, proxy.material, proxy.transform, proxy.transparent, proxy.isPBR, objectID);
             }
 
-            // PBR - ؼ޸ģPBRMaterialתΪMaterial
-            auto meshViewPbr = ecs.GetRegistry().view<TransformComponent, MeshComponent, PBRMaterialComponent>();
-            for (auto [entity, tf, meshComp, matComp] : meshViewPbr.each()) {
-                if (!meshComp.mesh || !matComp.material) continue;
-                RenderItem item;
-                item.mesh = meshComp.mesh;
+            world.RecordCollectTime(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
 
-                // ؼPBRMaterialתΪMaterial
-                item.material = std::static_pointer_cast<Material>(matComp.material);
+        // 把启用的遮挡体加入遮挡剔除器：优先使用简化的遮挡网格，否则使用盒子
+        static void CollectOccluders(ECS& ecs, OcclusionCuller& culler) {
+            auto& reg = ecs.GetRegistry();
+            auto view = reg.view<LocalToWorldComponent, OccluderComponent>();
+            for (auto [entity, ltw, occluder] : view.each()) {
+                if (!occluder.enabled) continue;
+                const glm::mat4& transform = ltw.matrix;
+
+                if (occluder.mesh) {
+                    const auto& vertices = occluder.mesh->GetVertices();
+                    const auto& indices = occluder.mesh->GetIndices();
+                    if (vertices.empty() || indices.empty()) continue;
+                    culler.AddOccluderMesh(&vertices[0].Position, sizeof(Vertex), indices.data(), indices.size(), transform);
+                    continue;
+                }
 
-                item.transform = tf.transform.GetModelMatrix();
-                item.transparent = matComp.Transparent;
-                item.isPBR = true;  // ΪPBR
+                // 渲染网格的包围盒一般比实际绘制的几何大，不能作为遮挡体；没有显式给出盒子时不参与遮挡
+                if (occluder.size.x <= 0.0f || occluder.size.y <= 0.0f || occluder.size.z <= 0.0f) continue;
 
-                if (item.transparent)
-                    queue.transparent.push_back(item);
-                else
-                    queue.opaque.push_back(item);
+                BoundingBox box;
+                box.min = occluder.offset - occluder.size * 0.5f;
+                box.max = occluder.offset + occluder.size * 0.5f;
+                culler.AddOccluderBox(box, transform);
             }
+        }
+
+    private:
+        enum class CullResult {
+            Visible,
+            OutsideFrustum,
+            Occluded
+        };
+
+        static CullResult Cull(const Frustum& frustum, const OcclusionCuller* occlusion, const glm::mat4& transform,
+            const BoundingSphere& localSphere, const BoundingBox& localBounds) {
+            return CullWorld(frustum, occlusion, localSphere.Transformed(transform), localBounds.Transformed(transform));
+        }
+
+        static CullResult CullWorld(const Frustum& frustum, const OcclusionCuller* occlusion,
+            const BoundingSphere& sphere, const BoundingBox& box) {
+            if (!frustum.ContainsSphere(sphere.center, sphere.radius))
+                return CullResult::OutsideFrustum;
 
-            auto modelView = ecs.GetRegistry().view<TransformComponent, ModelComponent, MaterialComponent>();
-            for (auto [entity, tf, modelComp, matComp] : modelView.each()) {
-                if (!modelComp.model || !matComp.material) continue;
-                for (const auto& meshPtr : modelComp.model->GetMeshes()) {
-                    RenderItem item;
-                    item.mesh = meshPtr;
-                    item.material = matComp.material;
-                    item.transform = tf.transform.GetModelMatrix();
-                    item.transparent = matComp.Transparent;
-                    item.isPBR = false;
-                    if (item.transparent)
-                        queue.transparent.push_back(item);
-                    else
-                        queue.opaque.push_back(item);
+            if (!frustum.IntersectsAABB(box.min, box.max))
+                return CullResult::OutsideFrustum;
+
+            if (occlusion && !occlusion->IsVisible(box))
+                return CullResult::Occluded;
+            return CullResult::Visible;
+        }
+
+        static void CountCulled(RenderQueue& queue, CullResult result, uint32_t count) {
+            queue.culledCount += count;
+            if (result == CullResult::Occluded) queue.occludedCount += count;
+        }
+
+        static void PushItem(RenderQueue& queue, LodSelector* lod, const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Material>& material,
+            const glm::mat4& transform, bool transparent, bool isPBR, uint32_t objectID) {
+            RenderItem item;
+            item.mesh = mesh;
+            item.material = material;
+            item.transform = transform;
+            item.transparent = transparent;
+            item.isPBR = isPBR;
+            item.objectID = objectID;
+
+            if (lod && !mesh->GetLods().empty()) {
+                LodSelector::Selection selection = lod->Select(LodSelector::MakeKey(objectID, mesh->GetMeshID()), *mesh, transform);
+                item.mesh = LodMesh(mesh, selection.level);
+                // 透明物体不做抖动淡化（抖动会和混合叠加），直接切换
+                if (selection.fading && !transparent) {
+                    item.lodFade = LodSelector::PackFade(selection.fade, false);
+
+                    RenderItem previous = item;
+                    previous.mesh = LodMesh(mesh, selection.previousLevel);
+                    previous.lodFade = LodSelector::PackFade(selection.fade, true);
+                    queue.Push(std::move(previous));
                 }
             }
 
+            queue.Push(std::move(item));
+            queue.visibleCount++;
+        }
 
+        static const std::shared_ptr<Mesh>& LodMesh(const std::shared_ptr<Mesh>& mesh, uint32_t level) {
+            return level == 0 ? mesh : mesh->GetLods()[level - 1].mesh;
+        }
 
-            auto modelViewPbr = ecs.GetRegistry().view<TransformComponent, ModelComponent, PBRMaterialComponent>();
-            for (auto [entity, tf, modelComp, matComp] : modelViewPbr.each()) {
-                if (!modelComp.model || !matComp.material) continue;
-                for (const auto& meshPtr : modelComp.model->GetMeshes()) {
-                    RenderItem item;
-                    item.mesh = meshPtr;
-                    item.material = std::static_pointer_cast<Material>(matComp.material);
-                    item.transform = tf.transform.GetModelMatrix();
-                    item.transparent = matComp.Transparent;
-                    item.isPBR = true;
-                    if (item.transparent)
-                        queue.transparent.push_back(item);
-                    else
-                        queue.opaque.push_back(item);
+        // Model 先用代理缓存的合并包围体整体剔除，可见时再逐个 Mesh 剔除
+        static void CollectModel(RenderQueue& queue, const Frustum& frustum, const OcclusionCuller* occlusion, LodSelector* lod, const Model& model,
+            const RenderWorld::Proxy& proxy, const std::shared_ptr<Material>& material, bool transparent, bool isPBR, uint32_t objectID) {
+            const auto& meshes = model.GetMeshes();
+            const glm::mat4& transform = proxy.transform;
+            CullResult result = CullWorld(frustum, occlusion, proxy.worldSphere, proxy.worldBounds);
+            if (result != CullResult::Visible) {
+                CountCulled(queue, result, static_cast<uint32_t>(meshes.size()));
+                return;
+            }
+
+            for (const auto& meshPtr : meshes) {
+                if (meshes.size() > 1) {
+                    result = Cull(frustum, occlusion, transform, meshPtr->GetBoundingSphere(), meshPtr->GetBounds());
+                    if (result != CullResult::Visible) {
+                        CountCulled(queue, result, 1);
+                        continue;
+                    }
                 }
+                PushItem(queue, lod, meshPtr, material, transform, transparent, isPBR, objectID);
             }
         }
     };
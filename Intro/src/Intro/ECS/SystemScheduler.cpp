@@ -0,0 +1,156 @@
+#include "itrpch.h"
+#include "SystemScheduler.h"
+#include "Intro/Jobs/JobSystem.h"
+#include "Intro/Log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace Intro {
+
+    namespace {
+
+        bool Intersects(const std::vector<entt::id_type>& a, const std::vector<entt::id_type>& b) {
+            for (entt::id_type x : a) {
+                if (std::find(b.begin(), b.end(), x) != b.end()) return true;
+            }
+            return false;
+        }
+
+    }
+
+    bool SystemScheduler::Access::ConflictsWith(const Access& other) const {
+        if (exclusive || other.exclusive) return true;
+        return Intersects(writes, other.reads) || Intersects(writes, other.writes) || Intersects(reads, other.writes);
+    }
+
+    void SystemScheduler::AddSystem(const std::string& name, const Access& access, SystemFunction function) {
+        m_Systems.push_back({ name, access, std::move(function), true });
+    }
+
+    void SystemScheduler::SetEnabled(const std::string& name, bool enabled) {
+        for (auto& system : m_Systems) {
+            if (system.name == name) {
+                system.enabled = enabled;
+                return;
+            }
+        }
+        ITR_WARN("SystemScheduler: unknown system '{}'", name);
+    }
+
+    bool SystemScheduler::IsEnabled(const std::string& name) const {
+        for (const auto& system : m_Systems) {
+            if (system.name == name) return system.enabled;
+        }
+        return false;
+    }
+
+    void SystemScheduler::BuildGraph() {
+        m_Active.clear();
+        for (uint32_t i = 0; i < (uint32_t)m_Systems.size(); ++i) {
+            if (m_Systems[i].enabled) m_Active.push_back(i);
+        }
+
+        // 依赖边总是从注册顺序在前的系统指向在后的系统，图天然无环
+        const uint32_t count = (uint32_t)m_Active.size();
+        m_Dependents.assign(count, {});
+        m_DependencyCounts.assign(count, 0);
+        std::vector<uint32_t> depth(count, 1);
+        m_Stats.edgeCount = 0;
+        m_Stats.criticalPath = 0;
+
+        for (uint32_t b = 0; b < count; ++b) {
+            const Access& accessB = m_Systems[m_Active[b]].access;
+            for (uint32_t a = 0; a < b; ++a) {
+                if (!m_Systems[m_Active[a]].access.ConflictsWith(accessB)) continue;
+                m_Dependents[a].push_back(b);
+                m_DependencyCounts[b]++;
+                m_Stats.edgeCount++;
+                depth[b] = std::max(depth[b], depth[a] + 1);
+            }
+            m_Stats.criticalPath = std::max(m_Stats.criticalPath, depth[b]);
+        }
+    }
+
+    void SystemScheduler::Run(ECS& ecs, float deltaTime, bool isPlaying) {
+        auto frameStart = std::chrono::steady_clock::now();
+        BuildGraph();
+
+        const uint32_t count = (uint32_t)m_Active.size();
+        m_Stats.systemCount = count;
+        m_Stats.systems.resize(count);
+        if (count == 0) {
+            m_Stats.frameMs = 0.0f;
+            return;
+        }
+
+        // 存储在这里创建，系统在工作线程上只访问已存在的存储
+        auto& registry = ecs.GetRegistry();
+        for (uint32_t index : m_Active) {
+            for (auto createStorage : m_Systems[index].access.storages)
+                createStorage(registry);
+        }
+
+        std::vector<std::atomic<uint32_t>> remaining(count);
+        for (uint32_t i = 0; i < count; ++i)
+            remaining[i].store(m_DependencyCounts[i], std::memory_order_relaxed);
+
+        std::mutex mainMutex;
+        std::vector<uint32_t> mainReady;
+        std::atomic<uint32_t> completed{ 0 };
+        JobCounter jobs;
+
+        std::function<void(uint32_t)> dispatch;
+        auto execute = [&](uint32_t node) {
+            SystemEntry& system = m_Systems[m_Active[node]];
+            auto start = std::chrono::steady_clock::now();
+            system.function(ecs, deltaTime, isPlaying);
+
+            SystemTiming& timing = m_Stats.systems[node];
+            timing.name = system.name;
+            timing.ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            timing.threadIndex = JobSystem::GetCurrentThreadIndex();
+
+            for (uint32_t dependent : m_Dependents[node]) {
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    dispatch(dependent);
+            }
+            completed.fetch_add(1, std::memory_order_release);
+        };
+        dispatch = [&](uint32_t node) {
+            if (m_Systems[m_Active[node]].access.mainThread) {
+                std::lock_guard<std::mutex> lock(mainMutex);
+                mainReady.push_back(node);
+                return;
+            }
+            JobSystem::Run([&execute, node]() { execute(node); }, &jobs);
+        };
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (m_DependencyCounts[i] == 0) dispatch(i);
+        }
+
+        // 调用线程执行主线程系统，空闲时帮忙执行任务队列
+        while (completed.load(std::memory_order_acquire) < count) {
+            uint32_t node = UINT32_MAX;
+            {
+                std::lock_guard<std::mutex> lock(mainMutex);
+                if (!mainReady.empty()) {
+                    node = mainReady.back();
+                    mainReady.pop_back();
+                }
+            }
+            if (node != UINT32_MAX) {
+                execute(node);
+                continue;
+            }
+            if (!JobSystem::ExecuteOne()) std::this_thread::yield();
+        }
+        JobSystem::Wait(jobs);
+
+        m_Stats.frameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    }
+
+} // namespace Intro
@@ -0,0 +1,95 @@
+// SystemScheduler.h
+#pragma once
+
+#include "ECS.h"
+#include "Intro/Core.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Intro {
+
+    // 按组件读写声明调度 ECS 系统：
+    // - 每帧在启用的系统之间建立依赖图：注册顺序在前、且读写冲突（一方写另一方读或写同一组件）的系统先执行
+    // - 没有冲突的系统作为任务在 JobSystem 上并行执行；MainThread 系统只在调用线程执行（GL 调用等）
+    // - Exclusive 系统与所有系统冲突（会增删实体或组件的系统必须这样声明）
+    // - 运行前在调用线程上创建声明过的组件存储，系统执行期间 registry 的存储表不会被修改
+    class ITR_API SystemScheduler {
+    public:
+        using SystemFunction = std::function<void(ECS& ecs, float deltaTime, bool isPlaying)>;
+
+        struct Access {
+            std::vector<entt::id_type> reads;
+            std::vector<entt::id_type> writes;
+            std::vector<void(*)(entt::registry&)> storages;
+            bool mainThread = false;
+            bool exclusive = false;
+
+            template<typename... Components>
+            Access& Read() {
+                (Add<Components>(reads), ...);
+                return *this;
+            }
+
+            template<typename... Components>
+            Access& Write() {
+                (Add<Components>(writes), ...);
+                return *this;
+            }
+
+            Access& MainThread() { mainThread = true; return *this; }
+            Access& Exclusive() { exclusive = true; return *this; }
+
+            bool ConflictsWith(const Access& other) const;
+
+        private:
+            template<typename Component>
+            void Add(std::vector<entt::id_type>& ids) {
+                ids.push_back(entt::type_hash<Component>::value());
+                storages.push_back([](entt::registry& registry) { registry.storage<Component>(); });
+            }
+        };
+
+        void AddSystem(const std::string& name, const Access& access, SystemFunction function);
+        void SetEnabled(const std::string& name, bool enabled);
+        bool IsEnabled(const std::string& name) const;
+
+        // 执行本帧所有启用的系统，返回时全部完成
+        void Run(ECS& ecs, float deltaTime, bool isPlaying);
+
+        struct SystemTiming {
+            std::string name;
+            float ms = 0.0f;
+            uint32_t threadIndex = 0;   // 执行该系统的 JobSystem 线程
+        };
+        struct Statistics {
+            uint32_t systemCount = 0;
+            uint32_t edgeCount = 0;     // 依赖图的边数
+            uint32_t criticalPath = 0;  // 最长依赖链上的系统数
+            float frameMs = 0.0f;
+            std::vector<SystemTiming> systems;
+        };
+        const Statistics& GetStats() const { return m_Stats; }
+
+    private:
+        struct SystemEntry {
+            std::string name;
+            Access access;
+            SystemFunction function;
+            bool enabled = true;
+        };
+
+        void BuildGraph();
+
+        std::vector<SystemEntry> m_Systems;
+
+        // 本帧的依赖图（只含启用的系统，下标指向 m_Active）
+        std::vector<uint32_t> m_Active;
+        std::vector<std::vector<uint32_t>> m_Dependents;
+        std::vector<uint32_t> m_DependencyCounts;
+
+        Statistics m_Stats;
+    };
+
+} // namespace Intro
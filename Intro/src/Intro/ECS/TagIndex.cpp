@@ -0,0 +1,70 @@
+#include "itrpch.h"
+#include "TagIndex.h"
+#include "Components.h"
+#include <algorithm>
+
+namespace Intro {
+
+    void TagIndex::Connect(entt::registry& registry) {
+        registry.on_construct<TagComponent>().connect<&TagIndex::OnTagChanged>(*this);
+        registry.on_update<TagComponent>().connect<&TagIndex::OnTagChanged>(*this);
+        registry.on_destroy<TagComponent>().connect<&TagIndex::OnTagDestroyed>(*this);
+    }
+
+    void TagIndex::OnTagChanged(entt::registry& registry, entt::entity entity) {
+        StringID id = MakeStringID(registry.get<TagComponent>(entity).Tag);
+
+        auto it = m_EntityIDs.find(entity);
+        if (it != m_EntityIDs.end()) {
+            if (it->second == id) return;
+            Remove(entity);
+        }
+
+        m_Entities[id].push_back(entity);
+        m_EntityIDs[entity] = id;
+    }
+
+    void TagIndex::OnTagDestroyed(entt::registry&, entt::entity entity) {
+        Remove(entity);
+    }
+
+    void TagIndex::Remove(entt::entity entity) {
+        auto it = m_EntityIDs.find(entity);
+        if (it == m_EntityIDs.end()) return;
+
+        auto bucket = m_Entities.find(it->second);
+        if (bucket != m_Entities.end()) {
+            // 保持其余实体的先后顺序
+            auto& entities = bucket->second;
+            entities.erase(std::find(entities.begin(), entities.end(), entity));
+            if (entities.empty()) m_Entities.erase(bucket);
+        }
+        m_EntityIDs.erase(it);
+    }
+
+    entt::entity TagIndex::FindFirst(const entt::registry& registry, std::string_view tag) const {
+        auto bucket = m_Entities.find(MakeStringID(tag));
+        if (bucket == m_Entities.end()) return entt::null;
+
+        for (entt::entity entity : bucket->second) {
+            const auto* component = registry.try_get<TagComponent>(entity);
+            if (component && component->Tag == tag) {
+                return entity;
+            }
+        }
+        return entt::null;
+    }
+
+    void TagIndex::FindAll(const entt::registry& registry, std::string_view tag, std::vector<entt::entity>& result) const {
+        auto bucket = m_Entities.find(MakeStringID(tag));
+        if (bucket == m_Entities.end()) return;
+
+        for (entt::entity entity : bucket->second) {
+            const auto* component = registry.try_get<TagComponent>(entity);
+            if (component && component->Tag == tag) {
+                result.push_back(entity);
+            }
+        }
+    }
+
+} // namespace Intro
@@ -0,0 +1,44 @@
+// TagIndex.h
+#pragma once
+
+#include "Intro/Core.h"
+#include <entt/entt.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Intro {
+
+    // 名称 / 标签的字符串 ID：FNV-1a 散列，与 entt::hashed_string（"Player"_hs）的值相同，可以在编译期预先计算
+    using StringID = entt::id_type;
+
+    inline StringID MakeStringID(std::string_view str) {
+        return entt::hashed_string::value(str.data(), str.size());
+    }
+
+    // TagComponent（对象名称兼标签）的散列索引：StringID -> 实体列表，由 registry 的 construct/update/destroy 信号维护
+    // - 同一 ID 的实体按获得该名称的先后顺序保存，同名对象的查找结果是确定的
+    // - 查找按 ID 取出候选后再比较 TagComponent::Tag，散列冲突不会返回错误的实体
+    // - 直接改写 Tag 字段不会触发信号，改名请使用 GameObject::SetName 或 registry.patch<TagComponent>
+    class ITR_API TagIndex {
+    public:
+        void Connect(entt::registry& registry);
+
+        // 返回最早获得该名称（且仍然使用它）的实体，没有时返回 entt::null
+        entt::entity FindFirst(const entt::registry& registry, std::string_view tag) const;
+        // 按获得名称的先后顺序追加所有 Tag 等于 tag 的实体
+        void FindAll(const entt::registry& registry, std::string_view tag, std::vector<entt::entity>& result) const;
+
+        size_t GetEntryCount() const { return m_EntityIDs.size(); }
+
+    private:
+        void OnTagChanged(entt::registry& registry, entt::entity entity);
+        void OnTagDestroyed(entt::registry& registry, entt::entity entity);
+        void Remove(entt::entity entity);
+
+        std::unordered_map<StringID, std::vector<entt::entity>> m_Entities;
+        // 实体当前被索引的 ID：改名或销毁时据此定位旧条目
+        std::unordered_map<entt::entity, StringID> m_EntityIDs;
+    };
+
+} // namespace Intro
@@ -0,0 +1,248 @@
+#include "itrpch.h"
+#include "TransformHierarchy.h"
+#include "Components.h"
+#include <glm/gtx/matrix_decompose.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace Intro {
+
+    uint32_t TransformHierarchy::IndexOf(entt::entity entity) const {
+        const entt::registry& registry = *m_Registry;
+        if (!registry.valid(entity)) return InvalidIndex;
+
+        // 组件里的下标可能已经过期（节点被整体移出后组件才被移除），以数组中的实体为准
+        const auto* node = registry.try_get<HierarchyComponent>(entity);
+        if (!node || node->index >= m_Entities.size() || m_Entities[node->index] != entity)
+            return InvalidIndex;
+        return node->index;
+    }
+
+    uint32_t TransformHierarchy::Append(entt::entity entity) {
+        uint32_t index = (uint32_t)m_Entities.size();
+        m_Entities.push_back(entity);
+        m_Parents.push_back(InvalidIndex);
+        m_SubtreeSizes.push_back(1);
+        m_Depths.push_back(0);
+        m_Registry->emplace_or_replace<HierarchyComponent>(entity, HierarchyComponent{ index });
+        return index;
+    }
+
+    uint32_t TransformHierarchy::EnsureNode(entt::entity entity) {
+        uint32_t index = IndexOf(entity);
+        return index != InvalidIndex ? index : Append(entity);
+    }
+
+    void TransformHierarchy::SyncIndex(uint32_t index) {
+        m_Registry->get<HierarchyComponent>(m_Entities[index]).index = index;
+    }
+
+    void TransformHierarchy::AddToAncestors(uint32_t parent, int64_t delta) {
+        for (uint32_t a = parent; a != InvalidIndex; a = m_Parents[a])
+            m_SubtreeSizes[a] = (uint32_t)((int64_t)m_SubtreeSizes[a] + delta);
+    }
+
+    void TransformHierarchy::Truncate(uint32_t size) {
+        m_Entities.resize(size);
+        m_Parents.resize(size);
+        m_SubtreeSizes.resize(size);
+        m_Depths.resize(size);
+    }
+
+    uint32_t TransformHierarchy::MoveRange(uint32_t start, uint32_t count, uint32_t dest) {
+        const uint32_t end = start + count;
+        if (dest == start || dest == end) return start;
+
+        // [lo, hi) 是 rotate 涉及的窗口：子树区间与它跨过的节点交换位置
+        const bool moveBack = dest < start;
+        const uint32_t lo = moveBack ? dest : start;
+        const uint32_t hi = moveBack ? end : dest;
+        const uint32_t newStart = moveBack ? dest : dest - count;
+
+        auto remap = [&](uint32_t index) -> uint32_t {
+            if (index == InvalidIndex || index < lo || index >= hi) return index;
+            if (index >= start && index < end) return index - start + newStart;
+            return moveBack ? index + count : index - count;
+        };
+        auto rotate = [&](auto& values) {
+            if (moveBack) std::rotate(values.begin() + dest, values.begin() + start, values.begin() + end);
+            else std::rotate(values.begin() + start, values.begin() + end, values.begin() + dest);
+        };
+        rotate(m_Entities);
+        rotate(m_Parents);
+        rotate(m_SubtreeSizes);
+        rotate(m_Depths);
+
+        for (uint32_t k = lo; k < hi; ++k) {
+            m_Parents[k] = remap(m_Parents[k]);
+            SyncIndex(k);
+        }
+        uint32_t touched = hi - lo;
+
+        // 窗口之后的节点本身没有移动，只有父节点在窗口内的需要修正，它们都是窗口内节点的直接子节点。
+        // 按整棵子树跳过：一旦遇到父节点在窗口之前（或是根）的节点，后面的节点的父节点也都在窗口之前
+        const uint32_t size = (uint32_t)m_Entities.size();
+        for (uint32_t k = hi; k < size; k += m_SubtreeSizes[k]) {
+            uint32_t parent = m_Parents[k];
+            if (parent == InvalidIndex || parent < lo) break;
+            m_Parents[k] = remap(parent);
+            touched++;
+        }
+
+        m_Stats.movedNodes += touched;
+        return newStart;
+    }
+
+    bool TransformHierarchy::SetParent(entt::entity child, entt::entity parent) {
+        if (child == parent || !m_Registry->valid(child)) return false;
+        if (parent != entt::null && !m_Registry->valid(parent)) return false;
+
+        uint32_t childIndex = EnsureNode(child);
+        uint32_t parentIndex = parent == entt::null ? InvalidIndex : EnsureNode(parent);
+        const uint32_t count = m_SubtreeSizes[childIndex];
+
+        // 新父节点在子树内部会形成环
+        if (parentIndex != InvalidIndex && parentIndex >= childIndex && parentIndex < childIndex + count)
+            return false;
+        if (m_Parents[childIndex] == parentIndex) return true;
+
+        // 挂到新父节点子树的末尾（成为最后一个子节点）；根节点放到数组末尾
+        uint32_t dest = parentIndex == InvalidIndex ? (uint32_t)m_Entities.size() : parentIndex + m_SubtreeSizes[parentIndex];
+
+        AddToAncestors(m_Parents[childIndex], -(int64_t)count);
+        uint32_t start = MoveRange(childIndex, count, dest);
+
+        parentIndex = parent == entt::null ? InvalidIndex : IndexOf(parent);
+        m_Parents[start] = parentIndex;
+        uint32_t depth = parentIndex == InvalidIndex ? 0 : m_Depths[parentIndex] + 1;
+        if (depth != m_Depths[start]) {
+            int64_t delta = (int64_t)depth - (int64_t)m_Depths[start];
+            for (uint32_t k = start; k < start + count; ++k)
+                m_Depths[k] = (uint32_t)((int64_t)m_Depths[k] + delta);
+        }
+        AddToAncestors(parentIndex, count);
+
+        m_Stats.reparents++;
+        return true;
+    }
+
+    entt::entity TransformHierarchy::GetParent(entt::entity entity) const {
+        uint32_t index = IndexOf(entity);
+        if (index == InvalidIndex || m_Parents[index] == InvalidIndex) return entt::null;
+        return m_Entities[m_Parents[index]];
+    }
+
+    std::vector<entt::entity> TransformHierarchy::GetChildren(entt::entity entity) const {
+        std::vector<entt::entity> children;
+        uint32_t index = IndexOf(entity);
+        if (index == InvalidIndex) return children;
+
+        // 直接子节点：从第一个后代开始，每次跳过一整棵子树
+        const uint32_t end = index + m_SubtreeSizes[index];
+        for (uint32_t k = index + 1; k < end; k += m_SubtreeSizes[k])
+            children.push_back(m_Entities[k]);
+        return children;
+    }
+
+    bool TransformHierarchy::IsDescendantOf(entt::entity entity, entt::entity ancestor) const {
+        if (entity == ancestor) return entity != entt::null;
+        uint32_t ancestorIndex = IndexOf(ancestor);
+        uint32_t index = IndexOf(entity);
+        if (ancestorIndex == InvalidIndex || index == InvalidIndex) return false;
+        return index > ancestorIndex && index < ancestorIndex + m_SubtreeSizes[ancestorIndex];
+    }
+
+    std::vector<entt::entity> TransformHierarchy::RemoveSubtree(entt::entity root) {
+        uint32_t start = IndexOf(root);
+        if (start == InvalidIndex) return {};
+
+        // 先搬到数组末尾再截断，只有窗口内的节点需要修正
+        const uint32_t count = m_SubtreeSizes[start];
+        AddToAncestors(m_Parents[start], -(int64_t)count);
+        start = MoveRange(start, count, (uint32_t)m_Entities.size());
+
+        std::vector<entt::entity> removed(m_Entities.begin() + start, m_Entities.end());
+        Truncate(start);
+        // 数组已经截断，移除组件触发的回调中 IndexOf 会返回无效下标
+        for (entt::entity entity : removed)
+            m_Registry->remove<HierarchyComponent>(entity);
+        return removed;
+    }
+
+    void TransformHierarchy::RemoveNode(entt::entity entity) {
+        uint32_t start = IndexOf(entity);
+        if (start == InvalidIndex) return;
+
+        // 节点销毁过程中 TransformComponent 可能已被移除，此时退回到缓存的世界矩阵
+        entt::registry& registry = *m_Registry;
+        glm::mat4 parentWorld(1.0f);
+        if (registry.all_of<TransformComponent>(entity)) {
+            parentWorld = ComputeWorldMatrix(entity);
+        }
+        else if (const auto* localToWorld = registry.try_get<LocalToWorldComponent>(entity)) {
+            parentWorld = localToWorld->matrix;
+        }
+
+        const uint32_t count = m_SubtreeSizes[start];
+        AddToAncestors(m_Parents[start], -(int64_t)count);
+        start = MoveRange(start, count, (uint32_t)m_Entities.size());
+
+        // 直接子节点变为根：把父节点的世界矩阵合并进局部变换，保持世界变换不变
+        for (uint32_t k = start + 1; k < start + count; k += m_SubtreeSizes[k]) {
+            entt::entity child = m_Entities[k];
+            if (auto* tf = registry.try_get<TransformComponent>(child)) {
+                glm::vec3 scale, translation, skew;
+                glm::vec4 perspective;
+                glm::quat rotation;
+                if (glm::decompose(parentWorld * tf->transform.GetModelMatrix(), scale, rotation, translation, skew, perspective)) {
+                    tf->transform.position = translation;
+                    tf->transform.rotation = glm::normalize(rotation);
+                    tf->transform.scale = scale;
+                }
+            }
+            if (auto* localToWorld = registry.try_get<LocalToWorldComponent>(child)) {
+                localToWorld->dirty = true;
+            }
+        }
+
+        // 子树现在位于末尾：去掉头节点，直接子节点变为根，其余节点的父下标与深度整体平移
+        const uint32_t size = (uint32_t)m_Entities.size();
+        const uint32_t removedDepth = m_Depths[start];
+        for (uint32_t k = start + 1; k < size; ++k) {
+            uint32_t parent = m_Parents[k];
+            m_Parents[k] = parent == start ? InvalidIndex : parent - 1;
+            m_Depths[k] -= removedDepth + 1;
+        }
+        m_Entities.erase(m_Entities.begin() + start);
+        m_Parents.erase(m_Parents.begin() + start);
+        m_SubtreeSizes.erase(m_SubtreeSizes.begin() + start);
+        m_Depths.erase(m_Depths.begin() + start);
+        for (uint32_t k = start; k + 1 < size; ++k)
+            SyncIndex(k);
+    }
+
+    void TransformHierarchy::Clear() {
+        std::vector<entt::entity> entities = std::move(m_Entities);
+        Truncate(0);
+        for (entt::entity entity : entities) {
+            if (m_Registry->valid(entity))
+                m_Registry->remove<HierarchyComponent>(entity);
+        }
+    }
+
+    glm::mat4 TransformHierarchy::ComputeWorldMatrix(entt::entity entity) const {
+        const entt::registry& registry = *m_Registry;
+        auto localMatrix = [&registry](entt::entity e) {
+            const auto* tf = registry.valid(e) ? registry.try_get<TransformComponent>(e) : nullptr;
+            return tf ? tf->transform.GetModelMatrix() : glm::mat4(1.0f);
+        };
+
+        glm::mat4 world = localMatrix(entity);
+        uint32_t index = IndexOf(entity);
+        if (index == InvalidIndex) return world;
+        for (uint32_t p = m_Parents[index]; p != InvalidIndex; p = m_Parents[p])
+            world = localMatrix(m_Entities[p]) * world;
+        return world;
+    }
+
+} // namespace Intro
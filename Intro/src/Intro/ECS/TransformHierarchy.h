@@ -0,0 +1,82 @@
+// TransformHierarchy.h
+#pragma once
+
+#include "Intro/Core.h"
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Intro {
+
+    // 层级中的节点在扁平数组中的下标（由 TransformHierarchy 维护，不要手动修改）
+    struct HierarchyComponent {
+        uint32_t index = UINT32_MAX;
+    };
+
+    // 扁平的变换层级：
+    // - 节点按先序（深度优先）存放在几组平行数组中，父节点总在子节点之前，任意子树占据连续区间 [index, index + subtreeSize)
+    // - 世界矩阵传播只需按下标顺序线性扫描一遍：world[i] = world[parents[i]] * local[i]
+    // - 重新挂接用 std::rotate 把子树区间搬到新父节点子树的末尾，只修正旧位置与新位置之间的节点，以及这些节点在区间之后的直接子节点
+    // - 销毁 / 递归设置激活直接遍历子树区间，不需要递归
+    // 只有参与父子关系的实体才会进入层级；其余实体仍由 TransformSystem 逐个处理
+    class ITR_API TransformHierarchy {
+    public:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+        explicit TransformHierarchy(entt::registry& registry) : m_Registry(&registry) {}
+
+        TransformHierarchy(const TransformHierarchy&) = delete;
+        TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+        uint32_t IndexOf(entt::entity entity) const;
+        bool Contains(entt::entity entity) const { return IndexOf(entity) != InvalidIndex; }
+
+        // parent 为 entt::null 时变为根节点；会形成环时返回 false
+        bool SetParent(entt::entity child, entt::entity parent);
+        entt::entity GetParent(entt::entity entity) const;
+        std::vector<entt::entity> GetChildren(entt::entity entity) const;
+        // 是否为 ancestor 自身或其后代
+        bool IsDescendantOf(entt::entity entity, entt::entity ancestor) const;
+
+        // 把整个子树移出层级，按先序返回其中的实体（不销毁实体）
+        std::vector<entt::entity> RemoveSubtree(entt::entity root);
+        // 只移除一个节点，它的直接子节点变为根节点（实体在层级之外被销毁时使用）
+        // 子节点保持原来的世界变换：父节点的世界矩阵被合并进它们的局部变换，LocalToWorld 标记为 dirty
+        void RemoveNode(entt::entity entity);
+        void Clear();
+
+        // 沿父链把局部矩阵乘起来得到当前的世界矩阵（不依赖 LocalToWorldComponent 是否已更新）
+        glm::mat4 ComputeWorldMatrix(entt::entity entity) const;
+
+        // 扁平数组（只读），供 TransformSystem 线性传播
+        uint32_t GetSize() const { return (uint32_t)m_Entities.size(); }
+        const std::vector<entt::entity>& GetEntities() const { return m_Entities; }
+        const std::vector<uint32_t>& GetParents() const { return m_Parents; }
+        const std::vector<uint32_t>& GetSubtreeSizes() const { return m_SubtreeSizes; }
+        const std::vector<uint32_t>& GetDepths() const { return m_Depths; }
+
+        struct Statistics {
+            uint32_t reparents = 0;
+            uint32_t movedNodes = 0;    // 重新挂接时被搬动或修正过下标的节点累计数
+        };
+        const Statistics& GetStats() const { return m_Stats; }
+
+    private:
+        uint32_t Append(entt::entity entity);
+        uint32_t EnsureNode(entt::entity entity);
+        // 把 [start, start + count) 搬到原数组下标 dest 之前，返回区间的新起点
+        uint32_t MoveRange(uint32_t start, uint32_t count, uint32_t dest);
+        void AddToAncestors(uint32_t parent, int64_t delta);
+        void Truncate(uint32_t size);
+        void SyncIndex(uint32_t index);
+
+        entt::registry* m_Registry;
+        std::vector<entt::entity> m_Entities;
+        std::vector<uint32_t> m_Parents;        // InvalidIndex 表示根
+        std::vector<uint32_t> m_SubtreeSizes;   // 含自身
+        std::vector<uint32_t> m_Depths;
+        Statistics m_Stats;
+    };
+
+} // namespace Intro
@@ -0,0 +1,139 @@
+#include "itrpch.h"
+#include "TransformSystem.h"
+#include "Components.h"
+#include "Intro/Renderer/Mesh.h"
+#include "Intro/Renderer/Model.h"
+#include "Intro/Jobs/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Intro {
+
+    namespace {
+
+        TransformSystem::Statistics s_Stats;
+        std::vector<entt::entity> s_DirtyEntities;     // 本帧更新过的实体：先是扁平部分，层级传播再追加
+        std::vector<glm::mat4> s_HierarchyWorlds;
+        std::vector<uint8_t> s_HierarchyChanged;
+
+        using TransformStorage = entt::storage_for_t<TransformComponent>;
+        using LocalToWorldStorage = entt::storage_for_t<LocalToWorldComponent>;
+        using MeshStorage = entt::storage_for_t<MeshComponent>;
+        using ModelStorage = entt::storage_for_t<ModelComponent>;
+
+        void StoreWorld(entt::entity entity, const glm::mat4& matrix, LocalToWorldComponent& localToWorld,
+            const MeshStorage& meshes, const ModelStorage& models) {
+            localToWorld.matrix = matrix;
+
+            // Model 优先（与渲染收集时整体剔除使用的包围体一致）
+            localToWorld.worldBounds = BoundingBox();
+            localToWorld.worldSphere = BoundingSphere();
+            if (models.contains(entity) && models.get(entity).model) {
+                const Model& model = *models.get(entity).model;
+                localToWorld.worldBounds = model.GetBounds().Transformed(matrix);
+                localToWorld.worldSphere = model.GetBoundingSphere().Transformed(matrix);
+            }
+            else if (meshes.contains(entity) && meshes.get(entity).mesh) {
+                const Mesh& mesh = *meshes.get(entity).mesh;
+                localToWorld.worldBounds = mesh.GetBounds().Transformed(matrix);
+                localToWorld.worldSphere = mesh.GetBoundingSphere().Transformed(matrix);
+            }
+            localToWorld.dirty = false;
+        }
+
+        // 工作线程只通过各组件的存储访问数据（不经过 registry，避免并发创建存储）
+        void UpdateRange(const entt::entity* entities, size_t count, const TransformStorage& transforms,
+            LocalToWorldStorage& localToWorlds, const MeshStorage& meshes, const ModelStorage& models) {
+            for (size_t i = 0; i < count; ++i) {
+                entt::entity entity = entities[i];
+                StoreWorld(entity, transforms.get(entity).transform.GetModelMatrix(), localToWorlds.get(entity), meshes, models);
+            }
+        }
+
+        // 层级按先序存放，父节点总在子节点之前：一次线性扫描即可传播，
+        // 自身 dirty 或父节点本帧发生变化的节点才重算
+        uint32_t UpdateHierarchy(const TransformHierarchy& hierarchy, const TransformStorage& transforms,
+            LocalToWorldStorage& localToWorlds, const MeshStorage& meshes, const ModelStorage& models) {
+            const auto& entities = hierarchy.GetEntities();
+            const auto& parents = hierarchy.GetParents();
+            const uint32_t size = hierarchy.GetSize();
+            s_HierarchyWorlds.resize(size);
+            s_HierarchyChanged.resize(size);
+
+            uint32_t updated = 0;
+            for (uint32_t i = 0; i < size; ++i) {
+                entt::entity entity = entities[i];
+                uint32_t parent = parents[i];
+                LocalToWorldComponent* localToWorld = localToWorlds.contains(entity) ? &localToWorlds.get(entity) : nullptr;
+
+                bool changed = (parent != TransformHierarchy::InvalidIndex && s_HierarchyChanged[parent])
+                    || (localToWorld && localToWorld->dirty);
+                s_HierarchyChanged[i] = changed ? 1 : 0;
+
+                if (!changed && localToWorld) {
+                    s_HierarchyWorlds[i] = localToWorld->matrix;
+                    continue;
+                }
+
+                // 没有 TransformComponent 的节点相当于单位局部矩阵
+                glm::mat4 world = parent != TransformHierarchy::InvalidIndex ? s_HierarchyWorlds[parent] : glm::mat4(1.0f);
+                if (transforms.contains(entity))
+                    world = world * transforms.get(entity).transform.GetModelMatrix();
+                s_HierarchyWorlds[i] = world;
+
+                if (localToWorld) {
+                    StoreWorld(entity, world, *localToWorld, meshes, models);
+                    s_DirtyEntities.push_back(entity);
+                    updated++;
+                }
+            }
+            return updated;
+        }
+
+    }
+
+    void TransformSystem::Update(ECS& ecs, const TransformHierarchy* hierarchy) {
+        auto start = std::chrono::steady_clock::now();
+        auto& reg = ecs.GetRegistry();
+
+        // 存储在调用线程上取得（由调度器预先创建），并行块只读写已有的存储
+        const auto& transforms = reg.storage<TransformComponent>();
+        auto& localToWorlds = reg.storage<LocalToWorldComponent>();
+        const auto& meshes = reg.storage<MeshComponent>();
+        const auto& models = reg.storage<ModelComponent>();
+        const auto& hierarchyNodes = reg.storage<HierarchyComponent>();
+
+        // 层级中的实体由后面的线性传播处理
+        s_DirtyEntities.clear();
+        for (auto [entity, localToWorld] : localToWorlds.each()) {
+            if (localToWorld.dirty && transforms.contains(entity) && !hierarchyNodes.contains(entity))
+                s_DirtyEntities.push_back(entity);
+        }
+
+        // 连续区间分块交给 JobSystem，块数随线程数增长；数量少时只有一块，在调用线程上执行
+        const uint32_t dirtyCount = (uint32_t)s_DirtyEntities.size();
+        const uint32_t batchSize = dirtyCount >= ParallelThreshold ? JobSystem::ComputeBatchSize(dirtyCount, MinChunkSize) : std::max(dirtyCount, 1u);
+        const uint32_t batchCount = (dirtyCount + batchSize - 1) / batchSize;
+        const entt::entity* entities = s_DirtyEntities.data();
+        JobSystem::ParallelFor(dirtyCount, batchSize, [&](uint32_t begin, uint32_t end) {
+            UpdateRange(entities + begin, end - begin, transforms, localToWorlds, meshes, models);
+        });
+
+        uint32_t hierarchyUpdated = 0;
+        if (hierarchy && hierarchy->GetSize() > 0)
+            hierarchyUpdated = UpdateHierarchy(*hierarchy, transforms, localToWorlds, meshes, models);
+
+        ecs.RecordMovedEntities(s_DirtyEntities);
+
+        s_Stats.entityCount = (uint32_t)localToWorlds.size();
+        s_Stats.hierarchyCount = hierarchy ? hierarchy->GetSize() : 0;
+        s_Stats.updatedCount = dirtyCount + hierarchyUpdated;
+        s_Stats.workerCount = std::min(batchCount, JobSystem::GetThreadCount());
+        s_Stats.updateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const TransformSystem::Statistics& TransformSystem::GetStats() {
+        return s_Stats;
+    }
+
+} // namespace Intro
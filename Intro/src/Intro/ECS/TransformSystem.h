@@ -0,0 +1,34 @@
+// TransformSystem.h
+#pragma once
+
+#include "ECS.h"
+#include "TransformHierarchy.h"
+#include "Intro/Core.h"
+#include <cstdint>
+#include <vector>
+
+namespace Intro {
+
+    // 维护 LocalToWorldComponent：每帧一次，只重算被标记为 dirty 的实体的世界矩阵与世界包围体。
+    // dirty 条目较多时按连续区间分块交给 JobSystem，每块只写自己区间内实体的 LocalToWorldComponent。
+    // 渲染、阴影、光源等读取缓存矩阵的代码需要在本帧的 Update 之后运行。
+    // 传入层级时，层级中的实体改为按先序线性传播：world = parentWorld * local。
+    class ITR_API TransformSystem {
+    public:
+        // dirty 条目少于这个值时单线程更新
+        static constexpr uint32_t ParallelThreshold = 1024;
+        static constexpr uint32_t MinChunkSize = 256;
+
+        static void Update(ECS& ecs, const TransformHierarchy* hierarchy = nullptr);
+
+        struct Statistics {
+            uint32_t entityCount = 0;
+            uint32_t hierarchyCount = 0;
+            uint32_t updatedCount = 0;
+            uint32_t workerCount = 0;       // 参与本次更新的线程数（上限为 JobSystem 的线程数）
+            float updateMs = 0.0f;
+        };
+        static const Statistics& GetStats();
+    };
+
+} // namespace Intro
@@ -33,9 +33,9 @@ namespace Intro {
 	{
 		friend class EventDispatcher;
 	public:
-		virtual EventType GetEventType() const = 0; //ȡ¼
-		virtual const char* GetName() const = 0;    //ȡ¼
-		virtual int GetCategoryFlags() const = 0;   //ȡ¼
+		virtual EventType GetEventType() const = 0; //获取事件类型
+		virtual const char* GetName() const = 0;    //获取事件名称
+		virtual int GetCategoryFlags() const = 0;   //获取事件
 		virtual std::string ToString() const { return GetName(); };
 
 		inline bool IsInCategory(EventCategory category)
@@ -12,7 +12,7 @@ namespace Intro
 
 		EVENT_CLASS_CATEGORY(EventCategoryKeyboard | EventCategoryInput)
 	protected:
-		KeyEvent(int keycode)  //ܴ
+		KeyEvent(int keycode)  //仅从派生类能创建
 			:m_KeyCode(keycode) { }
 
 		int m_KeyCode;
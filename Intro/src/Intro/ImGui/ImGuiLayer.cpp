@@ -3,6 +3,15 @@
 #include "ImGuiLayer.h"
 
 #include "Intro/Renderer/Renderer.h"
+#include "Intro/Renderer/RenderState.h"
+#include "Intro/Renderer/GeometryPool.h"
+#include "Intro/Renderer/MaterialTable.h"
+#include "Intro/Renderer/TextureArrayPool.h"
+#include "Intro/Renderer/GPUProfiler.h"
+#include "Intro/Renderer/DebugDraw.h"
+#include "Intro/Renderer/ShaderCache.h"
+#include "Intro/ECS/TransformSystem.h"
+#include "Intro/Jobs/JobSystem.h"
 #include "Intro/Config/ConfigObserver.h"
 #include "Intro/Application.h"
 #include "Intro/Renderer/ShapeGenerator.h"
@@ -111,15 +120,19 @@ namespace Intro {
 		ImGui::Render();
 
 		// 确保在渲染 ImGui 时使用正确的混合状态
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		glDisable(GL_DEPTH_TEST); // ImGui 不需要深度测试
+		RenderState::SetBlend(true);
+		RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		RenderState::SetDepthTest(false); // ImGui 不需要深度测试
 
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		// ImGui 后端会自行备份并恢复它修改的 GL 状态，因此 RenderState 缓存保持有效
+		{
+			GPUProfileScope profileScope("ImGui");
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		}
 
 		// 恢复状态（如果需要）
-		glEnable(GL_DEPTH_TEST);
-		glDisable(GL_BLEND);
+		RenderState::SetDepthTest(true);
+		RenderState::SetBlend(false);
 
 		ImGuiIO& io = ImGui::GetIO();
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -305,6 +318,8 @@ namespace Intro {
 			m_ViewportOffset = imageMin;
 			m_ViewportSize = ImVec2(imageMax.x - imageMin.x, imageMax.y - imageMin.y);
 
+			DrawDebugTexts();
+
 			// 在视口内绘制 gizmo（如果选中实体）
 			if (m_SelectedGameObject.IsValid())
 				RenderGizmo();
@@ -319,6 +334,30 @@ namespace Intro {
 		ImGui::End();
 	}
 
+	// DebugDraw::Text3D 记录的文字：用上一次 Flush 的视图投影矩阵投影到视口图像上
+	void ImGuiLayer::DrawDebugTexts()
+	{
+		const auto& texts = DebugDraw::GetTexts();
+		if (texts.empty()) return;
+
+		const glm::mat4& viewProjection = DebugDraw::GetTextViewProjection();
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		ImVec2 clipMax(m_ViewportOffset.x + m_ViewportSize.x, m_ViewportOffset.y + m_ViewportSize.y);
+		drawList->PushClipRect(m_ViewportOffset, clipMax, true);
+		for (const auto& text : texts) {
+			glm::vec4 clip = viewProjection * glm::vec4(text.position, 1.0f);
+			if (clip.w <= 1e-4f) continue;	// 在相机后方
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			if (ndc.z < -1.0f || ndc.z > 1.0f) continue;
+
+			ImVec2 screen(m_ViewportOffset.x + (ndc.x * 0.5f + 0.5f) * m_ViewportSize.x,
+				m_ViewportOffset.y + (0.5f - ndc.y * 0.5f) * m_ViewportSize.y);
+			ImVec2 size = ImGui::CalcTextSize(text.text.c_str());
+			drawList->AddText(ImVec2(screen.x - size.x * 0.5f, screen.y - size.y * 0.5f), text.color, text.text.c_str());
+		}
+		drawList->PopClipRect();
+	}
+
 	// -------------------------------------------------------------------------
 	// Entity manager / inspector / scene controls
 	// -------------------------------------------------------------------------
@@ -445,11 +484,11 @@ namespace Intro {
 				if (light.Type == LightType::Directional)
 				{
 					ImGui::Text("Direction controlled by entity rotation");
-					if (ImGui::Button("Down")) { auto& t = m_SelectedGameObject.GetComponent<TransformComponent>(); t.transform.rotation = glm::quat(1.0f, 0, 0, 0); SyncTransformEditor(); }
+					if (ImGui::Button("Down")) { m_SelectedGameObject.GetTransform().rotation = glm::quat(1.0f, 0, 0, 0); SyncTransformEditor(); }
 					ImGui::SameLine();
-					if (ImGui::Button("Up")) { auto& t = m_SelectedGameObject.GetComponent<TransformComponent>(); t.transform.rotation = glm::angleAxis(glm::radians(180.0f), glm::vec3(1, 0, 0)); SyncTransformEditor(); }
+					if (ImGui::Button("Up")) { m_SelectedGameObject.GetTransform().rotation = glm::angleAxis(glm::radians(180.0f), glm::vec3(1, 0, 0)); SyncTransformEditor(); }
 					ImGui::SameLine();
-					if (ImGui::Button("Forward")) { auto& t = m_SelectedGameObject.GetComponent<TransformComponent>(); t.transform.rotation = glm::angleAxis(glm::radians(-90.0f), glm::vec3(1, 0, 0)); SyncTransformEditor(); }
+					if (ImGui::Button("Forward")) { m_SelectedGameObject.GetTransform().rotation = glm::angleAxis(glm::radians(-90.0f), glm::vec3(1, 0, 0)); SyncTransformEditor(); }
 				}
 
 				if (light.Type == LightType::Point || light.Type == LightType::Spot)
@@ -460,6 +499,8 @@ namespace Intro {
 					ImGui::DragFloat("Spot Angle", &light.SpotAngle, 1.0f, 1.0f, 89.0f);
 					ImGui::DragFloat("Inner Angle", &light.InnerSpotAngle, 1.0f, 1.0f, light.SpotAngle);
 				}
+
+				ImGui::Checkbox("Cast Shadows", &light.CastShadows);
 			}
 		}
 
@@ -491,6 +532,14 @@ namespace Intro {
 					cameraChanged = true;
 				}
 
+				// 透明物体的绘制方式：按深度排序混合，或加权混合 OIT（不排序）
+				const char* transparencyModes[] = { "Sorted", "Weighted Blended OIT" };
+				int transparencyMode = (int)camera.transparency;
+				if (ImGui::Combo("Transparency", &transparencyMode, transparencyModes, IM_ARRAYSIZE(transparencyModes))) {
+					camera.transparency = (TransparencyMode)transparencyMode;
+					cameraChanged = true;
+				}
+
 				// 主相机标记
 				bool oldIsMain = camera.isMainCamera;
 				ImGui::Checkbox("Is Main Camera", &camera.isMainCamera);
@@ -640,6 +689,13 @@ namespace Intro {
 			{
 				auto& meshComp = m_SelectedGameObject.GetComponent<MeshComponent>();
 				ImGui::Text("Mesh: %s", meshComp.mesh ? "Loaded" : "None");
+				if (meshComp.mesh) {
+					ImGui::Text("LOD 0: %u triangles", meshComp.mesh->GetGeometry().indexCount / 3);
+					const auto& lods = meshComp.mesh->GetLods();
+					for (size_t i = 0; i < lods.size(); ++i) {
+						ImGui::Text("LOD %zu: %u triangles (error %.4f)", i + 1, lods[i].mesh->GetGeometry().indexCount / 3, lods[i].error);
+					}
+				}
 
 				if (ImGui::Button("Remove Mesh Component")) {
 					m_SelectedGameObject.RemoveComponent<MeshComponent>();
@@ -742,6 +798,13 @@ namespace Intro {
 						materialChanged = true;
 					}
 
+					// 不透明度（透明物体）
+					float opacity = mat->GetOpacity();
+					if (ImGui::SliderFloat("Opacity", &opacity, 0.0f, 1.0f)) {
+						mat->SetOpacity(opacity);
+						materialChanged = true;
+					}
+
 					ImGui::Separator();
 					ImGui::Text("PBR Textures:");
 
@@ -786,6 +849,9 @@ namespace Intro {
 					bool transparent = pbrMaterialComp.Transparent;
 					if (ImGui::Checkbox("Transparent", &transparent)) {
 						pbrMaterialComp.Transparent = transparent;
+						// 透明标记保存在渲染代理里，直接改字段需要通知 RenderWorld 重建
+						if (auto* scene = m_SceneManager ? m_SceneManager->GetActiveScene() : nullptr)
+							scene->GetECS().MarkRenderableDirty(m_SelectedGameObject.GetEntity());
 						materialChanged = true;
 					}
 
@@ -956,6 +1022,34 @@ namespace Intro {
 			}
 		}
 
+		// --- Occluder Component ---
+		if (m_SelectedGameObject.HasComponent<OccluderComponent>())
+		{
+			if (ImGui::CollapsingHeader("Occluder", ImGuiTreeNodeFlags_DefaultOpen))
+			{
+				auto& occluder = m_SelectedGameObject.GetComponent<OccluderComponent>();
+
+				ImGui::Checkbox("Enabled##Occluder", &occluder.enabled);
+				if (occluder.mesh) {
+					ImGui::Text("Occluder Mesh: %zu triangles", occluder.mesh->GetIndices().size() / 3);
+					if (ImGui::Button("Use Box")) occluder.mesh.reset();
+				}
+				else {
+					ImGui::DragFloat3("Box Size", &occluder.size.x, 0.1f, 0.0f, 1000.0f);
+					ImGui::DragFloat3("Box Offset", &occluder.offset.x, 0.1f);
+					ImGui::TextDisabled("The box must lie inside the rendered geometry; size 0 disables it");
+					// 渲染网格本身总是位于渲染几何内部，可以直接作为遮挡网格（三角形多时 CPU 光栅化更慢）
+					if (m_SelectedGameObject.HasComponent<MeshComponent>() && m_SelectedGameObject.GetComponent<MeshComponent>().mesh) {
+						if (ImGui::Button("Use Render Mesh")) occluder.mesh = m_SelectedGameObject.GetComponent<MeshComponent>().mesh;
+					}
+				}
+
+				if (ImGui::Button("Remove Occluder Component")) {
+					m_SelectedGameObject.RemoveComponent<OccluderComponent>();
+				}
+			}
+		}
+
 		ImGui::Separator();
 		ImGui::Spacing();
 
@@ -1131,18 +1225,10 @@ namespace Intro {
 					auto* activeScene = m_SceneManager ? m_SceneManager->GetActiveScene() : nullptr;
 					if (activeScene)
 					{
-						// 使用 GameObject 接口写入 TagComponent
+						// 使用 GameObject 接口写入 TagComponent（SetName 会同步名称索引）
 						if (m_EditingGameObject.IsValid())
 						{
-							if (m_EditingGameObject.HasComponent<TagComponent>())
-							{
-								m_EditingGameObject.GetComponent<TagComponent>().Tag = newTag;
-							}
-							else
-							{
-								// 如果 GameObject 管理 AddComponent，可直接用它
-								m_EditingGameObject.AddComponent<TagComponent>(newTag);
-							}
+							m_EditingGameObject.SetName(newTag);
 
 							if (m_EditingGameObject == m_SelectedGameObject) m_SelectedGameObjectName = newTag;
 						}
@@ -1188,8 +1274,13 @@ namespace Intro {
 		ImGuizmo::SetDrawlist(ImGui::GetWindowDrawList());
 		ImGuizmo::SetRect(m_ViewportOffset.x, m_ViewportOffset.y, m_ViewportSize.x, m_ViewportSize.y);
 
+		// TransformComponent 是相对父对象的局部变换，gizmo 在世界空间中操作
+		auto& manager = activeScene->GetGameObjectManager();
+		GameObject parent = manager.GetParent(m_SelectedGameObject);
+		glm::mat4 parentWorld = parent.IsValid() ? manager.GetWorldMatrix(parent) : glm::mat4(1.0f);
+
 		auto& tc = m_SelectedGameObject.GetComponent<TransformComponent>();
-		glm::mat4 model = glm::translate(glm::mat4(1.0f), tc.transform.position) *
+		glm::mat4 model = parentWorld * glm::translate(glm::mat4(1.0f), tc.transform.position) *
 			glm::toMat4(tc.transform.rotation) *
 			glm::scale(glm::mat4(1.0f), tc.transform.scale);
 
@@ -1211,17 +1302,19 @@ namespace Intro {
 
 		if (m_IsUsingGizmo)
 		{
+			glm::mat4 local = parent.IsValid() ? glm::inverse(parentWorld) * model : model;
+
 			float translation[3], rotationEulerDeg[3], scaleArr[3];
-			ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(model), translation, rotationEulerDeg, scaleArr);
+			ImGuizmo::DecomposeMatrixToComponents(glm::value_ptr(local), translation, rotationEulerDeg, scaleArr);
 
 			glm::vec3 newTranslation(translation[0], translation[1], translation[2]);
 			glm::vec3 newScale(scaleArr[0], scaleArr[1], scaleArr[2]);
-			glm::quat newQuat = glm::quat_cast(glm::mat3(model));
+			glm::quat newQuat = glm::quat_cast(glm::mat3(local));
 
-			auto& comp = m_SelectedGameObject.GetComponent<TransformComponent>();
-			comp.transform.position = newTranslation;
-			comp.transform.rotation = newQuat;
-			comp.transform.scale = newScale;
+			Transform& transform = m_SelectedGameObject.GetTransform();
+			transform.position = newTranslation;
+			transform.rotation = newQuat;
+			transform.scale = newScale;
 
 			m_TransformEditor.position = newTranslation;
 			m_TransformEditor.rotation = newQuat;
@@ -1448,6 +1541,23 @@ namespace Intro {
 
 			ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "Orange: Editor Camera");
 			ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Green: Game Camera");
+
+			bool showColliders = m_RendererLayer->GetShowColliders();
+			if (ImGui::Checkbox("Show Colliders", &showColliders)) {
+				m_RendererLayer->SetShowColliders(showColliders);
+			}
+		}
+
+		// 调试绘制每帧的顶点预算（超出的图元被丢弃）
+		int debugBudget = (int)graphicsConfig.DebugDrawVertexBudget;
+		if (ImGui::DragInt("Debug Draw Budget", &debugBudget, 1024.0f, 1024, 1 << 22)) {
+			graphicsConfig.DebugDrawVertexBudget = (uint32_t)debugBudget;
+			configChanged = true;
+		}
+
+		// 着色器程序二进制缓存：只影响之后创建的着色器（通常是下次启动）
+		if (ImGui::Checkbox("Shader Binary Cache", &graphicsConfig.EnableShaderCache)) {
+			configChanged = true;
 		}
 
 		// MSAA 设置
@@ -1478,6 +1588,154 @@ namespace Intro {
 			configChanged = true;
 		}
 
+		// 间接绘制（共享几何池 + glMultiDrawElementsIndirect）
+		if (ImGui::Checkbox("Multi-Draw Indirect", &graphicsConfig.EnableMultiDrawIndirect)) {
+			configChanged = true;
+		}
+
+		// 深度预通道（不透明物体先只写深度，主通道以 GL_LEQUAL 只着色可见片元）
+		if (ImGui::Checkbox("Depth Pre-pass", &graphicsConfig.EnableDepthPrepass)) {
+			configChanged = true;
+		}
+
+		// CPU 遮挡剔除（只有添加了 Occluder 组件的物体作为遮挡体）
+		if (ImGui::Checkbox("Occlusion Culling", &graphicsConfig.EnableOcclusionCulling)) {
+			configChanged = true;
+		}
+
+		// 编辑器相机的透明物体模式（场景相机在 Camera 组件中设置）
+		if (m_RendererLayer) {
+			const char* transparencyModes[] = { "Sorted", "Weighted Blended OIT" };
+			Camera& editorCamera = m_RendererLayer->GetEditorCamera();
+			int transparencyMode = (int)editorCamera.GetTransparencyMode();
+			if (ImGui::Combo("Editor Camera Transparency", &transparencyMode, transparencyModes, IM_ARRAYSIZE(transparencyModes))) {
+				editorCamera.SetTransparencyMode((TransparencyMode)transparencyMode);
+			}
+		}
+
+		// 阴影设置（级联划分方案、分辨率与图集更新预算）
+		if (ImGui::CollapsingHeader("Shadows")) {
+			if (ImGui::Checkbox("Enable Shadows", &graphicsConfig.Shadows)) {
+				configChanged = true;
+			}
+
+			int cascadeCount = (int)graphicsConfig.ShadowCascadeCount;
+			if (ImGui::SliderInt("Cascades", &cascadeCount, 1, (int)MAX_SHADOW_CASCADES)) {
+				graphicsConfig.ShadowCascadeCount = (uint32_t)cascadeCount;
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Split Lambda", &graphicsConfig.ShadowSplitLambda, 0.0f, 1.0f)) {
+				configChanged = true;
+			}
+			ImGui::TextDisabled("Split scheme: %.0f%% logarithmic / %.0f%% uniform",
+				graphicsConfig.ShadowSplitLambda * 100.0f, (1.0f - graphicsConfig.ShadowSplitLambda) * 100.0f);
+			if (ImGui::SliderFloat("Shadow Distance", &graphicsConfig.ShadowDistance, 10.0f, 500.0f)) {
+				configChanged = true;
+			}
+
+			const char* sizeItems[] = { "1024", "2048", "4096" };
+			int currentSize = graphicsConfig.ShadowMapSize <= 1024 ? 0 : (graphicsConfig.ShadowMapSize <= 2048 ? 1 : 2);
+			if (ImGui::Combo("Cascade Resolution", &currentSize, sizeItems, IM_ARRAYSIZE(sizeItems))) {
+				graphicsConfig.ShadowMapSize = 1024u << currentSize;
+				configChanged = true;
+			}
+			int updateBudget = (int)graphicsConfig.ShadowUpdateBudget;
+			if (ImGui::SliderInt("Atlas Updates / Frame", &updateBudget, 1, 32)) {
+				graphicsConfig.ShadowUpdateBudget = (uint32_t)updateBudget;
+				configChanged = true;
+			}
+
+			if (m_RendererLayer && m_RendererLayer->GetShadowMaps()) {
+				const auto& shadowStats = m_RendererLayer->GetShadowMaps()->GetStats();
+				std::string splits;
+				for (uint32_t i = 0; i < shadowStats.cascadeCount; ++i) {
+					char buffer[32];
+					snprintf(buffer, sizeof(buffer), i == 0 ? "%.1f" : " / %.1f", shadowStats.cascadeSplits[i]);
+					splits += buffer;
+				}
+				ImGui::Text("Cascade Splits: %s", splits.empty() ? "-" : splits.c_str());
+				ImGui::Text("Shadow Map Updates: %u cascades, %u atlas tiles (%u deferred)",
+					shadowStats.cascadeUpdates, shadowStats.localUpdates, shadowStats.pendingLocalUpdates);
+				ImGui::Text("Atlas: %u / %u tiles, %u shadowed lights, %u casters",
+					shadowStats.usedAtlasTiles, shadowStats.atlasTiles, shadowStats.shadowedLocalLights, shadowStats.casterCount);
+			}
+		}
+
+		// 细节层次：生成参数在导入模型时生效，选择参数每帧生效
+		if (ImGui::CollapsingHeader("Level of Detail")) {
+			if (ImGui::Checkbox("Enable LOD", &graphicsConfig.EnableLod)) {
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Pixel Error", &graphicsConfig.LodPixelError, 0.25f, 8.0f)) {
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Hysteresis", &graphicsConfig.LodHysteresis, 0.0f, 0.9f)) {
+				configChanged = true;
+			}
+			if (ImGui::Checkbox("Dithered Cross-fade", &graphicsConfig.LodCrossFade)) {
+				configChanged = true;
+			}
+
+			int lodLevels = (int)graphicsConfig.LodLevels;
+			if (ImGui::SliderInt("Levels", &lodLevels, 1, (int)LodSelector::MaxLevels)) {
+				graphicsConfig.LodLevels = (uint32_t)lodLevels;
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Triangle Ratio", &graphicsConfig.LodTriangleRatio, 0.1f, 0.9f)) {
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Max Error", &graphicsConfig.LodMaxError, 0.001f, 0.2f, "%.3f")) {
+				configChanged = true;
+			}
+			ImGui::TextDisabled("Levels / ratio / error apply to models loaded afterwards");
+
+			if (m_RendererLayer && graphicsConfig.EnableLod) {
+				const auto& lodStats = m_RendererLayer->GetLodSelector().GetStats();
+				std::string levels;
+				for (uint32_t i = 0; i < LodSelector::MaxLevels; ++i) {
+					if (lodStats.levelCounts[i] == 0) continue;
+					char buffer[32];
+					snprintf(buffer, sizeof(buffer), levels.empty() ? "L%u: %u" : "  L%u: %u", i, lodStats.levelCounts[i]);
+					levels += buffer;
+				}
+				ImGui::Text("Selected: %s (%u fading)", levels.empty() ? "-" : levels.c_str(), lodStats.fadingCount);
+				uint64_t saved = lodStats.fullTriangles - lodStats.selectedTriangles;
+				ImGui::Text("Triangles: %llu / %llu (saved %.1f%%)",
+					(unsigned long long)lodStats.selectedTriangles, (unsigned long long)lodStats.fullTriangles,
+					lodStats.fullTriangles > 0 ? 100.0f * (float)saved / (float)lodStats.fullTriangles : 0.0f);
+			}
+		}
+
+		// 动态分辨率（按场景 GPU 时间缩放渲染子区域，再上采样到视口）
+		if (ImGui::CollapsingHeader("Dynamic Resolution")) {
+			if (ImGui::Checkbox("Enable Dynamic Resolution", &graphicsConfig.EnableDynamicResolution)) {
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Target GPU Time (ms)", &graphicsConfig.DynamicResolutionTargetMs, 2.0f, 50.0f, "%.1f")) {
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Min Scale", &graphicsConfig.DynamicResolutionMinScale, 0.25f, 1.0f, "%.2f")) {
+				graphicsConfig.DynamicResolutionMaxScale = std::max(graphicsConfig.DynamicResolutionMaxScale, graphicsConfig.DynamicResolutionMinScale);
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Max Scale", &graphicsConfig.DynamicResolutionMaxScale, 0.25f, 1.0f, "%.2f")) {
+				graphicsConfig.DynamicResolutionMinScale = std::min(graphicsConfig.DynamicResolutionMinScale, graphicsConfig.DynamicResolutionMaxScale);
+				configChanged = true;
+			}
+			if (ImGui::SliderFloat("Upscale Sharpness", &graphicsConfig.UpscaleSharpness, 0.0f, 1.0f, "%.2f")) {
+				configChanged = true;
+			}
+
+			if (m_RendererLayer) {
+				const auto& resolution = m_RendererLayer->GetDynamicResolution();
+				const auto& resolutionStats = resolution.GetStats();
+				glm::uvec2 renderSize = m_RendererLayer->GetRenderSize();
+				ImGui::Text("Scale: %.2f  Render Size: %u x %u", resolution.GetScale(), renderSize.x, renderSize.y);
+				ImGui::Text("Scene GPU: %.2f ms (average %.2f ms)", resolutionStats.lastMs, resolutionStats.averageMs);
+				ImGui::Text("Adjustments: %u  Dropped Queries: %u", resolutionStats.adjustments, resolutionStats.droppedQueries);
+			}
+		}
+
 		// 后期处理设置
 		if (ImGui::CollapsingHeader("Post Processing")) {
 			if (ImGui::Checkbox("Enable Post Processing", &graphicsConfig.EnablePostProcessing)) {
@@ -1503,15 +1761,125 @@ namespace Intro {
 		// 统计信息
 		if (ImGui::CollapsingHeader("Statistics")) {
 			auto stats = Renderer::GetStats();
-			ImGui::Text("Draw Calls: %d", stats.drawCalls);
+			ImGui::Text("Draw Calls: %d (indirect commands %d)", stats.drawCalls, stats.indirectCommands);
+			ImGui::Text("Instances: %d (%.1f per draw)", stats.instanceCount,
+				stats.drawCalls > 0 ? (float)stats.instanceCount / (float)stats.drawCalls : 0.0f);
 			ImGui::Text("Triangles: %d", stats.triangleCount);
 			ImGui::Text("Vertices: %d", stats.vertexCount);
+			ImGui::Text("Visible: %d  Culled: %d (occluded %d)", stats.visibleCount, stats.culledCount, stats.occludedCount);
+			ImGui::Text("Object Data Stalls: %d", stats.objectDataStalls);
+			auto poolStats = GeometryPool::GetStats();
+			ImGui::Text("Geometry Pool: %u / %u vertices, %u / %u indices",
+				poolStats.vertexUsed, poolStats.vertexCapacity, poolStats.indexUsed, poolStats.indexCapacity);
+			ImGui::Text("Material Binds: %d (materials %u)", stats.materialBinds, MaterialTable::GetMaterialCount());
+			ImGui::Text("Texture Arrays: %u (%u layers)", TextureArrayPool::GetArrayCount(), TextureArrayPool::GetLayerCount());
+			ImGui::Text("Skipped Uniform Updates: %llu", (unsigned long long)Shader::GetSkippedUniformUpdates());
+			const auto& stateStats = RenderState::GetStats();
+			ImGui::Text("GL State Changes: %u (filtered %u redundant)", stateStats.stateChanges, stateStats.redundantChanges);
+			const auto& debugStats = DebugDraw::GetStats();
+			ImGui::Text("Debug Draw: %u / %u vertices (%u dropped), %u draws, %u texts",
+				debugStats.vertexCount, debugStats.vertexBudget, debugStats.droppedVertices, debugStats.drawCalls, debugStats.textCount);
+			const auto& transformStats = TransformSystem::GetStats();
+			ImGui::Text("Transforms: %u / %u updated on %u threads, %u in hierarchy (%.3f ms)",
+				transformStats.updatedCount, transformStats.entityCount, transformStats.workerCount,
+				transformStats.hierarchyCount, transformStats.updateMs);
+			if (m_RendererLayer) {
+				const auto& worldStats = m_RendererLayer->GetRenderWorld().GetStats();
+				ImGui::Text("Render Proxies: %u (%u entities rebuilt%s, %u moved), extract %.3f ms (sync %.3f + collect %.3f)",
+					worldStats.proxyCount, worldStats.rebuiltEntities, worldStats.fullRebuild ? ", full" : "", worldStats.movedProxies,
+					worldStats.syncMs + worldStats.collectMs, worldStats.syncMs, worldStats.collectMs);
+			}
+			auto jobStats = JobSystem::GetStats();
+			ImGui::Text("Jobs: %u threads, %llu executed (%llu stolen)", jobStats.threadCount,
+				(unsigned long long)jobStats.jobsExecuted, (unsigned long long)jobStats.jobsStolen);
+			if (auto* scene = m_SceneManager ? m_SceneManager->GetActiveScene() : nullptr) {
+				const auto& systemStats = scene->GetSystems().GetStats();
+				ImGui::Text("Systems: %u (%u edges, critical path %u), %.3f ms",
+					systemStats.systemCount, systemStats.edgeCount, systemStats.criticalPath, systemStats.frameMs);
+				for (const auto& timing : systemStats.systems)
+					ImGui::BulletText("%s: %.3f ms (thread %u)", timing.name.c_str(), timing.ms, timing.threadIndex);
+			}
+			const auto& cacheStats = ShaderCache::GetStats();
+			ImGui::Text("Shader Cache: %u hits, %u misses (%u rejected), saved ~%.1f ms",
+				cacheStats.hits, cacheStats.misses, cacheStats.rejected, cacheStats.savedMs);
+			if (m_RendererLayer) {
+				const auto& graphStats = m_RendererLayer->GetRenderGraph().GetStats();
+				ImGui::Text("Render Graph: %u passes (%u culled), %u FBO binds, %u clears",
+					graphStats.passCount, graphStats.culledPasses, graphStats.framebufferBinds, graphStats.clears);
+				ImGui::Text("Transient Textures: %u -> %u physical, %u cached FBOs",
+					graphStats.transientTextures, graphStats.physicalTextures, graphStats.cachedFramebuffers);
+				if (const LightClusters* clusters = m_RendererLayer->GetLightClusters()) {
+					const auto& clusterStats = clusters->GetStats();
+					ImGui::Text("Clustered Lights: %u (%u indices, max %u per cluster)",
+						clusterStats.lightCount, clusterStats.indexCount, clusterStats.maxLightsPerCluster);
+					ImGui::Text("Active Clusters: %u / %u, binning %.3f ms on %u threads",
+						clusterStats.activeClusters, LightClusters::ClusterCount, clusterStats.binningMs, clusterStats.workerCount);
+				}
+				const auto& occlusionStats = m_RendererLayer->GetOcclusionCuller().GetStats();
+				ImGui::Text("Occluders: %u (%u triangles), raster %.3f ms on %u threads",
+					occlusionStats.occluderCount, occlusionStats.triangleCount, occlusionStats.rasterMs, occlusionStats.workerCount);
+				ImGui::Text("Transparency: %s", m_RendererLayer->GetTransparencyModeThisFrame() == TransparencyMode::WeightedBlended
+					? "Weighted Blended OIT" : "Sorted");
+				const auto& overdraw = m_RendererLayer->GetOverdrawStats();
+				ImGui::Text("Opaque Shading: %.2f samples / pixel (%llu samples)",
+					overdraw.shadedPerPixel, (unsigned long long)overdraw.shadedSamples);
+				if (overdraw.depthPrepass) {
+					ImGui::Text("Depth Pre-pass: %.2f samples / pixel (%llu samples)",
+						overdraw.prepassPerPixel, (unsigned long long)overdraw.prepassSamples);
+				}
+				else {
+					ImGui::TextDisabled("Depth Pre-pass: off");
+				}
+			}
 
 			if (ImGui::Button("Reset Stats")) {
 				Renderer::ResetStats();
 			}
 		}
 
+		// GPU 计时（结果延迟一到两帧读取）
+		if (ImGui::CollapsingHeader("GPU Profiler")) {
+			bool profilerEnabled = GPUProfiler::IsEnabled();
+			if (ImGui::Checkbox("Enable GPU Timers", &profilerEnabled)) {
+				GPUProfiler::SetEnabled(profilerEnabled);
+			}
+
+			GPUProfiler::GetScopeHistory("Frame", m_GPUProfilePlot);
+			if (!m_GPUProfilePlot.empty()) {
+				ImGui::PlotLines("Frame (ms)", m_GPUProfilePlot.data(), (int)m_GPUProfilePlot.size(),
+					0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+			}
+
+			if (ImGui::BeginTable("GPUTimings", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+				ImGui::TableSetupColumn("Pass");
+				ImGui::TableSetupColumn("Last (ms)");
+				ImGui::TableSetupColumn("Avg (ms)");
+				ImGui::TableSetupColumn("Max (ms)");
+				ImGui::TableHeadersRow();
+
+				for (const auto& scope : GPUProfiler::GetScopeStats()) {
+					ImGui::TableNextRow();
+					ImGui::TableSetColumnIndex(0);
+					ImGui::Indent(scope.depth * 10.0f + 1.0f);
+					ImGui::TextUnformatted(scope.name.c_str());
+					ImGui::Unindent(scope.depth * 10.0f + 1.0f);
+					ImGui::TableSetColumnIndex(1);
+					ImGui::Text("%.3f", scope.lastMs);
+					ImGui::TableSetColumnIndex(2);
+					ImGui::Text("%.3f", scope.averageMs);
+					ImGui::TableSetColumnIndex(3);
+					ImGui::Text("%.3f", scope.maxMs);
+				}
+				ImGui::EndTable();
+			}
+			ImGui::Text("Dropped Frames: %u", GPUProfiler::GetDroppedFrameCount());
+
+			ImGui::InputText("CSV Path", &m_GPUProfileExportPath);
+			if (ImGui::Button("Export CSV")) {
+				GPUProfiler::ExportCSV(m_GPUProfileExportPath);
+			}
+		}
+
 		if (configChanged) {
 			config.MarkDirty(true);
 			ConfigObserver::Get().OnGraphicsConfigChanged(graphicsConfig);
@@ -1886,16 +2254,16 @@ namespace Intro {
 		if (!m_SceneManager || !m_SelectedGameObject.IsValid()) return;
 		if (!m_SelectedGameObject.HasComponent<TransformComponent>()) return;
 
-		auto& t = m_SelectedGameObject.GetComponent<TransformComponent>();
-		t.transform.position = m_TransformEditor.position;
-		t.transform.rotation = m_TransformEditor.rotation;
-		t.transform.scale = m_TransformEditor.scale;
+		Transform& t = m_SelectedGameObject.GetTransform();
+		t.position = m_TransformEditor.position;
+		t.rotation = m_TransformEditor.rotation;
+		t.scale = m_TransformEditor.scale;
 
 		if (m_SelectedGameObject.HasComponent<LightComponent>())
 		{
 			auto& light = m_SelectedGameObject.GetComponent<LightComponent>();
 			if (light.Type == LightType::Directional) {
-				glm::vec3 worldDir = t.transform.rotation * light.Direction;
+				glm::vec3 worldDir = t.rotation * light.Direction;
 				ITR_INFO("Directional Light direction updated: ({:.2f},{:.2f},{:.2f})", worldDir.x, worldDir.y, worldDir.z);
 			}
 		}
@@ -1920,7 +2288,7 @@ namespace Intro {
 		// 列出所有可添加的组件类型
 		std::vector<std::string> allComponents = {
 			"Mesh", "Model", "Light", "Camera", "Material",
-			"Rigidbody", "Collider", "PBRMaterial"
+			"Rigidbody", "Collider", "PBRMaterial", "Occluder"
 		};
 
 		// 过滤掉已经存在的组件
@@ -1944,6 +2312,8 @@ namespace Intro {
 				shouldAdd = false;
 			else if (compName == "Collider" && m_SelectedGameObject.HasComponent<ColliderComponent>())
 				shouldAdd = false;
+			else if (compName == "Occluder" && m_SelectedGameObject.HasComponent<OccluderComponent>())
+				shouldAdd = false;
 
 
 			if (shouldAdd) {
@@ -2067,6 +2437,10 @@ namespace Intro {
 			m_SelectedGameObject.AddComponent<ColliderComponent>();
 			ITR_INFO("Added ColliderComponent to {}", m_SelectedGameObjectName);
 		}
+		else if (componentName == "Occluder") {
+			m_SelectedGameObject.AddComponent<OccluderComponent>();
+			ITR_INFO("Added OccluderComponent to {}", m_SelectedGameObjectName);
+		}
 	}
 
 	// -------------------------------------------------------------------------
@@ -43,7 +43,7 @@ namespace Intro {
 		void BeginFrame();
 		void EndFrameAndRender();
 
-		// Draw helpers (һܺ)
+		// Draw helpers (单一功能函数)
 		void DrawMenuBar();
 		void DrawDockSpaceHost();
 		void DrawViewport();
@@ -52,6 +52,7 @@ namespace Intro {
 		void ShowSceneControlsWindow();
 		void ShowImportModelWindow();
 		void RenderGizmo();
+		void DrawDebugTexts();
 		void HandleRenamePopup();
 
 		// Utilities
@@ -74,7 +75,7 @@ namespace Intro {
 		void ShowAddComponentPopup();
 		void AddComponentToSelected(const std::string& componentName);
 
-		// Event handlers (ԭװ ImGui IO ״̬)
+		// Event handlers (原样保留，封装 ImGui IO 状态)
 		bool OnMouseButtonPressedEvent(MouseButtonPressedEvent& e);
 		bool OnMouseButtonReleasedEvent(MouseButtonReleasedEvent& e);
 		bool OnMouseMovedEvent(MouseMovedEvent& e);
@@ -100,7 +101,7 @@ namespace Intro {
 		bool m_ViewportFocused = false;
 
 		// selection / entities
-		GameObject m_SelectedGameObject; // ѡ GameObjectʼΪЧ
+		GameObject m_SelectedGameObject; // 选中 GameObject（初始为无效对象）
 		std::string m_SelectedGameObjectName;
 		std::vector<GameObject> m_CachedGameObjects;
 
@@ -125,8 +126,12 @@ namespace Intro {
 		std::string m_ModelImportPath;
 		bool m_ShowImportWindow = false;
 
+		// GPU profiler export
+		std::string m_GPUProfileExportPath = "gpu_profile.csv";
+		std::vector<float> m_GPUProfilePlot;
 
-		// optional default material/shader (ע)
+
+		// optional default material/shader (可注入)
 		std::shared_ptr<Material> m_DefaultMaterial;
 		std::shared_ptr<Shader> m_DefaultShader = Application::GetShaderLibrary().Get("UnnamedShader");
 
@@ -137,15 +142,15 @@ namespace Intro {
 		char m_RenameBuffer[256] = { 0 };
 		bool m_ShowHiddenFiles = false;
 		int m_SortMode = 0; // 0=name, 1=time, 2=type
-		float m_ResourcePaneWidth = 320.0f; // 
+		float m_ResourcePaneWidth = 320.0f; // 左边树宽度
 
 		bool m_ShowPlayControls = true;
 
 		bool m_ShowResourceBrowser = false;
-		bool m_ShowGameObjectManager = true; // Ĭʾ
-		bool m_ShowEntityInspector = true; // Ĭʾ
-		bool m_ShowSceneControls = true; // Ĭʾ
-		bool m_ShowRendererSettings = false; // Ĭϲʾ
+		bool m_ShowGameObjectManager = true; // 默认显示
+		bool m_ShowEntityInspector = true; // 默认显示
+		bool m_ShowSceneControls = true; // 默认显示
+		bool m_ShowRendererSettings = false; // 默认不显示
 		bool m_ShowSkyboxSettings = false;
 
 		bool m_ShowAddComponentPopup = false;
@@ -16,7 +16,7 @@ namespace Intro {
 
     class ITR_API Input {
     public:
-        // ԭеľ̬
+        // 原有的静态函数
         inline static bool IsKeyPressed(int keycode) {
             return s_Instance->IsKeyPressedImpl(keycode);
         }
@@ -37,9 +37,9 @@ namespace Intro {
             return s_Instance->GetMouseYImpl();
         }
 
-        // ===  ===
+        // === 新增功能 ===
 
-        // հ/ͷż
+        // 刚按下/刚释放检测
         inline static bool IsKeyJustPressed(int keycode) {
             return s_Instance->IsKeyJustPressedImpl(keycode);
         }
@@ -56,12 +56,12 @@ namespace Intro {
             return s_Instance->IsMouseButtonJustReleasedImpl(button);
         }
 
-        // 
+        // 鼠标滚动
         inline static float GetMouseScrollDelta() {
             return s_Instance->GetMouseScrollDeltaImpl();
         }
 
-        // ģʽ
+        // 光标模式
         inline static void SetCursorMode(CursorMode mode) {
             s_Instance->SetCursorModeImpl(mode);
         }
@@ -70,7 +70,7 @@ namespace Intro {
             return s_Instance->GetCursorModeImpl();
         }
 
-        // ӳ
+        // 输入映射
         inline static void AddActionMapping(const std::string& name, int keycode) {
             s_Instance->AddActionMappingImpl(name, keycode);
         }
@@ -91,20 +91,20 @@ namespace Intro {
             return s_Instance->GetActionJustReleasedImpl(name);
         }
 
-        // ڲ
+        // 内部更新
         inline static void Update() {
             s_Instance->UpdateImpl();
         }
 
     protected:
-        // ԭе麯
+        // 原有的虚函数
         virtual bool IsKeyPressedImpl(int keycode) = 0;
         virtual bool IsMouseButtonPressedImpl(int button) = 0;
         virtual std::pair<float, float> GetMousePositionImpl() = 0;
         virtual float GetMouseXImpl() = 0;
         virtual float GetMouseYImpl() = 0;
 
-        // === 麯 ===
+        // === 新增虚函数 ===
         virtual bool IsKeyJustPressedImpl(int keycode) = 0;
         virtual bool IsKeyJustReleasedImpl(int keycode) = 0;
         virtual bool IsMouseButtonJustPressedImpl(int button) = 0;
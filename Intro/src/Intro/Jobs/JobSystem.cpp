@@ -0,0 +1,178 @@
+#include "itrpch.h"
+#include "JobSystem.h"
+#include "Intro/Log.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Intro {
+
+	namespace {
+
+		struct Job {
+			JobSystem::JobFunction function;
+			JobCounter* counter = nullptr;
+		};
+
+		// 任务粒度是“一块实体 / 一个系统”，远大于加锁开销，队列用普通互斥锁保护
+		struct WorkQueue {
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		std::vector<std::unique_ptr<WorkQueue>> s_Queues;	// [0] 主线程与外部线程，[1..] 工作线程
+		std::vector<std::thread> s_Threads;
+		std::atomic<bool> s_Running{ false };
+		std::atomic<uint32_t> s_QueuedJobs{ 0 };
+		std::mutex s_SleepMutex;
+		std::condition_variable s_WakeCondition;
+		std::atomic<uint64_t> s_Executed{ 0 };
+		std::atomic<uint64_t> s_Stolen{ 0 };
+
+		thread_local uint32_t t_QueueIndex = 0;
+
+		bool PopLocal(uint32_t index, Job& job) {
+			WorkQueue& queue = *s_Queues[index];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.jobs.empty()) return false;
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			return true;
+		}
+
+		bool Steal(uint32_t thief, Job& job) {
+			const uint32_t queueCount = (uint32_t)s_Queues.size();
+			for (uint32_t i = 1; i < queueCount; ++i) {
+				WorkQueue& queue = *s_Queues[(thief + i) % queueCount];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				if (queue.jobs.empty()) continue;
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+				s_Stolen.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+			return false;
+		}
+
+		bool TryExecute(uint32_t index) {
+			Job job;
+			if (!PopLocal(index, job) && !Steal(index, job)) return false;
+
+			s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			job.function();
+			if (job.counter) job.counter->pending.fetch_sub(1, std::memory_order_release);
+			s_Executed.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		void WorkerLoop(uint32_t index) {
+			t_QueueIndex = index;
+			while (s_Running.load(std::memory_order_acquire)) {
+				if (TryExecute(index)) continue;
+
+				std::unique_lock<std::mutex> lock(s_SleepMutex);
+				s_WakeCondition.wait(lock, []() {
+					return !s_Running.load(std::memory_order_acquire) || s_QueuedJobs.load(std::memory_order_acquire) > 0;
+				});
+			}
+		}
+
+	}
+
+	void JobSystem::Initialize(uint32_t workerCount) {
+		if (s_Running) return;
+
+		if (workerCount == 0) {
+			uint32_t hardware = std::max(std::thread::hardware_concurrency(), 1u);
+			workerCount = hardware - 1;
+		}
+
+		s_Queues.clear();
+		for (uint32_t i = 0; i <= workerCount; ++i)
+			s_Queues.push_back(std::make_unique<WorkQueue>());
+
+		t_QueueIndex = 0;
+		s_Running = true;
+		for (uint32_t i = 1; i <= workerCount; ++i)
+			s_Threads.emplace_back(WorkerLoop, i);
+
+		ITR_INFO("JobSystem: {} worker threads (+ main thread)", workerCount);
+	}
+
+	void JobSystem::Shutdown() {
+		if (!s_Running) return;
+
+		// 先把剩余任务在主线程上执行完，保证等待中的计数都能归零
+		while (TryExecute(0)) {}
+
+		{
+			std::lock_guard<std::mutex> lock(s_SleepMutex);
+			s_Running = false;
+		}
+		s_WakeCondition.notify_all();
+		for (auto& thread : s_Threads) thread.join();
+		s_Threads.clear();
+		s_Queues.clear();
+	}
+
+	bool JobSystem::IsInitialized() {
+		return s_Running.load(std::memory_order_acquire);
+	}
+
+	uint32_t JobSystem::GetThreadCount() {
+		return IsInitialized() ? (uint32_t)s_Queues.size() : 1u;
+	}
+
+	uint32_t JobSystem::GetCurrentThreadIndex() {
+		return t_QueueIndex;
+	}
+
+	void JobSystem::Run(JobFunction job, JobCounter* counter) {
+		if (!IsInitialized() || s_Queues.size() == 1) {
+			job();
+			s_Executed.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+		{
+			WorkQueue& queue = *s_Queues[t_QueueIndex];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back({ std::move(job), counter });
+		}
+		s_QueuedJobs.fetch_add(1, std::memory_order_release);
+
+		// 与工作线程检查等待条件互斥，避免在它判断之后、睡眠之前发出的通知丢失
+		{ std::lock_guard<std::mutex> lock(s_SleepMutex); }
+		s_WakeCondition.notify_one();
+	}
+
+	void JobSystem::Wait(const JobCounter& counter) {
+		while (!counter.IsDone()) {
+			if (!IsInitialized() || !TryExecute(t_QueueIndex))
+				std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::ExecuteOne() {
+		return IsInitialized() && TryExecute(t_QueueIndex);
+	}
+
+	uint32_t JobSystem::ComputeBatchSize(uint32_t count, uint32_t minBatchSize) {
+		uint32_t batches = GetThreadCount() * BatchesPerThread;
+		uint32_t batchSize = (count + batches - 1) / batches;
+		return std::max({ batchSize, minBatchSize, 1u });
+	}
+
+	JobSystem::Statistics JobSystem::GetStats() {
+		Statistics stats;
+		stats.threadCount = GetThreadCount();
+		stats.jobsExecuted = s_Executed.load(std::memory_order_relaxed);
+		stats.jobsStolen = s_Stolen.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Intro {
+
+	// 一组任务的完成计数：Run 时加一，任务执行完减一，归零表示全部完成
+	struct JobCounter {
+		std::atomic<uint32_t> pending{ 0 };
+
+		bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	// 工作窃取任务系统：
+	// - 每个线程（主线程占 0 号队列）有自己的双端队列，自己从尾部取（LIFO，缓存热），空闲时从其他队列头部窃取
+	// - 非任务线程提交的任务进入 0 号队列，由主线程或窃取者执行
+	// - Wait 不会阻塞线程：等待期间继续执行队列中的任务，因此任务内部可以嵌套 ParallelFor
+	// - 未初始化（或只有一个线程）时 Run 直接在调用线程上执行
+	class ITR_API JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+
+		// workerCount 为 0 时使用 hardware_concurrency - 1 个工作线程（主线程也参与执行）
+		static void Initialize(uint32_t workerCount = 0);
+		static void Shutdown();
+		static bool IsInitialized();
+
+		// 参与执行任务的线程数（工作线程 + 主线程），至少为 1
+		static uint32_t GetThreadCount();
+		// 当前线程的队列下标：主线程与外部线程为 0，工作线程从 1 开始
+		static uint32_t GetCurrentThreadIndex();
+
+		static void Run(JobFunction job, JobCounter* counter = nullptr);
+		static void Wait(const JobCounter& counter);
+		// 尝试执行一个任务（先本线程队列，再窃取），没有可执行的任务时返回 false
+		static bool ExecuteOne();
+
+		// 把 [0, count) 按 batchSize 切成连续的块并行执行 func(begin, end)；
+		// 块的划分是确定的（第 k 块为 [k * batchSize, (k + 1) * batchSize)），调用线程执行第一块并等待全部完成
+		template<typename Func>
+		static void ParallelFor(uint32_t count, uint32_t batchSize, Func&& func);
+
+		// 对 entt 视图中的每个实体并行执行 func(entity)。先把实体收集到连续数组再分块，
+		// func 只能访问视图涉及的组件存储，不能增删组件或实体
+		template<typename View, typename Func>
+		static void ParallelForEach(const View& view, uint32_t batchSize, Func&& func);
+
+		// 按线程数与最小块大小计算 ParallelFor 的块大小：每个线程约 BatchesPerThread 块，便于窃取时均衡负载
+		static uint32_t ComputeBatchSize(uint32_t count, uint32_t minBatchSize);
+		static constexpr uint32_t BatchesPerThread = 4;
+
+		struct Statistics {
+			uint32_t threadCount = 1;
+			uint64_t jobsExecuted = 0;
+			uint64_t jobsStolen = 0;
+		};
+		static Statistics GetStats();
+	};
+
+	template<typename Func>
+	void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, Func&& func) {
+		if (count == 0) return;
+		if (batchSize == 0) batchSize = 1;
+
+		const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+		if (batchCount == 1 || GetThreadCount() == 1) {
+			func(0u, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t b = 1; b < batchCount; ++b) {
+			uint32_t begin = b * batchSize;
+			uint32_t end = begin + batchSize < count ? begin + batchSize : count;
+			Run([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+		func(0u, batchSize < count ? batchSize : count);
+		Wait(counter);
+	}
+
+	template<typename View, typename Func>
+	void JobSystem::ParallelForEach(const View& view, uint32_t batchSize, Func&& func) {
+		std::vector<typename View::entity_type> entities;
+		for (auto entity : view)
+			entities.push_back(entity);
+
+		const auto* data = entities.data();
+		ParallelFor((uint32_t)entities.size(), batchSize, [&func, data](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i)
+				func(data[i]);
+		});
+	}
+
+}
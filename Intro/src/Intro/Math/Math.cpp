@@ -7,7 +7,7 @@ namespace Intro{
         glm::vec3& translation,
         glm::quat& rotation,
         glm::vec3& scale) {
-        // ʹGLMķֽ⺯
+        // 使用GLM的分解函数
         glm::vec3 skew;
         glm::vec4 perspective;
         return glm::decompose(transform, scale, rotation, translation, skew, perspective);
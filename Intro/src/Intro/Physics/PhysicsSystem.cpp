@@ -1,18 +1,23 @@
-// Physics/PhysicsSystem.cpp - ޸汾
+// Physics/PhysicsSystem.cpp - 修复版本
 #include "itrpch.h"
 #include "PhysicsSystem.h"
 #include "Intro/ECS/GameObject.h"
+#include "Intro/ECS/TransformHierarchy.h"
 #include "Intro/Log.h"
+#include "Intro/Renderer/DebugDraw.h"
+#include "Intro/Jobs/JobSystem.h"
 #include <algorithm>
 #include <glm/gtx/norm.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
 
 namespace Intro {
 
-    // ̬Ա
+    // 静态成员定义
     PhysicsConfig PhysicsSystem::s_Config;
     float PhysicsSystem::s_AccumulatedTime = 0.0f;
     bool PhysicsSystem::s_Initialized = false;
     bool PhysicsSystem::s_DebugDraw = true;
+    const TransformHierarchy* PhysicsSystem::s_Hierarchy = nullptr;
     std::vector<CollisionInfo> PhysicsSystem::s_CollisionPairs;
     std::vector<CollisionInfo> PhysicsSystem::s_TriggerPairs;
 
@@ -26,10 +31,12 @@ namespace Intro {
         ITR_INFO("Physics System Initialized");
     }
 
-    void PhysicsSystem::OnUpdate(float deltaTime, ECS& ecs, bool isPlaying) {
+    void PhysicsSystem::OnUpdate(float deltaTime, ECS& ecs, bool isPlaying, const TransformHierarchy* hierarchy) {
         if (!s_Initialized || !isPlaying) return;
 
-        // ۻʱ䲢ִй̶ʱ䲽
+        s_Hierarchy = hierarchy;
+
+        // 累积时间并执行固定时间步长更新
         s_AccumulatedTime += deltaTime;
 
         int numSubSteps = 0;
@@ -38,14 +45,16 @@ namespace Intro {
             s_AccumulatedTime -= s_Config.fixedTimeStep;
             numSubSteps++;
         }
+
+        s_Hierarchy = nullptr;
     }
 
     void PhysicsSystem::FixedUpdate(ECS& ecs, float fixedDeltaTime) {
-        // һ֡ײ
+        // 清除上一帧的碰撞对
         s_CollisionPairs.clear();
         s_TriggerPairs.clear();
 
-        // ²
+        // 物理更新步骤
         IntegrateForces(ecs, fixedDeltaTime);
         DetectCollisions(ecs);
         ResolveCollisions(ecs, fixedDeltaTime);
@@ -55,49 +64,54 @@ namespace Intro {
     void PhysicsSystem::IntegrateForces(ECS& ecs, float deltaTime) {
         auto view = ecs.GetRegistry().view<TransformComponent, RigidbodyComponent, ColliderComponent>();
 
-        for (auto [entity, transform, rigidbody, collider] : view.each()) {
-            if (rigidbody.isKinematic || !collider.enabled) continue;
+        // 每个刚体只读写自己的 RigidbodyComponent，按块并行
+        JobSystem::ParallelForEach(view, ForceBatchSize, [&view, deltaTime](entt::entity entity) {
+            auto& rigidbody = view.get<RigidbodyComponent>(entity);
+            const auto& collider = view.get<ColliderComponent>(entity);
+            if (rigidbody.isKinematic || !collider.enabled) return;
 
-            // Ӧ
+            // 应用重力
             if (rigidbody.useGravity) {
                 rigidbody.force += s_Config.gravity * rigidbody.mass;
             }
 
-            // ٶ (F = ma -> a = F/m)
+            // 计算加速度 (F = ma -> a = F/m)
             glm::vec3 acceleration = rigidbody.force / rigidbody.mass;
             rigidbody.velocity += acceleration * deltaTime;
 
-            // Ӧ - ޸ʹøȶ
+            // 应用线性阻力 - 修复：使用更稳定的阻力计算
             if (glm::length(rigidbody.velocity) > 0.01f) {
                 rigidbody.velocity *= (1.0f - rigidbody.drag * deltaTime);
-                // ֹٶȹСֵȶ
+                // 防止速度过小导致数值不稳定
                 if (glm::length(rigidbody.velocity) < 0.01f) {
                     rigidbody.velocity = glm::vec3(0.0f);
                 }
             }
 
-            // 
+            // 重置力
             rigidbody.force = glm::vec3(0.0f);
-        }
+        });
     }
 
     void PhysicsSystem::DetectCollisions(ECS& ecs) {
         auto view = ecs.GetRegistry().view<TransformComponent, ColliderComponent>();
         std::vector<entt::entity> entities(view.begin(), view.end());
 
-        // 򵥵
+        // 简单的两两检测
         for (size_t i = 0; i < entities.size(); ++i) {
             for (size_t j = i + 1; j < entities.size(); ++j) {
                 auto entityA = entities[i];
                 auto entityB = entities[j];
 
-                auto& transformA = ecs.GetComponent<TransformComponent>(entityA).transform;
                 auto& colliderA = ecs.GetComponent<ColliderComponent>(entityA);
-                auto& transformB = ecs.GetComponent<TransformComponent>(entityB).transform;
                 auto& colliderB = ecs.GetComponent<ColliderComponent>(entityB);
 
                 if (!colliderA.enabled || !colliderB.enabled) continue;
 
+                // 有父对象的碰撞体在世界空间中检测
+                Transform transformA = GetWorldTransform(entityA, ecs.GetComponent<TransformComponent>(entityA).transform);
+                Transform transformB = GetWorldTransform(entityB, ecs.GetComponent<TransformComponent>(entityB).transform);
+
                 CollisionInfo collision;
                 bool hasCollision = CheckCollision(transformA, colliderA, transformB, colliderB, collision);
 
@@ -106,7 +120,7 @@ namespace Intro {
                     collision.entityB = GameObject(entityB, &ecs);
                     collision.isTrigger = colliderA.isTrigger || colliderB.isTrigger;
 
-                    // ٶ
+                    // 计算相对速度
                     if (collision.entityA.HasComponent<RigidbodyComponent>() &&
                         collision.entityB.HasComponent<RigidbodyComponent>()) {
                         auto& rbA = collision.entityA.GetComponent<RigidbodyComponent>();
@@ -128,7 +142,7 @@ namespace Intro {
     bool PhysicsSystem::CheckCollision(const Transform& transformA, const ColliderComponent& colliderA,
         const Transform& transformB, const ColliderComponent& colliderB,
         CollisionInfo& collision) {
-        // ײ͵Ӧļ⺯
+        // 根据碰撞体类型调用相应的检测函数
         if (colliderA.type == ColliderType::Box && colliderB.type == ColliderType::Box) {
             return CheckAABBCollision(transformA, colliderA, transformB, colliderB, collision);
         }
@@ -153,7 +167,7 @@ namespace Intro {
         glm::vec3 posB = GetColliderWorldPosition(transformB, colliderB);
         glm::vec3 sizeB = GetColliderWorldSize(transformB, colliderB);
 
-        // AABB ײ
+        // AABB 碰撞检测
         bool collisionX = posA.x + sizeA.x / 2.0f >= posB.x - sizeB.x / 2.0f &&
             posB.x + sizeB.x / 2.0f >= posA.x - sizeA.x / 2.0f;
         bool collisionY = posA.y + sizeA.y / 2.0f >= posB.y - sizeB.y / 2.0f &&
@@ -162,11 +176,11 @@ namespace Intro {
             posB.z + sizeB.z / 2.0f >= posA.z - sizeA.z / 2.0f;
 
         if (collisionX && collisionY && collisionZ) {
-            // 㴩͸ͷ
+            // 计算穿透向量和法线
             glm::vec3 delta = posB - posA;
             glm::vec3 penetration = (sizeA + sizeB) / 2.0f - glm::abs(delta);
 
-            // ҵС͸
+            // 找到最小穿透轴
             if (penetration.x < penetration.y && penetration.x < penetration.z) {
                 collision.normal = glm::vec3(delta.x > 0 ? 1.0f : -1.0f, 0.0f, 0.0f);
                 collision.penetration = penetration.x;
@@ -199,9 +213,9 @@ namespace Intro {
         float distance = glm::length(posB - posA);
         float minDistance = radiusA + radiusB;
 
-        // ޸Ӿ飬
+        // 修复：添加距离检查，避免除以零
         if (distance < 0.001f) {
-            // غϣʹĬϷ
+            // 球体重合，使用默认法线
             collision.normal = glm::vec3(0.0f, 1.0f, 0.0f);
             collision.penetration = minDistance;
             collision.point = posA;
@@ -226,7 +240,7 @@ namespace Intro {
         glm::vec3 spherePos = GetColliderWorldPosition(transformB, colliderB);
         float sphereRadius = GetColliderWorldRadius(transformB, colliderB);
 
-        // ҵAABBϾĵ
+        // 找到AABB上距离球心最近的点
         glm::vec3 closestPoint;
         closestPoint.x = std::max(boxPos.x - boxSize.x / 2.0f, std::min(spherePos.x, boxPos.x + boxSize.x / 2.0f));
         closestPoint.y = std::max(boxPos.y - boxSize.y / 2.0f, std::min(spherePos.y, boxPos.y + boxSize.y / 2.0f));
@@ -234,9 +248,9 @@ namespace Intro {
 
         float distance = glm::length(spherePos - closestPoint);
 
-        // ޸ֵȶ
+        // 修复：避免除以零和数值不稳定
         if (distance < 0.001f) {
-            // AABBڲʹôĵAABBĵķΪ
+            // 球心在AABB内部，使用从球心到AABB中心的方向作为法线
             glm::vec3 centerToSphere = spherePos - boxPos;
             if (glm::length(centerToSphere) < 0.001f) {
                 collision.normal = glm::vec3(0.0f, 1.0f, 0.0f);
@@ -262,23 +276,23 @@ namespace Intro {
     bool PhysicsSystem::CheckSphereAABBCollision(const Transform& transformA, const ColliderComponent& colliderA,
         const Transform& transformB, const ColliderComponent& colliderB,
         CollisionInfo& collision) {
-        // ABȻAABB-Sphere
+        // 交换A和B，然后调用AABB-Sphere检测
         bool result = CheckAABBSphereCollision(transformB, colliderB, transformA, colliderA, collision);
         if (result) {
-            // ײϢ
+            // 交换碰撞信息
             collision.normal = -collision.normal;
         }
         return result;
     }
 
     void PhysicsSystem::ResolveCollisions(ECS& ecs, float deltaTime) {
-        // 
+        // 处理触发器
         for (auto& trigger : s_TriggerPairs) {
             ITR_INFO("Trigger detected between {} and {}",
                 trigger.entityA.GetName(), trigger.entityB.GetName());
         }
 
-        // ײ - ޸ÿ֡ײ
+        // 处理碰撞 - 修复：限制每帧最大碰撞解决次数
         const int maxIterations = 4;
         for (int iteration = 0; iteration < maxIterations && !s_CollisionPairs.empty(); ++iteration) {
             for (auto& collision : s_CollisionPairs) {
@@ -292,14 +306,15 @@ namespace Intro {
             return;
         }
 
-        // Ƿи
+        // 检查是否都有刚体组件
         bool hasRbA = collision.entityA.HasComponent<RigidbodyComponent>();
         bool hasRbB = collision.entityB.HasComponent<RigidbodyComponent>();
 
         if (!hasRbA && !hasRbB) return;
 
-        auto& transformA = collision.entityA.GetComponent<TransformComponent>();
-        auto& transformB = collision.entityB.GetComponent<TransformComponent>();
+        // GetTransform 会标记 LocalToWorldComponent 需要重算
+        Transform& transformA = collision.entityA.GetTransform();
+        Transform& transformB = collision.entityB.GetTransform();
 
         RigidbodyComponent* rbA = nullptr;
         RigidbodyComponent* rbB = nullptr;
@@ -307,12 +322,12 @@ namespace Intro {
         if (hasRbA) rbA = &collision.entityA.GetComponent<RigidbodyComponent>();
         if (hasRbB) rbB = &collision.entityB.GetComponent<RigidbodyComponent>();
 
-        // ˶ѧ壬ײ
+        // 如果两个都是运动学刚体，不处理碰撞
         if ((rbA && rbA->isKinematic) && (rbB && rbB->isKinematic)) return;
 
-        // λֹ͸- ޸º͵λ
-        float correctionFactor = 0.2f; // ǿ
-        float slop = 0.01f; // ͸ݲ
+        // 位置修正（防止穿透）- 修复：更温和的位置修正
+        float correctionFactor = 0.2f; // 减少修正强度
+        float slop = 0.01f; // 穿透容差
 
         if (collision.penetration > slop) {
             float totalInverseMass = 0.0f;
@@ -322,16 +337,17 @@ namespace Intro {
             if (totalInverseMass > 0.0f) {
                 glm::vec3 correction = collision.normal * (collision.penetration - slop) * correctionFactor / totalInverseMass;
 
+                // 修正量在世界空间，换算成各自的局部位移
                 if (rbA && !rbA->isKinematic) {
-                    transformA.transform.position -= correction * (1.0f / rbA->mass);
+                    transformA.position -= WorldToLocalOffset(collision.entityA.GetEntity(), correction * (1.0f / rbA->mass));
                 }
                 if (rbB && !rbB->isKinematic) {
-                    transformB.transform.position += correction * (1.0f / rbB->mass);
+                    transformB.position += WorldToLocalOffset(collision.entityB.GetEntity(), correction * (1.0f / rbB->mass));
                 }
             }
         }
 
-        // ٶӦ - ޸صĳ
+        // 速度响应 - 修复：更保守的冲量计算
         if (rbA && rbB && !rbA->isKinematic && !rbB->isKinematic) {
             ApplyImpulse(*rbA, *rbB, collision);
         }
@@ -342,21 +358,21 @@ namespace Intro {
 
     void PhysicsSystem::ApplyImpulse(RigidbodyComponent& rbA, RigidbodyComponent& rbB,
         const CollisionInfo& collision) {
-        // ޸ȶĳ
+        // 修复：更稳定的冲量计算
         glm::vec3 relativeVelocity = rbB.velocity - rbA.velocity;
         float velocityAlongNormal = glm::dot(relativeVelocity, collision.normal);
 
-        // ڷ룬Ӧó
+        // 如果物体正在分离，不应用冲量
         if (velocityAlongNormal > 0) return;
 
-        // ޸Ƶϵȷ
-        float restitution = 0.2f; // ͵
+        // 修复：限制弹性系数，避免过度反弹
+        float restitution = 0.2f; // 降低弹性
 
         float j = -(1.0f + restitution) * velocityAlongNormal;
         j /= (1.0f / rbA.mass + 1.0f / rbB.mass);
 
-        // ޸ƳСٶȹ
-        float maxImpulse = 10.0f; // 
+        // 修复：限制冲量大小，避免速度过大
+        float maxImpulse = 10.0f; // 最大冲量
         j = std::min(j, maxImpulse);
 
         glm::vec3 impulse = j * collision.normal;
@@ -364,7 +380,7 @@ namespace Intro {
         rbA.velocity -= impulse / rbA.mass;
         rbB.velocity += impulse / rbB.mass;
 
-        // ޸ٶȣ
+        // 修复：限制最大速度，避免物体飞走
         float maxSpeed = 50.0f;
         if (glm::length(rbA.velocity) > maxSpeed) {
             rbA.velocity = glm::normalize(rbA.velocity) * maxSpeed;
@@ -380,19 +396,56 @@ namespace Intro {
         for (auto [entity, transform, rigidbody] : view.each()) {
             if (rigidbody.isKinematic) continue;
 
-            // λ
-            transform.transform.position += rigidbody.velocity * deltaTime;
-
-            // ޸򵥵ı߽飬ֹ
-            if (transform.transform.position.y < -100.0f) {
-                transform.transform.position.y = 10.0f;
+            // 更新位置：速度在世界空间，有父对象时换算成局部位移
+            glm::mat4 parentWorld;
+            const bool hasParent = GetParentWorldMatrix(entity, parentWorld);
+            glm::vec3 offset = rigidbody.velocity * deltaTime;
+            transform.transform.position += hasParent ? glm::inverse(glm::mat3(parentWorld)) * offset : offset;
+            ecs.MarkTransformDirty(entity);
+
+            // 修复：简单的边界检查，防止物体掉出世界
+            glm::vec3 worldPosition = hasParent ? glm::vec3(parentWorld * glm::vec4(transform.transform.position, 1.0f))
+                : transform.transform.position;
+            if (worldPosition.y < -100.0f) {
+                worldPosition.y = 10.0f;
+                transform.transform.position = hasParent ? glm::vec3(glm::inverse(parentWorld) * glm::vec4(worldPosition, 1.0f))
+                    : worldPosition;
                 rigidbody.velocity = glm::vec3(0.0f);
                 ITR_WARN("Object respawned due to falling out of world");
             }
         }
     }
 
-    // ߺʵ
+    // 工具函数实现
+    bool PhysicsSystem::GetParentWorldMatrix(entt::entity entity, glm::mat4& parentWorld) {
+        if (!s_Hierarchy) return false;
+
+        entt::entity parent = s_Hierarchy->GetParent(entity);
+        if (parent == entt::null) return false;
+
+        parentWorld = s_Hierarchy->ComputeWorldMatrix(parent);
+        return true;
+    }
+
+    Transform PhysicsSystem::GetWorldTransform(entt::entity entity, const Transform& local) {
+        glm::mat4 parentWorld;
+        if (!GetParentWorldMatrix(entity, parentWorld)) return local;
+
+        glm::vec3 scale, translation, skew;
+        glm::vec4 perspective;
+        glm::quat rotation;
+        if (!glm::decompose(parentWorld * local.GetModelMatrix(), scale, rotation, translation, skew, perspective)) {
+            return local;
+        }
+        return Transform(translation, glm::normalize(rotation), scale);
+    }
+
+    glm::vec3 PhysicsSystem::WorldToLocalOffset(entt::entity entity, const glm::vec3& worldOffset) {
+        glm::mat4 parentWorld;
+        if (!GetParentWorldMatrix(entity, parentWorld)) return worldOffset;
+        return glm::inverse(glm::mat3(parentWorld)) * worldOffset;
+    }
+
     glm::vec3 PhysicsSystem::GetColliderWorldPosition(const Transform& transform, const ColliderComponent& collider) {
         return transform.position + collider.offset;
     }
@@ -406,90 +459,37 @@ namespace Intro {
         return collider.radius * maxScale;
     }
 
-    // Ի
-    void PhysicsSystem::DebugDrawColliders(ECS& ecs, std::vector<glm::vec3>& lines) {
+    // 调试绘制
+    void PhysicsSystem::DebugDrawColliders(ECS& ecs, const glm::vec4& color) {
         if (!s_DebugDraw) return;
 
-        lines.clear();
-        auto view = ecs.GetRegistry().view<TransformComponent, ColliderComponent>();
+        auto view = ecs.GetRegistry().view<LocalToWorldComponent, ColliderComponent>();
 
-        for (auto [entity, transform, collider] : view.each()) {
+        for (auto [entity, localToWorld, collider] : view.each()) {
             if (!collider.enabled) continue;
-            GetColliderWireframe(transform.transform, collider, lines);
+            DrawColliderWireframe(localToWorld, collider, color);
         }
     }
 
-    void PhysicsSystem::GetColliderWireframe(const Transform& transform, const ColliderComponent& collider,
-        std::vector<glm::vec3>& lines) {
-        glm::vec3 worldPos = GetColliderWorldPosition(transform, collider);
+    // 碰撞体是轴对齐的，只需要缓存矩阵中的平移与各轴缩放（列向量长度）
+    void PhysicsSystem::DrawColliderWireframe(const LocalToWorldComponent& localToWorld, const ColliderComponent& collider,
+        const glm::vec4& color) {
+        const glm::mat4& m = localToWorld.matrix;
+        glm::vec3 worldPos = localToWorld.GetPosition() + collider.offset;
+        glm::vec3 scale(glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2])));
 
         switch (collider.type) {
-        case ColliderType::Box:
-            GetAABBWireframe(worldPos, transform, collider, lines);
+        case ColliderType::Box: {
+            glm::vec3 halfSize = collider.size * scale * 0.5f;
+            DebugDraw::Box(worldPos - halfSize, worldPos + halfSize, color);
             break;
+        }
         case ColliderType::Sphere:
-            GetSphereWireframe(worldPos, transform, collider, lines);
+            DebugDraw::Sphere(worldPos, collider.radius * std::max({ scale.x, scale.y, scale.z }), color);
             break;
         default:
             break;
         }
     }
 
-    void PhysicsSystem::GetAABBWireframe(const glm::vec3& center, const Transform& transform,
-        const ColliderComponent& collider, std::vector<glm::vec3>& lines) {
-        glm::vec3 size = GetColliderWorldSize(transform, collider);
-        glm::vec3 halfSize = size * 0.5f;
-
-        // 8
-        std::vector<glm::vec3> vertices = {
-            center + glm::vec3(-halfSize.x, -halfSize.y, -halfSize.z),
-            center + glm::vec3(halfSize.x, -halfSize.y, -halfSize.z),
-            center + glm::vec3(halfSize.x, -halfSize.y,  halfSize.z),
-            center + glm::vec3(-halfSize.x, -halfSize.y,  halfSize.z),
-            center + glm::vec3(-halfSize.x,  halfSize.y, -halfSize.z),
-            center + glm::vec3(halfSize.x,  halfSize.y, -halfSize.z),
-            center + glm::vec3(halfSize.x,  halfSize.y,  halfSize.z),
-            center + glm::vec3(-halfSize.x,  halfSize.y,  halfSize.z)
-        };
-
-        // 12
-        const std::vector<std::pair<int, int>> edges = {
-            {0,1}, {1,2}, {2,3}, {3,0}, // ײ
-            {4,5}, {5,6}, {6,7}, {7,4}, // 
-            {0,4}, {1,5}, {2,6}, {3,7}  // ֱ
-        };
-
-        for (const auto& edge : edges) {
-            lines.push_back(vertices[edge.first]);
-            lines.push_back(vertices[edge.second]);
-        }
-    }
-
-    void PhysicsSystem::GetSphereWireframe(const glm::vec3& center, const Transform& transform,
-        const ColliderComponent& collider, std::vector<glm::vec3>& lines) {
-        float radius = GetColliderWorldRadius(transform, collider);
-        const int segments = 16; // ϸֶ
-
-        // Բ
-        for (int i = 0; i < segments; ++i) {
-            float angle1 = (float)i / segments * 2.0f * glm::pi<float>();
-            float angle2 = (float)(i + 1) / segments * 2.0f * glm::pi<float>();
-
-            // XYƽ
-            glm::vec3 v1 = center + radius * glm::vec3(cos(angle1), sin(angle1), 0.0f);
-            glm::vec3 v2 = center + radius * glm::vec3(cos(angle2), sin(angle2), 0.0f);
-            lines.push_back(v1); lines.push_back(v2);
-
-            // XZƽ
-            v1 = center + radius * glm::vec3(cos(angle1), 0.0f, sin(angle1));
-            v2 = center + radius * glm::vec3(cos(angle2), 0.0f, sin(angle2));
-            lines.push_back(v1); lines.push_back(v2);
-
-            // YZƽ
-            v1 = center + radius * glm::vec3(0.0f, cos(angle1), sin(angle1));
-            v2 = center + radius * glm::vec3(0.0f, cos(angle2), sin(angle2));
-            lines.push_back(v1); lines.push_back(v2);
-        }
-    }
-
 } // namespace Intro
\ No newline at end of file
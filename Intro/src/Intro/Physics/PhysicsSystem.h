@@ -12,18 +12,20 @@
 namespace Intro
 {
 
-    // ײϢ
+    class TransformHierarchy;
+
+    // 碰撞信息
     struct CollisionInfo {
         GameObject entityA;
         GameObject entityB;
-        glm::vec3 point;           // ײ
-        glm::vec3 normal;          // ײ
-        float penetration;         // ͸
-        glm::vec3 relativeVelocity; // ٶ
-        bool isTrigger = false;    // ǷǴ
+        glm::vec3 point;           // 碰撞点
+        glm::vec3 normal;          // 碰撞法线
+        float penetration;         // 穿透深度
+        glm::vec3 relativeVelocity; // 相对速度
+        bool isTrigger = false;    // 是否是触发器
     };
 
-    // ߼
+    // 射线检测结果
     struct RaycastHit {
         GameObject entity;
         glm::vec3 point;
@@ -32,11 +34,11 @@ namespace Intro
         bool hit = false;
     };
 
-    // 
+    // 物理材质
     struct PhysicsMaterial {
-        float bounciness = 0.0f;              // ϵ [0,1]
-        float staticFriction = 0.5f;          // Ħϵ
-        float dynamicFriction = 0.3f;         // Ħϵ
+        float bounciness = 0.0f;              // 弹性系数 [0,1]
+        float staticFriction = 0.5f;          // 静摩擦系数
+        float dynamicFriction = 0.3f;         // 动摩擦系数
 
         PhysicsMaterial() = default;
         PhysicsMaterial(float bounce, float staticFric, float dynamicFric)
@@ -44,14 +46,14 @@ namespace Intro
         }
     };
      
-    // 
+    // 物理配置
     struct PhysicsConfig {
         glm::vec3 gravity = glm::vec3(0.0f, -9.81f, 0.0f);
-        float fixedTimeStep = 1.0f / 60.0f;   // ̶ʱ䲽
-        int maxSubSteps = 10;                 // Ӳ
-        bool enableSleeping = true;           // 
-        float sleepThreshold = 0.1f;          // ֵ
-        bool enableCCD = false;               // ײ
+        float fixedTimeStep = 1.0f / 60.0f;   // 固定时间步长
+        int maxSubSteps = 10;                 // 最大子步数
+        bool enableSleeping = true;           // 启用休眠
+        float sleepThreshold = 0.1f;          // 休眠阈值
+        bool enableCCD = false;               // 启用连续碰撞检测
     };
 
     class ITR_API PhysicsSystem {
@@ -59,11 +61,12 @@ namespace Intro
         static void Initialize(const PhysicsConfig& config = PhysicsConfig());
         static void Shutdown();
 
-        // º
+        // 主更新函数
         static void OnUpdate(ECS& ecs, float deltaTime);
-        static void OnUpdate(float deltaTime, ECS& ecs, bool isPlaying);
+        // hierarchy 不为空时，有父对象的碰撞体与刚体在世界空间中检测与积分，修正量换算回局部变换
+        static void OnUpdate(float deltaTime, ECS& ecs, bool isPlaying, const TransformHierarchy* hierarchy = nullptr);
 
-        // ߼
+        // 射线检测
         static bool Raycast(ECS& ecs, const glm::vec3& origin,
             const glm::vec3& direction, float maxDistance,
             RaycastHit& hitInfo, uint32_t layerMask = 0xFFFFFFFF);
@@ -72,52 +75,56 @@ namespace Intro
             const glm::vec3& direction, float maxDistance,
             RaycastHit& hitInfo, uint32_t layerMask = 0xFFFFFFFF);
 
-        // ѯ
+        // 体积查询
         static std::vector<GameObject> OverlapSphere(ECS& ecs, const glm::vec3& center,
             float radius, uint32_t layerMask = 0xFFFFFFFF);
         static std::vector<GameObject> OverlapBox(ECS& ecs, const glm::vec3& center,
             const glm::vec3& halfExtents, uint32_t layerMask = 0xFFFFFFFF);
 
-        // 
-        // ģʽö
+        // 力操作
+        // 力模式枚举
         enum class ForceMode {
-            Force,      //  ()
-            Impulse,    //  ()
-            Velocity,   // ֱӸıٶ (޹)
-            Acceleration // ֱӸıٶ (޹)
+            Force,      // 持续力 (质量相关)
+            Impulse,    // 冲量 (质量相关)
+            Velocity,   // 直接改变速度 (质量无关)
+            Acceleration // 直接改变加速度 (质量无关)
         };
         static void AddForce(GameObject entity, const glm::vec3& force, ForceMode mode = ForceMode::Force);
         static void AddForceAtPosition(GameObject entity, const glm::vec3& force,
             const glm::vec3& position, ForceMode mode = ForceMode::Force);
         static void AddTorque(GameObject entity, const glm::vec3& torque, ForceMode mode = ForceMode::Force);
 
-        // ٶȲ
+        // 速度操作
         static void SetVelocity(GameObject entity, const glm::vec3& velocity);
         static void SetAngularVelocity(GameObject entity, const glm::vec3& angularVelocity);
         static glm::vec3 GetVelocity(GameObject entity);
         static glm::vec3 GetAngularVelocity(GameObject entity);
 
-        // Ի
-        static void DebugDrawColliders(ECS& ecs, std::vector<glm::vec3>& lines);
+        // 调试绘制（提交到 DebugDraw，随调试线通道一起绘制）
+        static void DebugDrawColliders(ECS& ecs, const glm::vec4& color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
         static void SetDebugDraw(bool enable) { s_DebugDraw = enable; }
 
-        // 
+        // 配置
         static void SetConfig(const PhysicsConfig& config) { s_Config = config; }
         static const PhysicsConfig& GetConfig() { return s_Config; }
 
 
     private:
-        // ڲ״̬
+        // 力积分每个并行块的最小刚体数
+        static constexpr uint32_t ForceBatchSize = 256;
+
+        // 内部状态
         static PhysicsConfig s_Config;
         static float s_AccumulatedTime;
         static bool s_Initialized;
         static bool s_DebugDraw;
+        static const TransformHierarchy* s_Hierarchy;   // 只在 OnUpdate 期间有效
 
-        // ײԻ
+        // 碰撞对缓存
         static std::vector<CollisionInfo> s_CollisionPairs;
         static std::vector<CollisionInfo> s_TriggerPairs;
 
-        // ڲ²
+        // 内部更新步骤
         static void FixedUpdate(ECS& ecs, float fixedDeltaTime);
         static void IntegrateForces(ECS& ecs, float deltaTime);
         static void DetectCollisions(ECS& ecs);
@@ -125,7 +132,7 @@ namespace Intro
         static void IntegrateVelocities(ECS& ecs, float deltaTime);
         static void UpdateSleepState(ECS& ecs, float deltaTime);
 
-        // ײⷽ
+        // 碰撞检测方法
         static bool CheckCollision(const Transform& transformA, const ColliderComponent& colliderA,
             const Transform& transformB, const ColliderComponent& colliderB,
             CollisionInfo& collision);
@@ -151,36 +158,36 @@ namespace Intro
             const PhysicsMaterial& materialB);
 
 
-        // ײ
+        // 连续碰撞检测
         static bool CheckCCD(const Transform& transformA, const RigidbodyComponent& rbA, const ColliderComponent& colliderA,
             const Transform& transformB, const RigidbodyComponent& rbB, const ColliderComponent& colliderB,
             CollisionInfo& collision, float deltaTime);
 
-        // ײӦ
+        // 碰撞响应
         static void ResolveCollision(CollisionInfo& collision, float deltaTime);
         static void ApplyImpulse(RigidbodyComponent& rbA, RigidbodyComponent& rbB,
             const CollisionInfo& collision);
 
-        // ߺ
+        // 工具函数
         static glm::vec3 GetColliderWorldPosition(const Transform& transform, const ColliderComponent& collider);
         static glm::vec3 GetColliderWorldSize(const Transform& transform, const ColliderComponent& collider);
         static float GetColliderWorldRadius(const Transform& transform, const ColliderComponent& collider);
 
+        // TransformComponent 保存的是相对父对象的局部变换：根对象返回 false，否则给出父对象的世界矩阵
+        static bool GetParentWorldMatrix(entt::entity entity, glm::mat4& parentWorld);
+        static Transform GetWorldTransform(entt::entity entity, const Transform& local);
+        // 世界空间的位移换算成局部位移
+        static glm::vec3 WorldToLocalOffset(entt::entity entity, const glm::vec3& worldOffset);
+
         static PhysicsMaterial GetPhysicsMaterial(const ColliderComponent& collider);
         static float CombineFriction(float frictionA, float frictionB);
         static float CombineBounciness(float bouncinessA, float bouncinessB);
 
-        // ԻƸ
-        static void GetColliderWireframe(const Transform& transform, const ColliderComponent& collider,
-            std::vector<glm::vec3>& lines);
-        static void GetAABBWireframe(const glm::vec3& center, const Transform& transform,
-            const ColliderComponent& collider, std::vector<glm::vec3>& lines);
-        static void GetSphereWireframe(const glm::vec3& center, const Transform& transform,
-            const ColliderComponent& collider, std::vector<glm::vec3>& lines);
-        static void GetCapsuleWireframe(const glm::vec3& center, const Transform& transform,
-            const ColliderComponent& collider, std::vector<glm::vec3>& lines);
-
-        // ߼⸨
+        // 调试绘制辅助
+        static void DrawColliderWireframe(const LocalToWorldComponent& localToWorld, const ColliderComponent& collider,
+            const glm::vec4& color);
+
+        // 射线检测辅助
         static bool RaycastAABB(const glm::vec3& origin, const glm::vec3& direction,
             const glm::vec3& center, const glm::vec3& halfExtents,
             float& distance);
@@ -11,16 +11,16 @@ namespace Intro {
         return instance;
     }
 
-    // 滻 ResourceManager::ScanAssetsDirectory ʵ
+    // 替换 ResourceManager::ScanAssetsDirectory 的实现
     void ResourceManager::ScanAssetsDirectory(const std::string& rootPath) {
-        // ־¼
+        // 调试日志：记录调用输入
         ITR_INFO("ScanAssetsDirectory called with rootPath='{}'", rootPath);
 
         if (!rootPath.empty()) {
             m_AssetsRoot = rootPath;
         }
 
-        // ·ӡ㶨λ
+        // 解析绝对路径并打印（方便定位）
         std::filesystem::path assetsPath(m_AssetsRoot);
         auto absAssetsPath = std::filesystem::absolute(assetsPath);
         bool exists = std::filesystem::exists(absAssetsPath);
@@ -28,7 +28,7 @@ namespace Intro {
         ITR_INFO("ResourceManager: m_AssetsRoot='{}', absolute='{}', exists={}",
             m_AssetsRoot, absAssetsPath.string(), exists ? "true" : "false");
 
-        // һɨ·뱾ͬظǣ
+        // 如果上一次扫描的路径与本次相同，则跳过（避免重复覆盖）
         if (!m_LastScannedPath.empty()) {
             std::filesystem::path last(m_LastScannedPath);
             if (std::filesystem::equivalent(last, absAssetsPath)) {
@@ -37,7 +37,7 @@ namespace Intro {
             }
         }
 
-        // Ŀ¼ڣ¼沢ǲҪ
+        // 如果目录不存在，记录警告并创建（但是不要继续构建空树）
         if (!exists) {
             ITR_WARN("Assets directory does not exist: {} -- creating directories", absAssetsPath.string());
             std::error_code ec;
@@ -45,22 +45,22 @@ namespace Intro {
             if (ec) {
                 ITR_ERROR("Failed to create assets directory '{}': {}", absAssetsPath.string(), ec.message());
             }
-            //  last scanned to avoid immediate duplicate build attempts
+            // 更新 last scanned to avoid immediate duplicate build attempts
             m_LastScannedPath = absAssetsPath.string();
             return;
         }
 
-        // ڵ㣨 path ¼Ϊ·ַ
+        // 构建根节点（把 path 记录为绝对路径字符串）
         m_FileTreeRoot = std::make_shared<ResourceFileNode>(
             ResourceFileInfo{ "Assets", absAssetsPath.string(), ResourceType::Directory, "", 0, 0, true }
         );
 
-        // 
+        // 遍历构建子树
         BuildFileTree(absAssetsPath, m_FileTreeRoot);
 
         ITR_INFO("File tree built with {} root items (path='{}')", m_FileTreeRoot->children.size(), absAssetsPath.string());
 
-        // ¼ɨ·
+        // 记录最后扫描路径
         m_LastScannedPath = absAssetsPath.string();
 
         if (m_FileTreeUpdatedCallback) {
@@ -81,7 +81,7 @@ namespace Intro {
                 auto fileInfo = CreateFileInfo(entry.path());
                 auto node = std::make_shared<ResourceFileNode>(fileInfo);
 
-                // ֱøڵ㣬ʹ AddChild
+                // 直接设置父节点，不使用 AddChild
                 node->parent = parentNode;
                 parentNode->children.push_back(node);
 
@@ -137,11 +137,11 @@ namespace Intro {
         if (!info.isDirectory) {
             try {
                 info.fileSize = std::filesystem::file_size(path);
-                // 򻯣ļʱ
+                // 简化：不处理文件时间
                 info.lastModified = 0;
             }
             catch (...) {
-                // Դ
+                // 忽略错误
             }
         }
 
@@ -171,7 +171,7 @@ namespace Intro {
         return texture;
     }
 
-    // ԭеļݷ
+    // 原有的兼容方法
     std::shared_ptr<Model> ResourceManager::LoadModel(const std::string& path) {
         std::string fullPath = ResolveAssetPath(path);
 
@@ -245,7 +245,7 @@ namespace Intro {
         }
     }
 
-    // ԭз
+    // 其他原有方法
     std::string ResourceManager::ResolveAssetPath(const std::string& relativePath) const {
         std::filesystem::path path(relativePath);
         if (path.is_absolute()) return relativePath;
@@ -310,7 +310,7 @@ namespace Intro {
         return (it != m_Materials.end()) ? it->second : nullptr;
     }
 
-    // 
+    // 清理方法
     void ResourceManager::UnloadAllModels() { m_Models.clear(); }
     void ResourceManager::UnloadAllTextures() { m_Textures.clear(); }
     void ResourceManager::UnloadAllShaders() { m_Shaders.clear(); }
@@ -325,7 +325,7 @@ namespace Intro {
     }
 
     void ResourceManager::ClearUnusedResources() {
-        // ʵ֣δʹõԴ
+        // 简单实现：清除所有未使用的资源
         size_t modelsCleared = 0, texturesCleared = 0;
 
         for (auto it = m_Models.begin(); it != m_Models.end(); ) {
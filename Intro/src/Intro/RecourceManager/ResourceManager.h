@@ -20,67 +20,67 @@ namespace Intro {
     public:
         static ResourceManager& Get();
 
-        // ÿƶ
+        // 禁用拷贝和移动
         ResourceManager(const ResourceManager&) = delete;
         ResourceManager& operator=(const ResourceManager&) = delete;
         ResourceManager(ResourceManager&&) = delete;
         ResourceManager& operator=(ResourceManager&&) = delete;
 
-        // ʼ/ر
+        // 初始化/关闭
         void Initialize();
         void Shutdown();
 
-        // ļ
+        // 文件树管理
         void ScanAssetsDirectory(const std::string& rootPath = "");
         std::shared_ptr<ResourceFileNode> GetFileTree() const { return m_FileTreeRoot; }
         void RefreshFileTree();
 
-        // ͨļڵȡԴ
+        // 通过文件树节点获取资源
         std::shared_ptr<Model> LoadModelFromNode(std::shared_ptr<ResourceFileNode> node);
         std::shared_ptr<Texture> LoadTextureFromNode(std::shared_ptr<ResourceFileNode> node);
 
-        // ͳ·ʽּݣ
+        // 传统路径方式（保持兼容）
         std::shared_ptr<Model> LoadModel(const std::string& path);
         std::shared_ptr<Texture> LoadTexture(const std::string& path);
         std::shared_ptr<Shader> LoadShader(const std::string& name,
             const std::string& vertexPath,
             const std::string& fragmentPath);
 
-        // ȡԴ
+        // 获取资源
         std::shared_ptr<Model> GetModel(const std::string& path);
         std::shared_ptr<Texture> GetTexture(const std::string& path);
         std::shared_ptr<Shader> GetShader(const std::string& name);
 
-        // ʹ
+        // 材质管理
         std::shared_ptr<Material> CreateMaterial(const std::string& name,
             std::shared_ptr<Shader> shader);
         std::shared_ptr<Material> GetMaterial(const std::string& name);
 
-        // ĬԴ
+        // 默认资源
         std::shared_ptr<Shader> GetDefaultShader() const { return m_DefaultShader; }
         std::shared_ptr<Material> GetDefaultMaterial() const { return m_DefaultMaterial; }
 
-        // Դͳƺ
+        // 资源统计和清理
         void PrintResourceStats() const;
         void ClearUnusedResources();
 
-        // ·
+        // 路径工具
         void SetAssetsRoot(const std::string& path) { m_AssetsRoot = path; }
         std::string ResolveAssetPath(const std::string& relativePath) const;
 
-        // 
+        // 清理方法
         void UnloadAllModels();
         void UnloadAllTextures();
         void UnloadAllShaders();
         void RemoveAllMaterials();
 
-        // ¼ص
+        // 事件回调
         using FileTreeUpdatedCallback = std::function<void()>;
         void SetFileTreeUpdatedCallback(FileTreeUpdatedCallback callback) {
             m_FileTreeUpdatedCallback = callback;
         }
 
-        // ͳϢ
+        // 统计信息
         size_t GetModelCount() const { return m_Models.size(); }
         size_t GetTextureCount() const { return m_Textures.size(); }
         size_t GetShaderCount() const { return m_Shaders.size(); }
@@ -90,30 +90,30 @@ namespace Intro {
         ResourceManager() = default;
         ~ResourceManager() = default;
 
-        // ļ
+        // 文件树构建
         void BuildFileTree(const std::filesystem::path& currentPath,
             std::shared_ptr<ResourceFileNode> parentNode);
         ResourceType DetermineResourceType(const std::filesystem::path& path);
         ResourceFileInfo CreateFileInfo(const std::filesystem::path& path);
 
-        // ĬԴʼ
+        // 默认资源初始化
         void CreateDefaultResources();
 
-        // Դ洢
+        // 资源存储
         std::unordered_map<std::string, std::shared_ptr<Model>> m_Models;
         std::unordered_map<std::string, std::shared_ptr<Texture>> m_Textures;
         std::unordered_map<std::string, std::shared_ptr<Shader>> m_Shaders;
         std::unordered_map<std::string, std::shared_ptr<Material>> m_Materials;
 
-        // ļ
+        // 文件树
         std::shared_ptr<ResourceFileNode> m_FileTreeRoot;
         std::string m_AssetsRoot = "E:/MyEngine/Intro//Intro/src/Intro/assets/";
 
-        // ĬԴ
+        // 默认资源
         std::shared_ptr<Shader> m_DefaultShader;
         std::shared_ptr<Material> m_DefaultMaterial;
 
-        // ص
+        // 回调
         FileTreeUpdatedCallback m_FileTreeUpdatedCallback;
 
         bool m_Initialized = false;
@@ -8,7 +8,7 @@ namespace Intro {
     }
 
     void ShaderLibrary::Add(const std::shared_ptr<Shader>& shader) {
-        auto& name = "UnnamedShader"; // Դɫļȡ
+        auto& name = "UnnamedShader"; // 可以从着色器文件中提取名称
         Add(name, shader);
     }
 
@@ -35,7 +35,7 @@ namespace Intro {
 
     void ShaderLibrary::ReloadAll() {
         for (auto& [name, shader] : m_Shaders) {
-            // ʵɫ
+            // 这里可以实现着色器的热重载
             ITR_INFO("Reloading shader: {}", name);
         }
     }
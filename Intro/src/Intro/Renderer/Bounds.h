@@ -0,0 +1,70 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace Intro {
+
+	// 轴对齐包围盒（局部空间或世界空间）
+	struct BoundingBox
+	{
+		glm::vec3 min = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest());
+
+		bool IsValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+		void Expand(const glm::vec3& point)
+		{
+			min = glm::min(min, point);
+			max = glm::max(max, point);
+		}
+
+		void Merge(const BoundingBox& other)
+		{
+			if (!other.IsValid()) return;
+			min = glm::min(min, other.min);
+			max = glm::max(max, other.max);
+		}
+
+		glm::vec3 GetCenter() const { return (min + max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+		// 变换到另一个空间后的包围盒（Arvo 方法：中心点变换 + 半长按 |M| 投影）
+		BoundingBox Transformed(const glm::mat4& m) const
+		{
+			glm::vec3 center = glm::vec3(m * glm::vec4(GetCenter(), 1.0f));
+			glm::vec3 extents = GetExtents();
+			glm::vec3 newExtents(
+				std::abs(m[0][0]) * extents.x + std::abs(m[1][0]) * extents.y + std::abs(m[2][0]) * extents.z,
+				std::abs(m[0][1]) * extents.x + std::abs(m[1][1]) * extents.y + std::abs(m[2][1]) * extents.z,
+				std::abs(m[0][2]) * extents.x + std::abs(m[1][2]) * extents.y + std::abs(m[2][2]) * extents.z);
+
+			BoundingBox result;
+			result.min = center - newExtents;
+			result.max = center + newExtents;
+			return result;
+		}
+	};
+
+	// 包围球
+	struct BoundingSphere
+	{
+		glm::vec3 center = glm::vec3(0.0f);
+		float radius = 0.0f;
+
+		// 变换后的包围球（半径按最大轴缩放）
+		BoundingSphere Transformed(const glm::mat4& m) const
+		{
+			float sx = glm::dot(glm::vec3(m[0]), glm::vec3(m[0]));
+			float sy = glm::dot(glm::vec3(m[1]), glm::vec3(m[1]));
+			float sz = glm::dot(glm::vec3(m[2]), glm::vec3(m[2]));
+
+			BoundingSphere result;
+			result.center = glm::vec3(m * glm::vec4(center, 1.0f));
+			result.radius = radius * std::sqrt(std::max(sx, std::max(sy, sz)));
+			return result;
+		}
+	};
+
+}
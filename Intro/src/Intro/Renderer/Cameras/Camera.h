@@ -4,9 +4,16 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include "Intro/Log.h"
 #include "Intro/Window.h"
+#include <cstdint>
 
 namespace Intro {
 
+    // 透明物体的绘制方式
+    enum class TransparencyMode : uint8_t {
+        Sorted = 0,         // 每帧由远到近排序后逐个混合
+        WeightedBlended     // 加权混合 OIT：不排序，累积后合成一次（近似，相交物体也不会出错）
+    };
+
     class ITR_API Camera
     {
     public:
@@ -14,11 +21,11 @@ namespace Intro {
         Camera(const Window& window) { SetAspectRatio((float)window.GetWidth() / (float)window.GetHeight()); }
         virtual ~Camera() = default;
 
-        // ӿڣʵ֣
+        // 矩阵接口（派生类必须实现）
         virtual glm::mat4 GetViewMat() const = 0;
         virtual glm::vec3 GetPosition() const = 0;
         virtual glm::quat GetRotation() const = 0;
-        // Fov  Camera ڲ  (radians) 洢ֱʹ FovҪٵ glm::radians
+        // Fov 在 Camera 内部以 弧度 (radians) 存储，因此直接使用 Fov（不要再调用 glm::radians）
         virtual glm::mat4 GetProjectionMat() const {
             return glm::perspective(Fov, AspectRatio, NearClip, FarClip);
         }
@@ -32,10 +39,10 @@ namespace Intro {
 
         virtual void OnUpdate(float deltaTime) = 0;
 
-        // 
+        // 常用设置
         float GetAspectRatio() { return AspectRatio; }
 
-        // ע⣺SetFov ֱڲ FovλΪ ȣ
+        // 注意：SetFov 直接设置内部 Fov（单位为 弧度）
         void SetFov(float f) { Fov = f; }
 
         void SetAspectRatio(float ar) {
@@ -58,13 +65,17 @@ namespace Intro {
             FarClip = farClip;
         }
 
+        TransparencyMode GetTransparencyMode() const { return m_TransparencyMode; }
+        void SetTransparencyMode(TransparencyMode mode) { m_TransparencyMode = mode; }
+
         float AspectRatio = 16.0f / 9.0f;
     protected:
-        // ͨò
-        // 洢λȣradians
+        // 通用参数
+        // 存储单位：弧度（radians）
         float Fov = glm::radians(45.0f);
         float NearClip = 0.1f;
         float FarClip = 1000.0f;
+        TransparencyMode m_TransparencyMode = TransparencyMode::Sorted;
     };
 
 } // namespace Intro
@@ -22,7 +22,7 @@ namespace Intro {
         glm::vec3 target = Position + m_Front;
         glm::mat4 view = glm::lookAt(Position, target, m_WorldUp);
 
-        // Ϣ
+        // 调试信息
 
         return view;
     }
@@ -35,13 +35,13 @@ namespace Intro {
     {
         Application& app = Application::Get();
 
-        // --- ӽǿ ---
+        // --- 鼠标视角控制 ---
         bool mouseButtonDown = Input::IsMouseButtonPressed(ITR_MOUSE_BUTTON_1);
         bool allowMouseControl = mouseButtonDown && app.IsViewportHovered() && !app.IsUsingGizmo();
 
         if (allowMouseControl)
         {
-            // ԭе߼
+            // 原有的鼠标控制逻辑
             float currentX = Input::GetMouseX();
             float currentY = Input::GetMouseY();
 
@@ -75,7 +75,7 @@ namespace Intro {
             m_LastMouseY = Input::GetMouseY();
         }
 
-        // --- ƶ ---
+        // --- 键盘移动 ---
         bool allowKeyboardControl = app.IsViewportFocused() && !app.IsUsingGizmo();
 
         if (allowKeyboardControl)
@@ -102,7 +102,7 @@ namespace Intro {
         m_Front = glm::normalize(front);
 
         m_Right = glm::normalize(glm::cross(m_Front, m_WorldUp));
-        // m_WorldUp ֲ
+        // m_WorldUp 保持不变
     }
 
     void FreeCamera::SetPerspective(float radins, float aspectRatio, float nearClip, float farClip)
@@ -115,13 +115,13 @@ namespace Intro {
 
     glm::quat FreeCamera::GetRotation() const
     {
-        // ȡͼתת棨
+        // 获取视图矩阵，其旋转部分是相机旋转的逆（正交矩阵）
         glm::mat4 viewMatrix = GetViewMat();
-        // ȡͼת֣3x3
+        // 提取视图矩阵的旋转部分（3x3矩阵）
         glm::mat3 rotationMatrix = glm::mat3(viewMatrix);
-        // תãתúõʵʵת
+        // 正交矩阵的逆等于转置，转置后得到相机实际的旋转矩阵
         rotationMatrix = glm::transpose(rotationMatrix);
-        // תתΪԪ
+        // 将旋转矩阵转换为四元数
         return glm::quat(rotationMatrix);
     }
 
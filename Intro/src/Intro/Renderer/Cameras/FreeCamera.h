@@ -29,19 +29,19 @@ namespace Intro {
         {
             glm::vec3 forward = rotation * glm::vec3(0.0f, 0.0f, -1.0f);
 
-            //  forward  yaw / pitch
+            // 从 forward 向量反推 yaw / pitch
             m_Yaw = glm::degrees(atan2(forward.z, forward.x)) - 90.0f;
             m_Pitch = glm::degrees(asin(forward.y));
 
-            //  pitch  gimbal lock
+            // 限制 pitch 避免 gimbal lock
             if (m_Pitch > 89.0f) m_Pitch = 89.0f;
             if (m_Pitch < -89.0f) m_Pitch = -89.0f;
 
-            //  forward  yaw / pitch
+            // 从 forward 向量反推 yaw / pitch
             m_Yaw = glm::degrees(atan2(forward.z, forward.x)) - 90.0f;
             m_Pitch = glm::degrees(asin(forward.y));
 
-            //  pitch  gimbal lock
+            // 限制 pitch 避免 gimbal lock
             if (m_Pitch > 89.0f) m_Pitch = 89.0f;
             if (m_Pitch < -89.0f) m_Pitch = -89.0f;
             UpdateCameraVectors();
@@ -5,11 +5,11 @@
 
 namespace Intro {
 
-    // Frustum.cpp - ޸ UpdateFromMatrix еĽǵ㲿
+    // Frustum.cpp - 修改 UpdateFromMatrix 函数中的角点部分
     void Frustum::UpdateFromMatrix(const glm::mat4& viewProjectionMatrix) {
         glm::mat4 matrix = glm::transpose(viewProjectionMatrix);
 
-        // ȡƽ棨ֲ䣩
+        // 提取平面（保持不变）
         m_Planes[Plane_Left] = matrix[3] + matrix[0];
         m_Planes[Plane_Right] = matrix[3] - matrix[0];
         m_Planes[Plane_Bottom] = matrix[3] + matrix[1];
@@ -17,32 +17,32 @@ namespace Intro {
         m_Planes[Plane_Near] = matrix[3] + matrix[2];
         m_Planes[Plane_Far] = matrix[3] - matrix[2];
 
-        // һƽ
+        // 归一化平面
         for (auto& plane : m_Planes) {
             NormalizePlane(plane);
         }
 
-        // ʹȷNDC꣨OpenGL׼zΧ[-1,1]
+        // 修正：使用正确的NDC坐标（OpenGL标准：z范围[-1,1]）
         std::array<glm::vec4, Corner_Count> ndcCorners = {
-            // ƽ (z = -1)
-            glm::vec4(-1.0f, -1.0f, -1.0f, 1.0f),  // ½
-            glm::vec4(1.0f, -1.0f, -1.0f, 1.0f),  // ½  
-            glm::vec4(-1.0f,  1.0f, -1.0f, 1.0f),  // Ͻ
-            glm::vec4(1.0f,  1.0f, -1.0f, 1.0f),  // Ͻ
-            // Զƽ (z = 1)
-            glm::vec4(-1.0f, -1.0f, 1.0f, 1.0f),   // Զ
-            glm::vec4(1.0f, -1.0f, 1.0f, 1.0f),   // Զ
-            glm::vec4(-1.0f,  1.0f, 1.0f, 1.0f),   // Զ
-            glm::vec4(1.0f,  1.0f, 1.0f, 1.0f)    // Զ
+            // 近平面 (z = -1)
+            glm::vec4(-1.0f, -1.0f, -1.0f, 1.0f),  // 左下近
+            glm::vec4(1.0f, -1.0f, -1.0f, 1.0f),  // 右下近  
+            glm::vec4(-1.0f,  1.0f, -1.0f, 1.0f),  // 左上近
+            glm::vec4(1.0f,  1.0f, -1.0f, 1.0f),  // 右上近
+            // 远平面 (z = 1)
+            glm::vec4(-1.0f, -1.0f, 1.0f, 1.0f),   // 左下远
+            glm::vec4(1.0f, -1.0f, 1.0f, 1.0f),   // 右下远
+            glm::vec4(-1.0f,  1.0f, 1.0f, 1.0f),   // 左上远
+            glm::vec4(1.0f,  1.0f, 1.0f, 1.0f)    // 右上远
         };
 
-        // 任ռ
+        // 变换到世界空间
         glm::mat4 inverseMatrix = glm::inverse(viewProjectionMatrix);
 
         for (size_t i = 0; i < Corner_Count; ++i) {
             glm::vec4 worldCorner = inverseMatrix * ndcCorners[i];
 
-            // ȷȷ͸ӳ
+            // 确保正确的透视除法
             if (std::abs(worldCorner.w) > 1e-6f) {
                 m_Corners[i] = glm::vec3(worldCorner) / worldCorner.w;
             }
@@ -79,4 +79,18 @@ namespace Intro {
         return true;
     }
 
+    bool Frustum::IntersectsAABB(const glm::vec3& min, const glm::vec3& max) const {
+        for (const auto& plane : m_Planes) {
+            // 取沿平面法线方向最远的顶点（正顶点），若它都在平面外则整个盒子在外
+            glm::vec3 positive(
+                plane.x >= 0.0f ? max.x : min.x,
+                plane.y >= 0.0f ? max.y : min.y,
+                plane.z >= 0.0f ? max.z : min.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 } // namespace Intro
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace Intro {
 
     class ITR_API Frustum {
     public:
-        // ޸öٶ壬ͻ
+        // 修改枚举定义，避免命名冲突
         enum PlaneEnum {
             Plane_Near = 0,
             Plane_Far,
@@ -33,19 +33,22 @@ namespace Intro {
 
         Frustum() = default;
 
-        // ͼͶӰ׶
+        // 从视图投影矩阵更新视锥体
         void UpdateFromMatrix(const glm::mat4& viewProjectionMatrix);
 
-        // Ƿ׶
+        // 检查点是否在视锥体内
         bool ContainsPoint(const glm::vec3& point) const;
 
-        // Ƿ׶
+        // 检查球体是否在视锥体内
         bool ContainsSphere(const glm::vec3& center, float radius) const;
 
-        // ȡ׶8ǵ
+        // 检查世界空间 AABB 是否与视锥体相交（保守测试，可能误判为可见）
+        bool IntersectsAABB(const glm::vec3& min, const glm::vec3& max) const;
+
+        // 获取视锥体的8个角点
         const std::array<glm::vec3, Corner_Count>& GetCorners() const { return m_Corners; }
 
-        // ȡ׶ƽ
+        // 获取视锥体平面
         const std::array<glm::vec4, Plane_Count>& GetPlanes() const { return m_Planes; }
 
     private:
@@ -4,7 +4,7 @@
 #include "Intro/Input.h"
 #include "Intro/MouseButtonCodes.h"
 #include "Intro/KeyCodes.h"
-#include "Intro/Application.h" // ڴ״̬ж
+#include "Intro/Application.h" // 新增：用于窗口状态判断
 
 namespace Intro {
 
@@ -12,7 +12,7 @@ namespace Intro {
         : Camera(window)
     {
         Distance = glm::length(Position - Target);
-        // ݳʼλüʼǶȣοFreeCameraĽǶȳʼ
+        // 新增：根据初始位置计算初始角度（参考FreeCamera的角度初始化）
         glm::vec3 direction = glm::normalize(Position - Target);
         m_Pitch = glm::degrees(glm::asin(direction.y));
         m_Yaw = glm::degrees(glm::atan(direction.z, direction.x));
@@ -28,9 +28,9 @@ namespace Intro {
 
     void OrbitCamera::OnUpdate(float deltaTime)
     {
-        Application& app = Application::Get(); // ȡӦʵ
+        Application& app = Application::Get(); // 新增：获取应用实例
 
-        // תƣοFreeCameraĽ
+        // 鼠标旋转控制（参考FreeCamera的交互条件）
         bool mouseButtonDown = Input::IsMouseButtonPressed(ITR_MOUSE_BUTTON_1);
         bool allowMouseControl = mouseButtonDown && app.IsViewportHovered() && !app.IsUsingGizmo();
 
@@ -46,7 +46,7 @@ namespace Intro {
             }
 
             float xoffset = currentX - m_LastMouseX;
-            float yoffset = m_LastMouseY - currentY; // YᷴתFreeCameraһ£
+            float yoffset = m_LastMouseY - currentY; // Y轴反转（和FreeCamera一致）
 
             m_LastMouseX = currentX;
             m_LastMouseY = currentY;
@@ -55,32 +55,32 @@ namespace Intro {
         }
         else
         {
-            // ״̬οFreeCamera
+            // 重置鼠标状态（参考FreeCamera）
             m_FirstMouse = true;
             m_LastMouseX = Input::GetMouseX();
             m_LastMouseY = Input::GetMouseY();
         }
 
-        // ̿ƣοFreeCameraļ̽߼
+        // 新增：键盘控制（参考FreeCamera的键盘交互逻辑）
         bool allowKeyboardControl = app.IsViewportFocused() && !app.IsUsingGizmo();
         if (allowKeyboardControl)
         {
             float zoomVelocity = m_ZoomSpeed * deltaTime;
             float targetVelocity = m_TargetMovementSpeed * deltaTime;
 
-            // Shift٣FreeCameraһ£
+            // 左Shift加速（和FreeCamera一致）
             if (Input::IsKeyPressed(ITR_KEY_LEFT_SHIFT)) {
                 zoomVelocity *= 2.0f;
                 targetVelocity *= 2.0f;
             }
 
-            // ſƣW/S룩
+            // 缩放控制（W/S调整距离）
             if (Input::IsKeyPressed(ITR_KEY_W))
                 SetDistance(Distance - zoomVelocity);
             if (Input::IsKeyPressed(ITR_KEY_S))
                 SetDistance(Distance + zoomVelocity);
 
-            // ĿƶƣοFreeCameraWASDQE߼
+            // 目标移动控制（参考FreeCamera的WASDQE逻辑）
             glm::vec3 forward = glm::normalize(Target - Position);
             glm::vec3 right = glm::normalize(glm::cross(forward, Up));
 
@@ -104,24 +104,24 @@ namespace Intro {
         xoffset *= m_MouseSensitivity;
         yoffset *= m_MouseSensitivity;
 
-        // ½ǶȣοFreeCameraĽǶȼ㣩
+        // 更新角度（参考FreeCamera的角度计算）
         m_Yaw += xoffset;
         m_Pitch += yoffset;
 
-        // ƸǣⷭתFreeCameraһ£
+        // 限制俯仰角（避免翻转，和FreeCamera一致）
         if (m_Pitch > 89.0f)
             m_Pitch = 89.0f;
         if (m_Pitch < -89.0f)
             m_Pitch = -89.0f;
 
-        // ݽǶȼλãοFreeCamera߼
+        // 根据角度计算相机位置（参考FreeCamera的向量更新逻辑）
         glm::vec3 direction;
         direction.x = cos(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch));
         direction.y = sin(glm::radians(m_Pitch));
         direction.z = sin(glm::radians(m_Yaw)) * cos(glm::radians(m_Pitch));
         direction = glm::normalize(direction);
 
-        Position = Target + direction * Distance; // ΧĿת
+        Position = Target + direction * Distance; // 围绕目标旋转
     }
 
 } // namespace Intro
\ No newline at end of file
@@ -11,18 +11,18 @@ namespace Intro {
         OrbitCamera() = default;
         OrbitCamera(const Window& window);
 
-        // ʵֻി麯
+        // 实现基类纯虚函数
         glm::mat4 GetViewMat() const override;
-        glm::vec3 GetPosition() const override { return Position; } // ʵֻӿ
+        glm::vec3 GetPosition() const override { return Position; } // 新增：实现基类接口
         void OnUpdate(float deltaTime) override;
 
-        // Ŀ;
+        // 目标和距离控制
         void SetTarget(const glm::vec3& t) { Target = t; }
         const glm::vec3& GetTarget() const { return Target; }
-        void SetDistance(float d) { Distance = glm::max(0.1f, d); } // С
+        void SetDistance(float d) { Distance = glm::max(0.1f, d); } // 限制最小距离
         float GetDistance() const { return Distance; }
 
-        // ȺٶãοFreeCameraĵŽӿڣ
+        // 灵敏度和速度设置（参考FreeCamera的调优接口）
         void SetMouseSensitivity(float s) { m_MouseSensitivity = s; }
         void SetZoomSpeed(float s) { m_ZoomSpeed = s; }
         void SetTargetMovementSpeed(float s) { m_TargetMovementSpeed = s; }
@@ -37,10 +37,10 @@ namespace Intro {
 
         float Distance = 5.0f;
         float m_MouseSensitivity = 0.1f;
-        float m_ZoomSpeed = 5.0f; // ٶ
-        float m_TargetMovementSpeed = 5.0f; // Ŀƶٶ
+        float m_ZoomSpeed = 5.0f; // 新增：缩放速度
+        float m_TargetMovementSpeed = 5.0f; // 新增：目标移动速度
 
-        // ǶȿƣοFreeCameraYaw/Pitch
+        // 新增：角度控制（参考FreeCamera的Yaw/Pitch）
         float m_Yaw = 90.0f;
         float m_Pitch = 0.0f;
 
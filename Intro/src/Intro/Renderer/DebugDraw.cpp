@@ -0,0 +1,437 @@
+#include "itrpch.h"
+#include "DebugDraw.h"
+#include "Renderer.h"
+#include "RenderState.h"
+#include "Shader.h"
+#include "Cameras/Frustum.h"
+#include "Intro/Application.h"
+#include "Intro/Log.h"
+#include <glm/gtc/constants.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace Intro {
+
+	namespace {
+
+		// 分组下标：图元类型（线 / 三角形） x 深度模式（测试 / 覆盖）
+		constexpr uint32_t GroupCount = 4;
+
+		inline uint32_t GroupIndex(GLenum primitive, bool depthTest)
+		{
+			return (primitive == GL_TRIANGLES ? 2u : 0u) + (depthTest ? 0u : 1u);
+		}
+
+		inline GLenum GroupPrimitive(uint32_t group) { return group >= 2 ? GL_TRIANGLES : GL_LINES; }
+		inline bool GroupDepthTest(uint32_t group) { return (group & 1u) == 0; }
+
+		inline uint32_t PackColor(const glm::vec4& color)
+		{
+			glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+			return (uint32_t)c.r | ((uint32_t)c.g << 8) | ((uint32_t)c.b << 16) | ((uint32_t)c.a << 24);
+		}
+
+		struct DebugDrawData
+		{
+			std::vector<DebugDraw::Vertex> groups[GroupCount];
+			uint32_t vertexCount = 0;
+			uint32_t droppedVertices = 0;
+
+			std::vector<DebugDraw::Text> texts;
+			std::vector<DebugDraw::Text> flushedTexts;
+			glm::mat4 textViewProjection = glm::mat4(1.0f);
+
+			GLuint vao = 0;
+			GLuint vbo = 0;
+			DebugDraw::Vertex* mapped = nullptr;
+			uint32_t capacity = 0;			// 每段顶点数（即创建缓冲时的预算）
+			uint32_t frame = 0;
+			GLsync fences[DebugDraw::FrameCount] = {};
+
+			DebugDraw::Statistics stats;
+		};
+
+		DebugDrawData s_Data;
+
+		uint32_t VertexBudget()
+		{
+			return std::max(Renderer::GetConfig().debugDrawVertexBudget, 1024u);
+		}
+
+		void DestroyBuffer()
+		{
+			for (auto& fence : s_Data.fences) {
+				if (fence) glDeleteSync(fence);
+				fence = nullptr;
+			}
+			if (s_Data.vbo) {
+				if (s_Data.mapped) {
+					glBindBuffer(GL_ARRAY_BUFFER, s_Data.vbo);
+					glUnmapBuffer(GL_ARRAY_BUFFER);
+					glBindBuffer(GL_ARRAY_BUFFER, 0);
+				}
+				glDeleteBuffers(1, &s_Data.vbo);
+			}
+			if (s_Data.vao)
+				RenderState::DeleteVertexArrays(1, &s_Data.vao);
+
+			s_Data.vbo = 0;
+			s_Data.vao = 0;
+			s_Data.mapped = nullptr;
+			s_Data.capacity = 0;
+			s_Data.frame = 0;
+		}
+
+		void CreateBuffer(uint32_t capacity)
+		{
+			s_Data.capacity = capacity;
+			s_Data.frame = 0;
+
+			glGenVertexArrays(1, &s_Data.vao);
+			glGenBuffers(1, &s_Data.vbo);
+			RenderState::BindVertexArray(s_Data.vao);
+			glBindBuffer(GL_ARRAY_BUFFER, s_Data.vbo);
+
+			if (GLAD_GL_VERSION_4_4) {
+				// 三段环形使用，每段正好容纳一帧的预算
+				GLsizeiptr totalBytes = (GLsizeiptr)capacity * DebugDraw::FrameCount * sizeof(DebugDraw::Vertex);
+				GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				glBufferStorage(GL_ARRAY_BUFFER, totalBytes, nullptr, flags);
+				s_Data.mapped = static_cast<DebugDraw::Vertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalBytes, flags));
+				if (!s_Data.mapped)
+					ITR_ERROR("DebugDraw: failed to map persistent vertex buffer, debug primitives disabled");
+			}
+			else {
+				// 每帧用 glBufferData(nullptr) 孤立，驱动为新数据分配新的存储，不与 GPU 上一帧的读取同步
+				glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)capacity * sizeof(DebugDraw::Vertex), nullptr, GL_STREAM_DRAW);
+			}
+
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DebugDraw::Vertex), (void*)offsetof(DebugDraw::Vertex, position));
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugDraw::Vertex), (void*)offsetof(DebugDraw::Vertex, color));
+			glEnableVertexAttribArray(1);
+
+			RenderState::BindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		void WaitForFence(uint32_t frame)
+		{
+			GLsync& fence = s_Data.fences[frame];
+			if (!fence) return;
+
+			GLenum result = glClientWaitSync(fence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED) {
+				s_Data.stats.stalls++;
+				do {
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+				} while (result == GL_TIMEOUT_EXPIRED);
+			}
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		void ClearPrimitives()
+		{
+			for (auto& group : s_Data.groups) group.clear();
+			s_Data.vertexCount = 0;
+			s_Data.droppedVertices = 0;
+		}
+	}
+
+	DebugDraw::Vertex* DebugDraw::Reserve(GLenum primitive, bool depthTest, uint32_t count)
+	{
+		if (s_Data.vertexCount + count > VertexBudget()) {
+			s_Data.droppedVertices += count;
+			return nullptr;
+		}
+
+		// 列表在帧间保留容量，稳定后追加不再分配内存
+		auto& group = s_Data.groups[GroupIndex(primitive, depthTest)];
+		size_t offset = group.size();
+		group.resize(offset + count);
+		s_Data.vertexCount += count;
+		return group.data() + offset;
+	}
+
+	void DebugDraw::Line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color, bool depthTest)
+	{
+		Vertex* v = Reserve(GL_LINES, depthTest, 2);
+		if (!v) return;
+		uint32_t c = PackColor(color);
+		v[0] = { a, c };
+		v[1] = { b, c };
+	}
+
+	void DebugDraw::Triangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec4& color, bool depthTest)
+	{
+		Vertex* v = Reserve(GL_TRIANGLES, depthTest, 3);
+		if (!v) return;
+		uint32_t packed = PackColor(color);
+		v[0] = { a, packed };
+		v[1] = { b, packed };
+		v[2] = { c, packed };
+	}
+
+	namespace {
+
+		// 8 个角点按 (x, y, z) 的位组合排列：第 i 位为 1 表示该轴取最大值
+		constexpr int BoxEdges[12][2] = {
+			{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },	// x 方向
+			{ 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },	// y 方向
+			{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }		// z 方向
+		};
+
+		// 与 Frustum::GetCorners 的角点顺序一致（0-3 近平面，4-7 远平面）
+		constexpr int FrustumEdges[12][2] = {
+			{ 0, 1 }, { 1, 3 }, { 3, 2 }, { 2, 0 },
+			{ 4, 5 }, { 5, 7 }, { 7, 6 }, { 6, 4 },
+			{ 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 }
+		};
+
+		void EmitEdges(DebugDraw::Vertex* v, const glm::vec3* corners, const int (*edges)[2], uint32_t color)
+		{
+			for (int e = 0; e < 12; ++e) {
+				v[e * 2 + 0] = { corners[edges[e][0]], color };
+				v[e * 2 + 1] = { corners[edges[e][1]], color };
+			}
+		}
+	}
+
+	void DebugDraw::Box(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, bool depthTest)
+	{
+		Vertex* v = Reserve(GL_LINES, depthTest, 24);
+		if (!v) return;
+
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; ++i) {
+			corners[i] = glm::vec3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+		}
+		EmitEdges(v, corners, BoxEdges, PackColor(color));
+	}
+
+	void DebugDraw::OBB(const glm::mat4& transform, const glm::vec3& halfExtents, const glm::vec4& color, bool depthTest)
+	{
+		Vertex* v = Reserve(GL_LINES, depthTest, 24);
+		if (!v) return;
+
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; ++i) {
+			glm::vec3 local((i & 1) ? halfExtents.x : -halfExtents.x,
+				(i & 2) ? halfExtents.y : -halfExtents.y,
+				(i & 4) ? halfExtents.z : -halfExtents.z);
+			corners[i] = glm::vec3(transform * glm::vec4(local, 1.0f));
+		}
+		EmitEdges(v, corners, BoxEdges, PackColor(color));
+	}
+
+	void DebugDraw::Sphere(const glm::vec3& center, float radius, const glm::vec4& color, bool depthTest, uint32_t segments)
+	{
+		segments = std::max(segments, 3u);
+		Vertex* v = Reserve(GL_LINES, depthTest, segments * 6);
+		if (!v) return;
+
+		uint32_t c = PackColor(color);
+		float step = 2.0f * glm::pi<float>() / (float)segments;
+		glm::vec2 prev(radius, 0.0f);
+		for (uint32_t i = 0; i < segments; ++i) {
+			float angle = (float)(i + 1) * step;
+			glm::vec2 next(std::cos(angle) * radius, std::sin(angle) * radius);
+
+			// XY / XZ / YZ 平面
+			*v++ = { center + glm::vec3(prev.x, prev.y, 0.0f), c };
+			*v++ = { center + glm::vec3(next.x, next.y, 0.0f), c };
+			*v++ = { center + glm::vec3(prev.x, 0.0f, prev.y), c };
+			*v++ = { center + glm::vec3(next.x, 0.0f, next.y), c };
+			*v++ = { center + glm::vec3(0.0f, prev.x, prev.y), c };
+			*v++ = { center + glm::vec3(0.0f, next.x, next.y), c };
+			prev = next;
+		}
+	}
+
+	void DebugDraw::Frustum(const Intro::Frustum& frustum, const glm::vec4& color, bool depthTest)
+	{
+		Vertex* v = Reserve(GL_LINES, depthTest, 24);
+		if (!v) return;
+		EmitEdges(v, frustum.GetCorners().data(), FrustumEdges, PackColor(color));
+	}
+
+	void DebugDraw::Arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float headSize, bool depthTest)
+	{
+		glm::vec3 axis = to - from;
+		float length = glm::length(axis);
+		if (length < 1e-6f) return;
+
+		Vertex* v = Reserve(GL_LINES, depthTest, 10);
+		if (!v) return;
+
+		uint32_t c = PackColor(color);
+		glm::vec3 dir = axis / length;
+		if (headSize <= 0.0f) headSize = length * 0.2f;
+
+		// 与箭头方向垂直的两个轴
+		glm::vec3 up = std::abs(dir.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+		glm::vec3 side = glm::normalize(glm::cross(dir, up)) * headSize * 0.5f;
+		glm::vec3 side2 = glm::cross(dir, side);
+		glm::vec3 base = to - dir * headSize;
+
+		*v++ = { from, c }; *v++ = { to, c };
+		*v++ = { to, c }; *v++ = { base + side, c };
+		*v++ = { to, c }; *v++ = { base - side, c };
+		*v++ = { to, c }; *v++ = { base + side2, c };
+		*v++ = { to, c }; *v++ = { base - side2, c };
+	}
+
+	void DebugDraw::Text3D(const glm::vec3& position, const std::string& text, const glm::vec4& color)
+	{
+		s_Data.texts.push_back({ position, PackColor(color), text });
+	}
+
+	bool DebugDraw::HasPending()
+	{
+		return s_Data.vertexCount > 0 || !s_Data.texts.empty();
+	}
+
+	void DebugDraw::Clear()
+	{
+		ClearPrimitives();
+		s_Data.texts.clear();
+	}
+
+	void DebugDraw::Flush(const glm::mat4& viewProjection)
+	{
+		Statistics& stats = s_Data.stats;
+		stats.vertexCount = s_Data.vertexCount;
+		stats.droppedVertices = s_Data.droppedVertices;
+		stats.drawCalls = 0;
+		stats.textCount = (uint32_t)s_Data.texts.size();
+		stats.vertexBudget = VertexBudget();
+
+		// 文字交给 ImGui 绘制，两块缓冲交换以复用容量
+		std::swap(s_Data.texts, s_Data.flushedTexts);
+		s_Data.texts.clear();
+		s_Data.textViewProjection = viewProjection;
+
+		if (s_Data.vertexCount == 0) {
+			ClearPrimitives();
+			return;
+		}
+
+		auto& library = Application::GetShaderLibrary();
+		if (!library.Exists("debugDrawShader")) {
+			ITR_WARN("DebugDraw: debugDrawShader not found, debug primitives skipped");
+			ClearPrimitives();
+			return;
+		}
+
+		// 预算变化时重建缓冲（等待全部旧段，避免 GPU 仍在读取）
+		uint32_t budget = VertexBudget();
+		if (s_Data.capacity != budget) {
+			for (uint32_t i = 0; i < FrameCount; ++i) WaitForFence(i);
+			DestroyBuffer();
+			CreateBuffer(budget);
+		}
+		if (GLAD_GL_VERSION_4_4 && !s_Data.mapped) {
+			ClearPrimitives();
+			return;
+		}
+
+		// 上传：各组依次排列，记录每组的起始顶点
+		GLint first[GroupCount];
+		GLint baseVertex = 0;
+		if (s_Data.mapped) {
+			s_Data.frame = (s_Data.frame + 1) % FrameCount;
+			WaitForFence(s_Data.frame);
+			baseVertex = (GLint)(s_Data.frame * s_Data.capacity);
+		}
+		else {
+			glBindBuffer(GL_ARRAY_BUFFER, s_Data.vbo);
+			glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)s_Data.capacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+		}
+
+		GLint cursor = 0;
+		for (uint32_t g = 0; g < GroupCount; ++g) {
+			const auto& group = s_Data.groups[g];
+			first[g] = baseVertex + cursor;
+			if (group.empty()) continue;
+
+			if (s_Data.mapped)
+				std::memcpy(s_Data.mapped + first[g], group.data(), group.size() * sizeof(Vertex));
+			else
+				glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)cursor * sizeof(Vertex), group.size() * sizeof(Vertex), group.data());
+			cursor += (GLint)group.size();
+		}
+		if (!s_Data.mapped)
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// 保存状态
+		bool prevDepthTest = RenderState::IsDepthTestEnabled();
+		bool prevDepthMask = RenderState::IsDepthMaskEnabled();
+		bool prevBlend = RenderState::IsBlendEnabled();
+		bool prevCullFace = RenderState::IsCullFaceEnabled();
+		GLenum prevPolygonMode = RenderState::GetPolygonMode();
+		float prevLineWidth = RenderState::GetLineWidth();
+
+		// 调试图元不写深度，半透明颜色按 alpha 混合
+		RenderState::SetDepthMask(false);
+		RenderState::SetBlend(true);
+		RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		RenderState::SetCullFace(false);
+		RenderState::SetPolygonMode(GL_FILL);
+		RenderState::SetLineWidth(2.0f);
+
+		auto shader = library.Get("debugDrawShader");
+		shader->Bind();
+		shader->SetUniformMat4("u_ViewProjection", viewProjection);
+		RenderState::BindVertexArray(s_Data.vao);
+
+		for (uint32_t g = 0; g < GroupCount; ++g) {
+			GLsizei count = (GLsizei)s_Data.groups[g].size();
+			if (count == 0) continue;
+			RenderState::SetDepthTest(GroupDepthTest(g));
+			glDrawArrays(GroupPrimitive(g), first[g], count);
+			stats.drawCalls++;
+		}
+
+		RenderState::BindVertexArray(0);
+		shader->UnBind();
+
+		if (s_Data.mapped) {
+			if (s_Data.fences[s_Data.frame]) glDeleteSync(s_Data.fences[s_Data.frame]);
+			s_Data.fences[s_Data.frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		// 恢复状态
+		RenderState::SetDepthTest(prevDepthTest);
+		RenderState::SetDepthMask(prevDepthMask);
+		RenderState::SetBlend(prevBlend);
+		RenderState::SetCullFace(prevCullFace);
+		RenderState::SetPolygonMode(prevPolygonMode);
+		RenderState::SetLineWidth(prevLineWidth);
+
+		ClearPrimitives();
+	}
+
+	void DebugDraw::Shutdown()
+	{
+		DestroyBuffer();
+		Clear();
+		s_Data.flushedTexts.clear();
+	}
+
+	const std::vector<DebugDraw::Text>& DebugDraw::GetTexts()
+	{
+		return s_Data.flushedTexts;
+	}
+
+	const glm::mat4& DebugDraw::GetTextViewProjection()
+	{
+		return s_Data.textViewProjection;
+	}
+
+	const DebugDraw::Statistics& DebugDraw::GetStats()
+	{
+		return s_Data.stats;
+	}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Intro {
+
+	class Frustum;
+
+	// 立即模式调试绘制：
+	// - 各接口只把顶点追加到 CPU 端列表（按图元类型与深度模式分组），不触碰 GL，可以在一帧内任意位置调用
+	// - Flush 把本帧全部顶点写入一个流式 VBO：GL 4.4 以上持久映射并分 FrameCount 段轮换（fence 保证 GPU 读完才复用），
+	//   否则每帧孤立缓冲后 glBufferSubData；每组（图元类型 x 深度模式）一次 glDrawArrays
+	// - 每帧顶点数有预算（RendererConfig::debugDrawVertexBudget），超出预算的图元整个丢弃并计数
+	// - Text3D 只记录世界坐标与文字，由编辑器视口用 ImGui 投影后绘制
+	class ITR_API DebugDraw
+	{
+	public:
+		static constexpr uint32_t FrameCount = 3;
+
+		struct Vertex {
+			glm::vec3 position;
+			uint32_t color;		// RGBA8
+		};
+		static_assert(sizeof(Vertex) == 16, "DebugDraw::Vertex must match the vertex layout of debugDrawShader");
+
+		struct Text {
+			glm::vec3 position;
+			uint32_t color;
+			std::string text;
+		};
+
+		// depthTest = false 时绘制在场景之上（不被遮挡）
+		static void Line(const glm::vec3& a, const glm::vec3& b, const glm::vec4& color, bool depthTest = true);
+		static void Triangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec4& color, bool depthTest = true);
+		static void Box(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, bool depthTest = true);
+		// transform 作用于以原点为中心、半长为 halfExtents 的盒子
+		static void OBB(const glm::mat4& transform, const glm::vec3& halfExtents, const glm::vec4& color, bool depthTest = true);
+		// 三个坐标平面上的圆环
+		static void Sphere(const glm::vec3& center, float radius, const glm::vec4& color, bool depthTest = true, uint32_t segments = 16);
+		static void Frustum(const Intro::Frustum& frustum, const glm::vec4& color, bool depthTest = true);
+		// headSize <= 0 时取箭头长度的 0.2 倍
+		static void Arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float headSize = 0.0f, bool depthTest = true);
+		static void Text3D(const glm::vec3& position, const std::string& text, const glm::vec4& color = glm::vec4(1.0f));
+
+		// 把本帧的图元绘制到当前帧缓冲并清空列表；文字保留到下一次 Flush，供 ImGui 绘制
+		static void Flush(const glm::mat4& viewProjection);
+		// 丢弃本帧已记录的图元
+		static void Clear();
+		static void Shutdown();
+
+		static bool HasPending();
+
+		// 上一次 Flush 的文字与视图投影矩阵
+		static const std::vector<Text>& GetTexts();
+		static const glm::mat4& GetTextViewProjection();
+
+		struct Statistics {
+			uint32_t vertexCount = 0;
+			uint32_t droppedVertices = 0;	// 超出预算被丢弃的顶点
+			uint32_t drawCalls = 0;
+			uint32_t textCount = 0;
+			uint32_t vertexBudget = 0;
+			uint32_t stalls = 0;			// 等待 GPU 读完旧数据的次数
+		};
+		static const Statistics& GetStats();
+
+	private:
+		static Vertex* Reserve(GLenum primitive, bool depthTest, uint32_t count);
+	};
+
+}
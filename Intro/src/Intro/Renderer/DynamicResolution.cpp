@@ -0,0 +1,121 @@
+#include "itrpch.h"
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Intro {
+
+	DynamicResolution::~DynamicResolution()
+	{
+		if (m_Queries[0][0])
+			glDeleteQueries(QueryLatency * 2, &m_Queries[0][0]);
+	}
+
+	void DynamicResolution::Resolve()
+	{
+		// 从最旧的槽位开始读取；查询按提交顺序完成，遇到未完成的就停下
+		for (uint32_t i = 1; i <= QueryLatency; ++i) {
+			uint32_t slot = (m_Slot + i) % QueryLatency;
+			if (!m_Pending[slot]) continue;
+
+			GLint available = 0;
+			glGetQueryObjectiv(m_Queries[slot][1], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available) break;
+
+			GLuint64 begin = 0, end = 0;
+			glGetQueryObjectui64v(m_Queries[slot][0], GL_QUERY_RESULT, &begin);
+			glGetQueryObjectui64v(m_Queries[slot][1], GL_QUERY_RESULT, &end);
+			m_Pending[slot] = false;
+
+			float ms = end > begin ? (float)((double)(end - begin) / 1.0e6) : 0.0f;
+			m_Stats.lastMs = ms;
+			if (m_Cooldown > 0) {
+				m_Cooldown--;
+				continue;
+			}
+			m_History[m_HistoryHead] = ms;
+			m_HistoryHead = (m_HistoryHead + 1) % WindowSize;
+			m_HistoryCount = std::min(m_HistoryCount + 1, WindowSize);
+		}
+	}
+
+	void DynamicResolution::Adjust()
+	{
+		if (m_HistoryCount < WindowSize) return;
+
+		float sum = 0.0f;
+		for (uint32_t i = 0; i < WindowSize; ++i) sum += m_History[i];
+		float average = sum / (float)WindowSize;
+		m_Stats.averageMs = average;
+		if (average <= 0.0f) return;
+
+		float target = m_Settings.targetMs;
+		if (average <= target && average >= target * Headroom) return;
+
+		float desired = m_Scale * std::sqrt(target / average);
+		desired = glm::clamp(desired, m_Scale - MaxStep, m_Scale + MaxStep);
+		desired = glm::clamp(desired, m_Settings.minScale, m_Settings.maxScale);
+		// 降低时向下取整、提高时向上取整到量化步长，保证确实发生变化
+		desired = average > target ? std::floor(desired / ScaleQuantum) * ScaleQuantum
+			: std::ceil(desired / ScaleQuantum) * ScaleQuantum;
+		desired = glm::clamp(desired, m_Settings.minScale, m_Settings.maxScale);
+		if (std::abs(desired - m_Scale) < 1e-4f) return;
+
+		m_Scale = desired;
+		m_Stats.adjustments++;
+		m_HistoryCount = 0;
+		m_HistoryHead = 0;
+		m_Cooldown = QueryLatency;
+	}
+
+	void DynamicResolution::BeginFrame(const Settings& settings)
+	{
+		m_Settings = settings;
+		m_Settings.maxScale = glm::clamp(m_Settings.maxScale, 0.1f, 1.0f);
+		m_Settings.minScale = glm::clamp(m_Settings.minScale, 0.1f, m_Settings.maxScale);
+
+		if (!m_Settings.enabled) {
+			// 关闭时不插入查询；丢弃未读取的测量，重新开启后从全分辨率开始
+			m_Scale = 1.0f;
+			m_HistoryCount = 0;
+			m_HistoryHead = 0;
+			m_Cooldown = 0;
+			for (bool& pending : m_Pending) pending = false;
+			m_FrameActive = false;
+			return;
+		}
+
+		if (!m_Queries[0][0])
+			glGenQueries(QueryLatency * 2, &m_Queries[0][0]);
+
+		Resolve();
+		Adjust();
+		m_Scale = glm::clamp(m_Scale, m_Settings.minScale, m_Settings.maxScale);
+
+		m_Slot = (m_Slot + 1) % QueryLatency;
+		if (m_Pending[m_Slot]) {
+			// GPU 落后超过 QueryLatency 帧：丢弃这次测量而不是等待
+			m_Pending[m_Slot] = false;
+			m_Stats.droppedQueries++;
+		}
+		glQueryCounter(m_Queries[m_Slot][0], GL_TIMESTAMP);
+		m_FrameActive = true;
+	}
+
+	void DynamicResolution::EndFrame()
+	{
+		if (!m_FrameActive) return;
+		glQueryCounter(m_Queries[m_Slot][1], GL_TIMESTAMP);
+		m_Pending[m_Slot] = true;
+		m_FrameActive = false;
+	}
+
+	glm::uvec2 DynamicResolution::GetRenderSize(uint32_t viewportWidth, uint32_t viewportHeight) const
+	{
+		uint32_t width = (uint32_t)std::lround((float)viewportWidth * m_Scale);
+		uint32_t height = (uint32_t)std::lround((float)viewportHeight * m_Scale);
+		return glm::uvec2(glm::clamp(width, 1u, std::max(viewportWidth, 1u)),
+			glm::clamp(height, 1u, std::max(viewportHeight, 1u)));
+	}
+
+}
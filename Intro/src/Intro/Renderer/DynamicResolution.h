@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Intro {
+
+	// 动态分辨率控制器：
+	// - 每帧在场景渲染前后各插入一个 GL_TIMESTAMP 查询，结果延迟 QueryLatency 帧非阻塞地读取（GPU 未完成时丢弃）
+	// - 最近 WindowSize 帧场景 GPU 时间的平均值与目标比较；着色开销近似与像素数（scale^2）成正比，
+	//   按 sqrt(target / average) 修正缩放，每次最多变化 MaxStep，并留出上调的余量避免在目标附近振荡
+	// - 调整后清空窗口并等待 QueryLatency 帧，旧缩放下的测量不参与下一次判断
+	// 缩放只决定渲染子区域的大小，目标纹理始终按视口全尺寸分配，缩放变化不会重新分配纹理
+	class ITR_API DynamicResolution
+	{
+	public:
+		static constexpr uint32_t QueryLatency = 4;
+		static constexpr uint32_t WindowSize = 16;
+		static constexpr float MaxStep = 0.1f;
+		static constexpr float ScaleQuantum = 1.0f / 32.0f;	// 缩放取 1/32 的整数倍，减少子区域尺寸的抖动
+		static constexpr float Headroom = 0.85f;			// 平均时间低于目标的这个比例才提高分辨率
+
+		struct Settings {
+			bool enabled = false;
+			float targetMs = 12.0f;
+			float minScale = 0.5f;
+			float maxScale = 1.0f;
+		};
+
+		DynamicResolution() = default;
+		~DynamicResolution();
+
+		DynamicResolution(const DynamicResolution&) = delete;
+		DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+		// 读取已完成的测量并更新缩放，然后开始本帧计时
+		void BeginFrame(const Settings& settings);
+		void EndFrame();
+
+		float GetScale() const { return m_Scale; }
+		// 本帧渲染子区域的尺寸（至少 1 像素，不超过视口）
+		glm::uvec2 GetRenderSize(uint32_t viewportWidth, uint32_t viewportHeight) const;
+
+		struct Statistics {
+			float lastMs = 0.0f;
+			float averageMs = 0.0f;
+			uint32_t adjustments = 0;
+			uint32_t droppedQueries = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		void Resolve();
+		void Adjust();
+
+		GLuint m_Queries[QueryLatency][2] = {};
+		bool m_Pending[QueryLatency] = {};
+		uint32_t m_Slot = 0;
+		bool m_FrameActive = false;
+
+		float m_History[WindowSize] = {};
+		uint32_t m_HistoryCount = 0;
+		uint32_t m_HistoryHead = 0;
+		uint32_t m_Cooldown = 0;
+
+		float m_Scale = 1.0f;
+		Settings m_Settings;
+		Statistics m_Stats;
+	};
+
+}
@@ -1,10 +1,11 @@
 #include "itrpch.h"
 #include "Framebuffer.h"
+#include "RenderState.h"
 #include <glad/glad.h>
 
 namespace Intro {
 
-    // öӳΪʵʵ OpenGL ʽ
+    // 将枚举映射为实际的 OpenGL 格式
     static GLenum TextureTarget(bool multisampled) {
         return multisampled ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
     }
@@ -14,10 +15,10 @@ namespace Intro {
     }
 
     static void BindTexture(bool multisampled, uint32_t id) {
-        glBindTexture(TextureTarget(multisampled), id);
+        RenderState::BindTexture(TextureTarget(multisampled), id);
     }
 
-    // ݸʽ OpenGL ڲʽ
+    // 根据格式返回 OpenGL 内部格式与数据类型
     static void AttachColorTexture(uint32_t id, int samples, GLenum internalFormat, GLenum format,
         uint32_t width, uint32_t height, int index) {
         bool multisampled = samples > 1;
@@ -61,23 +62,23 @@ namespace Intro {
         }
 
         ~OpenGLFramebuffer() override {
-            glDeleteFramebuffers(1, &m_RendererID);
-            glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
-            glDeleteTextures(1, &m_DepthAttachment);
+            RenderState::DeleteFramebuffers(1, &m_RendererID);
+            RenderState::DeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
+            RenderState::DeleteTextures(1, &m_DepthAttachment);
         }
 
         void Invalidate() {
             if (m_RendererID) {
-                glDeleteFramebuffers(1, &m_RendererID);
-                glDeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
-                glDeleteTextures(1, &m_DepthAttachment);
+                RenderState::DeleteFramebuffers(1, &m_RendererID);
+                RenderState::DeleteTextures((GLsizei)m_ColorAttachments.size(), m_ColorAttachments.data());
+                RenderState::DeleteTextures(1, &m_DepthAttachment);
 
                 m_ColorAttachments.clear();
                 m_DepthAttachment = 0;
             }
 
             glGenFramebuffers(1, &m_RendererID);
-            glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+            RenderState::BindFramebuffer(m_RendererID);
 
             bool multisampled = m_Specification.samples > 1;
 
@@ -123,15 +124,15 @@ namespace Intro {
 
             ITR_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer incomplete!");
 
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            RenderState::BindFramebuffer(0);
         }
 
         void Bind() override {
-            glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
+            RenderState::BindFramebuffer(m_RendererID);
         }
 
         void Unbind() override {
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            RenderState::BindFramebuffer(0);
         }
 
         void Resize(uint32_t width, uint32_t height) override {
@@ -142,7 +143,7 @@ namespace Intro {
         }
 
         void BindColorTexture(uint32_t slot, uint32_t index) const override {
-            glBindTextureUnit(slot, m_ColorAttachments[index]);
+            RenderState::BindTexture(slot, TextureTarget(m_Specification.samples > 1), m_ColorAttachments[index]);
         }
 
         uint32_t GetColorAttachmentRendererID(uint32_t index) const override {
@@ -0,0 +1,295 @@
+#include "itrpch.h"
+#include "GPUProfiler.h"
+#include "Intro/Log.h"
+#include <fstream>
+
+namespace Intro {
+
+	namespace {
+
+		// 一次作用域记录：begin/end 为本帧查询池中的下标
+		struct ScopeRecord
+		{
+			uint32_t nameIndex = 0;
+			uint32_t depth = 0;
+			uint32_t beginQuery = 0;
+			uint32_t endQuery = 0;
+		};
+
+		struct FrameQueries
+		{
+			std::vector<GLuint> queries;		// 跨帧复用的查询对象池
+			uint32_t usedQueries = 0;
+			std::vector<ScopeRecord> scopes;
+			uint64_t frameNumber = 0;
+			bool pending = false;				// 已提交、尚未读取
+		};
+
+		// 一帧的结果：下标为作用域名字编号，-1 表示该帧没有这个作用域
+		struct FrameSample
+		{
+			uint64_t frameNumber = 0;
+			std::vector<float> timings;
+		};
+
+		struct ProfilerData
+		{
+			FrameQueries frames[GPUProfiler::FrameLatency];
+			uint32_t currentFrame = 0;
+			uint64_t frameNumber = 0;
+			bool frameActive = false;
+			bool enabled = true;
+
+			std::vector<uint32_t> openScopes;	// 当前帧 scopes 中尚未结束的记录下标
+
+			std::vector<std::string> names;
+			std::vector<uint32_t> nameDepths;	// 最近一次出现时的嵌套深度（用于显示缩进）
+			std::unordered_map<std::string, uint32_t> nameLookup;
+
+			std::vector<FrameSample> history;	// 环形缓冲
+			uint32_t historyHead = 0;			// 下一次写入位置
+			uint32_t droppedFrames = 0;
+		};
+
+		ProfilerData s_Profiler;
+
+		uint32_t InternName(const char* name)
+		{
+			auto it = s_Profiler.nameLookup.find(name);
+			if (it != s_Profiler.nameLookup.end()) return it->second;
+
+			uint32_t index = (uint32_t)s_Profiler.names.size();
+			s_Profiler.names.emplace_back(name);
+			s_Profiler.nameDepths.push_back(0);
+			s_Profiler.nameLookup.emplace(s_Profiler.names.back(), index);
+			return index;
+		}
+
+		uint32_t AcquireQuery(FrameQueries& frame)
+		{
+			if (frame.usedQueries == frame.queries.size()) {
+				size_t oldSize = frame.queries.size();
+				frame.queries.resize(std::max<size_t>(oldSize * 2, 32));
+				glGenQueries((GLsizei)(frame.queries.size() - oldSize), frame.queries.data() + oldSize);
+			}
+			return frame.usedQueries++;
+		}
+
+		void PushSample(FrameSample&& sample)
+		{
+			if (s_Profiler.history.size() < GPUProfiler::HistorySize) {
+				s_Profiler.history.push_back(std::move(sample));
+			}
+			else {
+				s_Profiler.history[s_Profiler.historyHead] = std::move(sample);
+			}
+			s_Profiler.historyHead = (s_Profiler.historyHead + 1) % GPUProfiler::HistorySize;
+		}
+
+		// 按时间顺序访问历史中第 i 帧（0 为最旧）
+		const FrameSample& HistoryAt(size_t i)
+		{
+			if (s_Profiler.history.size() < GPUProfiler::HistorySize)
+				return s_Profiler.history[i];
+			return s_Profiler.history[(s_Profiler.historyHead + i) % GPUProfiler::HistorySize];
+		}
+
+		// 读取一帧的结果；GPU 尚未完成时返回 false（不等待）
+		bool TryResolve(FrameQueries& frame)
+		{
+			if (!frame.pending) return true;
+
+			if (!frame.scopes.empty()) {
+				// 查询按提交顺序完成；根作用域 "Frame" 最后结束，它的结束查询可用即整帧可用
+				GLint available = 0;
+				glGetQueryObjectiv(frame.queries[frame.scopes.front().endQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+				if (!available) return false;
+
+				FrameSample sample;
+				sample.frameNumber = frame.frameNumber;
+				sample.timings.assign(s_Profiler.names.size(), -1.0f);
+
+				for (const ScopeRecord& scope : frame.scopes) {
+					GLuint64 begin = 0, end = 0;
+					glGetQueryObjectui64v(frame.queries[scope.beginQuery], GL_QUERY_RESULT, &begin);
+					glGetQueryObjectui64v(frame.queries[scope.endQuery], GL_QUERY_RESULT, &end);
+					float ms = end > begin ? (float)((double)(end - begin) / 1.0e6) : 0.0f;
+
+					// 同名作用域（例如多个同名 RenderPass）在一帧内累加
+					float& slot = sample.timings[scope.nameIndex];
+					slot = slot < 0.0f ? ms : slot + ms;
+				}
+				PushSample(std::move(sample));
+			}
+
+			frame.pending = false;
+			return true;
+		}
+	}
+
+	void GPUProfiler::BeginFrame()
+	{
+		// 先按从旧到新的顺序读取已经完成的帧
+		for (uint32_t i = 1; i <= FrameLatency; ++i) {
+			FrameQueries& frame = s_Profiler.frames[(s_Profiler.currentFrame + i) % FrameLatency];
+			if (!TryResolve(frame)) break;
+		}
+
+		s_Profiler.currentFrame = (s_Profiler.currentFrame + 1) % FrameLatency;
+		FrameQueries& frame = s_Profiler.frames[s_Profiler.currentFrame];
+
+		// 要复用的槽位仍未完成：丢弃它的结果，而不是阻塞等待 GPU
+		if (frame.pending) {
+			frame.pending = false;
+			s_Profiler.droppedFrames++;
+		}
+
+		frame.usedQueries = 0;
+		frame.scopes.clear();
+		frame.frameNumber = ++s_Profiler.frameNumber;
+		s_Profiler.openScopes.clear();
+
+		s_Profiler.frameActive = s_Profiler.enabled;
+		if (s_Profiler.frameActive)
+			BeginScope("Frame");
+	}
+
+	void GPUProfiler::EndFrame()
+	{
+		if (!s_Profiler.frameActive) return;
+
+		if (s_Profiler.openScopes.size() > 1)
+			ITR_WARN("GPUProfiler: {} scope(s) left open at end of frame", s_Profiler.openScopes.size() - 1);
+		while (!s_Profiler.openScopes.empty())
+			EndScope();
+
+		s_Profiler.frames[s_Profiler.currentFrame].pending = true;
+		s_Profiler.frameActive = false;
+	}
+
+	void GPUProfiler::Shutdown()
+	{
+		for (FrameQueries& frame : s_Profiler.frames) {
+			if (!frame.queries.empty())
+				glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+			frame = FrameQueries();
+		}
+		s_Profiler.openScopes.clear();
+		s_Profiler.frameActive = false;
+	}
+
+	void GPUProfiler::BeginScope(const char* name)
+	{
+		if (!s_Profiler.frameActive) return;
+
+		FrameQueries& frame = s_Profiler.frames[s_Profiler.currentFrame];
+
+		ScopeRecord scope;
+		scope.nameIndex = InternName(name);
+		scope.depth = (uint32_t)s_Profiler.openScopes.size();
+		scope.beginQuery = AcquireQuery(frame);
+		glQueryCounter(frame.queries[scope.beginQuery], GL_TIMESTAMP);
+
+		s_Profiler.nameDepths[scope.nameIndex] = scope.depth;
+		s_Profiler.openScopes.push_back((uint32_t)frame.scopes.size());
+		frame.scopes.push_back(scope);
+	}
+
+	void GPUProfiler::EndScope()
+	{
+		if (!s_Profiler.frameActive || s_Profiler.openScopes.empty()) return;
+
+		FrameQueries& frame = s_Profiler.frames[s_Profiler.currentFrame];
+		ScopeRecord& scope = frame.scopes[s_Profiler.openScopes.back()];
+		s_Profiler.openScopes.pop_back();
+
+		scope.endQuery = AcquireQuery(frame);
+		glQueryCounter(frame.queries[scope.endQuery], GL_TIMESTAMP);
+	}
+
+	void GPUProfiler::SetEnabled(bool enabled)
+	{
+		s_Profiler.enabled = enabled;
+	}
+
+	bool GPUProfiler::IsEnabled()
+	{
+		return s_Profiler.enabled;
+	}
+
+	std::vector<GPUProfiler::ScopeStats> GPUProfiler::GetScopeStats()
+	{
+		std::vector<ScopeStats> result(s_Profiler.names.size());
+		std::vector<uint32_t> counts(s_Profiler.names.size(), 0);
+
+		for (size_t i = 0; i < result.size(); ++i) {
+			result[i].name = s_Profiler.names[i];
+			result[i].depth = s_Profiler.nameDepths[i];
+		}
+
+		for (size_t f = 0; f < s_Profiler.history.size(); ++f) {
+			const FrameSample& sample = HistoryAt(f);
+			for (size_t i = 0; i < sample.timings.size(); ++i) {
+				float ms = sample.timings[i];
+				if (ms < 0.0f) continue;
+				result[i].lastMs = ms;
+				result[i].averageMs += ms;
+				result[i].maxMs = std::max(result[i].maxMs, ms);
+				counts[i]++;
+			}
+		}
+
+		for (size_t i = 0; i < result.size(); ++i) {
+			if (counts[i] > 0) result[i].averageMs /= (float)counts[i];
+		}
+		return result;
+	}
+
+	void GPUProfiler::GetScopeHistory(const std::string& name, std::vector<float>& outMs)
+	{
+		outMs.clear();
+		auto it = s_Profiler.nameLookup.find(name);
+		if (it == s_Profiler.nameLookup.end()) return;
+
+		outMs.reserve(s_Profiler.history.size());
+		for (size_t f = 0; f < s_Profiler.history.size(); ++f) {
+			const FrameSample& sample = HistoryAt(f);
+			float ms = it->second < sample.timings.size() ? sample.timings[it->second] : -1.0f;
+			outMs.push_back(std::max(ms, 0.0f));
+		}
+	}
+
+	bool GPUProfiler::ExportCSV(const std::string& path)
+	{
+		std::ofstream file(path, std::ios::out | std::ios::trunc);
+		if (!file.is_open()) {
+			ITR_ERROR("GPUProfiler: failed to open {} for writing", path);
+			return false;
+		}
+
+		file << "frame";
+		for (const std::string& name : s_Profiler.names)
+			file << ',' << name;
+		file << '\n';
+
+		for (size_t f = 0; f < s_Profiler.history.size(); ++f) {
+			const FrameSample& sample = HistoryAt(f);
+			file << sample.frameNumber;
+			for (size_t i = 0; i < s_Profiler.names.size(); ++i) {
+				file << ',';
+				if (i < sample.timings.size() && sample.timings[i] >= 0.0f)
+					file << sample.timings[i];
+			}
+			file << '\n';
+		}
+
+		ITR_INFO("GPUProfiler: exported {} frames to {}", s_Profiler.history.size(), path);
+		return true;
+	}
+
+	uint32_t GPUProfiler::GetDroppedFrameCount()
+	{
+		return s_Profiler.droppedFrames;
+	}
+
+}
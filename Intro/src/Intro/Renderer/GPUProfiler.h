@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Intro {
+
+	// GPU 计时器：每个作用域在开始/结束处各插入一个 GL_TIMESTAMP 查询（glQueryCounter），
+	// 时间戳可以嵌套，不受 GL_TIME_ELAPSED 同一时间只能有一个活动查询的限制。
+	// 查询按帧分组放在 FrameLatency 个槽位中轮换，结果在一到两帧之后才读取，
+	// 读取前先检查 GL_QUERY_RESULT_AVAILABLE，GPU 还没完成时宁可丢弃这一帧也不等待。
+	class ITR_API GPUProfiler
+	{
+	public:
+		static constexpr uint32_t FrameLatency = 3;
+		static constexpr uint32_t HistorySize = 240;
+
+		// 帧边界（Application::Run 中调用）；BeginFrame 会自动打开名为 "Frame" 的根作用域
+		static void BeginFrame();
+		static void EndFrame();
+		static void Shutdown();
+
+		static void BeginScope(const char* name);
+		static void EndScope();
+
+		// 关闭后不再插入查询（在下一次 BeginFrame 时生效）
+		static void SetEnabled(bool enabled);
+		static bool IsEnabled();
+
+		struct ScopeStats {
+			std::string name;
+			uint32_t depth = 0;
+			float lastMs = 0.0f;
+			float averageMs = 0.0f;
+			float maxMs = 0.0f;
+		};
+		// 按首次出现的顺序返回各作用域在历史窗口内的统计
+		static std::vector<ScopeStats> GetScopeStats();
+		// 按时间顺序输出某个作用域的历史（毫秒，缺失的帧为 0）
+		static void GetScopeHistory(const std::string& name, std::vector<float>& outMs);
+
+		// 导出历史为 CSV：每行一帧，每列一个作用域（毫秒）
+		static bool ExportCSV(const std::string& path);
+
+		// GPU 尚未完成而被丢弃的帧数
+		static uint32_t GetDroppedFrameCount();
+	};
+
+	// 作用域辅助：构造时 BeginScope，析构时 EndScope
+	class GPUProfileScope
+	{
+	public:
+		explicit GPUProfileScope(const char* name) { GPUProfiler::BeginScope(name); }
+		~GPUProfileScope() { GPUProfiler::EndScope(); }
+
+		GPUProfileScope(const GPUProfileScope&) = delete;
+		GPUProfileScope& operator=(const GPUProfileScope&) = delete;
+	};
+
+}
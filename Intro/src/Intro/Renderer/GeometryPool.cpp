@@ -0,0 +1,289 @@
+#include "itrpch.h"
+#include "GeometryPool.h"
+#include "RenderConstant.h"
+#include "RenderState.h"
+#include "Intro/Log.h"
+
+namespace Intro {
+
+	namespace {
+
+		// 首次适配的区间分配器，释放时与相邻空闲区间合并
+		class RangeAllocator
+		{
+		public:
+			void Reset(uint32_t capacity)
+			{
+				m_Capacity = capacity;
+				m_Used = 0;
+				m_Free.clear();
+				if (capacity > 0) m_Free.push_back({ 0, capacity });
+			}
+
+			// 扩容：新增的尾部空间并入空闲链表
+			void Grow(uint32_t newCapacity)
+			{
+				if (newCapacity <= m_Capacity) return;
+				Release(m_Capacity, newCapacity - m_Capacity, false);
+				m_Capacity = newCapacity;
+			}
+
+			bool Allocate(uint32_t size, uint32_t& offset)
+			{
+				for (size_t i = 0; i < m_Free.size(); ++i) {
+					Range& range = m_Free[i];
+					if (range.size < size) continue;
+
+					offset = range.offset;
+					range.offset += size;
+					range.size -= size;
+					if (range.size == 0) m_Free.erase(m_Free.begin() + i);
+					m_Used += size;
+					return true;
+				}
+				return false;
+			}
+
+			void Free(uint32_t offset, uint32_t size) { Release(offset, size, true); }
+
+			uint32_t GetCapacity() const { return m_Capacity; }
+			uint32_t GetUsed() const { return m_Used; }
+
+		private:
+			struct Range { uint32_t offset; uint32_t size; };
+
+			void Release(uint32_t offset, uint32_t size, bool wasUsed)
+			{
+				if (size == 0) return;
+				if (wasUsed) m_Used -= size;
+
+				// 空闲链表按 offset 有序
+				auto it = std::lower_bound(m_Free.begin(), m_Free.end(), offset,
+					[](const Range& range, uint32_t value) { return range.offset < value; });
+				it = m_Free.insert(it, { offset, size });
+
+				auto next = it + 1;
+				if (next != m_Free.end() && it->offset + it->size == next->offset) {
+					it->size += next->size;
+					m_Free.erase(next);
+				}
+				if (it != m_Free.begin()) {
+					auto prev = it - 1;
+					if (prev->offset + prev->size == it->offset) {
+						prev->size += it->size;
+						m_Free.erase(it);
+					}
+				}
+			}
+
+			std::vector<Range> m_Free;
+			uint32_t m_Capacity = 0;
+			uint32_t m_Used = 0;
+		};
+
+		struct GeometryPoolData
+		{
+			GLuint vao = 0;
+			GLuint vbo = 0;
+			GLuint ibo = 0;
+			GLuint instanceIndexBuffer = 0;	// VAO 当前指向的实例索引缓冲
+			RangeAllocator vertices;
+			RangeAllocator indices;
+			bool initialized = false;
+		};
+
+		GeometryPoolData s_Pool;
+
+		// 把 buffer 扩容到 newBytes，保留原有 oldBytes 的内容
+		GLuint ReallocateBuffer(GLuint oldBuffer, size_t oldBytes, size_t newBytes)
+		{
+			GLuint newBuffer = 0;
+			glGenBuffers(1, &newBuffer);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+			glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+
+			if (oldBuffer && oldBytes > 0) {
+				glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+				glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			}
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+			if (oldBuffer) glDeleteBuffers(1, &oldBuffer);
+			return newBuffer;
+		}
+
+		// 重新把 VAO 指向当前的 VBO/IBO（创建或扩容后调用）
+		void SetupVertexArray()
+		{
+			RenderState::BindVertexArray(s_Pool.vao);
+
+			glBindBuffer(GL_ARRAY_BUFFER, s_Pool.vbo);
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+			glEnableVertexAttribArray(2);
+			glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_Pool.ibo);
+		}
+
+		void GrowVertices(uint32_t required)
+		{
+			uint32_t oldCapacity = s_Pool.vertices.GetCapacity();
+			uint32_t newCapacity = std::max(oldCapacity * 2, oldCapacity + required);
+			ITR_INFO("GeometryPool: growing vertex buffer {0} -> {1} vertices", oldCapacity, newCapacity);
+
+			s_Pool.vbo = ReallocateBuffer(s_Pool.vbo, (size_t)oldCapacity * sizeof(Vertex), (size_t)newCapacity * sizeof(Vertex));
+			s_Pool.vertices.Grow(newCapacity);
+			SetupVertexArray();
+		}
+
+		void GrowIndices(uint32_t required)
+		{
+			uint32_t oldCapacity = s_Pool.indices.GetCapacity();
+			uint32_t newCapacity = std::max(oldCapacity * 2, oldCapacity + required);
+			ITR_INFO("GeometryPool: growing index buffer {0} -> {1} indices", oldCapacity, newCapacity);
+
+			s_Pool.ibo = ReallocateBuffer(s_Pool.ibo, (size_t)oldCapacity * sizeof(uint32_t), (size_t)newCapacity * sizeof(uint32_t));
+			s_Pool.indices.Grow(newCapacity);
+			SetupVertexArray();
+		}
+	}
+
+	void GeometryPool::Init(uint32_t vertexCapacity, uint32_t indexCapacity)
+	{
+		if (s_Pool.initialized) return;
+
+		glGenVertexArrays(1, &s_Pool.vao);
+		s_Pool.vbo = ReallocateBuffer(0, 0, (size_t)vertexCapacity * sizeof(Vertex));
+		s_Pool.ibo = ReallocateBuffer(0, 0, (size_t)indexCapacity * sizeof(uint32_t));
+		s_Pool.vertices.Reset(vertexCapacity);
+		s_Pool.indices.Reset(indexCapacity);
+		s_Pool.instanceIndexBuffer = 0;
+		SetupVertexArray();
+
+		s_Pool.initialized = true;
+		ITR_INFO("GeometryPool initialized ({0} vertices, {1} indices)", vertexCapacity, indexCapacity);
+	}
+
+	void GeometryPool::Shutdown()
+	{
+		if (!s_Pool.initialized) return;
+
+		RenderState::DeleteVertexArrays(1, &s_Pool.vao);
+		glDeleteBuffers(1, &s_Pool.vbo);
+		glDeleteBuffers(1, &s_Pool.ibo);
+		s_Pool = GeometryPoolData();
+	}
+
+	GeometryAllocation GeometryPool::Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+	{
+		GeometryAllocation allocation;
+		if (vertices.empty() || indices.empty()) return allocation;
+
+		Init();
+
+		uint32_t vertexCount = (uint32_t)vertices.size();
+		uint32_t indexCount = (uint32_t)indices.size();
+
+		if (!s_Pool.vertices.Allocate(vertexCount, allocation.baseVertex)) {
+			GrowVertices(vertexCount);
+			s_Pool.vertices.Allocate(vertexCount, allocation.baseVertex);
+		}
+		if (!s_Pool.indices.Allocate(indexCount, allocation.firstIndex)) {
+			GrowIndices(indexCount);
+			s_Pool.indices.Allocate(indexCount, allocation.firstIndex);
+		}
+		allocation.vertexCount = vertexCount;
+		allocation.indexCount = indexCount;
+
+		// 索引保持 Mesh 内的局部编号，绘制时由 baseVertex 偏移
+		glBindBuffer(GL_ARRAY_BUFFER, s_Pool.vbo);
+		glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)allocation.baseVertex * sizeof(Vertex),
+			(GLsizeiptr)vertexCount * sizeof(Vertex), vertices.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, s_Pool.ibo);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.firstIndex * sizeof(uint32_t),
+			(GLsizeiptr)indexCount * sizeof(uint32_t), indices.data());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		return allocation;
+	}
+
+	GeometryAllocation GeometryPool::AllocateIndices(const GeometryAllocation& parent, const std::vector<unsigned int>& indices)
+	{
+		GeometryAllocation allocation;
+		if (!parent.IsValid() || indices.empty()) return allocation;
+
+		Init();
+
+		uint32_t indexCount = (uint32_t)indices.size();
+		if (!s_Pool.indices.Allocate(indexCount, allocation.firstIndex)) {
+			GrowIndices(indexCount);
+			s_Pool.indices.Allocate(indexCount, allocation.firstIndex);
+		}
+		allocation.baseVertex = parent.baseVertex;
+		allocation.vertexCount = parent.vertexCount;
+		allocation.indexCount = indexCount;
+		allocation.sharedVertices = true;
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, s_Pool.ibo);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.firstIndex * sizeof(uint32_t),
+			(GLsizeiptr)indexCount * sizeof(uint32_t), indices.data());
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		return allocation;
+	}
+
+	void GeometryPool::Free(const GeometryAllocation& allocation)
+	{
+		// Mesh 可能在 Renderer::Shutdown 之后才析构，此时池已释放
+		if (!s_Pool.initialized || !allocation.IsValid()) return;
+
+		if (!allocation.sharedVertices)
+			s_Pool.vertices.Free(allocation.baseVertex, allocation.vertexCount);
+		s_Pool.indices.Free(allocation.firstIndex, allocation.indexCount);
+	}
+
+	void GeometryPool::Bind(GLuint instanceIndexBuffer)
+	{
+		Init();
+		RenderState::BindVertexArray(s_Pool.vao);
+
+		if (instanceIndexBuffer && s_Pool.instanceIndexBuffer != instanceIndexBuffer) {
+			glBindBuffer(GL_ARRAY_BUFFER, instanceIndexBuffer);
+			glEnableVertexAttribArray(OBJECT_INDEX_LOCATION);
+			glVertexAttribIPointer(OBJECT_INDEX_LOCATION, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+			glVertexAttribDivisor(OBJECT_INDEX_LOCATION, 1);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			s_Pool.instanceIndexBuffer = instanceIndexBuffer;
+		}
+	}
+
+	GLuint GeometryPool::GetVertexArray()
+	{
+		return s_Pool.vao;
+	}
+
+	void GeometryPool::MultiDrawIndirect(uintptr_t commandOffset, uint32_t commandCount)
+	{
+		if (commandCount == 0) return;
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)commandOffset,
+			(GLsizei)commandCount, sizeof(DrawElementsIndirectCommand));
+	}
+
+	GeometryPool::Statistics GeometryPool::GetStats()
+	{
+		Statistics stats;
+		stats.vertexCapacity = s_Pool.vertices.GetCapacity();
+		stats.vertexUsed = s_Pool.vertices.GetUsed();
+		stats.indexCapacity = s_Pool.indices.GetCapacity();
+		stats.indexUsed = s_Pool.indices.GetUsed();
+		return stats;
+	}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include "Vertex.h"
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+namespace Intro {
+
+	// Mesh 在几何池中的区间（单位：顶点 / 索引）
+	struct GeometryAllocation
+	{
+		uint32_t baseVertex = 0;
+		uint32_t vertexCount = 0;
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		bool sharedVertices = false;	// 顶点区间属于另一个分配（LOD 只拥有自己的索引区间）
+
+		bool IsValid() const { return vertexCount > 0 && indexCount > 0; }
+	};
+
+	// glMultiDrawElementsIndirect 的命令格式（布局由 GL 规定）
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t count;
+		uint32_t instanceCount;
+		uint32_t firstIndex;
+		int32_t baseVertex;
+		uint32_t baseInstance;
+	};
+
+	// 静态几何池：所有 Mesh 的顶点/索引子分配到共享的大 VBO/IBO 中，使用同一个 VAO。
+	// 绘制时用 baseVertex/firstIndex 定位，不同 Mesh 之间无需切换 VAO，也可以合并为一次 MultiDrawIndirect。
+	class ITR_API GeometryPool
+	{
+	public:
+		// 首次分配时自动初始化；Renderer::Shutdown 中释放
+		static void Init(uint32_t vertexCapacity = 1u << 18, uint32_t indexCapacity = 1u << 20);
+		static void Shutdown();
+
+		static GeometryAllocation Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+		// 只分配索引区间，顶点沿用 parent 的区间（索引仍为 parent 内的局部编号）
+		static GeometryAllocation AllocateIndices(const GeometryAllocation& parent, const std::vector<unsigned int>& indices);
+		static void Free(const GeometryAllocation& allocation);
+
+		// 绑定共享 VAO，并确保实例索引属性指向 indexBuffer（只在缓冲变化时重新指定）
+		static void Bind(GLuint instanceIndexBuffer = 0);
+		static GLuint GetVertexArray();
+
+		// 用当前绑定的 GL_DRAW_INDIRECT_BUFFER 中从 commandOffset（字节）开始的 commandCount 条命令绘制
+		static void MultiDrawIndirect(uintptr_t commandOffset, uint32_t commandCount);
+
+		struct Statistics {
+			uint32_t vertexCapacity = 0;
+			uint32_t vertexUsed = 0;
+			uint32_t indexCapacity = 0;
+			uint32_t indexUsed = 0;
+		};
+		static Statistics GetStats();
+	};
+
+}
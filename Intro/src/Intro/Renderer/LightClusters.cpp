@@ -0,0 +1,283 @@
+#include "itrpch.h"
+#include "LightClusters.h"
+#include "ShadowMaps.h"
+#include "Cameras/Camera.h"
+#include "Intro/ECS/ECS.h"
+#include "Intro/ECS/Components.h"
+#include "Intro/Jobs/JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+
+namespace Intro {
+
+	namespace {
+
+		// 光源数量少于这个值时单线程分簇（线程调度的开销大于收益）
+		constexpr uint32_t ParallelLightThreshold = 64;
+
+		bool SphereIntersectsAABB(const glm::vec3& center, float radius, const glm::vec3& boxMin, const glm::vec3& boxMax)
+		{
+			float distanceSq = 0.0f;
+			for (int i = 0; i < 3; ++i) {
+				float v = center[i];
+				if (v < boxMin[i]) distanceSq += (boxMin[i] - v) * (boxMin[i] - v);
+				else if (v > boxMax[i]) distanceSq += (v - boxMax[i]) * (v - boxMax[i]);
+			}
+			return distanceSq <= radius * radius;
+		}
+
+		uint32_t NdcToTile(float ndc, uint32_t tiles)
+		{
+			int tile = (int)std::floor((ndc * 0.5f + 0.5f) * (float)tiles);
+			return (uint32_t)std::clamp(tile, 0, (int)tiles - 1);
+		}
+
+		// 对 orphan 后的缓冲整体重传；容量不足时按两倍增长
+		void UploadBuffer(GLuint buffer, size_t& capacity, const void* data, size_t bytes)
+		{
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+			if (bytes > capacity) capacity = std::max(bytes, capacity * 2);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)std::max<size_t>(capacity, 16), nullptr, GL_STREAM_DRAW);
+			if (bytes > 0) glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, (GLsizeiptr)bytes, data);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		}
+	}
+
+	LightClusters::LightClusters()
+	{
+		glGenBuffers(1, &m_LightBuffer);
+		glGenBuffers(1, &m_ClusterBuffer);
+		glGenBuffers(1, &m_IndexBuffer);
+
+		m_Clusters.resize(ClusterCount, LightClusterRange{ 0, 0 });
+		m_SliceLights.resize(LIGHT_CLUSTER_Z);
+		m_ClusterBounds.resize(ClusterCount);
+	}
+
+	LightClusters::~LightClusters()
+	{
+		if (m_LightBuffer) glDeleteBuffers(1, &m_LightBuffer);
+		if (m_ClusterBuffer) glDeleteBuffers(1, &m_ClusterBuffer);
+		if (m_IndexBuffer) glDeleteBuffers(1, &m_IndexBuffer);
+	}
+
+	void LightClusters::Update(ECS& ecs, Camera& camera, uint32_t viewportWidth, uint32_t viewportHeight, const ShadowMaps* shadows)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		m_ViewportSize = glm::vec2((float)std::max(viewportWidth, 1u), (float)std::max(viewportHeight, 1u));
+		m_Near = camera.GetNearClip();
+		m_Far = std::max(camera.GetFarClip(), m_Near * 2.0f);
+
+		glm::mat4 view = camera.GetViewMat();
+		glm::mat4 projection = camera.GetProjectionMat();
+		if (projection != m_CachedProjection) {
+			RebuildClusterBounds(projection, m_Near, m_Far);
+			m_CachedProjection = projection;
+		}
+
+		CollectLights(ecs, shadows);
+
+		// 每个光源先算出覆盖的簇范围，再按深度切片登记为候选
+		for (auto& slice : m_SliceLights) slice.clear();
+		m_LightBounds.resize(m_Lights.size());
+		for (uint32_t i = 0; i < (uint32_t)m_Lights.size(); ++i) {
+			if (!ComputeLightBounds(m_Lights[i], view, projection, m_LightBounds[i])) continue;
+			for (uint32_t z = m_LightBounds[i].minZ; z <= m_LightBounds[i].maxZ; ++z)
+				m_SliceLights[z].push_back(i);
+		}
+
+		// 深度切片按连续区间分块交给 JobSystem；每块只写自己切片内的簇和自己的输出数组，无需加锁
+		uint32_t workerCount = 1;
+		if (m_Lights.size() >= ParallelLightThreshold)
+			workerCount = std::min(JobSystem::GetThreadCount(), (uint32_t)LIGHT_CLUSTER_Z);
+		uint32_t slicesPerWorker = (LIGHT_CLUSTER_Z + workerCount - 1) / workerCount;
+		if (m_WorkerIndices.size() < workerCount) m_WorkerIndices.resize(workerCount);
+
+		JobSystem::ParallelFor(LIGHT_CLUSTER_Z, slicesPerWorker, [this, slicesPerWorker](uint32_t first, uint32_t end) {
+			BinSlices(first, end - 1, m_WorkerIndices[first / slicesPerWorker]);
+		});
+
+		// 把各线程的输出按簇顺序拼接，修正区间偏移
+		m_LightIndices.clear();
+		m_Stats.maxLightsPerCluster = 0;
+		m_Stats.activeClusters = 0;
+		const uint32_t clustersPerSlice = LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y;
+		for (uint32_t w = 0; w < workerCount; ++w) {
+			uint32_t first = w * slicesPerWorker;
+			uint32_t last = std::min(first + slicesPerWorker, (uint32_t)LIGHT_CLUSTER_Z);
+			if (first >= last) continue;
+
+			uint32_t base = (uint32_t)m_LightIndices.size();
+			for (uint32_t c = first * clustersPerSlice; c < last * clustersPerSlice; ++c) {
+				m_Clusters[c].offset += base;
+				m_Stats.maxLightsPerCluster = std::max(m_Stats.maxLightsPerCluster, m_Clusters[c].count);
+				if (m_Clusters[c].count > 0) m_Stats.activeClusters++;
+			}
+			m_LightIndices.insert(m_LightIndices.end(), m_WorkerIndices[w].begin(), m_WorkerIndices[w].end());
+		}
+
+		m_Stats.lightCount = (uint32_t)m_Lights.size();
+		m_Stats.indexCount = (uint32_t)m_LightIndices.size();
+		m_Stats.workerCount = workerCount;
+		m_Stats.binningMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		Upload();
+	}
+
+	void LightClusters::Bind() const
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_SSBO_BINDING, m_LightBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_CLUSTER_SSBO_BINDING, m_ClusterBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_INDEX_SSBO_BINDING, m_IndexBuffer);
+	}
+
+	glm::vec4 LightClusters::GetClusterParams() const
+	{
+		float logRatio = std::log(m_Far / m_Near);
+		float scale = (float)LIGHT_CLUSTER_Z / logRatio;
+		float bias = -(float)LIGHT_CLUSTER_Z * std::log(m_Near) / logRatio;
+		return glm::vec4(scale, bias, m_Near, m_Far);
+	}
+
+	void LightClusters::CollectLights(ECS& ecs, const ShadowMaps* shadows)
+	{
+		m_Lights.clear();
+		auto view = ecs.GetRegistry().view<LocalToWorldComponent, LightComponent>();
+		for (auto [entity, ltw, light] : view.each()) {
+			if (light.Type == LightType::Directional) continue;
+
+			LightGPU gpu;
+			gpu.positionRange = glm::vec4(ltw.GetPosition(), light.Range);
+			gpu.colorType = glm::vec4(light.Color * light.Intensity, light.Type == LightType::Spot ? 1.0f : 0.0f);
+
+			glm::vec3 worldDirection = ltw.TransformDirection(glm::normalize(light.Direction));
+			gpu.directionOuterCos = glm::vec4(worldDirection, glm::cos(glm::radians(light.SpotAngle)));
+			float shadowIndex = shadows ? (float)shadows->GetLocalShadowIndex((uint32_t)entity) : -1.0f;
+			gpu.params = glm::vec4(glm::cos(glm::radians(light.InnerSpotAngle)), shadowIndex, 0.0f, 0.0f);
+			m_Lights.push_back(gpu);
+		}
+	}
+
+	void LightClusters::RebuildClusterBounds(const glm::mat4& projection, float nearClip, float farClip)
+	{
+		glm::mat4 inverseProjection = glm::inverse(projection);
+
+		// NDC 中的点反投影成视图空间的视线方向（z = -1 处），再缩放到指定深度
+		auto viewRay = [&](float ndcX, float ndcY) {
+			glm::vec4 p = inverseProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+			glm::vec3 v = glm::vec3(p) / p.w;
+			return v / -v.z;
+		};
+
+		for (uint32_t z = 0; z < LIGHT_CLUSTER_Z; ++z) {
+			float sliceNear = nearClip * std::pow(farClip / nearClip, (float)z / (float)LIGHT_CLUSTER_Z);
+			float sliceFar = nearClip * std::pow(farClip / nearClip, (float)(z + 1) / (float)LIGHT_CLUSTER_Z);
+
+			for (uint32_t y = 0; y < LIGHT_CLUSTER_Y; ++y) {
+				float y0 = (float)y / LIGHT_CLUSTER_Y * 2.0f - 1.0f;
+				float y1 = (float)(y + 1) / LIGHT_CLUSTER_Y * 2.0f - 1.0f;
+				for (uint32_t x = 0; x < LIGHT_CLUSTER_X; ++x) {
+					float x0 = (float)x / LIGHT_CLUSTER_X * 2.0f - 1.0f;
+					float x1 = (float)(x + 1) / LIGHT_CLUSTER_X * 2.0f - 1.0f;
+
+					const glm::vec3 rays[4] = { viewRay(x0, y0), viewRay(x1, y0), viewRay(x0, y1), viewRay(x1, y1) };
+					ClusterAABB box{ glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+					for (const glm::vec3& ray : rays) {
+						box.min = glm::min(box.min, glm::min(ray * sliceNear, ray * sliceFar));
+						box.max = glm::max(box.max, glm::max(ray * sliceNear, ray * sliceFar));
+					}
+					m_ClusterBounds[(z * LIGHT_CLUSTER_Y + y) * LIGHT_CLUSTER_X + x] = box;
+				}
+			}
+		}
+	}
+
+	bool LightClusters::ComputeLightBounds(const LightGPU& light, const glm::mat4& view, const glm::mat4& projection, LightBounds& out) const
+	{
+		glm::vec3 center = glm::vec3(light.positionRange);
+		float range = light.positionRange.w;
+		float radius = range;
+
+		// 聚光灯用圆锥的最小包围球
+		if (light.colorType.w > 0.5f) {
+			glm::vec3 direction = glm::normalize(glm::vec3(light.directionOuterCos));
+			float cosAngle = std::clamp(light.directionOuterCos.w, 0.01f, 1.0f);
+			if (cosAngle < 0.70710678f) {
+				center += direction * (range * cosAngle);
+				radius = range * std::sqrt(1.0f - cosAngle * cosAngle);
+			}
+			else {
+				radius = range / (2.0f * cosAngle);
+				center += direction * radius;
+			}
+		}
+
+		glm::vec3 viewCenter = glm::vec3(view * glm::vec4(center, 1.0f));
+		float depth = -viewCenter.z;
+		if (depth + radius < m_Near || depth - radius > m_Far) return false;
+
+		// 包围盒的 8 个角点投影到 NDC（近平面之后的部分截到近平面上），得到保守的屏幕范围
+		glm::vec2 ndcMin(FLT_MAX), ndcMax(-FLT_MAX);
+		for (int i = 0; i < 8; ++i) {
+			glm::vec3 corner = viewCenter + glm::vec3((i & 1) ? radius : -radius, (i & 2) ? radius : -radius, (i & 4) ? radius : -radius);
+			corner.z = std::min(corner.z, -m_Near);
+			glm::vec4 clip = projection * glm::vec4(corner, 1.0f);
+			glm::vec2 ndc = glm::vec2(clip) / clip.w;
+			ndcMin = glm::min(ndcMin, ndc);
+			ndcMax = glm::max(ndcMax, ndc);
+		}
+		if (ndcMin.x > 1.0f || ndcMax.x < -1.0f || ndcMin.y > 1.0f || ndcMax.y < -1.0f) return false;
+
+		out.center = viewCenter;
+		out.radius = radius;
+		out.minX = NdcToTile(ndcMin.x, LIGHT_CLUSTER_X);
+		out.maxX = NdcToTile(ndcMax.x, LIGHT_CLUSTER_X);
+		out.minY = NdcToTile(ndcMin.y, LIGHT_CLUSTER_Y);
+		out.maxY = NdcToTile(ndcMax.y, LIGHT_CLUSTER_Y);
+		out.minZ = SliceForDepth(std::max(depth - radius, m_Near));
+		out.maxZ = SliceForDepth(std::min(depth + radius, m_Far));
+		return true;
+	}
+
+	uint32_t LightClusters::SliceForDepth(float viewDepth) const
+	{
+		float slice = std::log(viewDepth / m_Near) * (float)LIGHT_CLUSTER_Z / std::log(m_Far / m_Near);
+		return (uint32_t)std::clamp((int)std::floor(slice), 0, (int)LIGHT_CLUSTER_Z - 1);
+	}
+
+	void LightClusters::BinSlices(uint32_t firstSlice, uint32_t lastSlice, std::vector<uint32_t>& outIndices)
+	{
+		outIndices.clear();
+		for (uint32_t z = firstSlice; z <= lastSlice; ++z) {
+			const std::vector<uint32_t>& candidates = m_SliceLights[z];
+			for (uint32_t y = 0; y < LIGHT_CLUSTER_Y; ++y) {
+				for (uint32_t x = 0; x < LIGHT_CLUSTER_X; ++x) {
+					uint32_t cluster = (z * LIGHT_CLUSTER_Y + y) * LIGHT_CLUSTER_X + x;
+					const ClusterAABB& box = m_ClusterBounds[cluster];
+					uint32_t offset = (uint32_t)outIndices.size();
+
+					for (uint32_t index : candidates) {
+						const LightBounds& bounds = m_LightBounds[index];
+						if (x < bounds.minX || x > bounds.maxX || y < bounds.minY || y > bounds.maxY) continue;
+						if (SphereIntersectsAABB(bounds.center, bounds.radius, box.min, box.max))
+							outIndices.push_back(index);
+					}
+
+					// 偏移先相对于本线程的输出，拼接时再加上基址
+					m_Clusters[cluster] = { offset, (uint32_t)outIndices.size() - offset };
+				}
+			}
+		}
+	}
+
+	void LightClusters::Upload()
+	{
+		UploadBuffer(m_LightBuffer, m_LightCapacity, m_Lights.data(), m_Lights.size() * sizeof(LightGPU));
+		size_t clusterCapacity = 0;
+		UploadBuffer(m_ClusterBuffer, clusterCapacity, m_Clusters.data(), m_Clusters.size() * sizeof(LightClusterRange));
+		UploadBuffer(m_IndexBuffer, m_IndexCapacity, m_LightIndices.data(), m_LightIndices.size() * sizeof(uint32_t));
+	}
+
+}
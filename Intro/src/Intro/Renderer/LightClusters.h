@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include "RenderConstant.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Intro {
+
+	class ECS;
+	class Camera;
+	class ShadowMaps;
+
+	// 点光源与聚光灯的 GPU 数据（与 shader 中 std430 的 Light 布局一致）
+	struct LightGPU
+	{
+		glm::vec4 positionRange;		// xyz = 世界坐标, w = range
+		glm::vec4 colorType;			// rgb = color * intensity, w = 类型（0 点光源，1 聚光灯）
+		glm::vec4 directionOuterCos;	// xyz = 世界空间朝向, w = cos(外角)
+		glm::vec4 params;				// x = cos(内角), y = 阴影在 LocalShadowGPU 数组中的下标（-1 表示无阴影）
+	};
+	static_assert(sizeof(LightGPU) == 64, "LightGPU must match the std430 layout in the shaders");
+
+	// 簇在光源索引表中的区间（std430 下为 uvec2）
+	struct LightClusterRange
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	// 分簇前向光照：
+	// - 视锥按屏幕 LIGHT_CLUSTER_X x LIGHT_CLUSTER_Y 个块、深度方向 LIGHT_CLUSTER_Z 个指数切片划分成簇
+	// - CPU 上把每个光源的包围球分配到与之相交的簇，按深度切片分给多个线程并行处理
+	// - 光源数组、每簇的区间和压缩后的光源索引表通过三个 SSBO 上传，片元只计算自己所在簇的光源
+	class ITR_API LightClusters
+	{
+	public:
+		LightClusters();
+		~LightClusters();
+
+		LightClusters(const LightClusters&) = delete;
+		LightClusters& operator=(const LightClusters&) = delete;
+
+		// 收集场景中的点光源/聚光灯，按当前相机分簇并上传（shadows 提供各光源的阴影下标）
+		void Update(ECS& ecs, Camera& camera, uint32_t viewportWidth, uint32_t viewportHeight, const ShadowMaps* shadows = nullptr);
+		// 绑定到 LIGHT_SSBO_BINDING / LIGHT_CLUSTER_SSBO_BINDING / LIGHT_INDEX_SSBO_BINDING
+		void Bind() const;
+
+		// 写入 LightsUBO 的网格参数：x = scale, y = bias（slice = log(viewZ) * scale + bias）
+		glm::vec4 GetClusterParams() const;
+		glm::vec2 GetViewportSize() const { return m_ViewportSize; }
+		uint32_t GetLightCount() const { return (uint32_t)m_Lights.size(); }
+
+		struct Statistics {
+			uint32_t lightCount = 0;
+			uint32_t indexCount = 0;			// 所有簇的光源引用总数
+			uint32_t maxLightsPerCluster = 0;
+			uint32_t activeClusters = 0;		// 至少有一个光源的簇
+			uint32_t workerCount = 0;
+			float binningMs = 0.0f;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+		static constexpr uint32_t ClusterCount = LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z;
+
+	private:
+		// 光源在视图空间的包围球及其覆盖的簇范围
+		struct LightBounds {
+			glm::vec3 center;
+			float radius;
+			uint32_t minX, maxX, minY, maxY, minZ, maxZ;
+		};
+
+		struct ClusterAABB {
+			glm::vec3 min;
+			glm::vec3 max;
+		};
+
+		void CollectLights(ECS& ecs, const ShadowMaps* shadows);
+		void RebuildClusterBounds(const glm::mat4& projection, float nearClip, float farClip);
+		bool ComputeLightBounds(const LightGPU& light, const glm::mat4& view, const glm::mat4& projection, LightBounds& out) const;
+		uint32_t SliceForDepth(float viewDepth) const;
+		void BinSlices(uint32_t firstSlice, uint32_t lastSlice, std::vector<uint32_t>& outIndices);
+		void Upload();
+
+		std::vector<LightGPU> m_Lights;
+		std::vector<LightBounds> m_LightBounds;
+		std::vector<std::vector<uint32_t>> m_SliceLights;	// 每个深度切片的候选光源
+		std::vector<std::vector<uint32_t>> m_WorkerIndices;	// 每个线程输出的光源索引（按簇顺序）
+		std::vector<LightClusterRange> m_Clusters;
+		std::vector<uint32_t> m_LightIndices;
+
+		// 簇的视图空间 AABB，投影或近远平面变化时重建
+		std::vector<ClusterAABB> m_ClusterBounds;
+		glm::mat4 m_CachedProjection = glm::mat4(0.0f);
+
+		float m_Near = 0.1f;
+		float m_Far = 1000.0f;
+		glm::vec2 m_ViewportSize = glm::vec2(1.0f);
+
+		GLuint m_LightBuffer = 0;
+		GLuint m_ClusterBuffer = 0;
+		GLuint m_IndexBuffer = 0;
+		size_t m_LightCapacity = 0;
+		size_t m_IndexCapacity = 0;
+
+		Statistics m_Stats;
+	};
+
+}
@@ -0,0 +1,108 @@
+#include "itrpch.h"
+#include "LodSelector.h"
+#include "Mesh.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Intro {
+
+	void LodSelector::BeginFrame(const glm::mat4& projection, uint32_t viewportHeight, const glm::vec3& cameraPosition, const Settings& settings)
+	{
+		m_Frame++;
+		m_CameraPosition = cameraPosition;
+		m_PixelScale = projection[1][1] * 0.5f * (float)std::max(viewportHeight, 1u);
+		m_Settings = settings;
+		m_Stats = Statistics();
+	}
+
+	uint32_t LodSelector::CoarsestLevel(const Mesh& mesh, float pixelsPerUnit, float threshold) const
+	{
+		const auto& lods = mesh.GetLods();
+		uint32_t level = 0;
+		for (uint32_t i = 0; i < (uint32_t)lods.size() && i + 1 < MaxLevels; ++i) {
+			// 各级误差随级数单调增加，一旦超出阈值更粗的也不会满足
+			if (lods[i].error * pixelsPerUnit > threshold) break;
+			level = i + 1;
+		}
+		return level;
+	}
+
+	LodSelector::Selection LodSelector::Select(uint64_t key, const Mesh& mesh, const glm::mat4& transform)
+	{
+		Selection selection;
+
+		// 世界空间包围球：误差按最大轴缩放放大
+		const BoundingSphere& localSphere = mesh.GetBoundingSphere();
+		float scale = std::sqrt(std::max({ glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+			glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+			glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2])) }));
+		glm::vec3 center = glm::vec3(transform * glm::vec4(localSphere.center, 1.0f));
+		float distance = glm::length(center - m_CameraPosition) - localSphere.radius * scale;
+
+		// 相机位于包围球内时总是使用最细的一级
+		uint32_t desired = 0;
+		float pixelsPerUnit = 0.0f;
+		if (distance > 1e-4f) {
+			pixelsPerUnit = scale * m_PixelScale / distance;
+			desired = CoarsestLevel(mesh, pixelsPerUnit, m_Settings.pixelError);
+		}
+
+		auto [it, inserted] = m_States.try_emplace(key);
+		State& state = it->second;
+		if (inserted) {
+			// 首次出现直接使用目标级别，不淡入
+			state.level = desired;
+			state.previousLevel = desired;
+		}
+		else if (desired < state.level || (desired > state.level && pixelsPerUnit > 0.0f)) {
+			uint32_t next = desired;
+			if (desired > state.level) {
+				// 变粗需要留出迟滞余量
+				next = CoarsestLevel(mesh, pixelsPerUnit, m_Settings.pixelError * (1.0f - m_Settings.hysteresis));
+				next = std::max(next, state.level);
+			}
+			if (next != state.level) {
+				state.previousLevel = state.level;
+				state.level = next;
+				state.fadeFrame = m_Settings.crossFade ? 0 : FadeFrames;
+			}
+		}
+		state.level = std::min(state.level, mesh.GetLodCount() - 1);
+		state.lastFrame = m_Frame;
+
+		selection.level = state.level;
+		if (state.fadeFrame < FadeFrames && state.previousLevel < mesh.GetLodCount() && state.previousLevel != state.level) {
+			state.fadeFrame++;
+			selection.fading = true;
+			selection.previousLevel = state.previousLevel;
+			selection.fade = (float)state.fadeFrame / (float)(FadeFrames + 1);
+			m_Stats.fadingCount++;
+		}
+		else {
+			state.fadeFrame = FadeFrames;
+			selection.previousLevel = state.level;
+		}
+
+		m_Stats.levelCounts[selection.level]++;
+		m_Stats.fullTriangles += mesh.GetGeometry().indexCount / 3;
+		const Mesh& selected = selection.level == 0 ? mesh : *mesh.GetLods()[selection.level - 1].mesh;
+		m_Stats.selectedTriangles += selected.GetGeometry().indexCount / 3;
+		return selection;
+	}
+
+	void LodSelector::EndFrame()
+	{
+		// 连续若干帧没有被选择（被剔除或已删除）的条目重新出现时按首次出现处理
+		for (auto it = m_States.begin(); it != m_States.end();) {
+			if (m_Frame - it->second.lastFrame > FadeFrames) it = m_States.erase(it);
+			else ++it;
+		}
+	}
+
+	uint32_t LodSelector::PackFade(float visibleFraction, bool fadingOut)
+	{
+		uint32_t value = (uint32_t)(glm::clamp(visibleFraction, 0.0f, 1.0f) * 65535.0f + 0.5f);
+		return value | (fadingOut ? 0x10000u : 0u);
+	}
+
+}
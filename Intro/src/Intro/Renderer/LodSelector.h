@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Intro {
+
+	class Mesh;
+
+	// 每帧为带 LOD 链的 Mesh 选择细节层次：
+	// - 每级的局部空间误差乘以模型缩放，再按透视投影换算成屏幕像素；选择误差不超过 pixelError 的最粗一级
+	// - 迟滞：换成更粗的一级时误差必须低于 pixelError * (1 - hysteresis)，换成更细的一级立即生效，避免在阈值附近来回切换
+	// - 可选的交叉淡化：切换后 FadeFrames 帧内新旧两级同时绘制，片元着色器按屏幕抖动图案互补地丢弃片元
+	// 选择结果按 (实体, Mesh) 记录，EndFrame 清理不再可见的条目
+	class ITR_API LodSelector
+	{
+	public:
+		static constexpr uint32_t MaxLevels = 8;
+		static constexpr uint32_t FadeFrames = 12;
+
+		struct Settings {
+			float pixelError = 1.0f;
+			float hysteresis = 0.2f;
+			bool crossFade = false;
+		};
+
+		struct Selection {
+			uint32_t level = 0;
+			uint32_t previousLevel = 0;		// fading 时为正在淡出的一级
+			float fade = 1.0f;				// 新一级的可见比例 [0, 1]
+			bool fading = false;
+		};
+
+		// projection 用于取 y 方向的焦距（projection[1][1]），viewportHeight 为像素高度
+		void BeginFrame(const glm::mat4& projection, uint32_t viewportHeight, const glm::vec3& cameraPosition, const Settings& settings);
+		Selection Select(uint64_t key, const Mesh& mesh, const glm::mat4& transform);
+		void EndFrame();
+
+		// 打包写入对象数据 ids.z：低 16 位为可见比例，第 16 位表示淡出（使用互补的抖动图案）
+		static uint32_t PackFade(float visibleFraction, bool fadingOut);
+
+		static uint64_t MakeKey(uint32_t objectID, uint32_t meshID) { return ((uint64_t)objectID << 32) | meshID; }
+
+		struct Statistics {
+			uint32_t levelCounts[MaxLevels] = {};
+			uint32_t fadingCount = 0;
+			uint64_t fullTriangles = 0;		// 全部使用第 0 级时的三角形数
+			uint64_t selectedTriangles = 0;	// 实际选择的各级三角形数
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		struct State {
+			uint32_t level = 0;
+			uint32_t previousLevel = 0;
+			uint32_t fadeFrame = FadeFrames;	// 等于 FadeFrames 时没有淡化
+			uint64_t lastFrame = 0;
+		};
+
+		// 屏幕上误差不超过 threshold 像素的最粗一级
+		uint32_t CoarsestLevel(const Mesh& mesh, float pixelsPerUnit, float threshold) const;
+
+		std::unordered_map<uint64_t, State> m_States;
+		glm::vec3 m_CameraPosition = glm::vec3(0.0f);
+		float m_PixelScale = 0.0f;		// projection[1][1] * 0.5 * viewportHeight
+		Settings m_Settings;
+		uint64_t m_Frame = 0;
+
+		Statistics m_Stats;
+	};
+
+}
@@ -2,7 +2,9 @@
 
 #include "Shader.h"
 #include "Texture.h"
+#include "RenderState.h"
 #include <memory>
+#include <atomic>
 #include <glm/glm.hpp>
 
 namespace Intro {
@@ -13,7 +15,7 @@ namespace Intro {
             : m_Shader(std::move(shader)), m_Diffuse(nullptr), m_Specular(nullptr),
             m_Shininess(32.0f), m_Ambient(glm::vec3(0.2f))
         {
-            //  shader ڹʱѾãһĬ sampler ָȫ
+            // 如果 shader 在构造时已经可用，做一次默认 sampler 指定（安全）
             if (m_Shader) {
                 m_Shader->Bind();
                 m_Shader->SetUniformInt("material_diffuse", 0);
@@ -21,56 +23,48 @@ namespace Intro {
             }
         }
 
-        // Bind: ÿλʱãȷ shader Ѱ󶨲 sampler/texture ȷ
+        virtual ~Material() = default;
+
+        // Bind: 每次绘制时调用，确保 shader 已绑定并 sampler/texture 正确设置
         virtual void Bind() {
             auto shaderPtr = GetShader();
             if (!shaderPtr) return;
             shaderPtr->Bind();
-            GLuint program = shaderPtr->GetShaderID();
-
-            // ֳֶ֧ sampler ƣԣ
-            const char* diffuseNames[] = { "material_diffuse", "texture_diffuse1", "texture_diffuse", nullptr };
-            const char* specNames[] = { "material_specular", "texture_specular1", "texture_specular", nullptr };
-
-            for (int i = 0; diffuseNames[i] != nullptr; ++i) {
-                GLint loc = glGetUniformLocation(program, diffuseNames[i]);
-                if (loc >= 0) {
-                    glUniform1i(loc, 0); // diffuse -> unit 0
-                }
-            }
-            for (int i = 0; specNames[i] != nullptr; ++i) {
-                GLint loc = glGetUniformLocation(program, specNames[i]);
-                if (loc >= 0) {
-                    glUniform1i(loc, 1); // specular -> unit 1
-                }
-            }
-
-            //  uniform shader ʹã
-            GLint locSh = glGetUniformLocation(program, "material_shininess");
-            if (locSh >= 0) glUniform1f(locSh, m_Shininess);
 
-            GLint locAmb = glGetUniformLocation(program, "u_AmbientColor");
-            if (locAmb >= 0) glUniform3f(locAmb, m_Ambient.r, m_Ambient.g, m_Ambient.b);
-
-            //  1x1 ɫ󱸣
+            // 名称哈希在编译期计算，查询只走 Shader 的反射表；值未变化时 setter 不会调用 GL
+            static constexpr uint32_t diffuseNames[] = {
+                Shader::HashName("material_diffuse"), Shader::HashName("texture_diffuse1"), Shader::HashName("texture_diffuse") };
+            static constexpr uint32_t specNames[] = {
+                Shader::HashName("material_specular"), Shader::HashName("texture_specular1"), Shader::HashName("texture_specular") };
+            static constexpr uint32_t shininessName = Shader::HashName("material_shininess");
+            static constexpr uint32_t ambientName = Shader::HashName("u_AmbientColor");
+
+            // 支持多种常见 sampler 名称（兼容性）
+            for (uint32_t hash : diffuseNames)
+                shaderPtr->SetUniformInt(shaderPtr->GetUniformHandle(hash), 0); // diffuse -> unit 0
+            for (uint32_t hash : specNames)
+                shaderPtr->SetUniformInt(shaderPtr->GetUniformHandle(hash), 1); // specular -> unit 1
+
+            // 其它材质 uniform（如果 shader 使用）
+            shaderPtr->SetUniformFloat(shaderPtr->GetUniformHandle(shininessName), m_Shininess);
+            shaderPtr->SetUniformVec3(shaderPtr->GetUniformHandle(ambientName), m_Ambient);
+
+            // 绑定纹理（若无纹理则绑定 1x1 白色后备）
             GLuint white = GetOrCreateWhiteTexture();
 
             GLuint diffuseID = white;
             GLuint specID = white;
 
             if (m_Diffuse) {
-                // Texture ṩ GetID()  GetRendererID()
+                // Texture 类可能提供 GetID() 或 GetRendererID()
                 diffuseID = m_Diffuse->GetID();
             }
             if (m_Specular) {
                 specID = m_Specular->GetID();
             }
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, diffuseID);
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, specID);
-            glActiveTexture(GL_TEXTURE0);
+            RenderState::BindTexture(0, GL_TEXTURE_2D, diffuseID);
+            RenderState::BindTexture(1, GL_TEXTURE_2D, specID);
         }
 
         // setters / getters
@@ -82,30 +76,45 @@ namespace Intro {
         virtual std::shared_ptr<Texture> GetDiffuseTexture() const { return m_Diffuse; }
         std::shared_ptr<Texture> GetSpecularTexture() const { return m_Specular; }
 
-        // ݾ
+        // 兼容旧名
         std::shared_ptr<Texture> GetDiffuseTextureID() const { return m_Diffuse; }
         std::shared_ptr<Texture> GetSpecularTextureID() const { return m_Specular; }
 
+        // 材质唯一 ID（创建时分配，用于渲染排序键）
+        uint32_t GetMaterialID() const { return m_MaterialID; }
+
+        // 绑定键：shader 相同且绑定键相同的材质共享全部 GPU 绑定状态，相互切换时无需再次 Bind
+        // 普通材质的参数都在 uniform 中，因此每个材质各不相同
+        virtual uint64_t GetBindingKey() const { return m_MaterialID; }
+        // 材质参数表（MaterialTable）中的槽位，写入每个对象的数据；0 表示不使用参数表
+        virtual uint32_t GetGPUMaterialIndex() const { return 0; }
+
         float GetShininess() const { return m_Shininess; }
         std::shared_ptr<Shader> GetShader() const { return m_Shader; }
         glm::vec3 GetAmbient() const { return m_Ambient; }
 
-        // һ 1x1 ɫ
+        // 创建并返回一个 1x1 白色后备纹理（单例）
         static GLuint GetOrCreateWhiteTexture() {
             static GLuint whiteTex = 0;
             if (whiteTex == 0) {
                 glGenTextures(1, &whiteTex);
-                glBindTexture(GL_TEXTURE_2D, whiteTex);
+                RenderState::BindTexture(GL_TEXTURE_2D, whiteTex);
                 unsigned char white[4] = { 255,255,255,255 };
                 glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                RenderState::BindTexture(GL_TEXTURE_2D, 0);
             }
             return whiteTex;
         }
 
     private:
+        static uint32_t AllocateMaterialID() {
+            static std::atomic<uint32_t> nextID{ 1 };
+            return nextID++;
+        }
+
+        uint32_t m_MaterialID = AllocateMaterialID();
         std::shared_ptr<Shader> m_Shader;
         std::shared_ptr<Texture> m_Diffuse;
         std::shared_ptr<Texture> m_Specular;
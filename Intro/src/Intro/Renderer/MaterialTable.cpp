@@ -0,0 +1,109 @@
+#include "itrpch.h"
+#include "MaterialTable.h"
+#include "RenderConstant.h"
+
+namespace Intro {
+
+	namespace {
+
+		struct MaterialTableData
+		{
+			std::vector<GPUMaterialData> materials{ GPUMaterialData() };	// 槽位 0：默认材质
+			std::vector<uint32_t> freeSlots;
+			uint32_t liveCount = 0;
+
+			GLuint buffer = 0;
+			size_t bufferCapacity = 0;		// 以材质个数计
+			uint32_t dirtyBegin = 0;
+			uint32_t dirtyEnd = 1;			// [dirtyBegin, dirtyEnd)
+		};
+
+		MaterialTableData s_Table;
+
+		void MarkDirty(uint32_t slot)
+		{
+			if (s_Table.dirtyBegin >= s_Table.dirtyEnd) {
+				s_Table.dirtyBegin = slot;
+				s_Table.dirtyEnd = slot + 1;
+				return;
+			}
+			s_Table.dirtyBegin = std::min(s_Table.dirtyBegin, slot);
+			s_Table.dirtyEnd = std::max(s_Table.dirtyEnd, slot + 1);
+		}
+	}
+
+	uint32_t MaterialTable::Register()
+	{
+		uint32_t slot;
+		if (!s_Table.freeSlots.empty()) {
+			slot = s_Table.freeSlots.back();
+			s_Table.freeSlots.pop_back();
+			s_Table.materials[slot] = GPUMaterialData();
+		}
+		else {
+			slot = (uint32_t)s_Table.materials.size();
+			s_Table.materials.emplace_back();
+		}
+		s_Table.liveCount++;
+		MarkDirty(slot);
+		return slot;
+	}
+
+	void MaterialTable::Unregister(uint32_t slot)
+	{
+		if (slot == 0 || slot >= s_Table.materials.size()) return;
+		s_Table.freeSlots.push_back(slot);
+		s_Table.liveCount--;
+	}
+
+	void MaterialTable::Update(uint32_t slot, const GPUMaterialData& data)
+	{
+		if (slot >= s_Table.materials.size()) return;
+		s_Table.materials[slot] = data;
+		MarkDirty(slot);
+	}
+
+	void MaterialTable::Upload()
+	{
+		size_t count = s_Table.materials.size();
+
+		// 容量不足：重建缓冲并整体上传
+		if (count > s_Table.bufferCapacity) {
+			if (!s_Table.buffer) glGenBuffers(1, &s_Table.buffer);
+			s_Table.bufferCapacity = std::max(count, std::max<size_t>(s_Table.bufferCapacity * 2, 64));
+
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, s_Table.buffer);
+			glBufferData(GL_SHADER_STORAGE_BUFFER, s_Table.bufferCapacity * sizeof(GPUMaterialData), nullptr, GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+			s_Table.dirtyBegin = 0;
+			s_Table.dirtyEnd = (uint32_t)count;
+		}
+
+		if (s_Table.dirtyBegin < s_Table.dirtyEnd) {
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, s_Table.buffer);
+			glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+				(GLintptr)s_Table.dirtyBegin * sizeof(GPUMaterialData),
+				(GLsizeiptr)(s_Table.dirtyEnd - s_Table.dirtyBegin) * sizeof(GPUMaterialData),
+				s_Table.materials.data() + s_Table.dirtyBegin);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			s_Table.dirtyBegin = s_Table.dirtyEnd = 0;
+		}
+
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MATERIAL_SSBO_BINDING, s_Table.buffer);
+	}
+
+	void MaterialTable::Shutdown()
+	{
+		if (s_Table.buffer) glDeleteBuffers(1, &s_Table.buffer);
+		s_Table.buffer = 0;
+		s_Table.bufferCapacity = 0;
+		// 材质可能晚于渲染器析构，保留 CPU 镜像与槽位分配；下次 Upload 会整体重传
+	}
+
+	uint32_t MaterialTable::GetMaterialCount()
+	{
+		return s_Table.liveCount;
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Intro {
+
+	// 单个 PBR 材质的 GPU 参数（与 pbrShader 中 std430 的 MaterialData 布局一致）
+	struct GPUMaterialData
+	{
+		glm::vec4 albedoMetallic = glm::vec4(0.5f, 0.5f, 0.5f, 0.0f);		// rgb = albedo, a = metallic
+		glm::vec4 emissiveRoughness = glm::vec4(0.0f, 0.0f, 0.0f, 0.5f);	// rgb = emissive, a = roughness
+		glm::vec4 params = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);				// x = ao, y = exposure, z = opacity
+		glm::ivec4 layers0 = glm::ivec4(-1, -1, -1, -1);	// albedo/normal/metallic/roughness 贴图所在数组层，-1 表示不使用
+		glm::ivec4 layers1 = glm::ivec4(-1, -1, -1, -1);	// ao/emissive 贴图所在数组层
+	};
+	static_assert(sizeof(GPUMaterialData) == 80, "GPUMaterialData must match the std430 layout in the shaders");
+
+	// 材质参数表：所有 PBR 材质的参数存放在同一个 SSBO 中，按槽位索引。
+	// 槽位通过对象数据（ObjectData::ids.y）传给 shader，切换材质不再需要重新上传 uniform。
+	// CPU 端保存镜像，只把脏区间在下一次 Upload 时提交。
+	class ITR_API MaterialTable
+	{
+	public:
+		// 分配/释放槽位（槽位 0 保留为默认材质）
+		static uint32_t Register();
+		static void Unregister(uint32_t slot);
+
+		static void Update(uint32_t slot, const GPUMaterialData& data);
+
+		// 上传脏区间并绑定到 MATERIAL_SSBO_BINDING（每次 Flush 前调用，无变化时为空操作）
+		static void Upload();
+		static void Shutdown();
+
+		static uint32_t GetMaterialCount();
+	};
+
+}
@@ -1,17 +1,94 @@
 #include "itrpch.h"
 #include "Mesh.h"
+#include "RenderConstant.h"
+#include "RenderState.h"
+#include "MeshSimplifier.h"
 #include <glad/glad.h>
+#include <atomic>
 
 namespace Intro {
+
+	static std::atomic<uint32_t> s_NextMeshID{ 1 };
+
+	Mesh::Mesh(const Mesh& parent, std::vector<unsigned int> indices)
+		:Indices(std::move(indices)), m_Textures(parent.m_Textures),
+		m_Bounds(parent.m_Bounds), m_BoundingSphere(parent.m_BoundingSphere)
+	{
+		// 每个 LOD 有独立的 ID，排序与实例合并时和原网格区分开
+		m_MeshID = s_NextMeshID++;
+		m_Geometry = GeometryPool::AllocateIndices(parent.m_Geometry, Indices);
+	}
 	
+	Mesh::~Mesh()
+	{
+		// LOD 先于原网格释放（只释放自己的索引区间）
+		m_Lods.clear();
+		GeometryPool::Free(m_Geometry);
+	}
+
+	void Mesh::GenerateLods(uint32_t levelCount, float triangleRatio, float maxError)
+	{
+		m_Lods.clear();
+		if (IsLod() || levelCount <= 1 || Indices.size() < 3 || !m_Geometry.IsValid()) return;
+
+		triangleRatio = glm::clamp(triangleRatio, 0.05f, 0.95f);
+		float errorLimit = maxError * std::max(m_BoundingSphere.radius, 1e-6f);
+
+		size_t previousCount = Indices.size();
+		float ratio = 1.0f;
+		for (uint32_t level = 1; level < levelCount; ++level) {
+			ratio *= triangleRatio;
+			size_t target = (size_t)((float)(Indices.size() / 3) * ratio) * 3;
+			if (target < 3) break;
+
+			float error = 0.0f;
+			std::vector<unsigned int> indices = MeshSimplifier::Simplify(Vertices, Indices, target, errorLimit, &error);
+			if (indices.empty() || indices.size() * 10 > previousCount * 9) break;
+
+			previousCount = indices.size();
+			MeshLod lod;
+			lod.mesh = std::shared_ptr<Mesh>(new Mesh(*this, std::move(indices)));
+			lod.error = error;
+			m_Lods.push_back(std::move(lod));
+		}
+	}
+
+	// 所有 Mesh 共享 GeometryPool 的 VAO，绘制时只需给出 firstIndex/baseVertex
 	void Mesh::Draw(Shader& shader) const
+	{
+		if (!m_Geometry.IsValid()) return;
+
+		BindTextures(shader);
+
+		GeometryPool::Bind();
+		glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)m_Geometry.indexCount, GL_UNSIGNED_INT,
+			(void*)((uintptr_t)m_Geometry.firstIndex * sizeof(uint32_t)), (GLint)m_Geometry.baseVertex);
+
+		UnbindTextures();
+	}
+
+	void Mesh::DrawInstanced(Shader& shader, uint32_t instanceCount, uint32_t baseInstance, GLuint indexBuffer) const
+	{
+		if (instanceCount == 0 || !m_Geometry.IsValid()) return;
+
+		BindTextures(shader);
+
+		// 索引属性只在索引缓冲变化时（首次绘制或环形缓冲扩容后）重新指定，之后每次绘制只改 baseInstance
+		GeometryPool::Bind(indexBuffer);
+		glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, (GLsizei)m_Geometry.indexCount, GL_UNSIGNED_INT,
+			(void*)((uintptr_t)m_Geometry.firstIndex * sizeof(uint32_t)), (GLsizei)instanceCount,
+			(GLint)m_Geometry.baseVertex, baseInstance);
+
+		UnbindTextures();
+	}
+
+	void Mesh::BindTextures(Shader& shader) const
 	{
 		unsigned int diffuseNr = 1;
 		unsigned int specularNr = 1;
 
 		for (unsigned int i = 0;i < m_Textures.size();i++)
 		{
-			glActiveTexture(GL_TEXTURE0 + i);
 			std::string number;
 			std::string name = m_Textures[i]->GetType();
 			if (name == "texture_diffuse")
@@ -22,44 +99,46 @@ namespace Intro {
 			shader.SetUniformInt((name + number).c_str(), i);
 			m_Textures[i]->Bind(i);
 		}
+	}
 
-		glBindVertexArray(VAO);
-		glDrawElements(GL_TRIANGLES, Indices.size(), GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
-
+	void Mesh::UnbindTextures() const
+	{
 		for (unsigned int i = 0; i < m_Textures.size(); i++)
 		{
-			glActiveTexture(GL_TEXTURE0 + i);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			RenderState::BindTexture(i, GL_TEXTURE_2D, 0);
 		}
-		glActiveTexture(GL_TEXTURE0);
 	}
 
 
-	void Mesh::SetupMesh()
+	void Mesh::ComputeBounds()
 	{
-		glGenVertexArrays(1, &VAO);
-		glGenBuffers(1, &VBO);
-		glGenBuffers(1, &IBO);
-
-		glBindVertexArray(VAO);
-
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferData(GL_ARRAY_BUFFER, Vertices.size() * sizeof(Vertex), &Vertices[0], GL_STATIC_DRAW);
+		m_Bounds = BoundingBox();
+		for (const auto& vertex : Vertices)
+			m_Bounds.Expand(vertex.Position);
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, Indices.size() * sizeof(unsigned int), &Indices[0], GL_STATIC_DRAW);
+		if (!m_Bounds.IsValid())
+		{
+			m_Bounds.min = m_Bounds.max = glm::vec3(0.0f);
+		}
 
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+		// 以包围盒中心为球心，半径取到最远顶点的距离（比包围盒外接球更紧）
+		m_BoundingSphere.center = m_Bounds.GetCenter();
+		float maxDist2 = 0.0f;
+		for (const auto& vertex : Vertices)
+		{
+			glm::vec3 d = vertex.Position - m_BoundingSphere.center;
+			maxDist2 = std::max(maxDist2, glm::dot(d, d));
+		}
+		m_BoundingSphere.radius = std::sqrt(maxDist2);
+	}
 
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+	void Mesh::SetupMesh()
+	{
+		m_MeshID = s_NextMeshID++;
+		ComputeBounds();
 
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-		
-		glBindVertexArray(0);
+		// 顶点/索引子分配到共享几何池，不再为每个 Mesh 创建 VAO/VBO/IBO
+		m_Geometry = GeometryPool::Allocate(Vertices, Indices);
 	}
 
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "Vertex.h"
 #include "Texture.h"
 #include "Shader.h"
+#include "Bounds.h"
+#include "GeometryPool.h"
 #include "glad/glad.h"
 //std
 #include <memory>
@@ -10,6 +12,15 @@
 
 namespace Intro {
 
+	class Mesh;
+
+	// 简化后的细节层次：mesh 与原 Mesh 共用几何池中的顶点区间，只拥有自己的索引区间
+	struct MeshLod
+	{
+		std::shared_ptr<Mesh> mesh;
+		float error = 0.0f;		// 局部空间的最大几何误差（距离）
+	};
+
 	class ITR_API Mesh
 	{
 	public:
@@ -20,24 +31,54 @@ namespace Intro {
 			SetupMesh();
 		}
 
-		~Mesh() {
-			glDeleteVertexArrays(1, &VAO);
-			glDeleteBuffers(1, &VBO);
-			glDeleteBuffers(1, &IBO);
-		}
+		~Mesh();
 
 		void Draw(Shader& shader) const;
+		// 实例化绘制：每实例从 indexBuffer 读取对象索引（从 baseInstance 开始），shader 用它索引对象数据 SSBO
+		void DrawInstanced(Shader& shader, uint32_t instanceCount, uint32_t baseInstance, GLuint indexBuffer) const;
 
 		const std::vector<Vertex>& GetVertices() const { return Vertices; }
 		const std::vector<unsigned int>& GetIndices() const { return Indices; }
 		const std::vector<std::shared_ptr<Texture>>& GetTextures() const { return m_Textures; }
+
+		// 顶点/索引在 GeometryPool 中的区间（用于构建间接绘制命令）
+		const GeometryAllocation& GetGeometry() const { return m_Geometry; }
+
+		// 绑定/解绑 Mesh 自带的纹理（MultiDrawIndirect 路径中由 Renderer 按桶调用）
+		void BindTextures(Shader& shader) const;
+		void UnbindTextures() const;
+		// 两个 Mesh 的纹理完全相同时才能合并到同一次 MultiDrawIndirect
+		bool HasSameTextures(const Mesh& other) const { return m_Textures == other.m_Textures; }
+
+		// Mesh 唯一 ID（创建时分配，用于渲染排序键）
+		uint32_t GetMeshID() const { return m_MeshID; }
+
+		// 局部空间包围体（SetupMesh 时计算，用于视锥剔除）
+		const BoundingBox& GetBounds() const { return m_Bounds; }
+		const BoundingSphere& GetBoundingSphere() const { return m_BoundingSphere; }
+
+		// 生成 LOD 链：第 i 级的目标三角形数为原网格的 triangleRatio^i，误差不超过 maxError * 包围球半径。
+		// 每一级都从原网格简化；某一级减少不足 10% 时停止（说明误差上限已经限制住了简化）
+		void GenerateLods(uint32_t levelCount, float triangleRatio, float maxError);
+		// 不含原网格本身（第 0 级）；GetLods()[i] 为第 i + 1 级
+		const std::vector<MeshLod>& GetLods() const { return m_Lods; }
+		uint32_t GetLodCount() const { return 1 + (uint32_t)m_Lods.size(); }
+		bool IsLod() const { return m_Geometry.sharedVertices; }
 	private:
+		// LOD：共用 parent 的顶点区间、纹理与包围体，CPU 端只保留索引
+		Mesh(const Mesh& parent, std::vector<unsigned int> indices);
+
 		std::vector<Vertex> Vertices;
 		std::vector<unsigned int> Indices;
-		unsigned int VAO, VBO, IBO;
 		std::vector<std::shared_ptr<Texture>> m_Textures;
+		GeometryAllocation m_Geometry;
+		uint32_t m_MeshID = 0;
+		BoundingBox m_Bounds;
+		BoundingSphere m_BoundingSphere;
+		std::vector<MeshLod> m_Lods;
 
 		void SetupMesh();
+		void ComputeBounds();
 	};
 
 }
\ No newline at end of file
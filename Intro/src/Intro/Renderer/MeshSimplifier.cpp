@@ -0,0 +1,294 @@
+#include "itrpch.h"
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace Intro {
+
+	namespace {
+
+		// 对称 4x4 二次型（平面距离平方之和），按三角形面积加权，weight 记录总权重用于归一化
+		struct Quadric
+		{
+			double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+			double b0 = 0, b1 = 0, b2 = 0;
+			double c = 0;
+			double weight = 0;
+
+			static Quadric FromPlane(const glm::dvec3& n, double d, double w)
+			{
+				Quadric q;
+				q.a00 = n.x * n.x * w; q.a01 = n.x * n.y * w; q.a02 = n.x * n.z * w;
+				q.a11 = n.y * n.y * w; q.a12 = n.y * n.z * w; q.a22 = n.z * n.z * w;
+				q.b0 = n.x * d * w; q.b1 = n.y * d * w; q.b2 = n.z * d * w;
+				q.c = d * d * w;
+				q.weight = w;
+				return q;
+			}
+
+			Quadric& operator+=(const Quadric& o)
+			{
+				a00 += o.a00; a01 += o.a01; a02 += o.a02;
+				a11 += o.a11; a12 += o.a12; a22 += o.a22;
+				b0 += o.b0; b1 += o.b1; b2 += o.b2;
+				c += o.c;
+				weight += o.weight;
+				return *this;
+			}
+
+			// 点到所有平面距离平方的加权和
+			double Evaluate(const glm::dvec3& p) const
+			{
+				double result = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+					+ 2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z)
+					+ 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+				return std::max(result, 0.0);
+			}
+		};
+
+		struct PositionKey
+		{
+			uint32_t x, y, z;
+			bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+		};
+
+		struct PositionKeyHash
+		{
+			size_t operator()(const PositionKey& k) const
+			{
+				return ((size_t)k.x * 73856093u) ^ ((size_t)k.y * 19349663u) ^ ((size_t)k.z * 83492791u);
+			}
+		};
+
+		PositionKey MakeKey(const glm::vec3& p)
+		{
+			PositionKey key;
+			std::memcpy(&key.x, &p.x, 4);
+			std::memcpy(&key.y, &p.y, 4);
+			std::memcpy(&key.z, &p.z, 4);
+			return key;
+		}
+
+		struct Collapse
+		{
+			uint32_t from;		// 拓扑顶点（位置类）
+			uint32_t to;
+			double cost;		// 归一化后的距离平方
+		};
+
+		constexpr uint32_t MaxPasses = 64;
+
+		// 同一位置上的两个顶点属性差异超过这个范围才算接缝（完全相同的重复顶点不算）
+		constexpr float SeamTexCoordEpsilon = 1e-4f;
+		constexpr float SeamNormalCos = 0.9995f;
+
+		bool IsAttributeSeam(const Vertex& a, const Vertex& b)
+		{
+			if (std::abs(a.TexCoords.x - b.TexCoords.x) > SeamTexCoordEpsilon ||
+				std::abs(a.TexCoords.y - b.TexCoords.y) > SeamTexCoordEpsilon) return true;
+			float lengths = glm::length(a.Normal) * glm::length(b.Normal);
+			return lengths > 0.0f && glm::dot(a.Normal, b.Normal) < SeamNormalCos * lengths;
+		}
+	}
+
+	std::vector<unsigned int> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+		size_t targetIndexCount, float maxError, float* outError)
+	{
+		std::vector<unsigned int> result = indices;
+		if (outError) *outError = 0.0f;
+		if (vertices.empty() || indices.size() < 3 || indices.size() <= targetIndexCount) return result;
+
+		// 1. 位置相同的顶点合并为一个拓扑顶点（位置类），记录每个位置类包含的顶点（wedge）
+		const uint32_t vertexCount = (uint32_t)vertices.size();
+		std::vector<uint32_t> positionClass(vertexCount);
+		std::vector<uint32_t> classVertex;			// 位置类的代表顶点
+		std::vector<std::vector<uint32_t>> wedges;
+		{
+			std::unordered_map<PositionKey, uint32_t, PositionKeyHash> lookup;
+			lookup.reserve(vertexCount);
+			for (uint32_t v = 0; v < vertexCount; ++v) {
+				auto [it, inserted] = lookup.try_emplace(MakeKey(vertices[v].Position), (uint32_t)classVertex.size());
+				if (inserted) {
+					classVertex.push_back(v);
+					wedges.emplace_back();
+				}
+				positionClass[v] = it->second;
+				wedges[it->second].push_back(v);
+			}
+		}
+		const uint32_t classCount = (uint32_t)classVertex.size();
+		auto position = [&](uint32_t cls) { return glm::dvec3(vertices[classVertex[cls]].Position); };
+
+		// 2. 锁定属性接缝（同一位置上 UV 或法线不同的顶点）与开放边界上的位置类
+		std::vector<uint8_t> locked(classCount, 0);
+		for (uint32_t cls = 0; cls < classCount; ++cls) {
+			const auto& classWedges = wedges[cls];
+			for (size_t w = 1; w < classWedges.size() && !locked[cls]; ++w) {
+				if (IsAttributeSeam(vertices[classWedges[0]], vertices[classWedges[w]])) locked[cls] = 1;
+			}
+		}
+		{
+			std::unordered_map<uint64_t, int32_t> edgeBalance;
+			edgeBalance.reserve(indices.size());
+			for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+				for (uint32_t e = 0; e < 3; ++e) {
+					uint32_t a = positionClass[indices[t + e]];
+					uint32_t b = positionClass[indices[t + (e + 1) % 3]];
+					if (a == b) continue;
+					// 有向边正反各计一次：闭合流形上每条边的正反方向次数相同
+					uint64_t key = a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+					edgeBalance[key] += a < b ? 1 : -1;
+				}
+			}
+			for (const auto& [key, balance] : edgeBalance) {
+				if (balance == 0) continue;
+				locked[(uint32_t)(key >> 32)] = 1;
+				locked[(uint32_t)(key & 0xFFFFFFFFu)] = 1;
+			}
+		}
+
+		// 3. 每个位置类累加相邻三角形平面的二次型
+		std::vector<Quadric> quadrics(classCount);
+		for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+			uint32_t c0 = positionClass[indices[t]], c1 = positionClass[indices[t + 1]], c2 = positionClass[indices[t + 2]];
+			glm::dvec3 p0 = position(c0), p1 = position(c1), p2 = position(c2);
+			glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+			double length = glm::length(normal);
+			if (length <= 1e-20) continue;
+			normal /= length;
+			Quadric q = Quadric::FromPlane(normal, -glm::dot(normal, p0), length * 0.5);
+			quadrics[c0] += q;
+			quadrics[c1] += q;
+			quadrics[c2] += q;
+		}
+
+		auto collapseCost = [&](uint32_t from, uint32_t to) {
+			Quadric q = quadrics[from];
+			q += quadrics[to];
+			return q.weight > 0.0 ? q.Evaluate(position(to)) / q.weight : 0.0;
+		};
+
+		// 折叠到目标位置类时，为源顶点挑选属性最接近的 wedge（目标可能是接缝顶点）
+		auto pickWedge = [&](uint32_t targetClass, uint32_t sourceVertex) {
+			const auto& candidates = wedges[targetClass];
+			if (candidates.size() == 1) return candidates[0];
+			uint32_t best = candidates[0];
+			float bestDistance = FLT_MAX;
+			for (uint32_t w : candidates) {
+				glm::vec2 duv = vertices[w].TexCoords - vertices[sourceVertex].TexCoords;
+				glm::vec3 dn = vertices[w].Normal - vertices[sourceVertex].Normal;
+				float distance = glm::dot(duv, duv) + glm::dot(dn, dn);
+				if (distance < bestDistance) { bestDistance = distance; best = w; }
+			}
+			return best;
+		};
+
+		const double maxCost = (double)maxError * (double)maxError;
+		double appliedCost = 0.0;
+
+		std::vector<uint32_t> collapseTo(classCount);
+		std::vector<uint8_t> touched(classCount);
+		std::vector<Collapse> candidates;
+		std::vector<uint32_t> triangleOffsets(classCount + 1);
+		std::vector<uint32_t> triangleList;
+
+		for (uint32_t pass = 0; pass < MaxPasses && result.size() > targetIndexCount; ++pass) {
+			const size_t triangleCount = result.size() / 3;
+
+			// 位置类 -> 相邻三角形（CSR）
+			std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0u);
+			for (unsigned int index : result) triangleOffsets[positionClass[index] + 1]++;
+			for (uint32_t cls = 0; cls < classCount; ++cls) triangleOffsets[cls + 1] += triangleOffsets[cls];
+			triangleList.resize(result.size());
+			{
+				std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+				for (size_t i = 0; i < result.size(); ++i)
+					triangleList[cursor[positionClass[result[i]]]++] = (uint32_t)(i / 3);
+			}
+
+			// 候选边：每条边取两个方向中代价较小且未锁定的一个
+			candidates.clear();
+			for (size_t t = 0; t < triangleCount; ++t) {
+				for (uint32_t e = 0; e < 3; ++e) {
+					uint32_t a = positionClass[result[t * 3 + e]];
+					uint32_t b = positionClass[result[t * 3 + (e + 1) % 3]];
+					if (a >= b) continue;	// 每条内部边在两个三角形中各出现一次（方向相反），只取 a < b 的一次
+					double costAB = locked[a] ? DBL_MAX : collapseCost(a, b);
+					double costBA = locked[b] ? DBL_MAX : collapseCost(b, a);
+					if (costAB == DBL_MAX && costBA == DBL_MAX) continue;
+					if (costAB <= costBA) candidates.push_back({ a, b, costAB });
+					else candidates.push_back({ b, a, costBA });
+				}
+			}
+			if (candidates.empty()) break;
+			std::sort(candidates.begin(), candidates.end(), [](const Collapse& l, const Collapse& r) { return l.cost < r.cost; });
+
+			// 每次折叠大约删掉两个三角形；本轮最多执行到目标数量为止
+			size_t collapseBudget = std::max<size_t>(1, (triangleCount - targetIndexCount / 3) / 2);
+			for (uint32_t cls = 0; cls < classCount; ++cls) collapseTo[cls] = cls;
+			std::fill(touched.begin(), touched.end(), 0);
+
+			size_t collapses = 0;
+			for (const Collapse& collapse : candidates) {
+				if (collapses >= collapseBudget || collapse.cost > maxCost) break;
+				if (touched[collapse.from] || touched[collapse.to]) continue;
+
+				// 拒绝会翻转相邻三角形的折叠
+				glm::dvec3 target = position(collapse.to);
+				bool flips = false;
+				for (uint32_t i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1] && !flips; ++i) {
+					uint32_t t = triangleList[i];
+					uint32_t c[3] = { collapseTo[positionClass[result[t * 3]]], collapseTo[positionClass[result[t * 3 + 1]]],
+						collapseTo[positionClass[result[t * 3 + 2]]] };
+					if (c[0] == collapse.to || c[1] == collapse.to || c[2] == collapse.to) continue;	// 折叠后退化，会被删除
+
+					glm::dvec3 before[3], after[3];
+					for (uint32_t k = 0; k < 3; ++k) {
+						before[k] = position(c[k]);
+						after[k] = c[k] == collapse.from ? target : before[k];
+					}
+					glm::dvec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+					glm::dvec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+					if (glm::dot(n0, n1) < 0.25 * glm::length(n0) * glm::length(n1)) flips = true;
+				}
+				if (flips) continue;
+
+				collapseTo[collapse.from] = collapse.to;
+				quadrics[collapse.to] += quadrics[collapse.from];
+				// 源顶点的一环邻域本轮不再参与折叠，保证同一轮的折叠互相独立
+				for (uint32_t i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1]; ++i) {
+					uint32_t t = triangleList[i];
+					for (uint32_t k = 0; k < 3; ++k) touched[positionClass[result[t * 3 + k]]] = 1;
+				}
+				touched[collapse.to] = 1;
+				appliedCost = std::max(appliedCost, collapse.cost);
+				collapses++;
+			}
+			if (collapses == 0) break;
+
+			// 重写索引并删除退化三角形
+			size_t write = 0;
+			for (size_t t = 0; t < triangleCount; ++t) {
+				unsigned int tri[3];
+				for (uint32_t k = 0; k < 3; ++k) {
+					unsigned int v = result[t * 3 + k];
+					uint32_t cls = positionClass[v];
+					tri[k] = collapseTo[cls] == cls ? v : pickWedge(collapseTo[cls], v);
+				}
+				uint32_t c0 = positionClass[tri[0]], c1 = positionClass[tri[1]], c2 = positionClass[tri[2]];
+				if (c0 == c1 || c1 == c2 || c0 == c2) continue;
+				result[write++] = tri[0];
+				result[write++] = tri[1];
+				result[write++] = tri[2];
+			}
+			result.resize(write);
+		}
+
+		if (outError) *outError = (float)std::sqrt(appliedCost);
+		return result;
+	}
+
+}
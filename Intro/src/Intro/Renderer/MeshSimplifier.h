@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include "Vertex.h"
+#include <cstddef>
+#include <vector>
+
+namespace Intro {
+
+	// 基于二次误差度量（QEM）的网格简化：
+	// - 半边折叠：顶点只折叠到边的另一个端点上，不生成新顶点，结果索引直接引用原顶点（LOD 可以共用顶点缓冲）
+	// - 位置相同的顶点（UV/法线接缝）视为同一个拓扑顶点；接缝与开放边界上的顶点锁定，保证外形与贴图连续
+	// - 每一轮按误差排序候选边，互不相邻的折叠一起执行；会使三角形翻转的折叠被拒绝
+	// 不依赖 GL，可以离线或在导入线程上调用
+	class ITR_API MeshSimplifier
+	{
+	public:
+		// 简化到不超过 targetIndexCount 个索引，或任何进一步的折叠都会超过 maxError（局部空间距离）为止。
+		// outError 返回实际产生的最大误差
+		static std::vector<unsigned int> Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+			size_t targetIndexCount, float maxError, float* outError = nullptr);
+	};
+
+}
@@ -1,6 +1,7 @@
 #include "itrpch.h"
 #include "Model.h"
 #include "Intro/Renderer/RendererLayer.h"
+#include "Intro/Renderer/Renderer.h"
 #include <iostream>
 
 
@@ -8,7 +9,7 @@ namespace Intro {
 
     Model::Model(const std::string& modelPath) : m_ModelPath(modelPath)
     {
-        // ʹ filesystem ȷ·
+        // 使用 filesystem 正确处理路径
         std::filesystem::path path(modelPath);
         m_Directory = path.parent_path().string();
 
@@ -16,17 +17,38 @@ namespace Intro {
         const aiScene* scene = importer.ReadFile(
             modelPath,
             aiProcess_Triangulate |
+            aiProcess_JoinIdenticalVertices |   // 共享顶点：LOD 简化依赖网格的拓扑连接
             aiProcess_FlipUVs |
             aiProcess_GenNormals |
             aiProcess_ConvertToLeftHanded
         );
 
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-            std::cerr << "Assimpش: " << importer.GetErrorString() << std::endl;
+            std::cerr << "Assimp加载错误: " << importer.GetErrorString() << std::endl;
             return;
         }
 
         ProcessNode(scene->mRootNode, scene);
+        ComputeBounds();
+    }
+
+    void Model::ComputeBounds() {
+        m_Bounds = BoundingBox();
+        for (const auto& mesh : m_Meshes) {
+            m_Bounds.Merge(mesh->GetBounds());
+        }
+        if (!m_Bounds.IsValid()) {
+            m_Bounds.min = m_Bounds.max = glm::vec3(0.0f);
+        }
+
+        // 合并球：球心取合并包围盒中心，半径覆盖每个子 Mesh 的包围球
+        m_BoundingSphere.center = m_Bounds.GetCenter();
+        m_BoundingSphere.radius = 0.0f;
+        for (const auto& mesh : m_Meshes) {
+            const BoundingSphere& sphere = mesh->GetBoundingSphere();
+            float r = glm::length(sphere.center - m_BoundingSphere.center) + sphere.radius;
+            m_BoundingSphere.radius = std::max(m_BoundingSphere.radius, r);
+        }
     }
 
     void Model::ProcessNode(aiNode* node, const aiScene* scene) {
@@ -88,7 +110,14 @@ namespace Intro {
             textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
         }
 
-        return std::make_shared<Mesh>(vertices, indices, textures);
+        auto result = std::make_shared<Mesh>(vertices, indices, textures);
+
+        // 导入时生成 LOD 链（与原网格共用顶点区间）
+        const RendererConfig& config = Renderer::GetConfig();
+        if (config.enableLod && config.lodLevels > 1) {
+            result->GenerateLods(config.lodLevels, config.lodTriangleRatio, config.lodMaxError);
+        }
+        return result;
     }
 
     std::vector<std::shared_ptr<Texture>> Model::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName) {
@@ -99,42 +128,42 @@ namespace Intro {
 
             std::string texturePath = std::string(str.C_Str());
 
-            // Ľ·߼
+            // 改进的路径处理逻辑
             std::filesystem::path textureFilePath(texturePath);
 
             std::string fullPath;
 
-            // ǷǾ·
+            // 检查是否是绝对路径
             if (textureFilePath.is_absolute()) {
                 fullPath = texturePath;
             }
-            // ǷѾģĿ¼·
+            // 检查是否已经是相对模型目录的路径
             else if (std::filesystem::exists(m_Directory + "/" + texturePath)) {
                 fullPath = m_Directory + "/" + texturePath;
             }
             else {
-                // ģĿ¼в
+                // 尝试在模型目录中查找
                 std::filesystem::path modelDir(m_Directory);
                 auto potentialPath = modelDir / textureFilePath;
                 if (std::filesystem::exists(potentialPath)) {
                     fullPath = potentialPath.string();
                 }
                 else {
-                    // ҲʹļģĿ¼
+                    // 如果还找不到，尝试使用文件名在模型目录中搜索
                     std::string fileName = textureFilePath.filename().string();
                     auto searchPath = modelDir / fileName;
                     if (std::filesystem::exists(searchPath)) {
                         fullPath = searchPath.string();
                     }
                     else {
-                        std::cout << "޷ҵļ: " << texturePath << std::endl;
-                        std::cout << "Ե·: " << (modelDir / textureFilePath).string() << std::endl;
+                        std::cout << "无法找到纹理文件: " << texturePath << std::endl;
+                        std::cout << "尝试的路径: " << (modelDir / textureFilePath).string() << std::endl;
                         continue;
                     }
                 }
             }
 
-            // ׼·Ƴ ../ ./ ȣ
+            // 标准化路径（移除多余的 ../ ./ 等）
             std::filesystem::path normalizedPath = std::filesystem::path(fullPath).lexically_normal();
             fullPath = normalizedPath.string();
 
@@ -146,7 +175,7 @@ namespace Intro {
                 textures.push_back(texture);
             }
             catch (const std::exception& e) {
-                std::cerr << "ʧ: " << fullPath << " - " << e.what() << std::endl;
+                std::cerr << "纹理加载失败: " << fullPath << " - " << e.what() << std::endl;
             }
         }
         return textures;
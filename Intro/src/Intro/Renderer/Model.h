@@ -21,10 +21,18 @@ namespace Intro {
         const std::vector<std::shared_ptr<Mesh>>& GetMeshes() const { return m_Meshes; }
         const std::string& GetPath() const { return m_ModelPath; }
 
+        // 所有 Mesh 合并后的局部空间包围体
+        const BoundingBox& GetBounds() const { return m_Bounds; }
+        const BoundingSphere& GetBoundingSphere() const { return m_BoundingSphere; }
+
     private:
         std::string m_ModelPath;
         std::vector<std::shared_ptr<Mesh>> m_Meshes;
         std::string m_Directory;
+        BoundingBox m_Bounds;
+        BoundingSphere m_BoundingSphere;
+
+        void ComputeBounds();
 
         void ProcessNode(aiNode* node, const aiScene* scene);
         std::shared_ptr<Mesh> ProcessMesh(aiMesh* mesh, const aiScene* scene);
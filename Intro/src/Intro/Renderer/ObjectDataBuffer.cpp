@@ -0,0 +1,164 @@
+#include "itrpch.h"
+#include "ObjectDataBuffer.h"
+#include "RenderConstant.h"
+#include "Intro/Log.h"
+#include <numeric>
+
+namespace Intro {
+
+	ObjectDataBuffer::ObjectDataBuffer(uint32_t capacity)
+	{
+		Create(std::max(capacity, 1u));
+	}
+
+	ObjectDataBuffer::~ObjectDataBuffer()
+	{
+		Destroy();
+		if (!m_RetiredIndexBuffers.empty())
+			glDeleteBuffers((GLsizei)m_RetiredIndexBuffers.size(), m_RetiredIndexBuffers.data());
+		m_RetiredIndexBuffers.clear();
+	}
+
+	void ObjectDataBuffer::Create(uint32_t capacity)
+	{
+		m_Capacity = capacity;
+		m_Frame = 0;
+		m_Cursor = 0;
+
+		// 每段起始偏移必须满足 SSBO 的偏移对齐要求
+		GLint alignment = 256;
+		glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		size_t align = (size_t)std::max(alignment, 1);
+		size_t bytes = (size_t)capacity * sizeof(ObjectData);
+		m_FrameStride = (bytes + align - 1) / align * align;
+		size_t totalBytes = m_FrameStride * FrameCount;
+
+		glGenBuffers(1, &m_Buffer);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer);
+		if (GLAD_GL_VERSION_4_4) {
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			// DYNAMIC_STORAGE 只为映射失败时退化到 glBufferSubData 保留
+			glBufferStorage(GL_SHADER_STORAGE_BUFFER, totalBytes, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+			m_Mapped = static_cast<ObjectData*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, totalBytes, flags));
+			if (!m_Mapped) {
+				ITR_ERROR("ObjectDataBuffer: failed to map persistent buffer, falling back to glBufferSubData uploads");
+				m_Staging.resize(capacity);
+			}
+		}
+		else {
+			glBufferData(GL_SHADER_STORAGE_BUFFER, totalBytes, nullptr, GL_DYNAMIC_DRAW);
+			m_Staging.resize(capacity);
+			ITR_WARN("ObjectDataBuffer: GL 4.4 not available, falling back to glBufferSubData uploads");
+		}
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+		// 实例索引：第 i 个实例读到 baseInstance + i
+		std::vector<uint32_t> indices(capacity);
+		std::iota(indices.begin(), indices.end(), 0u);
+		glGenBuffers(1, &m_IndexBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, m_IndexBuffer);
+		glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		BindCurrentRange();
+	}
+
+	void ObjectDataBuffer::Destroy()
+	{
+		for (auto& fence : m_Fences) {
+			if (fence) glDeleteSync(fence);
+			fence = nullptr;
+		}
+
+		if (m_Buffer) {
+			if (m_Mapped) {
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer);
+				glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+				glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+			}
+			glDeleteBuffers(1, &m_Buffer);
+		}
+		if (m_IndexBuffer)
+			m_RetiredIndexBuffers.push_back(m_IndexBuffer);
+
+		m_Buffer = 0;
+		m_IndexBuffer = 0;
+		m_Mapped = nullptr;
+		m_Staging.clear();
+	}
+
+	// 本帧对象数超过容量：重建更大的缓冲。已提交的绘制仍引用旧缓冲，GL 会在其完成后再释放
+	void ObjectDataBuffer::Grow(uint32_t required)
+	{
+		uint32_t capacity = std::max(required, m_Capacity * 2);
+		ITR_INFO("ObjectDataBuffer: growing capacity {0} -> {1}", m_Capacity, capacity);
+		Destroy();
+		Create(capacity);
+	}
+
+	void ObjectDataBuffer::BindCurrentRange() const
+	{
+		glBindBufferRange(GL_SHADER_STORAGE_BUFFER, OBJECT_DATA_SSBO_BINDING, m_Buffer,
+			(GLintptr)(m_FrameStride * m_Frame), (GLsizeiptr)m_FrameStride);
+	}
+
+	void ObjectDataBuffer::WaitForFence(uint32_t frame)
+	{
+		GLsync& fence = m_Fences[frame];
+		if (!fence) return;
+
+		// 三缓冲下这一段通常早已被 GPU 读完，先不等待地查询一次
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED) {
+			m_StallCount++;
+			do {
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+			} while (result == GL_TIMEOUT_EXPIRED);
+		}
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	void ObjectDataBuffer::BeginFrame()
+	{
+		m_Frame = (m_Frame + 1) % FrameCount;
+		m_Cursor = 0;
+		WaitForFence(m_Frame);
+		BindCurrentRange();
+	}
+
+	void ObjectDataBuffer::EndFrame()
+	{
+		if (m_Fences[m_Frame]) glDeleteSync(m_Fences[m_Frame]);
+		m_Fences[m_Frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	ObjectData* ObjectDataBuffer::Allocate(uint32_t count, uint32_t& baseIndex)
+	{
+		if (m_Cursor + count > m_Capacity)
+			Grow(m_Cursor + count);
+
+		baseIndex = m_Cursor;
+		m_Cursor += count;
+
+		if (m_Mapped) {
+			auto* frameBase = reinterpret_cast<uint8_t*>(m_Mapped) + m_FrameStride * m_Frame;
+			return reinterpret_cast<ObjectData*>(frameBase) + baseIndex;
+		}
+		return m_Staging.data() + baseIndex;
+	}
+
+	void ObjectDataBuffer::Commit(uint32_t baseIndex, uint32_t count)
+	{
+		// 持久映射 + coherent：写入对之后提交的绘制直接可见
+		if (m_Mapped || count == 0) return;
+
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_Buffer);
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+			(GLintptr)(m_FrameStride * m_Frame + (size_t)baseIndex * sizeof(ObjectData)),
+			(GLsizeiptr)(count * sizeof(ObjectData)), m_Staging.data() + baseIndex);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Intro {
+
+	// 每个绘制对象的数据（与 shader 中 std430 的 ObjectData 布局一致）
+	struct ObjectData
+	{
+		glm::mat4 model;
+		glm::vec4 normalMatrix[3];	// std430 下 mat3 每列按 vec4 对齐
+		glm::uvec4 ids;				// x = 对象 ID，y = 材质下标，z = LOD 淡入淡出（LodSelector::PackFade），w = 标志位（OBJECT_FLAG_*）
+	};
+	static_assert(sizeof(ObjectData) == 128, "ObjectData must match the std430 layout in the shaders");
+
+	// 每帧对象数据的环形缓冲：
+	// - 一个 SSBO 分成 FrameCount 段，每帧写一段，用 fence 保证 GPU 读完后才复用
+	// - GL 4.4 以上用持久映射（persistent + coherent），CPU 直接线性写入映射内存
+	// - 否则退化为暂存数组 + glBufferSubData
+	// 绘制时用 baseInstance 偏移实例索引属性（0,1,2,...），shader 通过它索引 SSBO
+	class ITR_API ObjectDataBuffer
+	{
+	public:
+		static constexpr uint32_t FrameCount = 3;
+
+		explicit ObjectDataBuffer(uint32_t capacity = 4096);
+		~ObjectDataBuffer();
+
+		ObjectDataBuffer(const ObjectDataBuffer&) = delete;
+		ObjectDataBuffer& operator=(const ObjectDataBuffer&) = delete;
+
+		// 切换到下一段（必要时等待该段的 fence）并绑定到 OBJECT_DATA_SSBO_BINDING
+		void BeginFrame();
+		// 为当前段插入 fence
+		void EndFrame();
+
+		// 在当前段中分配 count 个连续对象，返回写入地址；baseIndex 为段内起始下标（即 baseInstance）
+		ObjectData* Allocate(uint32_t count, uint32_t& baseIndex);
+		// 写入完成（持久映射时为空操作，否则上传暂存数据）
+		void Commit(uint32_t baseIndex, uint32_t count);
+
+		// 实例索引缓冲：内容为 0..capacity-1，作为每实例属性读取
+		GLuint GetIndexBuffer() const { return m_IndexBuffer; }
+		uint32_t GetCapacity() const { return m_Capacity; }
+		bool IsPersistentlyMapped() const { return m_Mapped != nullptr; }
+
+		// CPU 因 GPU 尚未读完而等待 fence 的次数
+		uint32_t GetStallCount() const { return m_StallCount; }
+
+	private:
+		void Create(uint32_t capacity);
+		void Destroy();
+		void Grow(uint32_t required);
+		void BindCurrentRange() const;
+		void WaitForFence(uint32_t frame);
+
+		GLuint m_Buffer = 0;
+		GLuint m_IndexBuffer = 0;
+		// 扩容后旧的索引缓冲仍被 Mesh 的 VAO 引用，保留到析构再删除，避免名字被复用
+		std::vector<GLuint> m_RetiredIndexBuffers;
+
+		ObjectData* m_Mapped = nullptr;
+		std::vector<ObjectData> m_Staging;
+		GLsync m_Fences[FrameCount] = {};
+
+		uint32_t m_Capacity = 0;		// 每段可容纳的对象数
+		size_t m_FrameStride = 0;		// 每段字节数（按 SSBO 偏移对齐）
+		uint32_t m_Frame = 0;
+		uint32_t m_Cursor = 0;
+		uint32_t m_StallCount = 0;
+	};
+
+}
@@ -0,0 +1,311 @@
+#include "itrpch.h"
+#include "OcclusionCuller.h"
+#include "Intro/Jobs/JobSystem.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+namespace Intro {
+
+	namespace {
+
+		// 三角形少于这个值时单线程光栅化
+		constexpr uint32_t ParallelTriangleThreshold = 64;
+
+		// 盒子 8 个角的下标：bit0 = x, bit1 = y, bit2 = z（0 取 min，1 取 max）；每个面从外侧看为逆时针
+		constexpr uint8_t BoxIndices[36] = {
+			0, 4, 6,  0, 6, 2,		// -X
+			1, 3, 7,  1, 7, 5,		// +X
+			0, 1, 5,  0, 5, 4,		// -Y
+			2, 6, 7,  2, 7, 3,		// +Y
+			0, 2, 3,  0, 3, 1,		// -Z
+			4, 5, 7,  4, 7, 6		// +Z
+		};
+
+		// 三个顶点都在同一个裁剪平面（近平面之外的其余五个）外侧时整体丢弃
+		bool OutsideSamePlane(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2)
+		{
+			auto outside = [&](auto test) { return test(v0) && test(v1) && test(v2); };
+			return outside([](const glm::vec4& v) { return v.x < -v.w; })
+				|| outside([](const glm::vec4& v) { return v.x > v.w; })
+				|| outside([](const glm::vec4& v) { return v.y < -v.w; })
+				|| outside([](const glm::vec4& v) { return v.y > v.w; })
+				|| outside([](const glm::vec4& v) { return v.z > v.w; });
+		}
+	}
+
+	OcclusionCuller::~OcclusionCuller()
+	{
+		Wait();
+	}
+
+	void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection, uint32_t viewportWidth, uint32_t viewportHeight)
+	{
+		Wait();
+
+		m_ViewProjection = viewProjection;
+
+		float aspect = viewportHeight > 0 ? (float)viewportWidth / (float)viewportHeight : 1.0f;
+		uint32_t height = (uint32_t)std::ceil((float)BufferWidth / std::max(aspect, 0.01f) / (float)TileSize) * TileSize;
+		m_Width = BufferWidth;
+		m_Height = std::clamp(height, TileSize, MaxBufferHeight);
+		m_TilesX = m_Width / TileSize;
+		m_TilesY = m_Height / TileSize;
+
+		m_Triangles.clear();
+		m_Stats.occluderCount = 0;
+		m_Stats.triangleCount = 0;
+	}
+
+	void OcclusionCuller::AddOccluderBox(const BoundingBox& localBox, const glm::mat4& transform)
+	{
+		if (!localBox.IsValid()) return;
+
+		glm::mat4 mvp = m_ViewProjection * transform;
+		glm::vec4 corners[8];
+		for (uint32_t i = 0; i < 8; ++i) {
+			glm::vec3 corner((i & 1) ? localBox.max.x : localBox.min.x,
+				(i & 2) ? localBox.max.y : localBox.min.y,
+				(i & 4) ? localBox.max.z : localBox.min.z);
+			corners[i] = mvp * glm::vec4(corner, 1.0f);
+		}
+
+		// 镜像变换会翻转绕序
+		bool mirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+		for (uint32_t i = 0; i < 36; i += 3) {
+			const glm::vec4& v0 = corners[BoxIndices[i]];
+			const glm::vec4& v1 = corners[BoxIndices[i + 1]];
+			const glm::vec4& v2 = corners[BoxIndices[i + 2]];
+			if (mirrored) AddClipTriangle(v0, v2, v1, true);
+			else AddClipTriangle(v0, v1, v2, true);
+		}
+		m_Stats.occluderCount++;
+	}
+
+	void OcclusionCuller::AddOccluderMesh(const void* positions, size_t stride, const uint32_t* indices, size_t indexCount,
+		const glm::mat4& transform, bool cullBackFaces)
+	{
+		if (!positions || !indices || indexCount < 3) return;
+
+		const char* base = static_cast<const char*>(positions);
+		auto fetch = [&](uint32_t index) {
+			const float* p = reinterpret_cast<const float*>(base + (size_t)index * stride);
+			return glm::vec4(p[0], p[1], p[2], 1.0f);
+		};
+
+		glm::mat4 mvp = m_ViewProjection * transform;
+		bool mirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+		for (size_t i = 0; i + 2 < indexCount; i += 3) {
+			glm::vec4 v0 = mvp * fetch(indices[i]);
+			glm::vec4 v1 = mvp * fetch(indices[i + 1]);
+			glm::vec4 v2 = mvp * fetch(indices[i + 2]);
+			if (mirrored) AddClipTriangle(v0, v2, v1, cullBackFaces);
+			else AddClipTriangle(v0, v1, v2, cullBackFaces);
+		}
+		m_Stats.occluderCount++;
+	}
+
+	void OcclusionCuller::AddClipTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2, bool cullBackFaces)
+	{
+		if (OutsideSamePlane(v0, v1, v2)) return;
+
+		// 对近平面（z >= -w）做 Sutherland-Hodgman 裁剪，最多得到 4 个顶点
+		const glm::vec4 input[3] = { v0, v1, v2 };
+		glm::vec4 clipped[4];
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < 3; ++i) {
+			const glm::vec4& current = input[i];
+			const glm::vec4& next = input[(i + 1) % 3];
+			float dCurrent = current.z + current.w;
+			float dNext = next.z + next.w;
+
+			if (dCurrent >= 0.0f) clipped[count++] = current;
+			if ((dCurrent >= 0.0f) != (dNext >= 0.0f)) {
+				float t = dCurrent / (dCurrent - dNext);
+				clipped[count++] = current + (next - current) * t;
+			}
+		}
+
+		if (count >= 3) SetupTriangle(clipped, count, cullBackFaces);
+	}
+
+	void OcclusionCuller::SetupTriangle(const glm::vec4* clip, uint32_t count, bool cullBackFaces)
+	{
+		// 投影到缓冲的像素坐标（y 向上），深度映射到 [0, 1]
+		glm::vec3 screen[4];
+		for (uint32_t i = 0; i < count; ++i) {
+			if (clip[i].w <= 1e-6f) return;
+			float invW = 1.0f / clip[i].w;
+			screen[i] = glm::vec3(
+				(clip[i].x * invW * 0.5f + 0.5f) * (float)m_Width,
+				(clip[i].y * invW * 0.5f + 0.5f) * (float)m_Height,
+				std::clamp(clip[i].z * invW * 0.5f + 0.5f, 0.0f, 1.0f));
+		}
+
+		// 多边形按扇形拆成三角形
+		for (uint32_t i = 1; i + 1 < count; ++i) {
+			glm::vec3 p0 = screen[0];
+			glm::vec3 p1 = screen[i];
+			glm::vec3 p2 = screen[i + 1];
+
+			float area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+			if (std::abs(area) < 1e-6f) continue;
+			if (area < 0.0f) {
+				if (cullBackFaces) continue;
+				std::swap(p1, p2);
+			}
+
+			Triangle tri;
+			tri.minX = std::max(0, (int32_t)std::ceil(std::min({ p0.x, p1.x, p2.x }) - 0.5f));
+			tri.maxX = std::min((int32_t)m_Width - 1, (int32_t)std::floor(std::max({ p0.x, p1.x, p2.x }) - 0.5f));
+			tri.minY = std::max(0, (int32_t)std::ceil(std::min({ p0.y, p1.y, p2.y }) - 0.5f));
+			tri.maxY = std::min((int32_t)m_Height - 1, (int32_t)std::floor(std::max({ p0.y, p1.y, p2.y }) - 0.5f));
+			if (tri.minX > tri.maxX || tri.minY > tri.maxY) continue;
+
+			// 整个三角形使用最远顶点的深度：比逐像素插值粗糙，但不会把遮挡写得比真实几何更近
+			tri.depth = std::max({ p0.z, p1.z, p2.z });
+
+			const glm::vec3* v[3] = { &p0, &p1, &p2 };
+			for (uint32_t e = 0; e < 3; ++e) {
+				const glm::vec3& a = *v[e];
+				const glm::vec3& b = *v[(e + 1) % 3];
+				tri.a[e] = a.y - b.y;
+				tri.b[e] = b.x - a.x;
+				tri.c[e] = a.x * b.y - a.y * b.x;
+			}
+			m_Triangles.push_back(tri);
+		}
+	}
+
+	void OcclusionCuller::Rasterize()
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		m_Depth.resize((size_t)m_Width * m_Height);
+		m_TileMaxDepth.resize((size_t)m_TilesX * m_TilesY);
+
+		// 按块行分块交给 JobSystem；每块清除并写入自己的行，再计算这些行的块深度
+		uint32_t workerCount = 1;
+		if (m_Triangles.size() >= ParallelTriangleThreshold)
+			workerCount = std::min(JobSystem::GetThreadCount(), m_TilesY);
+		uint32_t rowsPerWorker = (m_TilesY + workerCount - 1) / workerCount;
+
+		JobSystem::ParallelFor(m_TilesY, rowsPerWorker, [this](uint32_t first, uint32_t last) {
+			RasterizeTileRows(first, last);
+		});
+
+		m_Stats.triangleCount = (uint32_t)m_Triangles.size();
+		m_Stats.workerCount = workerCount;
+		m_Stats.rasterMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void OcclusionCuller::RasterizeAsync()
+	{
+		Wait();
+		JobSystem::Run([this]() { Rasterize(); }, &m_Job);
+	}
+
+	void OcclusionCuller::Wait()
+	{
+		JobSystem::Wait(m_Job);
+	}
+
+	void OcclusionCuller::RasterizeTileRows(uint32_t firstRow, uint32_t lastRow)
+	{
+		const int32_t y0 = (int32_t)(firstRow * TileSize);
+		const int32_t y1 = (int32_t)(lastRow * TileSize) - 1;
+		std::fill(m_Depth.begin() + (size_t)y0 * m_Width, m_Depth.begin() + (size_t)(y1 + 1) * m_Width, 1.0f);
+
+		for (const Triangle& tri : m_Triangles) {
+			int32_t minY = std::max(tri.minY, y0);
+			int32_t maxY = std::min(tri.maxY, y1);
+			if (minY > maxY) continue;
+
+			const float startX = (float)tri.minX + 0.5f;
+			for (int32_t y = minY; y <= maxY; ++y) {
+				const float py = (float)y + 0.5f;
+				float e0 = tri.a[0] * startX + tri.b[0] * py + tri.c[0];
+				float e1 = tri.a[1] * startX + tri.b[1] * py + tri.c[1];
+				float e2 = tri.a[2] * startX + tri.b[2] * py + tri.c[2];
+
+				// 内层循环没有分支，边函数逐像素递增，编译器可以向量化
+				float* row = m_Depth.data() + (size_t)y * m_Width;
+				for (int32_t x = tri.minX; x <= tri.maxX; ++x) {
+					bool inside = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f);
+					row[x] = inside ? std::min(row[x], tri.depth) : row[x];
+					e0 += tri.a[0];
+					e1 += tri.a[1];
+					e2 += tri.a[2];
+				}
+			}
+		}
+
+		// 每块记录最远的遮挡深度：物体最近的深度比它还远时，这一块整体被遮挡
+		for (uint32_t ty = firstRow; ty < lastRow; ++ty) {
+			for (uint32_t tx = 0; tx < m_TilesX; ++tx) {
+				float maxDepth = 0.0f;
+				for (uint32_t y = ty * TileSize; y < (ty + 1) * TileSize; ++y) {
+					const float* row = m_Depth.data() + (size_t)y * m_Width + tx * TileSize;
+					for (uint32_t x = 0; x < TileSize; ++x)
+						maxDepth = std::max(maxDepth, row[x]);
+				}
+				m_TileMaxDepth[ty * m_TilesX + tx] = maxDepth;
+			}
+		}
+	}
+
+	bool OcclusionCuller::IsVisible(const BoundingBox& worldBox) const
+	{
+		if (m_Triangles.empty() || !worldBox.IsValid()) return true;
+
+		// 包围盒 8 个角投影后的屏幕矩形与最近深度
+		float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+		float minDepth = FLT_MAX;
+		for (uint32_t i = 0; i < 8; ++i) {
+			glm::vec3 corner((i & 1) ? worldBox.max.x : worldBox.min.x,
+				(i & 2) ? worldBox.max.y : worldBox.min.y,
+				(i & 4) ? worldBox.max.z : worldBox.min.z);
+			glm::vec4 clip = m_ViewProjection * glm::vec4(corner, 1.0f);
+			// 有角点在相机附近或身后：投影不可靠，按可见处理
+			if (clip.w <= 1e-5f) return true;
+
+			float invW = 1.0f / clip.w;
+			float x = (clip.x * invW * 0.5f + 0.5f) * (float)m_Width;
+			float y = (clip.y * invW * 0.5f + 0.5f) * (float)m_Height;
+			minX = std::min(minX, x);
+			maxX = std::max(maxX, x);
+			minY = std::min(minY, y);
+			maxY = std::max(maxY, y);
+			minDepth = std::min(minDepth, clip.z * invW * 0.5f + 0.5f);
+		}
+
+		int32_t x0 = std::max(0, (int32_t)std::floor(minX));
+		int32_t x1 = std::min((int32_t)m_Width - 1, (int32_t)std::ceil(maxX) - 1);
+		int32_t y0 = std::max(0, (int32_t)std::floor(minY));
+		int32_t y1 = std::min((int32_t)m_Height - 1, (int32_t)std::ceil(maxY) - 1);
+		// 屏幕外的部分交给视锥剔除
+		if (x0 > x1 || y0 > y1) return true;
+		if (minDepth <= 0.0f) return true;
+
+		for (int32_t ty = y0 / (int32_t)TileSize; ty <= y1 / (int32_t)TileSize; ++ty) {
+			for (int32_t tx = x0 / (int32_t)TileSize; tx <= x1 / (int32_t)TileSize; ++tx) {
+				if (m_TileMaxDepth[ty * m_TilesX + tx] < minDepth) continue;
+
+				// 块内有比物体更远（或未被遮挡）的像素，逐像素检查与矩形重叠的部分
+				int32_t px0 = std::max(x0, tx * (int32_t)TileSize);
+				int32_t px1 = std::min(x1, (tx + 1) * (int32_t)TileSize - 1);
+				int32_t py0 = std::max(y0, ty * (int32_t)TileSize);
+				int32_t py1 = std::min(y1, (ty + 1) * (int32_t)TileSize - 1);
+				for (int32_t y = py0; y <= py1; ++y) {
+					const float* row = m_Depth.data() + (size_t)y * m_Width;
+					for (int32_t x = px0; x <= px1; ++x) {
+						if (row[x] >= minDepth) return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include "Bounds.h"
+#include "Intro/Jobs/JobSystem.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Intro {
+
+	// CPU 软件遮挡剔除：
+	// - 标记为遮挡体的简化几何（盒子或低模网格）在 CPU 上光栅化到一张低分辨率深度缓冲，
+	//   每个三角形只写入它最远顶点的深度，保证遮挡深度是保守的（不会比真实几何更近）
+	// - 缓冲按 TileSize x TileSize 分块，每块记录块内最远的遮挡深度；测试时先比较块，块不能判定时再逐像素比较
+	// - 按块行分给多个线程光栅化，每个线程只写自己的行，无需加锁
+	// 不依赖 GL，可以在没有 GPU 的环境下单独使用
+	class ITR_API OcclusionCuller
+	{
+	public:
+		static constexpr uint32_t TileSize = 8;
+		static constexpr uint32_t BufferWidth = 256;		// 高度按视口宽高比取整到 TileSize 的倍数
+		static constexpr uint32_t MaxBufferHeight = 256;
+
+		OcclusionCuller() = default;
+		~OcclusionCuller();
+
+		OcclusionCuller(const OcclusionCuller&) = delete;
+		OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+		// 清空上一帧的遮挡体，按视口宽高比确定缓冲尺寸
+		void BeginFrame(const glm::mat4& viewProjection, uint32_t viewportWidth, uint32_t viewportHeight);
+
+		// 添加遮挡体（局部空间几何 + 模型矩阵）。遮挡几何必须位于可见几何内部，否则会错误地剔除物体
+		void AddOccluderBox(const BoundingBox& localBox, const glm::mat4& transform);
+		// positions 指向第一个顶点的位置，stride 为相邻顶点的字节距离（例如 sizeof(Vertex)）
+		void AddOccluderMesh(const void* positions, size_t stride, const uint32_t* indices, size_t indexCount,
+			const glm::mat4& transform, bool cullBackFaces = false);
+
+		// 光栅化全部遮挡体；RasterizeAsync 作为任务提交给 JobSystem，调用 IsVisible 之前必须 Wait
+		void Rasterize();
+		void RasterizeAsync();
+		void Wait();
+
+		bool HasOccluders() const { return !m_Triangles.empty(); }
+
+		// 世界空间包围盒是否可能可见（与相机近平面相交或超出屏幕时总是返回 true）
+		bool IsVisible(const BoundingBox& worldBox) const;
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+		// 行优先的深度缓冲（[0, 1]，1 为没有遮挡），用于调试显示
+		const std::vector<float>& GetDepthBuffer() const { return m_Depth; }
+
+		struct Statistics {
+			uint32_t occluderCount = 0;
+			uint32_t triangleCount = 0;		// 裁剪后参与光栅化的三角形
+			uint32_t workerCount = 0;
+			float rasterMs = 0.0f;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		// 屏幕空间三角形：三条边的边函数 A*x + B*y + C（内部为非负）与保守深度
+		struct Triangle {
+			float a[3], b[3], c[3];
+			float depth;
+			int32_t minX, maxX, minY, maxY;
+		};
+
+		void AddClipTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2, bool cullBackFaces);
+		void SetupTriangle(const glm::vec4* clip, uint32_t count, bool cullBackFaces);
+		void RasterizeTileRows(uint32_t firstRow, uint32_t lastRow);
+
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		uint32_t m_Width = BufferWidth;
+		uint32_t m_Height = 128;
+		uint32_t m_TilesX = BufferWidth / TileSize;
+		uint32_t m_TilesY = 128 / TileSize;
+
+		std::vector<Triangle> m_Triangles;
+		std::vector<float> m_Depth;
+		std::vector<float> m_TileMaxDepth;
+		JobCounter m_Job;
+
+		Statistics m_Stats;
+	};
+
+}
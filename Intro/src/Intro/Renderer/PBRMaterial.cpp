@@ -2,6 +2,9 @@
 #include "PBRMaterial.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "RenderState.h"
+#include "MaterialTable.h"
+#include "Intro/Log.h"
 #include <glad/glad.h>
 
 namespace Intro {
@@ -14,6 +17,7 @@ namespace Intro {
         , m_AO(1.0f)
         , m_Emissive(0.0f, 0.0f, 0.0f)
         , m_Exposure(1.0f)
+        , m_Opacity(1.0f)
         , m_UseAlbedoMap(false)
         , m_UseNormalMap(false)
         , m_UseMetallicMap(false)
@@ -21,214 +25,156 @@ namespace Intro {
         , m_UseAOMap(false)
         , m_UseEmissiveMap(false)
     {
-        
+        m_GPUIndex = MaterialTable::Register();
+        SyncGPUData();
     }
 
-    void PBRMaterial::Bind() {
-        std::cout << "=== PBRMaterial::Bind()  ===" << std::endl;
-        auto shaderPtr = GetShader();
-        if (!shaderPtr) return;
+    PBRMaterial::~PBRMaterial() {
+        const std::shared_ptr<Texture>* maps[Map_Count] = {
+            &m_AlbedoMap, &m_NormalMap, &m_MetallicMap, &m_RoughnessMap, &m_AOMap, &m_EmissiveMap };
+        for (int kind = 0; kind < Map_Count; ++kind) {
+            if (*maps[kind] && m_MapSlots[kind].IsValid())
+                TextureArrayPool::Release(**maps[kind]);
+        }
+        MaterialTable::Unregister(m_GPUIndex);
+    }
 
-        shaderPtr->Bind();
-        SetPBRUniforms();
-        BindPBRTextures();
+    namespace {
+        // 贴图采样器与 IBL 采样器的名称哈希（编译期计算）及固定纹理单元
+        // 0: albedo, 1: normal, 2: metallic, 3: roughness, 4: ao, 5: emissive, 6~8: IBL
+        constexpr uint32_t kSamplerNames[] = {
+            Shader::HashName("material_albedo"),
+            Shader::HashName("material_normal"),
+            Shader::HashName("material_metallic"),
+            Shader::HashName("material_roughness"),
+            Shader::HashName("material_ao"),
+            Shader::HashName("material_emissive")
+        };
+
+        constexpr uint32_t kIrradianceMap = Shader::HashName("u_IrradianceMap");
+        constexpr uint32_t kPrefilterMap = Shader::HashName("u_PrefilterMap");
+        constexpr uint32_t kBRDFLUT = Shader::HashName("u_BRDFLUT");
     }
 
-    void PBRMaterial::SetPBRUniforms() {
+    void PBRMaterial::Bind() {
         auto shaderPtr = GetShader();
         if (!shaderPtr) return;
 
-        // ؼPBR UniformǷ
-        GLint albedoLoc = shaderPtr->GetUniformLocation("u_AlbedoColor");
-        GLint metallicLoc = shaderPtr->GetUniformLocation("u_Metallic");
-        GLint roughnessLoc = shaderPtr->GetUniformLocation("u_Roughness");
-        GLint useAlbedoMapLoc = shaderPtr->GetUniformLocation("u_UseAlbedoMap");
-
-        std::cout << "PBR Uniform Locations:" << std::endl;
-        std::cout << "u_AlbedoColor: " << albedoLoc << std::endl;
-        std::cout << "u_Metallic: " << metallicLoc << std::endl;
-        std::cout << "u_Roughness: " << roughnessLoc << std::endl;
-        std::cout << "u_UseAlbedoMap: " << useAlbedoMapLoc << std::endl;
+        shaderPtr->Bind();
 
-        // κιؼUniform-1˵Shader
-        if (albedoLoc == -1 || metallicLoc == -1) {
-            std::cout << "ERROR: ؼPBR Uniformδҵ" << std::endl;
+        // 只绑定用到的贴图所在的纹理数组；RenderState 会过滤与上一个材质相同的绑定
+        for (int kind = 0; kind < Map_Count; ++kind) {
+            if (IsMapUsed((MapKind)kind))
+                RenderState::BindTexture(kind, GL_TEXTURE_2D_ARRAY, TextureArrayPool::GetTexture(m_MapSlots[kind].bucket));
+            shaderPtr->SetUniformInt(shaderPtr->GetUniformHandle(kSamplerNames[kind]), kind);
         }
 
-
-        // PBRʲ
-        shaderPtr->SetUniformVec3("u_AlbedoColor", m_Albedo);
-        shaderPtr->SetUniformFloat("u_Metallic", m_Metallic);
-        shaderPtr->SetUniformFloat("u_Roughness", m_Roughness);
-        shaderPtr->SetUniformFloat("u_AO", m_AO);
-        shaderPtr->SetUniformVec3("u_EmissiveColor", m_Emissive);
-        shaderPtr->SetUniformFloat("u_Exposure", m_Exposure);
-        shaderPtr->SetUniformVec3("u_AmbientColor", GetAmbient());
-
-        // ʹñ־
-        shaderPtr->SetUniformInt("u_UseAlbedoMap", m_UseAlbedoMap ? 1 : 0);
-        shaderPtr->SetUniformInt("u_UseNormalMap", m_UseNormalMap ? 1 : 0);
-        shaderPtr->SetUniformInt("u_UseMetallicMap", m_UseMetallicMap ? 1 : 0);
-        shaderPtr->SetUniformInt("u_UseRoughnessMap", m_UseRoughnessMap ? 1 : 0);
-        shaderPtr->SetUniformInt("u_UseAOMap", m_UseAOMap ? 1 : 0);
-        shaderPtr->SetUniformInt("u_UseEmissiveMap", m_UseEmissiveMap ? 1 : 0);
+        // IBL 采样器使用独立的纹理单元，避免与贴图数组的采样器类型冲突
+        shaderPtr->SetUniformInt(shaderPtr->GetUniformHandle(kIrradianceMap), 6);
+        shaderPtr->SetUniformInt(shaderPtr->GetUniformHandle(kPrefilterMap), 7);
+        shaderPtr->SetUniformInt(shaderPtr->GetUniformHandle(kBRDFLUT), 8);
     }
 
-    void PBRMaterial::BindPBRTextures() {
-        // PBRӦԪ
-        // Ԫ䣺
-        // 0: albedo, 1: normal, 2: metallic, 3: roughness, 4: ao, 5: emissive
-
-        GLuint whiteTex = GetOrCreateWhiteTexture();
-
-        // Albedo map
-        glActiveTexture(GL_TEXTURE0);
-        if (m_UseAlbedoMap && m_AlbedoMap) {
-            glBindTexture(GL_TEXTURE_2D, m_AlbedoMap->GetID());
-        }
-        else {
-            glBindTexture(GL_TEXTURE_2D, whiteTex);
-        }
+    bool PBRMaterial::IsMapUsed(MapKind kind) const {
+        static constexpr bool PBRMaterial::* useFlags[Map_Count] = {
+            &PBRMaterial::m_UseAlbedoMap, &PBRMaterial::m_UseNormalMap, &PBRMaterial::m_UseMetallicMap,
+            &PBRMaterial::m_UseRoughnessMap, &PBRMaterial::m_UseAOMap, &PBRMaterial::m_UseEmissiveMap };
+        return this->*useFlags[kind] && m_MapSlots[kind].IsValid();
+    }
 
-        // Normal map
-        glActiveTexture(GL_TEXTURE1);
-        if (m_UseNormalMap && m_NormalMap) {
-            glBindTexture(GL_TEXTURE_2D, m_NormalMap->GetID());
-        }
-        else {
-            // ڷͼĬʹԷ (0.5, 0.5, 1.0)
-            static GLuint defaultNormalTex = 0;
-            if (defaultNormalTex == 0) {
-                glGenTextures(1, &defaultNormalTex);
-                glBindTexture(GL_TEXTURE_2D, defaultNormalTex);
-                unsigned char normal[3] = { 128, 128, 255 }; // (0.5, 0.5, 1.0) in normalized
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, normal);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            }
-            glBindTexture(GL_TEXTURE_2D, defaultNormalTex);
+    uint64_t PBRMaterial::GetBindingKey() const {
+        // 最高位区分 PBR 绑定键与普通材质 ID；每类贴图占 10 位，记录所在数组编号 + 1（0 表示未使用）
+        uint64_t key = uint64_t(1) << 63;
+        for (int kind = 0; kind < Map_Count; ++kind) {
+            uint64_t bucket = IsMapUsed((MapKind)kind) ? (uint64_t)(m_MapSlots[kind].bucket + 1) & 0x3FF : 0;
+            key |= bucket << (kind * 10);
         }
+        return key;
+    }
 
-        // Metallic map
-        glActiveTexture(GL_TEXTURE2);
-        if (m_UseMetallicMap && m_MetallicMap) {
-            glBindTexture(GL_TEXTURE_2D, m_MetallicMap->GetID());
-        }
-        else {
-            // ڽȣĬʹúɫ (0.0)
-            static GLuint defaultBlackTex = 0;
-            if (defaultBlackTex == 0) {
-                glGenTextures(1, &defaultBlackTex);
-                glBindTexture(GL_TEXTURE_2D, defaultBlackTex);
-                unsigned char black[1] = { 0 };
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, 1, 1, 0, GL_RED, GL_UNSIGNED_BYTE, black);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            }
-            glBindTexture(GL_TEXTURE_2D, defaultBlackTex);
-        }
+    void PBRMaterial::SyncGPUData() {
+        GPUMaterialData data;
+        data.albedoMetallic = glm::vec4(m_Albedo, m_Metallic);
+        data.emissiveRoughness = glm::vec4(m_Emissive, m_Roughness);
+        data.params = glm::vec4(m_AO, m_Exposure, m_Opacity, 0.0f);
 
-        // Roughness map
-        glActiveTexture(GL_TEXTURE3);
-        if (m_UseRoughnessMap && m_RoughnessMap) {
-            glBindTexture(GL_TEXTURE_2D, m_RoughnessMap->GetID());
-        }
-        else {
-            // ڴֲڶȣĬʹðɫ (1.0)
-            glBindTexture(GL_TEXTURE_2D, whiteTex);
-        }
+        auto layer = [this](MapKind kind) { return IsMapUsed(kind) ? m_MapSlots[kind].layer : -1; };
+        data.layers0 = glm::ivec4(layer(Map_Albedo), layer(Map_Normal), layer(Map_Metallic), layer(Map_Roughness));
+        data.layers1 = glm::ivec4(layer(Map_AO), layer(Map_Emissive), -1, -1);
 
-        // AO map
-        glActiveTexture(GL_TEXTURE4);
-        if (m_UseAOMap && m_AOMap) {
-            glBindTexture(GL_TEXTURE_2D, m_AOMap->GetID());
-        }
-        else {
-            glBindTexture(GL_TEXTURE_2D, whiteTex);
-        }
+        MaterialTable::Update(m_GPUIndex, data);
+    }
 
-        // Emissive map
-        glActiveTexture(GL_TEXTURE5);
-        if (m_UseEmissiveMap && m_EmissiveMap) {
-            glBindTexture(GL_TEXTURE_2D, m_EmissiveMap->GetID());
-        }
-        else {
-            static GLuint defaultBlackTex = 0;
-            if (defaultBlackTex == 0) {
-                glGenTextures(1, &defaultBlackTex);
-                glBindTexture(GL_TEXTURE_2D, defaultBlackTex);
-                unsigned char black[3] = { 0, 0, 0 };
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, black);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            }
-            glBindTexture(GL_TEXTURE_2D, defaultBlackTex);
-        }
+    void PBRMaterial::AssignMap(MapKind kind, std::shared_ptr<Texture>& member, std::shared_ptr<Texture> texture) {
+        if (member && m_MapSlots[kind].IsValid())
+            TextureArrayPool::Release(*member);
+        m_MapSlots[kind] = TextureArraySlot();
 
-        // uniform
-        auto shaderPtr = GetShader();
-        if (shaderPtr) {
-            shaderPtr->SetUniformInt("material_albedo", 0);
-            shaderPtr->SetUniformInt("material_normal", 1);
-            shaderPtr->SetUniformInt("material_metallic", 2);
-            shaderPtr->SetUniformInt("material_roughness", 3);
-            shaderPtr->SetUniformInt("material_ao", 4);
-            shaderPtr->SetUniformInt("material_emissive", 5);
+        member = std::move(texture);
+        if (member) {
+            m_MapSlots[kind] = TextureArrayPool::Acquire(*member);
+            if (!m_MapSlots[kind].IsValid())
+                ITR_WARN("PBRMaterial: texture could not be placed in a texture array and will be ignored");
         }
-
-        // õԪ0
-        glActiveTexture(GL_TEXTURE0);
     }
 
-    // PBR÷ʵ
-    void PBRMaterial::SetAlbedo(const glm::vec3& albedo) { m_Albedo = albedo; }
-    void PBRMaterial::SetMetallic(float metallic) { m_Metallic = metallic; }
-    void PBRMaterial::SetRoughness(float roughness) { m_Roughness = roughness; }
-    void PBRMaterial::SetAO(float ao) { m_AO = ao; }
-    void PBRMaterial::SetEmissive(const glm::vec3& emissive) { m_Emissive = emissive; }
-    void PBRMaterial::SetExposure(float exposure) { m_Exposure = exposure; }
+    // PBR参数设置方法实现（写入 CPU 镜像，下一次 Flush 前统一上传）
+    void PBRMaterial::SetAlbedo(const glm::vec3& albedo) { m_Albedo = albedo; SyncGPUData(); }
+    void PBRMaterial::SetMetallic(float metallic) { m_Metallic = metallic; SyncGPUData(); }
+    void PBRMaterial::SetRoughness(float roughness) { m_Roughness = roughness; SyncGPUData(); }
+    void PBRMaterial::SetAO(float ao) { m_AO = ao; SyncGPUData(); }
+    void PBRMaterial::SetEmissive(const glm::vec3& emissive) { m_Emissive = emissive; SyncGPUData(); }
+    void PBRMaterial::SetExposure(float exposure) { m_Exposure = exposure; SyncGPUData(); }
+    void PBRMaterial::SetOpacity(float opacity) { m_Opacity = glm::clamp(opacity, 0.0f, 1.0f); SyncGPUData(); }
 
-    // PBR÷ʵ
+    // PBR纹理设置方法实现
     void PBRMaterial::SetAlbedoMap(std::shared_ptr<Texture> texture) {
-        m_AlbedoMap = std::move(texture);
+        AssignMap(Map_Albedo, m_AlbedoMap, std::move(texture));
         m_UseAlbedoMap = (m_AlbedoMap != nullptr);
+        SyncGPUData();
     }
     void PBRMaterial::SetNormalMap(std::shared_ptr<Texture> texture) {
-        m_NormalMap = std::move(texture);
+        AssignMap(Map_Normal, m_NormalMap, std::move(texture));
         m_UseNormalMap = (m_NormalMap != nullptr);
+        SyncGPUData();
     }
     void PBRMaterial::SetMetallicMap(std::shared_ptr<Texture> texture) {
-        m_MetallicMap = std::move(texture);
+        AssignMap(Map_Metallic, m_MetallicMap, std::move(texture));
         m_UseMetallicMap = (m_MetallicMap != nullptr);
+        SyncGPUData();
     }
     void PBRMaterial::SetRoughnessMap(std::shared_ptr<Texture> texture) {
-        m_RoughnessMap = std::move(texture);
+        AssignMap(Map_Roughness, m_RoughnessMap, std::move(texture));
         m_UseRoughnessMap = (m_RoughnessMap != nullptr);
+        SyncGPUData();
     }
     void PBRMaterial::SetAOMap(std::shared_ptr<Texture> texture) {
-        m_AOMap = std::move(texture);
+        AssignMap(Map_AO, m_AOMap, std::move(texture));
         m_UseAOMap = (m_AOMap != nullptr);
+        SyncGPUData();
     }
     void PBRMaterial::SetEmissiveMap(std::shared_ptr<Texture> texture) {
-        m_EmissiveMap = std::move(texture);
+        AssignMap(Map_Emissive, m_EmissiveMap, std::move(texture));
         m_UseEmissiveMap = (m_EmissiveMap != nullptr);
+        SyncGPUData();
     }
 
-    // ʹñ־÷
-    void PBRMaterial::SetUseAlbedoMap(bool use) { m_UseAlbedoMap = use; }
-    void PBRMaterial::SetUseNormalMap(bool use) { m_UseNormalMap = use; }
-    void PBRMaterial::SetUseMetallicMap(bool use) { m_UseMetallicMap = use; }
-    void PBRMaterial::SetUseRoughnessMap(bool use) { m_UseRoughnessMap = use; }
-    void PBRMaterial::SetUseAOMap(bool use) { m_UseAOMap = use; }
-    void PBRMaterial::SetUseEmissiveMap(bool use) { m_UseEmissiveMap = use; }
+    // 纹理使用标志设置方法
+    void PBRMaterial::SetUseAlbedoMap(bool use) { m_UseAlbedoMap = use; SyncGPUData(); }
+    void PBRMaterial::SetUseNormalMap(bool use) { m_UseNormalMap = use; SyncGPUData(); }
+    void PBRMaterial::SetUseMetallicMap(bool use) { m_UseMetallicMap = use; SyncGPUData(); }
+    void PBRMaterial::SetUseRoughnessMap(bool use) { m_UseRoughnessMap = use; SyncGPUData(); }
+    void PBRMaterial::SetUseAOMap(bool use) { m_UseAOMap = use; SyncGPUData(); }
+    void PBRMaterial::SetUseEmissiveMap(bool use) { m_UseEmissiveMap = use; SyncGPUData(); }
 
-    // Getterʵ
+    // Getter方法实现
     glm::vec3 PBRMaterial::GetAlbedo() const { return m_Albedo; }
     float PBRMaterial::GetMetallic() const { return m_Metallic; }
     float PBRMaterial::GetRoughness() const { return m_Roughness; }
     float PBRMaterial::GetAO() const { return m_AO; }
     glm::vec3 PBRMaterial::GetEmissive() const { return m_Emissive; }
     float PBRMaterial::GetExposure() const { return m_Exposure; }
+    float PBRMaterial::GetOpacity() const { return m_Opacity; }
 
     std::shared_ptr<Texture> PBRMaterial::GetAlbedoMap() const { return m_AlbedoMap; }
     std::shared_ptr<Texture> PBRMaterial::GetNormalMap() const { return m_NormalMap; }
@@ -244,7 +190,7 @@ namespace Intro {
     bool PBRMaterial::UseAOMap() const { return m_UseAOMap; }
     bool PBRMaterial::UseEmissiveMap() const { return m_UseEmissiveMap; }
 
-    // Է
+    // 兼容性方法
     void PBRMaterial::SetDiffuse(std::shared_ptr<Texture> texture) {
         SetAlbedoMap(std::move(texture));
     }
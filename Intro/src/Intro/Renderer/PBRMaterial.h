@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Material.h"
+#include "TextureArrayPool.h"
 #include <memory>
 #include <glm/glm.hpp>
 
@@ -9,19 +10,31 @@ namespace Intro {
     class ITR_API PBRMaterial : public Material {
     public:
         PBRMaterial(std::shared_ptr<Shader> shader = nullptr);
+        ~PBRMaterial() override;
 
-        // дBindʵPBRضİ߼
+        // 材质参数表槽位与纹理数组层是独占的，不允许拷贝
+        PBRMaterial(const PBRMaterial&) = delete;
+        PBRMaterial& operator=(const PBRMaterial&) = delete;
+
+        // 重写Bind方法以实现PBR特定的绑定逻辑：
+        // 参数已在 MaterialTable 中，这里只绑定 shader 和贴图所在的纹理数组
         void Bind() override;
 
-        // PBR
+        // 贴图所在的纹理数组相同的 PBR 材质共享绑定键（没有贴图的材质全部相同）
+        uint64_t GetBindingKey() const override;
+        uint32_t GetGPUMaterialIndex() const override { return m_GPUIndex; }
+
+        // PBR参数设置
         void SetAlbedo(const glm::vec3& albedo);
         void SetMetallic(float metallic);
         void SetRoughness(float roughness);
         void SetAO(float ao);
         void SetEmissive(const glm::vec3& emissive);
         void SetExposure(float exposure);
+        // 不透明度（只对透明物体有效）
+        void SetOpacity(float opacity);
 
-        // PBR
+        // PBR纹理设置
         void SetAlbedoMap(std::shared_ptr<Texture> texture);
         void SetNormalMap(std::shared_ptr<Texture> texture);
         void SetMetallicMap(std::shared_ptr<Texture> texture);
@@ -29,7 +42,7 @@ namespace Intro {
         void SetAOMap(std::shared_ptr<Texture> texture);
         void SetEmissiveMap(std::shared_ptr<Texture> texture);
 
-        // ʹñ־
+        // 纹理使用标志
         void SetUseAlbedoMap(bool use);
         void SetUseNormalMap(bool use);
         void SetUseMetallicMap(bool use);
@@ -44,6 +57,7 @@ namespace Intro {
         float GetAO() const;
         glm::vec3 GetEmissive() const;
         float GetExposure() const;
+        float GetOpacity() const;
 
         std::shared_ptr<Texture> GetAlbedoMap() const;
         std::shared_ptr<Texture> GetNormalMap() const;
@@ -59,23 +73,40 @@ namespace Intro {
         bool UseAOMap() const;
         bool UseEmissiveMap() const;
 
-        // Է
+        // 兼容性方法
         void SetDiffuse(std::shared_ptr<Texture> texture) override;
         std::shared_ptr<Texture> GetDiffuseTexture() const override;
 
     private:
-        void SetPBRUniforms();
-        void BindPBRTextures();
-
-        // PBRʲ
+        enum MapKind {
+            Map_Albedo = 0,
+            Map_Normal,
+            Map_Metallic,
+            Map_Roughness,
+            Map_AO,
+            Map_Emissive,
+            Map_Count
+        };
+
+        // 把参数与贴图层号写入 MaterialTable（参数或贴图变化时调用）
+        void SyncGPUData();
+        // 替换某一类贴图：释放旧贴图所在的层，把新贴图放入纹理数组
+        void AssignMap(MapKind kind, std::shared_ptr<Texture>& member, std::shared_ptr<Texture> texture);
+        bool IsMapUsed(MapKind kind) const;
+
+        uint32_t m_GPUIndex = 0;
+        TextureArraySlot m_MapSlots[Map_Count];
+
+        // PBR材质参数
         glm::vec3 m_Albedo;
         float m_Metallic;
         float m_Roughness;
         float m_AO;
         glm::vec3 m_Emissive;
         float m_Exposure;
+        float m_Opacity;
 
-        // PBR
+        // PBR纹理
         std::shared_ptr<Texture> m_AlbedoMap;
         std::shared_ptr<Texture> m_NormalMap;
         std::shared_ptr<Texture> m_MetallicMap;
@@ -83,7 +114,7 @@ namespace Intro {
         std::shared_ptr<Texture> m_AOMap;
         std::shared_ptr<Texture> m_EmissiveMap;
 
-        // ʹñ־
+        // 纹理使用标志
         bool m_UseAlbedoMap;
         bool m_UseNormalMap;
         bool m_UseMetallicMap;
@@ -1,4 +1,4 @@
-#include "itrpch.h" // ĿʹԤͷУƳ
+#include "itrpch.h" // 如果你的项目使用预编译头，保留此行；否则可以移除
 #include "RenderCommand.h"
 
 #include "Mesh.h"
@@ -15,4 +15,10 @@ namespace Intro {
         model.Draw(shader);
     }
 
+    void RenderCommand::DrawInstanced(const Mesh& mesh, Shader& shader, uint32_t instanceCount,
+                                      uint32_t baseInstance, uint32_t indexBuffer)
+    {
+        mesh.DrawInstanced(shader, instanceCount, baseInstance, indexBuffer);
+    }
+
 } // namespace Intro
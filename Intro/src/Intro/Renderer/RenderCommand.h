@@ -10,11 +10,15 @@ namespace Intro {
     class Shader;
 
     struct RenderCommand {
-        // Ƽ Shader ãú****ڲ bind/unbind shader
-        // Ϊڴʱⲿͳһ bind shader Ч
+        // 推荐：传入 Shader 引用（但该函数**不会**在内部 bind/unbind shader，
+        // 因为在大量对象时在外部统一 bind shader 更高效）
         static void Draw(const Mesh& mesh, Shader& shader);
 
         static void Draw(const Model& model, Shader& shader);
+
+        // 实例化绘制：实例 i 使用对象数据缓冲中的第 baseInstance + i 项
+        static void DrawInstanced(const Mesh& mesh, Shader& shader, uint32_t instanceCount,
+                                  uint32_t baseInstance, uint32_t indexBuffer);
     };
 } // namespace Intro
 
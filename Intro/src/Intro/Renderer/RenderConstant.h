@@ -3,12 +3,44 @@
 #include <glad/glad.h>
 
 namespace Intro {
-    // UBO󶨵
+    // UBO绑定点
     constexpr GLuint CAMERA_UBO_BINDING = 0;
     constexpr GLuint LIGHTS_UBO_BINDING = 1;
+    // 方向光级联阴影参数（ShadowMaps）
+    constexpr GLuint SHADOW_UBO_BINDING = 2;
 
-    // Դ
+    // 对象数据 SSBO 绑定点（每帧对象数据环形缓冲）
+    constexpr GLuint OBJECT_DATA_SSBO_BINDING = 2;
+
+    // 材质参数 SSBO 绑定点（MaterialTable）
+    constexpr GLuint MATERIAL_SSBO_BINDING = 3;
+
+    // 分簇光照 SSBO 绑定点（LightClusters）：光源数组 / 每簇区间 / 光源索引表
+    constexpr GLuint LIGHT_SSBO_BINDING = 4;
+    constexpr GLuint LIGHT_CLUSTER_SSBO_BINDING = 5;
+    constexpr GLuint LIGHT_INDEX_SSBO_BINDING = 6;
+
+    // 点光源/聚光灯阴影在图集中的矩阵与区域（ShadowMaps）
+    constexpr GLuint LOCAL_SHADOW_SSBO_BINDING = 7;
+
+    // 阴影贴图使用的纹理单元（避开材质贴图与 IBL 使用的低位单元，shader 中以 layout(binding) 固定）
+    constexpr GLuint SHADOW_CASCADE_TEXTURE_UNIT = 10;
+    constexpr GLuint SHADOW_ATLAS_TEXTURE_UNIT = 11;
+
+    // 对象数据 ids.w 的标志位：按加权混合 OIT 的格式输出（累积 + 透射率两个目标）
+    constexpr uint32_t OBJECT_FLAG_WEIGHTED_OIT = 1u;
+
+    // 实例化对象索引属性位置（uint，每实例前进一次，由 baseInstance 偏移）
+    constexpr GLuint OBJECT_INDEX_LOCATION = 5;
+
+    // 最大方向光数量（点光源与聚光灯走分簇光照，不设上限）
     constexpr int MAX_DIR_LIGHTS = 4;
-    constexpr int MAX_POINT_LIGHTS = 8;
-    constexpr int MAX_SPOT_LIGHTS = 4;
+
+    // 方向光阴影的最大级联数
+    constexpr uint32_t MAX_SHADOW_CASCADES = 4;
+
+    // 光照簇网格：屏幕 X x Y 块，深度方向 Z 个指数切片
+    constexpr uint32_t LIGHT_CLUSTER_X = 16;
+    constexpr uint32_t LIGHT_CLUSTER_Y = 9;
+    constexpr uint32_t LIGHT_CLUSTER_Z = 24;
 }
\ No newline at end of file
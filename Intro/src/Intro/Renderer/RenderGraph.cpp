@@ -0,0 +1,470 @@
+#include "itrpch.h"
+#include "RenderGraph.h"
+#include "Renderer.h"
+#include "RenderState.h"
+#include "GPUProfiler.h"
+#include "Intro/Log.h"
+
+namespace Intro {
+
+	namespace {
+
+		bool IsDepthFormat(GLenum format)
+		{
+			switch (format) {
+			case GL_DEPTH_COMPONENT16:
+			case GL_DEPTH_COMPONENT24:
+			case GL_DEPTH_COMPONENT32F:
+			case GL_DEPTH24_STENCIL8:
+			case GL_DEPTH32F_STENCIL8:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool HasStencil(GLenum format)
+		{
+			return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+		}
+
+		GLuint CreatePoolTexture(const RenderGraphTextureDesc& desc)
+		{
+			GLuint texture = 0;
+			glGenTextures(1, &texture);
+			RenderState::BindTexture(GL_TEXTURE_2D, texture);
+			glTexStorage2D(GL_TEXTURE_2D, 1, desc.internalFormat, (GLsizei)desc.width, (GLsizei)desc.height);
+
+			GLint filter = IsDepthFormat(desc.internalFormat) ? GL_NEAREST : GL_LINEAR;
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			RenderState::BindTexture(GL_TEXTURE_2D, 0);
+			return texture;
+		}
+	}
+
+	// ==================== RenderGraphBuilder ====================
+
+	RenderGraphResource RenderGraphBuilder::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+	{
+		RenderGraph::ResourceNode node;
+		node.name = name;
+		node.desc = desc;
+		m_Graph.m_Resources.push_back(node);
+		return (RenderGraphResource)(m_Graph.m_Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource)
+	{
+		if (resource >= m_Graph.m_Resources.size()) return InvalidRenderGraphResource;
+		m_Graph.m_Passes[m_PassIndex].reads.push_back(resource);
+		return resource;
+	}
+
+	RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource, AttachmentLoadOp loadOp, const glm::vec4& clearValue)
+	{
+		if (resource >= m_Graph.m_Resources.size()) return InvalidRenderGraphResource;
+
+		auto& pass = m_Graph.m_Passes[m_PassIndex];
+		auto& node = m_Graph.m_Resources[resource];
+		if (!IsDepthFormat(node.desc.internalFormat)) {
+			uint32_t colorCount = 0;
+			for (const auto& write : pass.writes)
+				if (!IsDepthFormat(m_Graph.m_Resources[write.resource].desc.internalFormat)) colorCount++;
+			if (colorCount >= RenderGraph::MaxColorAttachments) {
+				ITR_ERROR("RenderGraph: pass '{}' writes more than {} color attachments", pass.name, RenderGraph::MaxColorAttachments);
+				return InvalidRenderGraphResource;
+			}
+		}
+
+		// 以 Load 写入已有内容的资源依赖之前的写入者（例如主通道保留深度预通道的结果），按读取计入引用
+		if (loadOp == AttachmentLoadOp::Load && !node.writers.empty())
+			pass.reads.push_back(resource);
+
+		pass.writes.push_back({ resource, loadOp, clearValue });
+		node.writers.push_back(m_PassIndex);
+		return resource;
+	}
+
+	void RenderGraphBuilder::SetSideEffect()
+	{
+		m_Graph.m_Passes[m_PassIndex].sideEffect = true;
+	}
+
+	void RenderGraphBuilder::SetRenderArea(uint32_t width, uint32_t height)
+	{
+		RenderGraph::PassNode& pass = m_Graph.m_Passes[m_PassIndex];
+		pass.renderWidth = width;
+		pass.renderHeight = height;
+	}
+
+	// ==================== RenderGraph ====================
+
+	RenderGraph::~RenderGraph()
+	{
+		ReleaseResources();
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_Resources.clear();
+		m_Passes.clear();
+		m_Compiled = false;
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& name, GLuint texture, const RenderGraphTextureDesc& desc)
+	{
+		ResourceNode node;
+		node.name = name;
+		node.desc = desc;
+		node.texture = texture;
+		node.imported = true;
+		m_Resources.push_back(node);
+		return (RenderGraphResource)(m_Resources.size() - 1);
+	}
+
+	void RenderGraph::AddPass(const std::string& name, const SetupFn& setup, const ExecuteFn& execute)
+	{
+		PassNode pass;
+		pass.name = name;
+		pass.execute = execute;
+		m_Passes.push_back(std::move(pass));
+
+		RenderGraphBuilder builder(*this, (uint32_t)(m_Passes.size() - 1));
+		if (setup) setup(builder);
+		m_Compiled = false;
+	}
+
+	void RenderGraph::Compile()
+	{
+		// 引用计数：通道被写入的资源数，资源被读取的次数（导入资源视为被外部读取一次）
+		for (auto& resource : m_Resources)
+			resource.refCount = resource.imported ? 1 : 0;
+		for (auto& pass : m_Passes) {
+			pass.refCount = (uint32_t)pass.writes.size();
+			pass.culled = false;
+			for (RenderGraphResource r : pass.reads)
+				m_Resources[r].refCount++;
+		}
+
+		// 从没有读者的资源出发，反向剔除只产出无用资源的通道
+		std::vector<RenderGraphResource> unreferenced;
+		for (RenderGraphResource r = 0; r < m_Resources.size(); ++r) {
+			if (m_Resources[r].refCount == 0) unreferenced.push_back(r);
+		}
+
+		auto cullPass = [&](PassNode& pass) {
+			pass.culled = true;
+			for (RenderGraphResource r : pass.reads) {
+				if (--m_Resources[r].refCount == 0) unreferenced.push_back(r);
+			}
+		};
+
+		for (auto& pass : m_Passes) {
+			if (pass.refCount == 0 && !pass.sideEffect) cullPass(pass);
+		}
+
+		while (!unreferenced.empty()) {
+			RenderGraphResource r = unreferenced.back();
+			unreferenced.pop_back();
+			for (uint32_t writer : m_Resources[r].writers) {
+				PassNode& pass = m_Passes[writer];
+				if (pass.culled || pass.sideEffect) continue;
+				if (--pass.refCount == 0) cullPass(pass);
+			}
+		}
+
+		// 存活通道中每个资源的首次/最后一次使用
+		m_Stats.passCount = 0;
+		m_Stats.culledPasses = 0;
+		m_Stats.transientTextures = 0;
+		for (auto& resource : m_Resources) {
+			resource.firstPass = UINT32_MAX;
+			resource.lastPass = 0;
+		}
+
+		for (uint32_t i = 0; i < m_Passes.size(); ++i) {
+			const PassNode& pass = m_Passes[i];
+			if (pass.culled) {
+				m_Stats.culledPasses++;
+				continue;
+			}
+			m_Stats.passCount++;
+
+			auto touch = [&](RenderGraphResource r) {
+				ResourceNode& resource = m_Resources[r];
+				resource.firstPass = std::min(resource.firstPass, i);
+				resource.lastPass = std::max(resource.lastPass, i);
+			};
+			for (RenderGraphResource r : pass.reads) {
+				if (!m_Resources[r].imported && m_Resources[r].writers.empty())
+					ITR_WARN("RenderGraph: pass '{}' reads '{}' which is never written", pass.name, m_Resources[r].name);
+				touch(r);
+			}
+			for (const auto& write : pass.writes) touch(write.resource);
+		}
+
+		for (const auto& resource : m_Resources) {
+			if (!resource.imported && resource.firstPass != UINT32_MAX) m_Stats.transientTextures++;
+		}
+
+		m_Compiled = true;
+	}
+
+	void RenderGraph::Execute()
+	{
+		if (!m_Compiled) Compile();
+
+		m_FrameIndex++;
+		m_Stats.framebufferBinds = 0;
+		m_Stats.clears = 0;
+
+		for (uint32_t i = 0; i < m_Passes.size(); ++i) {
+			PassNode& pass = m_Passes[i];
+			if (pass.culled) continue;
+
+			// 首次使用的临时纹理从池中取出
+			auto acquire = [&](RenderGraphResource r) {
+				ResourceNode& resource = m_Resources[r];
+				if (!resource.imported && resource.firstPass == i && resource.poolIndex < 0) AcquireTransient(resource);
+			};
+			for (const auto& write : pass.writes) acquire(write.resource);
+			for (RenderGraphResource r : pass.reads) acquire(r);
+
+			{
+				GPUProfileScope profileScope(pass.name.c_str());
+				BeginPassTargets(pass);
+				if (pass.execute) pass.execute(*this);
+				// 通道内提交的批次必须在切换目标前画完
+				Renderer::Flush();
+			}
+
+			// 最后一次使用之后归还，后续通道可以复用同一张物理纹理
+			for (auto& resource : m_Resources) {
+				if (!resource.imported && resource.lastPass == i && resource.poolIndex >= 0)
+					ReleaseTransient(resource);
+			}
+		}
+
+		EvictUnused();
+		m_Stats.physicalTextures = (uint32_t)m_TexturePool.size();
+		m_Stats.cachedFramebuffers = (uint32_t)m_Framebuffers.size();
+	}
+
+	GLuint RenderGraph::GetTexture(RenderGraphResource resource) const
+	{
+		if (resource >= m_Resources.size()) return 0;
+		return m_Resources[resource].texture;
+	}
+
+	const RenderGraphTextureDesc& RenderGraph::GetDesc(RenderGraphResource resource) const
+	{
+		static const RenderGraphTextureDesc s_Empty;
+		if (resource >= m_Resources.size()) return s_Empty;
+		return m_Resources[resource].desc;
+	}
+
+	void RenderGraph::AcquireTransient(ResourceNode& resource)
+	{
+		for (size_t i = 0; i < m_TexturePool.size(); ++i) {
+			PooledTexture& pooled = m_TexturePool[i];
+			if (!pooled.inUse && pooled.desc == resource.desc) {
+				pooled.inUse = true;
+				pooled.lastUsedFrame = m_FrameIndex;
+				resource.poolIndex = (int32_t)i;
+				resource.texture = pooled.texture;
+				return;
+			}
+		}
+
+		PooledTexture pooled;
+		pooled.desc = resource.desc;
+		pooled.texture = CreatePoolTexture(resource.desc);
+		pooled.inUse = true;
+		pooled.lastUsedFrame = m_FrameIndex;
+		m_TexturePool.push_back(pooled);
+
+		resource.poolIndex = (int32_t)(m_TexturePool.size() - 1);
+		resource.texture = pooled.texture;
+	}
+
+	void RenderGraph::ReleaseTransient(ResourceNode& resource)
+	{
+		m_TexturePool[resource.poolIndex].inUse = false;
+		resource.poolIndex = -1;
+	}
+
+	void RenderGraph::BeginPassTargets(const PassNode& pass)
+	{
+		if (pass.writes.empty()) return;
+
+		FramebufferKey key;
+		uint32_t colorCount = 0;
+		const RenderGraphTextureDesc* targetDesc = nullptr;
+		for (const auto& write : pass.writes) {
+			const ResourceNode& resource = m_Resources[write.resource];
+			if (IsDepthFormat(resource.desc.internalFormat))
+				key.depth = resource.texture;
+			else
+				key.color[colorCount++] = resource.texture;
+			if (!targetDesc) targetDesc = &resource.desc;
+		}
+
+		GLuint fbo = GetFramebuffer(key, pass);
+		if (RenderState::GetFramebuffer() != fbo) m_Stats.framebufferBinds++;
+		RenderState::BindFramebuffer(fbo);
+		uint32_t width = pass.renderWidth ? std::min(pass.renderWidth, targetDesc->width) : targetDesc->width;
+		uint32_t height = pass.renderHeight ? std::min(pass.renderHeight, targetDesc->height) : targetDesc->height;
+		RenderState::SetViewport(0, 0, (GLsizei)width, (GLsizei)height);
+
+		// 只清除要求 Clear 的附件；临时纹理第一次写入且为 Load 时内容未定义，同样无需清除
+		uint32_t colorIndex = 0;
+		for (const auto& write : pass.writes) {
+			const ResourceNode& resource = m_Resources[write.resource];
+			bool isDepth = IsDepthFormat(resource.desc.internalFormat);
+			GLint drawBuffer = isDepth ? 0 : (GLint)colorIndex++;
+
+			if (write.loadOp != AttachmentLoadOp::Clear) continue;
+
+			if (isDepth) {
+				// glClearBuffer 受深度写入掩码影响
+				bool prevDepthMask = RenderState::IsDepthMaskEnabled();
+				RenderState::SetDepthMask(true);
+				if (HasStencil(resource.desc.internalFormat))
+					glClearBufferfi(GL_DEPTH_STENCIL, 0, write.clearValue.x, 0);
+				else
+					glClearBufferfv(GL_DEPTH, 0, &write.clearValue.x);
+				RenderState::SetDepthMask(prevDepthMask);
+			}
+			else {
+				glClearBufferfv(GL_COLOR, drawBuffer, &write.clearValue.x);
+			}
+			m_Stats.clears++;
+		}
+	}
+
+	bool RenderGraph::FramebufferKey::operator==(const FramebufferKey& other) const
+	{
+		for (uint32_t i = 0; i < MaxColorAttachments; ++i)
+			if (color[i] != other.color[i]) return false;
+		return depth == other.depth;
+	}
+
+	size_t RenderGraph::FramebufferKeyHash::operator()(const FramebufferKey& key) const
+	{
+		size_t h = std::hash<GLuint>()(key.depth);
+		for (uint32_t i = 0; i < MaxColorAttachments; ++i)
+			h ^= std::hash<GLuint>()(key.color[i]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		return h;
+	}
+
+	GLuint RenderGraph::GetFramebuffer(const FramebufferKey& key, const PassNode& pass)
+	{
+		auto it = m_Framebuffers.find(key);
+		if (it != m_Framebuffers.end()) {
+			it->second.lastUsedFrame = m_FrameIndex;
+			return it->second.fbo;
+		}
+
+		CachedFramebuffer cached;
+		cached.lastUsedFrame = m_FrameIndex;
+		glGenFramebuffers(1, &cached.fbo);
+		RenderState::BindFramebuffer(cached.fbo);
+
+		GLenum drawBuffers[MaxColorAttachments];
+		uint32_t colorCount = 0;
+		for (uint32_t i = 0; i < MaxColorAttachments && key.color[i]; ++i) {
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, key.color[i], 0);
+			drawBuffers[colorCount++] = GL_COLOR_ATTACHMENT0 + i;
+		}
+		if (key.depth) {
+			GLenum depthFormat = GL_DEPTH_COMPONENT24;
+			for (const auto& write : pass.writes) {
+				if (m_Resources[write.resource].texture == key.depth)
+					depthFormat = m_Resources[write.resource].desc.internalFormat;
+			}
+			GLenum attachment = HasStencil(depthFormat) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+			glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, key.depth, 0);
+		}
+
+		if (colorCount > 0)
+			glDrawBuffers((GLsizei)colorCount, drawBuffers);
+		else
+			glDrawBuffer(GL_NONE);
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			ITR_ERROR("RenderGraph: framebuffer for pass '{}' is incomplete", pass.name);
+
+		m_Framebuffers.emplace(key, cached);
+		return cached.fbo;
+	}
+
+	void RenderGraph::EvictUnused()
+	{
+		// 先淘汰 FBO，再淘汰纹理（被淘汰纹理所在的 FBO 一并销毁）
+		auto isStale = [&](uint64_t lastUsedFrame) { return m_FrameIndex - lastUsedFrame > RetainFrames; };
+
+		std::vector<GLuint> evictedTextures;
+		for (size_t i = 0; i < m_TexturePool.size();) {
+			if (!m_TexturePool[i].inUse && isStale(m_TexturePool[i].lastUsedFrame)) {
+				evictedTextures.push_back(m_TexturePool[i].texture);
+				m_TexturePool[i] = m_TexturePool.back();
+				m_TexturePool.pop_back();
+			}
+			else {
+				++i;
+			}
+		}
+
+		for (GLuint texture : evictedTextures)
+			ReleaseExternalTexture(texture);
+
+		for (auto it = m_Framebuffers.begin(); it != m_Framebuffers.end();) {
+			if (isStale(it->second.lastUsedFrame)) {
+				RenderState::DeleteFramebuffers(1, &it->second.fbo);
+				it = m_Framebuffers.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
+		if (!evictedTextures.empty())
+			RenderState::DeleteTextures((GLsizei)evictedTextures.size(), evictedTextures.data());
+	}
+
+	void RenderGraph::ReleaseExternalTexture(GLuint texture)
+	{
+		if (!texture) return;
+		for (auto it = m_Framebuffers.begin(); it != m_Framebuffers.end();) {
+			const FramebufferKey& key = it->first;
+			bool references = key.depth == texture;
+			for (uint32_t i = 0; i < MaxColorAttachments; ++i)
+				references = references || key.color[i] == texture;
+
+			if (references) {
+				RenderState::DeleteFramebuffers(1, &it->second.fbo);
+				it = m_Framebuffers.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+
+	void RenderGraph::ReleaseResources()
+	{
+		for (auto& entry : m_Framebuffers)
+			RenderState::DeleteFramebuffers(1, &entry.second.fbo);
+		m_Framebuffers.clear();
+
+		for (auto& pooled : m_TexturePool)
+			RenderState::DeleteTextures(1, &pooled.texture);
+		m_TexturePool.clear();
+
+		Reset();
+	}
+
+}
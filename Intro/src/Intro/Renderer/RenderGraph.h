@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Intro {
+
+	// 渲染图中的资源句柄（每帧重新声明，只在本帧内有效）
+	using RenderGraphResource = uint32_t;
+	constexpr RenderGraphResource InvalidRenderGraphResource = UINT32_MAX;
+
+	struct RenderGraphTextureDesc
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		GLenum internalFormat = GL_RGBA8;	// sized 格式；深度格式会挂到深度（模板）附件上
+
+		bool operator==(const RenderGraphTextureDesc& other) const {
+			return width == other.width && height == other.height && internalFormat == other.internalFormat;
+		}
+	};
+
+	// 附件在通道开始时的处理方式
+	enum class AttachmentLoadOp
+	{
+		Load,		// 保留已有内容
+		Clear,		// 清除为 clearValue（深度附件使用 clearValue.x）
+		DontCare	// 通道会完整覆盖，不需要清除
+	};
+
+	class RenderGraph;
+
+	// 通道声明阶段使用：声明本通道创建、读取（采样）与写入（作为附件）的资源
+	class ITR_API RenderGraphBuilder
+	{
+	public:
+		// 创建临时纹理：由渲染图在首次使用前从纹理池分配，最后一次使用后归还，生命周期不重叠的纹理共享同一张物理纹理
+		RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+		RenderGraphResource Read(RenderGraphResource resource);
+		// 以 Load 写入前面通道已写过的资源时同时视为读取，之前的写入者不会被剔除
+		RenderGraphResource Write(RenderGraphResource resource, AttachmentLoadOp loadOp = AttachmentLoadOp::Load,
+			const glm::vec4& clearValue = glm::vec4(0.0f));
+		// 通道有图外可见的副作用（例如写默认帧缓冲），不参与剔除
+		void SetSideEffect();
+		// 只渲染附件左下角 width x height 的区域（动态分辨率）；不设置时视口为整个附件
+		void SetRenderArea(uint32_t width, uint32_t height);
+
+	private:
+		friend class RenderGraph;
+		RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+
+		RenderGraph& m_Graph;
+		uint32_t m_PassIndex;
+	};
+
+	// 帧图：
+	// - 每帧 Reset 后按执行顺序 AddPass（只能读取已声明的资源，因此声明顺序即合法的拓扑顺序）
+	// - Compile 剔除输出没有被使用的通道，并计算临时纹理的生命周期
+	// - Execute 按顺序分配/归还临时纹理，为每个通道绑定（缓存的）FBO、只在需要时清除附件
+	// 导入的纹理（ImportTexture）视为图的输出，写入它们的通道不会被剔除。
+	class ITR_API RenderGraph
+	{
+	public:
+		static constexpr uint32_t MaxColorAttachments = 4;
+		// 纹理池中的纹理 / 缓存的 FBO 连续这么多帧没有使用就释放（例如视口尺寸变化之后）
+		static constexpr uint32_t RetainFrames = 3;
+
+		using SetupFn = std::function<void(RenderGraphBuilder&)>;
+		using ExecuteFn = std::function<void(const RenderGraph&)>;
+
+		RenderGraph() = default;
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+
+		void Reset();
+
+		RenderGraphResource ImportTexture(const std::string& name, GLuint texture, const RenderGraphTextureDesc& desc);
+		void AddPass(const std::string& name, const SetupFn& setup, const ExecuteFn& execute);
+
+		void Compile();
+		void Execute();
+
+		// 执行阶段查询资源对应的 GL 纹理（用于采样）
+		GLuint GetTexture(RenderGraphResource resource) const;
+		const RenderGraphTextureDesc& GetDesc(RenderGraphResource resource) const;
+
+		// 外部纹理删除前调用，销毁缓存中引用它的 FBO（纹理 ID 可能被复用）
+		void ReleaseExternalTexture(GLuint texture);
+		// 释放纹理池与 FBO 缓存
+		void ReleaseResources();
+
+		struct Statistics {
+			uint32_t passCount = 0;
+			uint32_t culledPasses = 0;
+			uint32_t transientTextures = 0;		// 本帧声明的临时纹理
+			uint32_t physicalTextures = 0;		// 纹理池中的物理纹理
+			uint32_t framebufferBinds = 0;
+			uint32_t clears = 0;
+			uint32_t cachedFramebuffers = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		friend class RenderGraphBuilder;
+
+		struct ResourceNode {
+			std::string name;
+			RenderGraphTextureDesc desc;
+			GLuint texture = 0;
+			bool imported = false;
+			std::vector<uint32_t> writers;
+			uint32_t refCount = 0;
+			uint32_t firstPass = UINT32_MAX;
+			uint32_t lastPass = 0;
+			int32_t poolIndex = -1;
+		};
+
+		struct AttachmentWrite {
+			RenderGraphResource resource;
+			AttachmentLoadOp loadOp;
+			glm::vec4 clearValue;
+		};
+
+		struct PassNode {
+			std::string name;
+			ExecuteFn execute;
+			std::vector<RenderGraphResource> reads;
+			std::vector<AttachmentWrite> writes;
+			bool sideEffect = false;
+			uint32_t renderWidth = 0;		// 0 表示使用附件尺寸
+			uint32_t renderHeight = 0;
+			uint32_t refCount = 0;
+			bool culled = false;
+		};
+
+		struct PooledTexture {
+			RenderGraphTextureDesc desc;
+			GLuint texture = 0;
+			uint64_t lastUsedFrame = 0;
+			bool inUse = false;
+		};
+
+		struct FramebufferKey {
+			GLuint color[MaxColorAttachments] = {};
+			GLuint depth = 0;
+
+			bool operator==(const FramebufferKey& other) const;
+		};
+		struct FramebufferKeyHash {
+			size_t operator()(const FramebufferKey& key) const;
+		};
+		struct CachedFramebuffer {
+			GLuint fbo = 0;
+			uint64_t lastUsedFrame = 0;
+		};
+
+		void AcquireTransient(ResourceNode& resource);
+		void ReleaseTransient(ResourceNode& resource);
+		void BeginPassTargets(const PassNode& pass);
+		GLuint GetFramebuffer(const FramebufferKey& key, const PassNode& pass);
+		void EvictUnused();
+
+		std::vector<ResourceNode> m_Resources;
+		std::vector<PassNode> m_Passes;
+		bool m_Compiled = false;
+
+		std::vector<PooledTexture> m_TexturePool;
+		std::unordered_map<FramebufferKey, CachedFramebuffer, FramebufferKeyHash> m_Framebuffers;
+		uint64_t m_FrameIndex = 0;
+
+		Statistics m_Stats;
+	};
+
+}
@@ -7,7 +7,7 @@ namespace Intro {
     RenderPass::RenderPass(const RenderPassSpecification& spec)
         : m_Specification(spec) {
 
-        // ʼгԱԱڷ
+        // 初始化公有成员以便于访问
         framebuffer = m_Specification.targetFramebuffer;
         shader = m_Specification.shader;
         clearColor = m_Specification.clearColor;
@@ -37,14 +37,14 @@ namespace Intro {
         std::shared_ptr<Framebuffer> GetTargetFramebuffer() const { return m_Specification.targetFramebuffer; }
         std::shared_ptr<Shader> GetShader() const { return m_Specification.shader; }
 
-        // Ϊ˷
+        // 为了方便访问
         std::shared_ptr<Framebuffer> framebuffer;
         std::shared_ptr<Shader> shader;
         glm::vec4 clearColor;
         bool clear;
         bool depthTest;
 
-        // 
+        // 辅助方法
         void SetClearColor(const glm::vec4& color) {
             clearColor = color;
             m_Specification.clearColor = color;
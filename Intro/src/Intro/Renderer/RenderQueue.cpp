@@ -0,0 +1,174 @@
+#include "itrpch.h"
+#include "RenderQueue.h"
+#include "Shader.h"
+#include <cstring>
+
+namespace Intro {
+
+	namespace {
+
+		inline uint64_t Field(uint64_t value, uint32_t bits)
+		{
+			return value & ((uint64_t(1) << bits) - 1);
+		}
+
+		// 非负浮点数的位模式与数值同序，取去掉符号位后的高 bits 位作为量化深度
+		inline uint64_t QuantizeDepth(float distance, uint32_t bits)
+		{
+			if (!(distance > 0.0f)) distance = 0.0f;
+			uint32_t raw;
+			std::memcpy(&raw, &distance, sizeof(raw));
+			return (raw & 0x7FFFFFFFu) >> (31 - bits);
+		}
+
+		// 材质字段使用绑定键：共享纹理数组的 PBR 材质排在一起，之后可以合并为一次间接绘制
+		inline uint64_t MaterialSortField(const RenderItem& item)
+		{
+			if (!item.material) return 0;
+			uint64_t key = item.material->GetBindingKey();
+			return key ^ (key >> 16) ^ (key >> 32) ^ (key >> 48);
+		}
+
+		inline uint64_t ShaderID(const RenderItem& item)
+		{
+			if (!item.material) return 0;
+			auto shader = item.material->GetShader();
+			return shader ? shader->GetShaderID() : 0;
+		}
+	}
+
+	uint64_t RenderQueue::BuildOpaqueKey(const RenderItem& item)
+	{
+		using namespace RenderSortKeyLayout;
+
+		uint64_t key = Field(item.layer, LayerBits);
+		key = (key << TranslucentBits) | 0;
+		key = (key << ShaderBits) | Field(ShaderID(item), ShaderBits);
+		key = (key << MaterialBits) | Field(MaterialSortField(item), MaterialBits);
+		key = (key << MeshBits) | Field(item.mesh ? item.mesh->GetMeshID() : 0, MeshBits);
+		key = (key << OpaqueDepthBits) | QuantizeDepth(item.distance, OpaqueDepthBits);
+		return key;
+	}
+
+	uint64_t RenderQueue::BuildTransparentKey(const RenderItem& item)
+	{
+		using namespace RenderSortKeyLayout;
+
+		// 反转深度，使远处的物体键值更小、先绘制
+		uint64_t maxDepth = (uint64_t(1) << TransparentDepthBits) - 1;
+		uint64_t depth = maxDepth - QuantizeDepth(item.distance, TransparentDepthBits);
+
+		uint64_t key = Field(item.layer, LayerBits);
+		key = (key << TranslucentBits) | 1;
+		key = (key << TransparentDepthBits) | depth;
+		key = (key << ShaderBits) | Field(ShaderID(item), ShaderBits);
+		key = (key << MaterialBits) | Field(MaterialSortField(item), MaterialBits);
+		key = (key << TransparentMeshBits) | Field(item.mesh ? item.mesh->GetMeshID() : 0, TransparentMeshBits);
+		return key;
+	}
+
+	uint64_t RenderQueue::BuildDepthKey(const RenderItem& item)
+	{
+		using namespace RenderSortKeyLayout;
+
+		uint64_t key = Field(item.layer, LayerBits);
+		key = (key << PrepassDepthBits) | QuantizeDepth(item.distance, PrepassDepthBits);
+		return key;
+	}
+
+	uint64_t RenderQueue::BuildStateKey(const RenderItem& item)
+	{
+		using namespace RenderSortKeyLayout;
+
+		uint64_t key = Field(item.layer, LayerBits);
+		key = (key << TranslucentBits) | 1;
+		key = (key << ShaderBits) | Field(ShaderID(item), ShaderBits);
+		key = (key << MaterialBits) | Field(MaterialSortField(item), MaterialBits);
+		key = (key << MeshBits) | Field(item.mesh ? item.mesh->GetMeshID() : 0, MeshBits);
+		key = key << OpaqueDepthBits;
+		return key;
+	}
+
+	void RenderQueue::Sort(const glm::vec3& cameraPos, bool sortTransparentByDepth)
+	{
+		opaque.clear();
+		transparent.clear();
+
+		for (uint32_t i = 0; i < (uint32_t)items.size(); ++i) {
+			RenderItem& item = items[i];
+			if (item.transparent && !sortTransparentByDepth) {
+				transparent.push_back({ BuildStateKey(item), i });
+				continue;
+			}
+
+			glm::vec3 delta = glm::vec3(item.transform[3]) - cameraPos;
+			item.distance = glm::dot(delta, delta);
+
+			if (item.transparent)
+				transparent.push_back({ BuildTransparentKey(item), i });
+			else
+				opaque.push_back({ BuildOpaqueKey(item), i });
+		}
+
+		RadixSort(opaque, m_Scratch);
+		RadixSort(transparent, m_Scratch);
+	}
+
+	void RenderQueue::SortFrontToBack()
+	{
+		opaqueFrontToBack.clear();
+		opaqueFrontToBack.reserve(opaque.size());
+		for (const auto& entry : opaque) {
+			opaqueFrontToBack.push_back({ BuildDepthKey(items[entry.index]), entry.index });
+		}
+
+		// 键只有低 33 位非零，高字节的趟会被跳过
+		RadixSort(opaqueFrontToBack, m_Scratch);
+	}
+
+	void RenderQueue::RadixSort(std::vector<RenderSortKey>& keys, std::vector<RenderSortKey>& scratch)
+	{
+		const size_t count = keys.size();
+		if (count < 2) return;
+
+		scratch.resize(count);
+
+		// 一次遍历统计全部 8 个字节的直方图
+		uint32_t histogram[8][256];
+		std::memset(histogram, 0, sizeof(histogram));
+		for (const auto& entry : keys) {
+			uint64_t k = entry.key;
+			for (int pass = 0; pass < 8; ++pass) {
+				histogram[pass][(k >> (pass * 8)) & 0xFF]++;
+			}
+		}
+
+		RenderSortKey* src = keys.data();
+		RenderSortKey* dst = scratch.data();
+
+		for (int pass = 0; pass < 8; ++pass) {
+			uint32_t* counts = histogram[pass];
+
+			// 所有键在该字节相同：本趟不改变顺序，跳过
+			if (counts[(src[0].key >> (pass * 8)) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (int b = 0; b < 256; ++b) {
+				uint32_t c = counts[b];
+				counts[b] = offset;
+				offset += c;
+			}
+
+			const int shift = pass * 8;
+			for (size_t i = 0; i < count; ++i) {
+				dst[counts[(src[i].key >> shift) & 0xFF]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+
+		if (src != keys.data()) {
+			std::memcpy(keys.data(), src, count * sizeof(RenderSortKey));
+		}
+	}
+}
@@ -1,57 +1,105 @@
 #pragma once
-#include "itrpch.h"
+#include "Intro/Core.h"
 #include "Mesh.h"
 #include "Material.h"
 #include "PBRMaterial.h"
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
-#include <glm/gtx/norm.hpp>
-#include <algorithm>
 
 
 namespace Intro {
 	struct RenderItem {
 		std::shared_ptr<Mesh> mesh;
-		std::shared_ptr<Material> material;  // ͳһʹûָ
+		std::shared_ptr<Material> material;  // 统一使用基类指针
 		glm::mat4 transform;
-		float distance;
-		bool transparent;
-		bool isPBR;  // ӱ־ֲ
+		float distance = 0.0f;
+		bool transparent = false;
+		bool isPBR = false;  // 添加标志区分材质类型
+		uint8_t layer = 0;   // 渲染层（排序键最高位，值小的先画）
+		uint32_t objectID = 0; // 来源实体 ID（写入对象数据缓冲）
+		uint32_t lodFade = 0;  // LOD 交叉淡化参数（LodSelector::PackFade，0 表示不淡化）
 	};
 
+	// 排序键：64 位打包键 + 指向 RenderQueue::items 的下标
+	// 排序时只移动这 16 字节，不触碰 RenderItem 里的 shared_ptr/mat4
+	struct RenderSortKey {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	// 排序键布局（从高位到低位）：
+	//   不透明: layer(2) | translucent(1)=0 | shader(12) | material(16) | mesh(16) | depth(17，由近到远)
+	//   透明  : layer(2) | translucent(1)=1 | depth(24，由远到近) | shader(12) | material(16) | mesh(9)
+	//   预通道: layer(2) | depth(31，由近到远)
+	//   OIT 透明: 与不透明相同但 translucent = 1、depth = 0（只按状态分组，不需要距离）
+	// 不透明物体先按 shader/材质/mesh 显式分组，再按深度；透明物体严格按深度，深度相同再按状态分组
+	// material 字段取材质绑定键（Material::GetBindingKey）的折叠值，绑定状态相同的材质相邻
+	namespace RenderSortKeyLayout {
+		constexpr uint32_t LayerBits = 2;
+		constexpr uint32_t TranslucentBits = 1;
+		constexpr uint32_t ShaderBits = 12;
+		constexpr uint32_t MaterialBits = 16;
+		constexpr uint32_t MeshBits = 16;
+		constexpr uint32_t OpaqueDepthBits = 17;
+		constexpr uint32_t TransparentDepthBits = 24;
+		constexpr uint32_t TransparentMeshBits = 9;
+		constexpr uint32_t PrepassDepthBits = 31;
+
+		static_assert(LayerBits + TranslucentBits + ShaderBits + MaterialBits + MeshBits + OpaqueDepthBits == 64,
+			"opaque sort key must use exactly 64 bits");
+		static_assert(LayerBits + TranslucentBits + TransparentDepthBits + ShaderBits + MaterialBits + TransparentMeshBits == 64,
+			"transparent sort key must use exactly 64 bits");
+	}
+
 
 	class ITR_API RenderQueue
 	{
 	public:
-		std::vector<RenderItem> opaque;
-		std::vector<RenderItem> transparent;
+		// 渲染项载荷（只追加，排序后通过 opaque/transparent 的 index 访问）
+		std::vector<RenderItem> items;
+
+		// 排序后的键（分别对应不透明、透明物体）
+		std::vector<RenderSortKey> opaque;
+		std::vector<RenderSortKey> transparent;
+		// 深度预通道使用的不透明顺序：只按 layer 和深度由近到远（SortFrontToBack 填写）
+		std::vector<RenderSortKey> opaqueFrontToBack;
+
+		// 剔除统计（CollectRenderables 填写；occludedCount 是 culledCount 中被遮挡剔除的部分）
+		uint32_t visibleCount = 0;
+		uint32_t culledCount = 0;
+		uint32_t occludedCount = 0;
 
 		void Clear() {
+			items.clear();
 			opaque.clear();
 			transparent.clear();
+			opaqueFrontToBack.clear();
+			visibleCount = culledCount = occludedCount = 0;
 		}
 
-		void Sort(const glm::vec3& cameraPos)
-		{
-			// 벢͸壨+룩
-			for (auto& item : opaque) {
-				glm::vec3 pos = glm::vec3(item.transform[3]);
-				item.distance = glm::distance2(pos, cameraPos);
-			}
-			std::sort(opaque.begin(), opaque.end(), [](const RenderItem& a, const RenderItem& b) {
-				if (a.material != b.material)
-					return a.material < b.material; // ָ򣨼򵥷飩
-				return a.distance < b.distance; // ǰ
-				});
-
-			// ͸壨뷴
-			for (auto& item : transparent) {
-				glm::vec3 pos = glm::vec3(item.transform[3]);
-				item.distance = glm::distance2(pos, cameraPos);
-			}
-			std::sort(transparent.begin(), transparent.end(), [](const RenderItem& a, const RenderItem& b) {
-				return a.distance > b.distance; // 
-				});
+		void Push(RenderItem&& item) {
+			items.push_back(std::move(item));
 		}
+
+		const RenderItem& GetItem(const RenderSortKey& key) const { return items[key.index]; }
+
+		// 计算距离、构建排序键并用 LSD 基数排序。
+		// sortTransparentByDepth 为 false 时（加权混合 OIT）透明物体与顺序无关，只按 shader/材质/mesh 分组，
+		// 不计算距离，键的低位全为 0，基数排序会跳过这些趟
+		void Sort(const glm::vec3& cameraPos, bool sortTransparentByDepth = true);
+		// 在 Sort 之后调用：预通道不切换材质，只需要尽早写入最近的深度
+		void SortFrontToBack();
+
+		static uint64_t BuildOpaqueKey(const RenderItem& item);
+		static uint64_t BuildTransparentKey(const RenderItem& item);
+		static uint64_t BuildDepthKey(const RenderItem& item);
+		static uint64_t BuildStateKey(const RenderItem& item);
+
+		// 对 64 位键做 LSD 基数排序（8 趟，每趟 8 位；所有键在某字节相同时跳过该趟）
+		static void RadixSort(std::vector<RenderSortKey>& keys, std::vector<RenderSortKey>& scratch);
+
+	private:
+		std::vector<RenderSortKey> m_Scratch;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,245 @@
+#include "itrpch.h"
+#include "RenderState.h"
+
+namespace Intro {
+
+	RenderState::CachedState RenderState::s_State;
+	RenderState::Statistics RenderState::s_Stats;
+
+	RenderState::CachedState::CachedState()
+	{
+		for (auto& unit : textures)
+			for (auto& texture : unit)
+				texture = ~0u;
+	}
+
+	int RenderState::TargetIndex(GLenum target)
+	{
+		switch (target) {
+		case GL_TEXTURE_2D:             return Target_2D;
+		case GL_TEXTURE_CUBE_MAP:       return Target_CubeMap;
+		case GL_TEXTURE_2D_ARRAY:       return Target_2DArray;
+		case GL_TEXTURE_2D_MULTISAMPLE: return Target_2DMultisample;
+		default:                        return -1;
+		}
+	}
+
+	// Init: 只在启动时读取一次真实的 GL 状态
+	void RenderState::Init()
+	{
+		Invalidate();
+
+		GLint value = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+		s_State.program = (GLuint)value;
+		glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+		s_State.vertexArray = (GLuint)value;
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &value);
+		s_State.framebuffer = (GLuint)value;
+		glGetIntegerv(GL_ACTIVE_TEXTURE, &value);
+		s_State.activeUnit = (uint32_t)(value - GL_TEXTURE0);
+
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		s_State.viewport = glm::ivec4(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+		s_State.depthTest = glIsEnabled(GL_DEPTH_TEST) ? 1 : 0;
+		s_State.blend = glIsEnabled(GL_BLEND) ? 1 : 0;
+		s_State.cullFace = glIsEnabled(GL_CULL_FACE) ? 1 : 0;
+
+		GLboolean depthMask = GL_TRUE;
+		glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+		s_State.depthMask = depthMask ? 1 : 0;
+
+		glGetIntegerv(GL_DEPTH_FUNC, &value);
+		s_State.depthFunc = (GLenum)value;
+		glGetIntegerv(GL_BLEND_SRC_RGB, &value);
+		s_State.blendSrc = (GLenum)value;
+		glGetIntegerv(GL_BLEND_DST_RGB, &value);
+		s_State.blendDst = (GLenum)value;
+		glGetIntegerv(GL_CULL_FACE_MODE, &value);
+		s_State.cullMode = (GLenum)value;
+		glGetIntegerv(GL_FRONT_FACE, &value);
+		s_State.frontFace = (GLenum)value;
+
+		GLint polygonMode[2] = { GL_FILL, GL_FILL };
+		glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+		s_State.polygonMode = (GLenum)polygonMode[0];
+
+		glGetFloatv(GL_LINE_WIDTH, &s_State.lineWidth);
+	}
+
+	void RenderState::Invalidate()
+	{
+		s_State = CachedState();
+	}
+
+	void RenderState::UseProgram(GLuint program)
+	{
+		if (s_State.program == program) { s_Stats.redundantChanges++; return; }
+		s_State.program = program;
+		glUseProgram(program);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::BindVertexArray(GLuint vao)
+	{
+		if (s_State.vertexArray == vao) { s_Stats.redundantChanges++; return; }
+		s_State.vertexArray = vao;
+		glBindVertexArray(vao);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::BindFramebuffer(GLuint fbo)
+	{
+		if (s_State.framebuffer == fbo) { s_Stats.redundantChanges++; return; }
+		s_State.framebuffer = fbo;
+		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetActiveTextureUnit(uint32_t unit)
+	{
+		if (s_State.activeUnit == unit) return;
+		s_State.activeUnit = unit;
+		glActiveTexture(GL_TEXTURE0 + unit);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::BindTexture(uint32_t unit, GLenum target, GLuint texture)
+	{
+		int index = TargetIndex(target);
+		if (index >= 0 && unit < MaxTextureUnits) {
+			if (s_State.textures[unit][index] == texture) { s_Stats.redundantChanges++; return; }
+			s_State.textures[unit][index] = texture;
+		}
+
+		// 只在绑定确实需要时才切换活动纹理单元
+		SetActiveTextureUnit(unit);
+		glBindTexture(target, texture);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::BindTexture(GLenum target, GLuint texture)
+	{
+		uint32_t unit = s_State.activeUnit < MaxTextureUnits ? s_State.activeUnit : 0;
+		BindTexture(unit, target, texture);
+	}
+
+	void RenderState::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+	{
+		glm::ivec4 viewport(x, y, width, height);
+		if (s_State.viewport == viewport) { s_Stats.redundantChanges++; return; }
+		s_State.viewport = viewport;
+		glViewport(x, y, width, height);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetCapability(GLenum cap, int8_t& cached, bool enabled)
+	{
+		int8_t value = enabled ? 1 : 0;
+		if (cached == value) { s_Stats.redundantChanges++; return; }
+		cached = value;
+		if (enabled) glEnable(cap);
+		else glDisable(cap);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetDepthTest(bool enabled) { SetCapability(GL_DEPTH_TEST, s_State.depthTest, enabled); }
+	void RenderState::SetBlend(bool enabled) { SetCapability(GL_BLEND, s_State.blend, enabled); }
+	void RenderState::SetCullFace(bool enabled) { SetCapability(GL_CULL_FACE, s_State.cullFace, enabled); }
+
+	void RenderState::SetDepthMask(bool enabled)
+	{
+		int8_t value = enabled ? 1 : 0;
+		if (s_State.depthMask == value) { s_Stats.redundantChanges++; return; }
+		s_State.depthMask = value;
+		glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetDepthFunc(GLenum func)
+	{
+		if (s_State.depthFunc == func) { s_Stats.redundantChanges++; return; }
+		s_State.depthFunc = func;
+		glDepthFunc(func);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetBlendFunc(GLenum src, GLenum dst)
+	{
+		if (s_State.blendSrc == src && s_State.blendDst == dst) { s_Stats.redundantChanges++; return; }
+		s_State.blendSrc = src;
+		s_State.blendDst = dst;
+		glBlendFunc(src, dst);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetBlendFunci(GLuint drawBuffer, GLenum src, GLenum dst)
+	{
+		s_State.blendSrc = 0;
+		s_State.blendDst = 0;
+		glBlendFunci(drawBuffer, src, dst);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetCullMode(GLenum face)
+	{
+		if (s_State.cullMode == face) { s_Stats.redundantChanges++; return; }
+		s_State.cullMode = face;
+		glCullFace(face);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetFrontFace(GLenum mode)
+	{
+		if (s_State.frontFace == mode) { s_Stats.redundantChanges++; return; }
+		s_State.frontFace = mode;
+		glFrontFace(mode);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetPolygonMode(GLenum mode)
+	{
+		if (s_State.polygonMode == mode) { s_Stats.redundantChanges++; return; }
+		s_State.polygonMode = mode;
+		glPolygonMode(GL_FRONT_AND_BACK, mode);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::SetLineWidth(float width)
+	{
+		if (s_State.lineWidth == width) { s_Stats.redundantChanges++; return; }
+		s_State.lineWidth = width;
+		glLineWidth(width);
+		s_Stats.stateChanges++;
+	}
+
+	void RenderState::DeleteTextures(GLsizei count, const GLuint* textures)
+	{
+		for (GLsizei i = 0; i < count; ++i) {
+			if (textures[i] == 0) continue;
+			for (auto& unit : s_State.textures)
+				for (auto& bound : unit)
+					if (bound == textures[i]) bound = 0;
+		}
+		glDeleteTextures(count, textures);
+	}
+
+	void RenderState::DeleteVertexArrays(GLsizei count, const GLuint* vaos)
+	{
+		for (GLsizei i = 0; i < count; ++i) {
+			if (vaos[i] != 0 && s_State.vertexArray == vaos[i]) s_State.vertexArray = 0;
+		}
+		glDeleteVertexArrays(count, vaos);
+	}
+
+	void RenderState::DeleteFramebuffers(GLsizei count, const GLuint* fbos)
+	{
+		for (GLsizei i = 0; i < count; ++i) {
+			if (fbos[i] != 0 && s_State.framebuffer == fbos[i]) s_State.framebuffer = 0;
+		}
+		glDeleteFramebuffers(count, fbos);
+	}
+
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace Intro {
+
+	// GL 状态影子缓存：引擎内所有状态切换都经过这里，只有状态真正变化时才调用 GL。
+	// 读取当前状态直接返回缓存值，不再需要每帧 glGet*/glIsEnabled 往返驱动。
+	// 注意：绕过它直接修改 GL 状态的代码（第三方库）必须自行恢复状态，或之后调用 Invalidate()。
+	class ITR_API RenderState {
+	public:
+		static constexpr uint32_t MaxTextureUnits = 32;
+
+		// 从 GL 读取一次初始状态（Renderer::Init 中调用）
+		static void Init();
+		// 把所有缓存标记为未知，下一次设置必定提交给 GL
+		static void Invalidate();
+
+		// 绑定
+		static void UseProgram(GLuint program);
+		static void BindVertexArray(GLuint vao);
+		static void BindFramebuffer(GLuint fbo);
+		static void BindTexture(uint32_t unit, GLenum target, GLuint texture);
+		static void BindTexture(GLenum target, GLuint texture);	// 绑定到当前活动纹理单元
+		static void SetActiveTextureUnit(uint32_t unit);
+
+		// 固定管线状态
+		static void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+		static void SetDepthTest(bool enabled);
+		static void SetDepthMask(bool enabled);
+		static void SetDepthFunc(GLenum func);
+		static void SetBlend(bool enabled);
+		static void SetBlendFunc(GLenum src, GLenum dst);
+		// 单个颜色附件的混合函数（MRT）；各附件不再一致，之后的 SetBlendFunc 一定会提交
+		static void SetBlendFunci(GLuint drawBuffer, GLenum src, GLenum dst);
+		static void SetCullFace(bool enabled);
+		static void SetCullMode(GLenum face);
+		static void SetFrontFace(GLenum mode);
+		static void SetPolygonMode(GLenum mode);
+		static void SetLineWidth(float width);
+
+		// 删除对象并同步缓存（GL 删除时会把已绑定的对象解绑，名字也可能被复用）
+		static void DeleteTextures(GLsizei count, const GLuint* textures);
+		static void DeleteVertexArrays(GLsizei count, const GLuint* vaos);
+		static void DeleteFramebuffers(GLsizei count, const GLuint* fbos);
+
+		// 查询缓存值（不访问驱动）
+		static GLuint GetProgram() { return s_State.program; }
+		static GLuint GetVertexArray() { return s_State.vertexArray; }
+		static GLuint GetFramebuffer() { return s_State.framebuffer; }
+		static uint32_t GetActiveTextureUnit() { return s_State.activeUnit; }
+		static const glm::ivec4& GetViewport() { return s_State.viewport; }
+		static bool IsDepthTestEnabled() { return s_State.depthTest == 1; }
+		static bool IsDepthMaskEnabled() { return s_State.depthMask == 1; }
+		static GLenum GetDepthFunc() { return s_State.depthFunc; }
+		static bool IsBlendEnabled() { return s_State.blend == 1; }
+		static bool IsCullFaceEnabled() { return s_State.cullFace == 1; }
+		static GLenum GetPolygonMode() { return s_State.polygonMode; }
+		static float GetLineWidth() { return s_State.lineWidth; }
+
+		// 统计：提交给 GL 的状态切换与被过滤掉的冗余切换
+		struct Statistics {
+			uint32_t stateChanges = 0;
+			uint32_t redundantChanges = 0;
+			void Reset() { stateChanges = redundantChanges = 0; }
+		};
+		static const Statistics& GetStats() { return s_Stats; }
+		static void ResetStats() { s_Stats.Reset(); }
+
+	private:
+		enum TextureTargetIndex {
+			Target_2D = 0,
+			Target_CubeMap,
+			Target_2DArray,
+			Target_2DMultisample,
+			Target_Count
+		};
+		static int TargetIndex(GLenum target);
+
+		// 布尔状态用 int8_t：-1 表示未知
+		struct CachedState {
+			GLuint program = ~0u;
+			GLuint vertexArray = ~0u;
+			GLuint framebuffer = ~0u;
+			uint32_t activeUnit = ~0u;
+			GLuint textures[MaxTextureUnits][Target_Count];
+			glm::ivec4 viewport = glm::ivec4(-1);
+			int8_t depthTest = -1;
+			int8_t depthMask = -1;
+			int8_t blend = -1;
+			int8_t cullFace = -1;
+			GLenum depthFunc = 0;
+			GLenum blendSrc = 0;
+			GLenum blendDst = 0;
+			GLenum cullMode = 0;
+			GLenum frontFace = 0;
+			GLenum polygonMode = 0;
+			float lineWidth = -1.0f;
+
+			CachedState();
+		};
+
+		static void SetCapability(GLenum cap, int8_t& cached, bool enabled);
+
+		static CachedState s_State;
+		static Statistics s_Stats;
+	};
+
+}
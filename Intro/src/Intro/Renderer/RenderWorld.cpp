@@ -0,0 +1,183 @@
+#include "itrpch.h"
+#include "RenderWorld.h"
+#include "Mesh.h"
+#include "Model.h"
+#include "Material.h"
+#include "PBRMaterial.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Intro {
+
+	void RenderWorld::Sync(ECS& ecs) {
+		auto start = std::chrono::steady_clock::now();
+		auto& registry = ecs.GetRegistry();
+
+		bool rebuildAll = ecs.ConsumeRenderableChanges(m_Changed);
+		ecs.ConsumeMovedEntities(m_Moved);
+		if (m_ECS != &ecs || m_ECSInstance != ecs.GetInstanceID()) {
+			m_ECS = &ecs;
+			m_ECSInstance = ecs.GetInstanceID();
+			rebuildAll = true;
+		}
+
+		m_Stats.rebuiltEntities = 0;
+		m_Stats.movedProxies = 0;
+		m_Stats.fullRebuild = rebuildAll;
+
+		if (rebuildAll) {
+			RebuildAll(registry);
+		}
+		else if (!m_Changed.empty()) {
+			// 同一下标按版本排序：旧实体先被移除，下标复用后的新实体最后重建
+			std::sort(m_Changed.begin(), m_Changed.end(), [](entt::entity a, entt::entity b) {
+				auto ia = entt::to_entity(a), ib = entt::to_entity(b);
+				return ia != ib ? ia < ib : entt::to_version(a) < entt::to_version(b);
+			});
+			m_Changed.erase(std::unique(m_Changed.begin(), m_Changed.end()), m_Changed.end());
+			for (entt::entity entity : m_Changed)
+				RebuildEntity(registry, entity);
+		}
+
+		// 重建时已经读取了最新的矩阵，这里只剩没有结构变化的移动
+		if (!rebuildAll) {
+			for (entt::entity entity : m_Moved)
+				RefreshTransform(registry, entity);
+		}
+
+		m_Stats.proxyCount = (uint32_t)m_Proxies.size();
+		m_Stats.syncMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void RenderWorld::Clear() {
+		m_Proxies.clear();
+		m_EntityProxies.clear();
+		m_ECS = nullptr;
+		m_ECSInstance = 0;
+		m_Stats = Statistics();
+	}
+
+	void RenderWorld::RebuildAll(entt::registry& registry) {
+		m_Proxies.clear();
+		m_EntityProxies.clear();
+		for (entt::entity entity : registry.view<LocalToWorldComponent>())
+			RebuildEntity(registry, entity);
+	}
+
+	void RenderWorld::RebuildEntity(entt::registry& registry, entt::entity entity) {
+		RemoveEntity((uint32_t)entt::to_entity(entity));
+		if (!registry.valid(entity)) return;
+
+		const auto* localToWorld = registry.try_get<LocalToWorldComponent>(entity);
+		if (!localToWorld) return;
+
+		const auto* meshComp = registry.try_get<MeshComponent>(entity);
+		const auto* modelComp = registry.try_get<ModelComponent>(entity);
+		const auto* matComp = registry.try_get<MaterialComponent>(entity);
+		const auto* pbrComp = registry.try_get<PBRMaterialComponent>(entity);
+		const bool occluder = registry.all_of<OccluderComponent>(entity);
+
+		auto addGeometry = [&](const std::shared_ptr<Mesh>& mesh, const std::shared_ptr<Model>& model) {
+			auto add = [&](std::shared_ptr<Material> material, bool transparent, bool isPBR) {
+				Proxy proxy;
+				proxy.entity = entity;
+				proxy.mesh = mesh;
+				proxy.model = model;
+				proxy.material = std::move(material);
+				proxy.transform = localToWorld->matrix;
+				proxy.transparent = transparent;
+				proxy.isPBR = isPBR;
+				proxy.occluder = occluder;
+				UpdateBounds(proxy);
+				AddProxy(std::move(proxy));
+			};
+			if (matComp && matComp->material)
+				add(matComp->material, matComp->Transparent, false);
+			if (pbrComp && pbrComp->material)
+				add(std::static_pointer_cast<Material>(pbrComp->material), pbrComp->Transparent, true);
+		};
+
+		if (meshComp && meshComp->mesh)
+			addGeometry(meshComp->mesh, nullptr);
+		if (modelComp && modelComp->model)
+			addGeometry(nullptr, modelComp->model);
+		m_Stats.rebuiltEntities++;
+	}
+
+	void RenderWorld::RefreshTransform(const entt::registry& registry, entt::entity entity) {
+		auto* slots = FindSlots((uint32_t)entt::to_entity(entity));
+		if (!slots) return;
+
+		const auto* localToWorld = registry.try_get<LocalToWorldComponent>(entity);
+		if (!localToWorld) return;
+
+		for (uint32_t proxyIndex : *slots) {
+			if (proxyIndex == InvalidProxy) continue;
+			Proxy& proxy = m_Proxies[proxyIndex];
+			if (proxy.entity != entity) continue;
+			proxy.transform = localToWorld->matrix;
+			UpdateBounds(proxy);
+			m_Stats.movedProxies++;
+		}
+	}
+
+	void RenderWorld::UpdateBounds(Proxy& proxy) {
+		if (proxy.model) {
+			proxy.worldBounds = proxy.model->GetBounds().Transformed(proxy.transform);
+			proxy.worldSphere = proxy.model->GetBoundingSphere().Transformed(proxy.transform);
+		}
+		else if (proxy.mesh) {
+			proxy.worldBounds = proxy.mesh->GetBounds().Transformed(proxy.transform);
+			proxy.worldSphere = proxy.mesh->GetBoundingSphere().Transformed(proxy.transform);
+		}
+	}
+
+	std::array<uint32_t, RenderWorld::MaxProxiesPerEntity>* RenderWorld::FindSlots(uint32_t entityIndex) {
+		return entityIndex < m_EntityProxies.size() ? &m_EntityProxies[entityIndex] : nullptr;
+	}
+
+	void RenderWorld::AddProxy(Proxy&& proxy) {
+		uint32_t entityIndex = (uint32_t)entt::to_entity(proxy.entity);
+		if (entityIndex >= m_EntityProxies.size()) {
+			std::array<uint32_t, MaxProxiesPerEntity> empty;
+			empty.fill(InvalidProxy);
+			m_EntityProxies.resize(entityIndex + 1, empty);
+		}
+
+		for (uint32_t& slot : m_EntityProxies[entityIndex]) {
+			if (slot != InvalidProxy) continue;
+			slot = (uint32_t)m_Proxies.size();
+			m_Proxies.push_back(std::move(proxy));
+			return;
+		}
+	}
+
+	void RenderWorld::RemoveEntity(uint32_t entityIndex) {
+		auto* slots = FindSlots(entityIndex);
+		if (!slots) return;
+
+		for (uint32_t& slot : *slots) {
+			if (slot == InvalidProxy) continue;
+			uint32_t proxyIndex = slot;
+			slot = InvalidProxy;
+			RemoveProxy(proxyIndex);
+		}
+	}
+
+	// 与末尾交换后弹出，被搬动的代理在其实体的槽位里更新下标
+	void RenderWorld::RemoveProxy(uint32_t proxyIndex) {
+		uint32_t last = (uint32_t)m_Proxies.size() - 1;
+		if (proxyIndex != last) {
+			m_Proxies[proxyIndex] = std::move(m_Proxies[last]);
+			auto* slots = FindSlots((uint32_t)entt::to_entity(m_Proxies[proxyIndex].entity));
+			for (uint32_t& slot : *slots) {
+				if (slot == last) {
+					slot = proxyIndex;
+					break;
+				}
+			}
+		}
+		m_Proxies.pop_back();
+	}
+
+}
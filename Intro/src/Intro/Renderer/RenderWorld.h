@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include "Intro/ECS/ECS.h"
+#include "Bounds.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Intro {
+
+	class Mesh;
+	class Model;
+	class Material;
+
+	// 渲染端持有的代理表：每个 (几何, 材质) 组合一条，保存渲染收集需要的全部数据。
+	// - 结构变化（Mesh/Model/材质/遮挡组件的添加、替换、移除，实体销毁）通过 ECS 记录的变化列表只重建相关实体
+	// - 移动只刷新 TransformSystem 记录在 ECS 里、上次同步之后更新过的实体的矩阵与世界包围体
+	// - 静态场景每帧的同步开销只有两次空列表检查；收集时线性遍历连续的代理数组，不再跑 registry 视图
+	// 直接改写组件字段（不经过 patch / replace）时需要调用 ECS::MarkRenderableDirty
+	class ITR_API RenderWorld
+	{
+	public:
+		// 一个实体最多 2 种几何（Mesh、Model）× 2 种材质（普通、PBR）
+		static constexpr uint32_t MaxProxiesPerEntity = 4;
+		static constexpr uint32_t InvalidProxy = UINT32_MAX;
+
+		struct Proxy {
+			entt::entity entity = entt::null;
+			std::shared_ptr<Mesh> mesh;				// 与 model 二选一
+			std::shared_ptr<Model> model;
+			std::shared_ptr<Material> material;		// PBR 材质已转换为基类指针
+			glm::mat4 transform = glm::mat4(1.0f);
+			BoundingBox worldBounds;				// 代理自身几何的世界包围体（Model 为合并包围体）
+			BoundingSphere worldSphere;
+			bool transparent = false;
+			bool isPBR = false;
+			bool occluder = false;					// 遮挡体自己不参与遮挡测试
+		};
+
+		struct Statistics {
+			uint32_t proxyCount = 0;
+			uint32_t rebuiltEntities = 0;	// 本帧因结构变化重建的实体
+			uint32_t movedProxies = 0;		// 本帧刷新了矩阵的代理
+			bool fullRebuild = false;
+			float syncMs = 0.0f;
+			float collectMs = 0.0f;			// RenderSystem::CollectRenderables 的耗时
+		};
+
+		RenderWorld() = default;
+		RenderWorld(const RenderWorld&) = delete;
+		RenderWorld& operator=(const RenderWorld&) = delete;
+
+		// 每帧在场景的系统（TransformSystem）更新之后调用；换了 ECS（切换场景）时整体重建
+		void Sync(ECS& ecs);
+		void Clear();
+
+		const std::vector<Proxy>& GetProxies() const { return m_Proxies; }
+
+		void RecordCollectTime(float ms) { m_Stats.collectMs = ms; }
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		void RebuildAll(entt::registry& registry);
+		void RebuildEntity(entt::registry& registry, entt::entity entity);
+		void RefreshTransform(const entt::registry& registry, entt::entity entity);
+		void RemoveEntity(uint32_t entityIndex);
+		void AddProxy(Proxy&& proxy);
+		void RemoveProxy(uint32_t proxyIndex);
+		static void UpdateBounds(Proxy& proxy);
+
+		std::array<uint32_t, MaxProxiesPerEntity>* FindSlots(uint32_t entityIndex);
+
+		std::vector<Proxy> m_Proxies;
+		// 按实体下标（entt::to_entity）索引的代理下标
+		std::vector<std::array<uint32_t, MaxProxiesPerEntity>> m_EntityProxies;
+		std::vector<entt::entity> m_Changed;
+		std::vector<entt::entity> m_Moved;
+
+		ECS* m_ECS = nullptr;
+		uint64_t m_ECSInstance = 0;
+		Statistics m_Stats;
+	};
+
+}
@@ -1,75 +1,122 @@
 // Renderer.cpp
 #include "itrpch.h"
 #include "Renderer.h"
-#include "UniformBuffers.h"   // ˵Renderer Ҫȫ UBO camera / lights
+#include "UniformBuffers.h"   // 用于说明：Renderer 可能需要与全局 UBO 合作（camera / lights）
 #include "Intro/Application.h"
 #include "Framebuffer.h"
 #include "Intro/RecourceManager/ShaderLibrary.h"
 #include "RenderPass.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "Material.h"
+#include "RenderState.h"
+#include "ObjectDataBuffer.h"
+#include "GeometryPool.h"
+#include "RenderConstant.h"
+#include "MaterialTable.h"
+#include "TextureArrayPool.h"
+#include "GPUProfiler.h"
+#include "DebugDraw.h"
 #include <glad/glad.h>
+#include <unordered_map>
 
 namespace Intro {
 
     static bool s_MainFramebufferBoundByRenderer = false;
+    // 已打开 GPU 计时作用域的 RenderPass 数（EndRenderPass 只关闭自己打开的作用域）
+    static uint32_t s_ProfiledRenderPasses = 0;
 
-    // ̬Ա壨ʼ
+    // FlushBatch 分组用的键：同一 shader + 材质 + mesh 的提交可以合并为一次实例化绘制
+    struct InstanceGroupKey {
+        const Shader* shader;
+        const Material* material;
+        const Mesh* mesh;
+
+        bool operator==(const InstanceGroupKey& other) const {
+            return shader == other.shader && material == other.material && mesh == other.mesh;
+        }
+    };
+
+    struct InstanceGroupKeyHash {
+        size_t operator()(const InstanceGroupKey& key) const {
+            size_t h = std::hash<const void*>()(key.shader);
+            h ^= std::hash<const void*>()(key.material) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<const void*>()(key.mesh) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    // 分组查找表与每个提交所属的组（跨帧复用，避免每帧分配）
+    static std::unordered_map<InstanceGroupKey, uint32_t, InstanceGroupKeyHash> s_GroupLookup;
+    static std::vector<uint32_t> s_BatchGroupIndices;
+
+    // 静态成员定义（初始化）
     std::vector<Renderer::BatchData> Renderer::s_BatchQueue;
+    std::vector<Renderer::InstanceGroup> Renderer::s_InstanceGroups;
+    std::vector<uint32_t> Renderer::s_InstanceOrder;
+    std::unique_ptr<ObjectDataBuffer> Renderer::s_ObjectData;
+    std::vector<DrawElementsIndirectCommand> Renderer::s_IndirectCommands;
+    uint32_t Renderer::s_IndirectBuffer = 0;
+    size_t Renderer::s_IndirectBufferCapacity = 0;
     Renderer::Statistics Renderer::s_Stats;
     RendererConfig Renderer::s_Config;
+    uint32_t Renderer::s_ObjectFlags = 0;
     std::unique_ptr<ShaderLibrary> Renderer::s_ShaderLibrary;
     std::shared_ptr<Framebuffer> Renderer::s_MainFramebuffer;
     std::shared_ptr<Framebuffer> Renderer::s_PostProcessFramebuffer;
     bool Renderer::s_Initialized = false;
 
-    // Init: Ⱦϵͳ
-    // -  ShaderLibrary㼯м shader
-    // - ֡֡壨 config
-    // - û GL ״̬ȲԡüsRGB ѡ
+    // Init: 负责启动渲染子系统
+    // - 创建 ShaderLibrary（方便集中加载 shader）
+    // - 主帧缓冲与后处理帧缓冲按需创建（GetMainFramebuffer / PostProcess），场景渲染目标由 RenderGraph 管理
+    // - 设置基础 GL 状态（深度测试、背面裁剪、sRGB 可选）
     void Renderer::Init() {
         if (s_Initialized) return;
 
         ITR_INFO("Initializing Renderer...");
 
-        //  shader ʵԤس shader
+        // 创建 shader 库实例（可以在这里预加载常用 shader）
         s_ShaderLibrary = std::make_unique<ShaderLibrary>();
 
-        // ò֡壺ɫ + ģ
-        FramebufferSpecification mainFBSpec;
-        mainFBSpec.width = s_Config.viewportWidth;
-        mainFBSpec.height = s_Config.viewportHeight;
-        mainFBSpec.samples = s_Config.enableMSAA ? s_Config.msaaSamples : 1;
-        mainFBSpec.attachments = {
-            { FramebufferTextureFormat::RGBA8, "Color" },
-            { FramebufferTextureFormat::DEPTH24STENCIL8, "DepthStencil" }
-        };
+        // 读取一次初始 GL 状态，之后所有状态切换都经过 RenderState 缓存
+        RenderState::Init();
 
-        s_MainFramebuffer = Framebuffer::Create(mainFBSpec);
+        // 设置基本的 GL 状态（渲染器统一管理）
+        RenderState::SetDepthTest(true);
+        RenderState::SetCullFace(true);
+        RenderState::SetCullMode(GL_BACK);
+        RenderState::SetFrontFace(GL_CCW);
 
-        // õ framebufferֻͨһɫ
-        FramebufferSpecification postProcessFBSpec;
-        postProcessFBSpec.width = s_Config.viewportWidth;
-        postProcessFBSpec.height = s_Config.viewportHeight;
-        postProcessFBSpec.attachments = {
-            { FramebufferTextureFormat::RGBA8, "Color" }
-        };
-
-        s_PostProcessFramebuffer = Framebuffer::Create(postProcessFBSpec);
+        // 每帧对象数据环形缓冲（三缓冲 + fence，FlushBatch 线性写入模型矩阵/法线矩阵/对象 ID）
+        s_ObjectData = std::make_unique<ObjectDataBuffer>();
 
-        // û GL ״̬Ⱦͳһ
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-        glFrontFace(GL_CCW);
+        // 静态几何池（所有 Mesh 共享的 VBO/IBO/VAO）与间接绘制命令缓冲
+        GeometryPool::Init();
+        glGenBuffers(1, &s_IndirectBuffer);
+        s_IndirectBufferCapacity = 0;
 
         s_Initialized = true;
         ITR_INFO("Renderer initialized successfully");
     }
 
-    // Shutdown: ڴ/Դ״̬
+    // Shutdown: 清理内存/资源句柄并重置状态
     void Renderer::Shutdown() {
         s_BatchQueue.clear();
+        s_InstanceGroups.clear();
+        s_InstanceOrder.clear();
+        s_GroupLookup.clear();
+        s_ObjectData.reset();
+        s_IndirectCommands.clear();
+        if (s_IndirectBuffer) {
+            glDeleteBuffers(1, &s_IndirectBuffer);
+            s_IndirectBuffer = 0;
+        }
+        s_IndirectBufferCapacity = 0;
+        GeometryPool::Shutdown();
+        MaterialTable::Shutdown();
+        TextureArrayPool::Shutdown();
+        GPUProfiler::Shutdown();
+        DebugDraw::Shutdown();
         s_ShaderLibrary.reset();
         s_MainFramebuffer.reset();
         s_PostProcessFramebuffer.reset();
@@ -77,173 +124,380 @@ namespace Intro {
         ITR_INFO("Renderer shutdown");
     }
 
-    // BeginFrame: ÿ֡ʼʱ
-    // - Reset ͳ
-    // -  FBOȾĿ꣩
-    // -  viewport  bufferĬ color + depth
+    // BeginFrame: 每帧开始时调用
+    // - Reset 统计
+    // - 若使用主 FBO：绑定、设置 viewport 并清除（color + depth）
     void Renderer::BeginFrame() {
         ResetStats();
+        RenderState::ResetStats();
 
-        // 鵱ǰ󶨵֡
-        GLint currentlyBound = 0;
-        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &currentlyBound);
+        // 切换到对象数据缓冲的下一段（三缓冲下通常无需等待）
+        uint32_t stallsBefore = s_ObjectData->GetStallCount();
+        s_ObjectData->BeginFrame();
+        s_Stats.objectDataStalls = s_ObjectData->GetStallCount() - stallsBefore;
 
-        // ֻеǰûаκ FBO󶨵Ĭ֡壩ʱ Renderer 󶨲 s_MainFramebuffer
+        // 只有主帧缓冲已经创建、且当前没有绑定任何 FBO 时，由 Renderer 绑定并清除 s_MainFramebuffer；
+        // 其余情况下渲染目标的绑定与清除由调用方负责（例如 RenderGraph 按通道声明的附件处理）
         s_MainFramebufferBoundByRenderer = false;
-        if (currentlyBound == 0) {
-            if (s_MainFramebuffer)
-                s_MainFramebuffer->Bind();
-            glViewport(0, 0, s_Config.viewportWidth, s_Config.viewportHeight);
+        if (s_MainFramebuffer && RenderState::GetFramebuffer() == 0) {
+            s_MainFramebuffer->Bind();
+            RenderState::SetViewport(0, 0, s_Config.viewportWidth, s_Config.viewportHeight);
 
-            //  Renderer ǰʱ FBO Ĭ FBO
             glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             s_MainFramebufferBoundByRenderer = true;
         }
-        else {
-            // Ѿⲿ FBO 󶨣 RendererLayer::BindRenderState
-            // ȥ/Ȼǰ󶨵Ļ壨ͨⲿ Bind ú viewport
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        }
     }
 
-    // EndFrame: ÿ֡ʱ
-    // - Flush ύУִʵʻƣ
-    // - ִкPostProcess ȣ
-    // -  FBOȾ swap chain ߺ
+    // EndFrame: 每帧结束时调用
+    // - Flush 提交队列（执行实际绘制）
+    // - 这里可执行后处理链（PostProcess 等）
+    // - 最后解绑主 FBO（将渲染结果交给 swap chain 或者后处理）
     void Renderer::EndFrame() {
-        // ִ
+        // 执行批量绘制
         FlushBatch();
-        // ֡壬֡ Renderer ʱŽ
+        // 本帧对象数据写完，插入 fence，三帧后复用这一段前检查
+        s_ObjectData->EndFrame();
+        // 解绑主帧缓冲，但仅当本帧是由 Renderer 绑定时才解绑
         if (s_MainFramebuffer && s_MainFramebufferBoundByRenderer) {
             s_MainFramebuffer->Unbind();
         }
 
     }
 
-    // BeginRenderPass:  RenderPass лȾĿ߼
+    // BeginRenderPass: 用 RenderPass 对象来切换渲染目标与清屏逻辑
     void Renderer::BeginRenderPass(const std::shared_ptr<RenderPass>& renderPass) {
         if (!renderPass) return;
 
-        //  RenderPass  framebuffer󶨲 viewport
+        GPUProfiler::BeginScope(renderPass->GetSpecification().debugName.c_str());
+        s_ProfiledRenderPasses++;
+
+        // 如果 RenderPass 含有 framebuffer，则绑定并设置 viewport
         if (renderPass->framebuffer) {
             renderPass->framebuffer->Bind();
-            glViewport(0, 0, renderPass->framebuffer->GetSpecification().width,
+            RenderState::SetViewport(0, 0, renderPass->framebuffer->GetSpecification().width,
                 renderPass->framebuffer->GetSpecification().height);
         }
 
-        // ѡ renderPass ָɫ
+        // 可选清屏（由 renderPass 指定颜色）
         if (renderPass->clear) {
             glClearColor(renderPass->clearColor.r, renderPass->clearColor.g,
                 renderPass->clearColor.b, renderPass->clearColor.a);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         }
 
-        // ȲԿصҲ renderPass->depthTest 
-        if (renderPass->depthTest)
-            glEnable(GL_DEPTH_TEST);
-        else
-            glDisable(GL_DEPTH_TEST);
+        // 深度测试开关等也可以在这里根据 renderPass->depthTest 控制
+        RenderState::SetDepthTest(renderPass->depthTest);
     }
 
     void Renderer::EndRenderPass() {
-        // ڽͨʱ flush ͨΣԱ֤Ⱦ˳
+        // 在结束通道时先 flush 本通道的批次（以保证渲染顺序）
         FlushBatch();
-        // ΪԸϸҪض framebuffer 
-        // ﲻԶ UnbindLeave to caller ͳһ EndFrame д
+        if (s_ProfiledRenderPasses > 0) {
+            GPUProfiler::EndScope();
+            s_ProfiledRenderPasses--;
+        }
+        // 解绑行为可以更细化（如果需要把特定 framebuffer 解绑）
+        // 这里不自动 Unbind，Leave to caller 或统一在 EndFrame 中处理
     }
 
-    // Submit(Mesh):  Mesh + shader + transform ύ
-    // - ڴ˴ƣں/
+    // Submit(Mesh): 将单个 Mesh + shader + transform 提交到队列
+    // - 不在此处立即绘制，便于后续排序/合批
     void Renderer::Submit(const std::shared_ptr<Shader>& shader,
         const std::shared_ptr<Mesh>& mesh,
-        const glm::mat4& transform) {
+        const glm::mat4& transform,
+        uint32_t lodFade) {
         if (!shader || !mesh) return;
 
-        // Ⱦ
-        s_BatchQueue.push_back({ shader, mesh, transform });
+        // 将渲染项推入队列
+        s_BatchQueue.push_back({ shader, nullptr, mesh, transform, 0, lodFade });
+
+        // 更新统计：使用几何池中的区间（LOD 没有 CPU 端顶点，顶点数为共用的原网格顶点数）
+        const GeometryAllocation& geometry = mesh->GetGeometry();
+        s_Stats.vertexCount += geometry.vertexCount;
+        s_Stats.triangleCount += geometry.indexCount / 3;
+    }
+
+    // Submit(Material): shader 取自材质，材质在 FlushBatch 中按组绑定
+    void Renderer::Submit(const std::shared_ptr<Material>& material,
+        const std::shared_ptr<Mesh>& mesh,
+        const glm::mat4& transform,
+        uint32_t objectID,
+        uint32_t lodFade) {
+        if (!material || !mesh) return;
+
+        auto shader = material->GetShader();
+        if (!shader) return;
+
+        s_BatchQueue.push_back({ shader, material, mesh, transform, objectID, lodFade });
 
-        // ͳƣʹ mesh ʵʶ/Ϣ
-        // ע⣺GetVertices/GetIndices ЩҪĿ Mesh Ľӿһ
-        s_Stats.vertexCount += static_cast<uint32_t>(mesh->GetVertices().size());
-        s_Stats.triangleCount += static_cast<uint32_t>(mesh->GetIndices().size() / 3);
+        const GeometryAllocation& geometry = mesh->GetGeometry();
+        s_Stats.vertexCount += geometry.vertexCount;
+        s_Stats.triangleCount += geometry.indexCount / 3;
     }
 
-    // Submit(Model):  model  meshes Ȼ Submit
+    // Submit(Model): 遍历 model 的 meshes 然后调用上面的 Submit
     void Renderer::Submit(const std::shared_ptr<Shader>& shader,
         const std::shared_ptr<Model>& model,
         const glm::mat4& transform) {
         if (!shader || !model) return;
 
-        // Model::GetMeshes() 践 shared_ptr<Mesh> Ŀʵǩ룩
+        // Model::GetMeshes() 需返回 shared_ptr<Mesh> 的容器（与项目实际签名对齐）
         for (const auto& mesh : model->GetMeshes()) {
             Submit(shader, mesh, transform);
         }
     }
 
-    // FlushBatch: ѶлƵ GPU
-    // - ƣÿ shader transform uniform RenderCommand::Draw
-    // - ŻԼ shader/л shader idȷͰ
-    void Renderer::FlushBatch() {
+    void Renderer::Flush(bool preserveOrder) {
+        FlushBatch(preserveOrder);
+    }
+
+    void Renderer::SetWeightedBlendedOIT(bool enabled) {
+        // 标志在 FlushBatch 写对象数据时生效，切换前先把已提交的批次按原来的格式画完
+        FlushBatch();
+        s_ObjectFlags = enabled ? (s_ObjectFlags | OBJECT_FLAG_WEIGHTED_OIT) : (s_ObjectFlags & ~OBJECT_FLAG_WEIGHTED_OIT);
+    }
+
+    // FlushBatch: 真正把队列绘制到 GPU
+    // - 按 (shader, material, mesh) 分组，组的顺序保持首次提交的顺序（保留外部排序结果）
+    // - preserveOrder 为 true 时只合并相邻提交（用于需要严格绘制顺序的透明物体）
+    // - 所有实例的对象数据按组顺序线性写入对象数据环形缓冲
+    // - 支持 MultiDrawIndirect 时：每组一条间接命令，相邻的同 shader/材质绑定状态/纹理 的组合并为一次 glMultiDrawElementsIndirect
+    // - 否则每组一次 glDrawElementsInstancedBaseVertexBaseInstance
+    // - 只在材质/shader 变化时重新绑定
+    void Renderer::FlushBatch(bool preserveOrder) {
         if (s_BatchQueue.empty()) return;
 
-        for (const auto& batch : s_BatchQueue) {
-            //  shader Shader  Bind / SetUniformMat4 Ƚӿڣ
-            batch.shader->Bind();
+        // 上传本帧变化过的材质参数（无变化时只重新绑定 SSBO）
+        MaterialTable::Upload();
+
+        // 1. 分组并统计每组实例数
+        s_InstanceGroups.clear();
+        s_GroupLookup.clear();
+        s_BatchGroupIndices.resize(s_BatchQueue.size());
+
+        for (size_t i = 0; i < s_BatchQueue.size(); ++i) {
+            const BatchData& batch = s_BatchQueue[i];
+            InstanceGroupKey key{ batch.shader.get(), batch.material.get(), batch.mesh.get() };
+
+            uint32_t groupIndex = static_cast<uint32_t>(s_InstanceGroups.size());
+            bool newGroup = true;
+            if (preserveOrder) {
+                // 保序模式（透明物体）：只合并相邻的相同提交，不打乱由远到近的顺序
+                if (!s_InstanceGroups.empty()) {
+                    const BatchData& prev = *s_InstanceGroups.back().first;
+                    if (key == InstanceGroupKey{ prev.shader.get(), prev.material.get(), prev.mesh.get() }) {
+                        groupIndex = groupIndex - 1;
+                        newGroup = false;
+                    }
+                }
+            }
+            else {
+                auto [it, inserted] = s_GroupLookup.try_emplace(key, groupIndex);
+                groupIndex = it->second;
+                newGroup = inserted;
+            }
+
+            if (newGroup) {
+                InstanceGroup group;
+                group.first = &batch;
+                s_InstanceGroups.push_back(group);
+            }
+            s_InstanceGroups[groupIndex].instanceCount++;
+            s_BatchGroupIndices[i] = groupIndex;
+        }
 
-            //  transform uniform shader һ "u_Transform"
-            batch.shader->SetUniformMat4("u_Transform", batch.transform);
+        // 2. 在本帧的对象数据段中分配连续槽位，计算每组的 baseInstance 与槽位顺序
+        uint32_t objectCount = static_cast<uint32_t>(s_BatchQueue.size());
+        uint32_t base = 0;
+        ObjectData* objects = s_ObjectData->Allocate(objectCount, base);
+        for (auto& group : s_InstanceGroups) {
+            group.baseInstance = base;
+            base += group.instanceCount;
+            group.instanceCount = 0;
+        }
+
+        uint32_t firstSlot = s_InstanceGroups.front().baseInstance;
+        s_InstanceOrder.resize(objectCount);
+        for (uint32_t i = 0; i < objectCount; ++i) {
+            InstanceGroup& group = s_InstanceGroups[s_BatchGroupIndices[i]];
+            s_InstanceOrder[group.baseInstance - firstSlot + group.instanceCount++] = i;
+        }
 
-            // RenderCommand  VAO 󶨺 glDrawElements / DrawArraysǩ룩
-            // ע⣺RenderCommand::Draw ĲĿеʵһ
-            RenderCommand::Draw(*batch.mesh, *batch.shader);
+        // 3. 按槽位顺序线性写入（映射内存是写合并的，顺序写、不回读）
+        for (uint32_t slot = 0; slot < objectCount; ++slot) {
+            const BatchData& batch = s_BatchQueue[s_InstanceOrder[slot]];
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(batch.transform)));
+
+            ObjectData& data = objects[slot];
+            data.model = batch.transform;
+            data.normalMatrix[0] = glm::vec4(normalMatrix[0], 0.0f);
+            data.normalMatrix[1] = glm::vec4(normalMatrix[1], 0.0f);
+            data.normalMatrix[2] = glm::vec4(normalMatrix[2], 0.0f);
+            data.ids = glm::uvec4(batch.objectID, batch.material ? batch.material->GetGPUMaterialIndex() : 0u, batch.lodFade, s_ObjectFlags);
+        }
+        s_ObjectData->Commit(firstSlot, objectCount);
+
+        // 4. 绘制
+        // 材质按 (shader, 绑定键) 判断是否需要重新绑定：参数在 MaterialTable 中的材质
+        // 只要贴图所在的纹理数组相同就共享绑定状态，切换材质只是对象数据中的一个索引
+        const Shader* lastShader = nullptr;
+        uint64_t lastBindingKey = 0;
+        bool hasBoundMaterial = false;
+
+        auto bindBatchState = [&](const BatchData& batch) {
+            if (batch.material) {
+                uint64_t bindingKey = batch.material->GetBindingKey();
+                if (!hasBoundMaterial || bindingKey != lastBindingKey || batch.shader.get() != lastShader) {
+                    batch.material->Bind();
+                    s_Stats.materialBinds++;
+                    lastBindingKey = bindingKey;
+                    lastShader = batch.shader.get();
+                    hasBoundMaterial = true;
+                }
+            }
+            else if (batch.shader.get() != lastShader) {
+                batch.shader->Bind();
+                lastShader = batch.shader.get();
+                hasBoundMaterial = false;
+            }
+        };
+
+        auto sameBindingState = [](const BatchData& a, const BatchData& b) {
+            if (a.shader != b.shader) return false;
+            if (!a.material || !b.material) return a.material == b.material;
+            return a.material->GetBindingKey() == b.material->GetBindingKey();
+        };
+
+        if (s_Config.enableMultiDrawIndirect && GLAD_GL_VERSION_4_3) {
+            // 4a. 每组一条间接命令，整批一次上传
+            s_IndirectCommands.clear();
+            s_IndirectCommands.reserve(s_InstanceGroups.size());
+            for (const auto& group : s_InstanceGroups) {
+                const GeometryAllocation& geometry = group.first->mesh->GetGeometry();
+                s_IndirectCommands.push_back({ geometry.indexCount, group.instanceCount, geometry.firstIndex,
+                    (int32_t)geometry.baseVertex, group.baseInstance });
+            }
+
+            size_t bytes = s_IndirectCommands.size() * sizeof(DrawElementsIndirectCommand);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_IndirectBuffer);
+            if (bytes > s_IndirectBufferCapacity) {
+                s_IndirectBufferCapacity = std::max(bytes, s_IndirectBufferCapacity * 2);
+            }
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, s_IndirectBufferCapacity, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, bytes, s_IndirectCommands.data());
+
+            // 4b. 所有 Mesh 共享几何池的 VAO，整个 Flush 只绑定一次
+            GeometryPool::Bind(s_ObjectData->GetIndexBuffer());
+
+            // 4c. 相邻且 shader/材质绑定状态/Mesh 纹理都相同的组合并为一个桶，每桶一次 MultiDrawIndirect
+            size_t first = 0;
+            while (first < s_InstanceGroups.size()) {
+                const BatchData& batch = *s_InstanceGroups[first].first;
+
+                size_t last = first + 1;
+                uint32_t bucketInstances = s_InstanceGroups[first].instanceCount;
+                while (last < s_InstanceGroups.size()) {
+                    const BatchData& next = *s_InstanceGroups[last].first;
+                    if (!sameBindingState(next, batch) || !next.mesh->HasSameTextures(*batch.mesh))
+                        break;
+                    bucketInstances += s_InstanceGroups[last].instanceCount;
+                    ++last;
+                }
+
+                bindBatchState(batch);
+                batch.mesh->BindTextures(*batch.shader);
+                GeometryPool::MultiDrawIndirect(first * sizeof(DrawElementsIndirectCommand), (uint32_t)(last - first));
+                batch.mesh->UnbindTextures();
+
+                s_Stats.drawCalls++;
+                s_Stats.indirectCommands += (uint32_t)(last - first);
+                s_Stats.instanceCount += bucketInstances;
+                first = last;
+            }
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+            s_BatchQueue.clear();
+            return;
+        }
+
+        // 4. 回退路径：每组一次实例化绘制
+        for (const auto& group : s_InstanceGroups) {
+            const BatchData& batch = *group.first;
+            bindBatchState(batch);
+
+            RenderCommand::DrawInstanced(*batch.mesh, *batch.shader, group.instanceCount,
+                group.baseInstance, s_ObjectData->GetIndexBuffer());
 
             s_Stats.drawCalls++;
+            s_Stats.instanceCount += group.instanceCount;
         }
 
-        // նУȴһ֡ύ
+        // 清空队列，等待下一帧提交
         s_BatchQueue.clear();
     }
 
-    // PostProcess: һ򵥵ĺʾ
-    // -  FBO ɫΪԪ 0ʹô postProcessShader һȫıε post FBO
-    // - ע⣺Ҫʵֲһȫ VAOδڱļУֻ
+    // PostProcess: 一个简单的后处理流程示例
+    // - 把主 FBO 的颜色附件绑定为纹理单元 0，使用传入的 postProcessShader 绘制一个全屏四边形到 post FBO
+    // - 注意：需要实现并缓存一个全屏 VAO（未包含在本文件中），这里只给出流程
     void Renderer::PostProcess(const std::shared_ptr<Shader>& postProcessShader) {
-        if (!postProcessShader || !s_MainFramebuffer || !s_PostProcessFramebuffer) return;
+        if (!postProcessShader || !s_MainFramebuffer) return;
+
+        // 后处理用的 framebuffer（只有一个颜色附件），第一次使用时创建
+        if (!s_PostProcessFramebuffer) {
+            FramebufferSpecification postProcessFBSpec;
+            postProcessFBSpec.width = s_Config.viewportWidth;
+            postProcessFBSpec.height = s_Config.viewportHeight;
+            postProcessFBSpec.attachments = {
+                { FramebufferTextureFormat::RGBA8, "Color" }
+            };
+            s_PostProcessFramebuffer = Framebuffer::Create(postProcessFBSpec);
+        }
 
-        // 󶨺ڴĿ FBOƽд FBO
+        // 绑定后期处理目标 FBO（绘制结果写入此 FBO）
         s_PostProcessFramebuffer->Bind();
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // 󶨺 shader Ԫ
+        // 绑定后处理 shader 并设置纹理单元
         postProcessShader->Bind();
         postProcessShader->SetUniformInt("u_ScreenTexture", 0);
 
-        //  FBO ɫ󶨵Ԫ 0
+        // 将主 FBO 的颜色附件绑定到纹理单元 0
         s_MainFramebuffer->BindColorTexture(0);
 
-        // ȾȫıΣҪʵһ ScreenQuad::Draw() ƺ
+        // 渲染全屏四边形（你需要实现一个 ScreenQuad::Draw() 或类似函数）
         // e.g. ScreenQuad::Get().Draw();
-        // һȫ quad  VAO/VBOѾʼ
-        // ûʵ ScreenQuadοעеʵֽ顣
+        // 这里假设存在一个全屏 quad 的 VAO/VBO，并且已经初始化好
+        // 如果你没有实现 ScreenQuad，请参考备注中的实现建议。
 
-        //  FBOѽдĬ FBO ںмʹã
+        // 解绑后处理 FBO（把结果写回默认 FBO 或在后续步骤中继续使用）
         s_PostProcessFramebuffer->Unbind();
     }
 
-    //  shader аֻȡ shaderڻԣ
+    // 从 shader 库中按名字获取 shader（若不存在会断言）
     std::shared_ptr<Shader> Renderer::GetShader(const std::string& name) {
         ITR_CORE_ASSERT(s_ShaderLibrary, "ShaderLibrary not initialized!");
         return s_ShaderLibrary->Get(name);
     }
 
+    // 主帧缓冲（颜色 + 深度模板）第一次请求时创建；RendererLayer 通过 RenderGraph 渲染，不会创建它
     std::shared_ptr<Framebuffer> Renderer::GetMainFramebuffer() {
+        if (!s_MainFramebuffer && s_Initialized) {
+            FramebufferSpecification mainFBSpec;
+            mainFBSpec.width = s_Config.viewportWidth;
+            mainFBSpec.height = s_Config.viewportHeight;
+            mainFBSpec.samples = s_Config.enableMSAA ? s_Config.msaaSamples : 1;
+            mainFBSpec.attachments = {
+                { FramebufferTextureFormat::RGBA8, "Color" },
+                { FramebufferTextureFormat::DEPTH24STENCIL8, "DepthStencil" }
+            };
+            s_MainFramebuffer = Framebuffer::Create(mainFBSpec);
+        }
         return s_MainFramebuffer;
     }
 
-    // ıã細 resize
-    // - ѾʼҪ Resize ֡
+    // 改变配置（例如窗口 resize）
+    // - 若已经初始化，则需要重新 Resize 帧缓冲
     void Renderer::SetConfig(const RendererConfig& config) {
         s_Config = config;
         if (s_Initialized) {
@@ -266,4 +520,10 @@ namespace Intro {
         s_Stats.Reset();
     }
 
+    void Renderer::RecordCulling(uint32_t visible, uint32_t culled, uint32_t occluded) {
+        s_Stats.visibleCount += visible;
+        s_Stats.culledCount += culled;
+        s_Stats.occludedCount += occluded;
+    }
+
 } // namespace Intro
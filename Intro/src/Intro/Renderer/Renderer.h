@@ -18,35 +18,83 @@ namespace Intro {
 		uint32_t msaaSamples = 4;
 		bool enableHDR = false;
 		bool enableGammaCorrection = true;
+		bool enableMultiDrawIndirect = true;	// 需要 GL 4.3，不支持时自动回退到逐组实例化绘制
+		bool enableDepthPrepass = false;		// 不透明队列先由近到远只写深度，主通道以 GL_LEQUAL 测试、不写深度
+		bool enableOcclusionCulling = true;		// 用 OccluderComponent 标记的遮挡体在 CPU 上做遮挡剔除
+
+		// 阴影（ShadowMaps）
+		bool enableShadows = true;
+		uint32_t shadowCascadeCount = 4;
+		float shadowSplitLambda = 0.75f;		// 0 = 均匀划分，1 = 对数划分
+		float shadowDistance = 150.0f;
+		uint32_t shadowMapSize = 2048;
+		uint32_t shadowAtlasSize = 4096;
+		uint32_t shadowUpdateBudget = 8;		// 每帧最多更新的图集块数
+
+		// 细节层次（Mesh::GenerateLods / LodSelector）
+		bool enableLod = true;
+		uint32_t lodLevels = 4;					// 导入时生成的级数（含原网格）
+		float lodTriangleRatio = 0.5f;
+		float lodMaxError = 0.02f;				// 相对包围球半径
+		float lodPixelError = 1.0f;				// 屏幕误差阈值（像素）
+		float lodHysteresis = 0.2f;
+		bool lodCrossFade = false;
+
+		uint32_t debugDrawVertexBudget = 65536;	// DebugDraw 每帧最多的顶点数，超出的图元丢弃
+		bool enableShaderCache = true;			// ShaderCache：程序二进制磁盘缓存，只影响之后创建的 Shader
+
+		// 动态分辨率（DynamicResolution）：场景渲染到全尺寸目标的子区域，再上采样到视口
+		bool enableDynamicResolution = false;
+		float dynamicResolutionTargetMs = 12.0f;	// 场景 GPU 时间目标
+		float dynamicResolutionMinScale = 0.5f;
+		float dynamicResolutionMaxScale = 1.0f;
+		float upscaleSharpness = 0.25f;
 	};
 
 	class ITR_API Renderer {
 	public:
 
-		//ڿ
+		//生命周期控制
 		static void Init();//
 		static void Shutdown();
 
-		//ÿ֡
+		//每帧调用
 		static void BeginFrame();
 		static void EndFrame();
 
-		// Ⱦͨڶͨ/
+		// 渲染通道（可用于多通道/后处理）
 		static void BeginRenderPass(const std::shared_ptr<class RenderPass>& renderPass);
 		static void EndRenderPass();
 
-		//ύ
-		// ύ Mesh shader transformȻ RenderCommand  draw
+		//提交
+		// 提交 Mesh（绑定 shader，设置 transform，然后由 RenderCommand 真正 draw）
+		// lodFade：LOD 切换时的抖动淡入淡出参数（LodSelector::PackFade，0 表示不淡化）
 		static void Submit(const std::shared_ptr<class Shader>& shader,
 							const std::shared_ptr<class Mesh>& mesh,
-							const glm::mat4& transfrom = glm::mat4(1.0f));
+							const glm::mat4& transfrom = glm::mat4(1.0f),
+							uint32_t lodFade = 0);
 
-		// ύ Model Model  Mesh ύ
+		// 提交 Mesh + 材质（shader 取自材质；相同 shader/材质/mesh 的提交会合并为一次实例化绘制）
+		// objectID 随对象数据一起写入 SSBO（例如实体 ID）
+		static void Submit(const std::shared_ptr<class Material>& material,
+							const std::shared_ptr<class Mesh>& mesh,
+							const glm::mat4& transfrom = glm::mat4(1.0f),
+							uint32_t objectID = 0,
+							uint32_t lodFade = 0);
+
+		// 提交 Model（遍历 Model 的所有 Mesh 并提交）
 		static void Submit(const std::shared_ptr<class Shader>& shader,
 			const std::shared_ptr<class Model>& model,
 			const glm::mat4& transfrom = glm::mat4(1.0f));
 
-		// ڴڣһ shaderú FBO ɫ󶨵ԪȾȫıΣ
+		// 立即绘制已提交的批次（在切换混合/深度等状态前调用，保证状态作用于对应的绘制）
+		// preserveOrder：只合并相邻的相同提交，保持提交顺序（透明物体）
+		static void Flush(bool preserveOrder = false);
+
+		// 之后 Flush 的对象按加权混合 OIT 的格式输出（写入对象数据 ids.w，shader 据此选择输出）
+		static void SetWeightedBlendedOIT(bool enabled);
+
+		// 后期处理入口：传入一个后处理 shader（该函数负责把主 FBO 的颜色纹理绑定到单元并渲染全屏四边形）
 		static void PostProcess(const std::shared_ptr<class Shader>& postProcessShader);
 		
 		static std::shared_ptr<class Shader> GetShader(const std::string& name);
@@ -55,31 +103,56 @@ namespace Intro {
 		static void SetConfig(const RendererConfig& config);
 		static const RendererConfig& GetConfig();
 
-		//ͳ
+		//统计
 		struct Statistics {
 			uint32_t drawCalls = 0;
+			uint32_t instanceCount = 0;		// 实例化绘制提交的实例总数
+			uint32_t indirectCommands = 0;	// MultiDrawIndirect 提交的命令总数
+			uint32_t materialBinds = 0;		// 实际执行的 Material::Bind 次数
 			uint32_t triangleCount = 0;
 			uint32_t vertexCount = 0;
-			void Reset() { drawCalls = triangleCount = vertexCount = 0; }
+			uint32_t visibleCount = 0;		// 通过视锥剔除的渲染项
+			uint32_t culledCount = 0;		// 被剔除的渲染项（视锥 + 遮挡）
+			uint32_t occludedCount = 0;		// 其中被 CPU 遮挡剔除的渲染项
+			uint32_t objectDataStalls = 0;	// 等待 GPU 释放对象数据缓冲段的次数（理想为 0）
+			void Reset() { drawCalls = instanceCount = triangleCount = vertexCount = visibleCount = culledCount = occludedCount = objectDataStalls = indirectCommands = materialBinds = 0; }
 		};
 		static const Statistics& GetStats();
 		static void ResetStats();
+		static void RecordCulling(uint32_t visible, uint32_t culled, uint32_t occluded = 0);
 
 
 	private:
-		//ύеõGPU
-		static void FlushBatch();
+		//把提交队列调用到GPU
+		static void FlushBatch(bool preserveOrder = false);
 
-		// ݽṹ洢ҪƵ shader/mesh/transform
+		// 批次数据结构：存储要绘制的 shader/material/mesh/transform
 		struct BatchData {
 			std::shared_ptr<Shader> shader;
+			std::shared_ptr<Material> material;
 			std::shared_ptr<Mesh> mesh;
 			glm::mat4 transform;
+			uint32_t objectID = 0;
+			uint32_t lodFade = 0;
+		};
+
+		// 实例组：同一 (shader, material, mesh) 的连续实例区间
+		struct InstanceGroup {
+			const BatchData* first = nullptr;
+			uint32_t baseInstance = 0;
+			uint32_t instanceCount = 0;
 		};
 
 		static std::vector<BatchData> s_BatchQueue;
+		static std::vector<InstanceGroup> s_InstanceGroups;
+		static std::vector<uint32_t> s_InstanceOrder;	// 对象数据槽位 -> s_BatchQueue 下标
+		static std::unique_ptr<class ObjectDataBuffer> s_ObjectData;
+		static std::vector<struct DrawElementsIndirectCommand> s_IndirectCommands;
+		static uint32_t s_IndirectBuffer;
+		static size_t s_IndirectBufferCapacity;
 		static Statistics s_Stats;
 		static RendererConfig s_Config;
+		static uint32_t s_ObjectFlags;
 		static std::unique_ptr<class ShaderLibrary> s_ShaderLibrary;
 		static std::shared_ptr<Framebuffer> s_MainFramebuffer;
 		static std::shared_ptr<Framebuffer> s_PostProcessFramebuffer;
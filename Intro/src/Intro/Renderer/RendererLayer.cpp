@@ -4,19 +4,52 @@
 #include "imgui.h"
 #include "Intro/Application.h"
 #include "Intro/ECS/SceneManager.h"
+#include "Intro/ECS/GameObjectManager.h"
 #include "Intro/RecourceManager/ShaderLibrary.h"
 #include "Intro/Physics/PhysicsSystem.h"
 #include "RenderCommand.h"
 #include "UBO.h"
+#include "RenderState.h"
+#include "RenderGraph.h"
+#include "DebugDraw.h"
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <glm/gtx/matrix_decompose.hpp>
 
 namespace Intro {
 
+    namespace {
+
+        // 相机对象可能有父对象：TransformComponent 保存的是局部变换，相机需要世界空间的位置与朝向
+        void GetCameraWorldPose(const GameObject& cameraObject, glm::vec3& position, glm::quat& rotation) {
+            const Transform& local = cameraObject.GetTransform();
+            position = local.position;
+            rotation = local.rotation;
+
+            auto* activeScene = Application::GetSceneManager().GetActiveScene();
+            if (!activeScene) return;
+
+            glm::mat4 world = activeScene->GetGameObjectManager().GetWorldMatrix(cameraObject);
+            glm::vec3 scale, skew;
+            glm::vec4 perspective;
+            if (glm::decompose(world, scale, rotation, position, skew, perspective)) {
+                rotation = glm::normalize(rotation);
+            }
+            else {
+                position = local.position;
+                rotation = local.rotation;
+            }
+        }
+
+    }
+
     RendererLayer::RendererLayer(const Window& window)
         : Layer("Renderer Layer"), m_Window(window), m_EditorCamera(window)
     {
         m_Shader = Application::GetShaderLibrary().Get("defaultShader");
+        m_DepthPrepassShader = Application::GetShaderLibrary().Get("depthPrepassShader");
+        m_OITCompositeShader = Application::GetShaderLibrary().Get("oitCompositeShader");
+        m_UpscaleShader = Application::GetShaderLibrary().Get("upscaleShader");
 
         m_ViewportWidth = window.GetWidth();
         m_ViewportHeight = window.GetHeight();
@@ -27,65 +60,53 @@ namespace Intro {
     RendererLayer::~RendererLayer()
     {
         m_Shader.reset();
+        m_DepthPrepassShader.reset();
+        m_OITCompositeShader.reset();
+        m_UpscaleShader.reset();
         DestroyFramebuffer();
 
-        if (m_ColliderVAO) {
-            glDeleteVertexArrays(1, &m_ColliderVAO);
-            m_ColliderVAO = 0;
-        }
-        if (m_ColliderVBO) {
-            glDeleteBuffers(1, &m_ColliderVBO);
-            m_ColliderVBO = 0;
+        if (m_FullscreenVAO) {
+            RenderState::DeleteVertexArrays(1, &m_FullscreenVAO);
+            m_FullscreenVAO = 0;
         }
     }
 
     void RendererLayer::OnAttach()
     {
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-
-        Renderer::SetConfig({
-            m_ViewportWidth,
-            m_ViewportHeight,
-            false,  // enableMSAA
-            4,      // msaaSamples
-            false,  // enableHDR
-            true    // enableGammaCorrection
-            });
+        // 保留配置中的其它选项（间接绘制、阴影等），只覆盖场景渲染相关的字段
+        RendererConfig rendererConfig = Renderer::GetConfig();
+        rendererConfig.viewportWidth = m_ViewportWidth;
+        rendererConfig.viewportHeight = m_ViewportHeight;
+        rendererConfig.enableMSAA = false;
+        rendererConfig.msaaSamples = 4;
+        rendererConfig.enableHDR = false;
+        rendererConfig.enableGammaCorrection = true;
+        Renderer::SetConfig(rendererConfig);
         Renderer::Init();
 
+        RenderState::SetDepthTest(true);
+        RenderState::SetCullFace(true);
+        RenderState::SetCullMode(GL_BACK);
+
         m_CameraUBO = std::make_unique<CameraUBO>();
         m_LightsUBO = std::make_unique<LightsUBO>();
+        m_LightClusters = std::make_unique<LightClusters>();
+        m_ShadowMaps = std::make_unique<ShadowMaps>();
 
-        // Ĭϲʣʹ shader 
+        // 创建默认材质（使用 shader 副本）
         auto shaderCopy = std::make_unique<Shader>(*m_Shader);
         std::shared_ptr<Shader> sharedShader = std::move(shaderCopy);
 
         m_DefaultMaterial = std::make_shared<Material>(sharedShader);
         m_DefaultMaterial->SetShininess(32.0f);
 
-        // һĬ uniform ãǱ裬ȫ
+        // 可做一次默认 uniform 设置（非必需，但安全）
         m_Shader->Bind();
         m_Shader->SetUniformInt("material_diffuse", 0);
         m_Shader->SetUniformInt("material_specular", 1);
         m_Shader->SetUniformFloat("material_shininess", 32.0f);
         m_Shader->SetUniformVec3("u_AmbientColor", glm::vec3(0.03f, 0.03f, 0.03f));
 
-        glGenVertexArrays(1, &m_ColliderVAO);
-        glGenBuffers(1, &m_ColliderVBO);
-
-        glBindVertexArray(m_ColliderVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, m_ColliderVBO);
-
-        // ʼһЩռ
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3) * 1000, nullptr, GL_DYNAMIC_DRAW);
-
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
-        glEnableVertexAttribArray(0);
-
-        glBindVertexArray(0);
-
         try {
             std::vector<std::string> skyboxFaces = {
                 "E:/MyEngine/Intro/Intro/src/Intro/assets/skybox/right.jpg",
@@ -96,7 +117,7 @@ namespace Intro {
                 "E:/MyEngine/Intro/Intro/src/Intro/assets/skybox/back.jpg"
             };
 
-            // պļǷ
+            // 检查天空盒文件是否存在
             bool allFilesExist = true;
             for (const auto& face : skyboxFaces) {
                 if (!std::filesystem::exists(face)) {
@@ -124,13 +145,13 @@ namespace Intro {
 
     void RendererLayer::OnUpdate(float deltaTime) {
   
-    //  OpenGL 
+    // 检查 OpenGL 错误
     GLenum error = glGetError();
     if (error != GL_NO_ERROR) {
         ITR_ERROR("OpenGL error before rendering: 0x%x", error);
     }
 
-    // ʱ
+    // 更新时间和相机
     m_Time += deltaTime;
 
     if (m_UseEditorCamera) {
@@ -140,7 +161,7 @@ namespace Intro {
         SyncGameCameraFromScene();
     }
 
-    // ȡ
+    // 获取活动场景
     auto& sceneMgr = Application::GetSceneManager();
     auto* activeScene = sceneMgr.GetActiveScene();
     if (!activeScene) {
@@ -149,99 +170,116 @@ namespace Intro {
     }
     auto& ecs = activeScene->GetECS();
 
+    // 世界矩阵 / 包围体已由场景的系统调度（SceneManager::OnUpdate 中的 TransformSystem）更新，
+    // 下面的调试绘制、阴影、光源与渲染收集都读取缓存。
+    // 渲染代理只重建结构变化的实体、刷新移动过的实体；静态场景几乎没有开销
+    m_RenderWorld.Sync(ecs);
 
     Camera& activeCam = GetActiveCamera();
     glm::mat4 viewProjection = activeCam.GetProjectionMat() * activeCam.GetViewMat();
-    // ༭׶Ǵӵǰ༭ͼ
+    // 编辑器相机的视锥体总是从当前活动相机（编辑器视图）更新
     m_EditorFrustum.UpdateFromMatrix(viewProjection);
 
-    // ۵ǰǷʹñ༭ԴӳϷ׶
-    // ڱ༭ģʽ¿ȷؿӻϷ׶
+    // 无论当前是否使用编辑器相机，都尝试从场景主相机更新游戏视锥体
+    // 这样在编辑器模式下可以正确地可视化游戏相机的视锥体
     Camera* sceneCamera = GetMainCameraFromScene();
     if (sceneCamera) {
         glm::mat4 gameViewProjection = sceneCamera->GetProjectionMat() * sceneCamera->GetViewMat();
         m_GameFrustum.UpdateFromMatrix(gameViewProjection);
     }
 
-    // ײ߿
+    // ==================== 调试图元 ====================
+    // 只记录到 DebugDraw 的顶点列表，在 "Debug Lines" 通道中一次上传、按类型绘制
     if (m_ShowColliders) {
-        PhysicsSystem::DebugDrawColliders(ecs, m_ColliderLines);
-
-        if (!m_ColliderLines.empty()) {
-            glBindBuffer(GL_ARRAY_BUFFER, m_ColliderVBO);
-            glBufferData(GL_ARRAY_BUFFER,
-                m_ColliderLines.size() * sizeof(glm::vec3),
-                m_ColliderLines.data(), GL_DYNAMIC_DRAW);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-        }
-    }
-
-    // ====================  UBO ====================
+        PhysicsSystem::DebugDrawColliders(ecs);
+    }
+    // 编辑器模式下显示游戏相机的视锥体（绿色，不被场景遮挡）；游戏模式下不显示
+    if (m_ShowFrustum && m_UseEditorCamera && sceneCamera) {
+        DebugDraw::Frustum(m_GameFrustum, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), false);
+    }
+
+    // ==================== 动态分辨率 ====================
+    // 按最近的场景 GPU 时间决定本帧的渲染尺寸；缩放只改变视口子区域，不重新分配纹理
+    const RendererConfig& resolutionConfig = Renderer::GetConfig();
+    DynamicResolution::Settings resolutionSettings;
+    resolutionSettings.enabled = resolutionConfig.enableDynamicResolution && m_UpscaleShader;
+    resolutionSettings.targetMs = resolutionConfig.dynamicResolutionTargetMs;
+    resolutionSettings.minScale = resolutionConfig.dynamicResolutionMinScale;
+    resolutionSettings.maxScale = resolutionConfig.dynamicResolutionMaxScale;
+    m_DynamicResolution.BeginFrame(resolutionSettings);
+    m_RenderSize = m_DynamicResolution.GetRenderSize(m_ViewportWidth, m_ViewportHeight);
+    m_UpscaleThisFrame = m_RenderSize.x != m_ViewportWidth || m_RenderSize.y != m_ViewportHeight;
+
+    // ==================== 遮挡剔除 ====================
+    // 遮挡体在工作线程上光栅化，与下面阴影/光源的 ECS 收集并行，收集渲染项之前等待完成
+    bool occlusionCulling = Renderer::GetConfig().enableOcclusionCulling;
+    if (occlusionCulling) {
+        m_OcclusionCuller.BeginFrame(viewProjection, m_ViewportWidth, m_ViewportHeight);
+        RenderSystem::CollectOccluders(ecs, m_OcclusionCuller);
+        m_OcclusionCuller.RasterizeAsync();
+    }
+
+    // ==================== 更新 UBO ====================
     m_CameraUBO->OnUpdate(activeCam, m_Time);
-    m_LightsUBO->OnUpdate(ecs);
+    // 先决定本帧要重绘的阴影（光源的阴影下标随分簇数据上传）
+    m_ShadowMaps->Update(ecs, activeCam);
+    // 点光源/聚光灯按当前相机分簇（网格参数随 LightsUBO 一起上传）
+    m_LightClusters->Update(ecs, activeCam, m_RenderSize.x, m_RenderSize.y, m_ShadowMaps.get());
+    m_LightsUBO->OnUpdate(ecs, *m_LightClusters, m_ShadowMaps.get());
 
-    // ==================== ռȾ ====================
+    // ==================== 收集渲染项 ====================
     m_RenderQueue.Clear();
-    RenderSystem::CollectRenderables(ecs, m_RenderQueue, activeCam.GetPosition());
-    m_RenderQueue.Sort(activeCam.GetPosition());
-
-
-    BindRenderState();
-
-    // ==================== ʼȾ֡ ====================
-    Renderer::BeginFrame();
-
-    // ==================== Ⱦ͸ ====================
-    RenderOpaqueObjects();
-
-    // ==================== Ⱦ͸ ====================
-    RenderTransparentObjects();
+    // m_EditorFrustum 总是由活动相机更新，用它做视锥剔除
+    if (occlusionCulling) m_OcclusionCuller.Wait();
+    const RendererConfig& rendererConfig = Renderer::GetConfig();
+    if (rendererConfig.enableLod) {
+        LodSelector::Settings lodSettings;
+        lodSettings.pixelError = rendererConfig.lodPixelError;
+        lodSettings.hysteresis = rendererConfig.lodHysteresis;
+        lodSettings.crossFade = rendererConfig.lodCrossFade;
+        m_LodSelector.BeginFrame(activeCam.GetProjectionMat(), m_RenderSize.y, activeCam.GetPosition(), lodSettings);
+    }
+    RenderSystem::CollectRenderables(m_RenderWorld, m_RenderQueue, activeCam.GetPosition(), m_EditorFrustum,
+        occlusionCulling ? &m_OcclusionCuller : nullptr, rendererConfig.enableLod ? &m_LodSelector : nullptr);
+    if (rendererConfig.enableLod) m_LodSelector.EndFrame();
+    // 加权混合 OIT 与顺序无关：透明物体只按状态分组，不按距离排序
+    m_TransparencyMode = m_OITCompositeShader ? activeCam.GetTransparencyMode() : TransparencyMode::Sorted;
+    m_RenderQueue.Sort(activeCam.GetPosition(), m_TransparencyMode == TransparencyMode::Sorted);
 
-    if (m_EnableSkybox && m_Skybox) {
-        RenderSkybox();
+    // 深度预通道：不透明物体额外按由近到远排一次
+    m_DepthPrepassThisFrame = Renderer::GetConfig().enableDepthPrepass && m_DepthPrepassShader && !m_RenderQueue.opaque.empty();
+    if (m_DepthPrepassThisFrame) {
+        m_RenderQueue.SortFrontToBack();
     }
 
 
-    // ==================== Ⱦײ߿ ====================
-    if (m_ShowColliders && !m_ColliderLines.empty()) {
-        RenderColliderWireframes();
+    // 视口尚未通知尺寸时按窗口尺寸创建场景颜色纹理
+    if (!m_ColorTexture) {
+        CreateFramebuffer(m_ViewportWidth, m_ViewportHeight);
     }
 
-    // ==================== Ⱦ׶ ====================
-    if (m_ShowFrustum) {
-        // ״̬
-        GLboolean prevDepthTest = glIsEnabled(GL_DEPTH_TEST);
-        GLboolean prevBlend = glIsEnabled(GL_BLEND);
+    BindRenderState();
 
-        // ׶Ⱦ״̬
-        glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // ==================== 开始渲染帧 ====================
+    Renderer::BeginFrame();
+    Renderer::RecordCulling(m_RenderQueue.visibleCount, m_RenderQueue.culledCount, m_RenderQueue.occludedCount);
 
-        // ༭ģʽ£ʾϷ׶壨ɫ
-        if (m_UseEditorCamera) {
-            if (sceneCamera) {
-                RenderFrustum(m_GameFrustum, glm::vec3(0.0f, 1.0f, 0.0f));
-                                                         
-            }
-            else {
-                ITR_WARN("No main scene camera available to render frustum");
-            }
-        }
-        else {
-            // Ϸģʽ£ʾκ׶
-            ITR_INFO("Game Mode - No frustum rendering");
-        }
+    m_CameraUBO->BindBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING);
+    m_LightsUBO->BindBase(GL_UNIFORM_BUFFER, LIGHTS_UBO_BINDING);
+    m_LightClusters->Bind();
+    m_ShadowMaps->Bind();
 
-        // ָ״̬
-        if (prevDepthTest) glEnable(GL_DEPTH_TEST);
-        if (!prevBlend) glDisable(GL_BLEND);
-    }
+    // ==================== 构建并执行渲染图 ====================
+    // 目标绑定、清屏与各通道的 GPU 计时由 RenderGraph 负责
+    BuildRenderGraph();
+    m_RenderGraph.Compile();
+    m_RenderGraph.Execute();
+    m_DynamicResolution.EndFrame();
 
-    // ==================== Ⱦ֡ ====================
+    // ==================== 结束渲染帧 ====================
     Renderer::EndFrame();
     UnbindRenderState();
-    //  OpenGL 
+    // 检查 OpenGL 错误
     error = glGetError();
     if (error != GL_NO_ERROR) {
         ITR_ERROR("OpenGL error after rendering: {0}", error);
@@ -249,45 +287,132 @@ namespace Intro {
 }
 
 
-    // ײ߿Ⱦ
-    void RendererLayer::RenderColliderWireframes() {
-        auto lineShader = Application::GetShaderLibrary().Get("lineShader");
-        if (!lineShader) {
-            ITR_WARN("Line shader not found for collision debug rendering");
-            return;
+    void RendererLayer::BuildRenderGraph() {
+        m_RenderGraph.Reset();
+
+        // 场景颜色由 ImGui 视口显示，跨帧存在，作为外部纹理导入
+        RenderGraphTextureDesc colorDesc{ m_ViewportWidth, m_ViewportHeight, GL_SRGB8_ALPHA8 };
+        RenderGraphResource outputColor = m_RenderGraph.ImportTexture("SceneColor", m_ColorTexture, colorDesc);
+        // 动态分辨率缩放时各场景通道只渲染 m_RenderSize 大小的子区域，最后上采样到视口
+        RenderGraphResource sceneColor = outputColor;
+        if (m_UpscaleThisFrame) {
+            RenderGraphTextureDesc scaledDesc{ m_ViewportWidth, m_ViewportHeight, GL_RGBA8 };
+            sceneColor = m_RenderGraph.ImportTexture("ScaledSceneColor", m_ScaledColorTexture, scaledDesc);
         }
+        RenderGraphResource sceneDepth = InvalidRenderGraphResource;
 
-        // 浱ǰ״̬
-        GLint prevPolygonMode[2];
-        glGetIntegerv(GL_POLYGON_MODE, prevPolygonMode);
-        GLboolean prevDepthTest = glIsEnabled(GL_DEPTH_TEST);
-        GLboolean prevBlend = glIsEnabled(GL_BLEND);
+        // 阴影贴图跨帧缓存，由 ShadowMaps 自己管理目标；只有需要重绘的级联/图集块时才有实际工作
+        if (m_ShadowMaps->HasPendingWork()) {
+            m_RenderGraph.AddPass("Shadows",
+                [&](RenderGraphBuilder& builder) { builder.SetSideEffect(); },
+                [this](const RenderGraph&) { m_ShadowMaps->Render(); });
+        }
 
-        // ߿Ⱦ״̬
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glEnable(GL_DEPTH_TEST);
-        glDisable(GL_BLEND);
-        glLineWidth(2.0f);
+        // 深度只在本帧的场景通道之间使用，作为临时纹理从池中分配
+        RenderGraphTextureDesc depthDesc{ m_ViewportWidth, m_ViewportHeight, GL_DEPTH24_STENCIL8 };
+
+        // 深度预通道只有深度附件（不写颜色），主通道在其结果上只着色最终可见的片元
+        if (m_DepthPrepassThisFrame) {
+            m_RenderGraph.AddPass("Depth Prepass",
+                [&](RenderGraphBuilder& builder) {
+                    builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                    sceneDepth = builder.CreateTexture("SceneDepth", depthDesc);
+                    builder.Write(sceneDepth, AttachmentLoadOp::Clear, glm::vec4(1.0f));
+                },
+                [this](const RenderGraph&) { RenderDepthPrepass(); });
+        }
 
-        lineShader->Bind();
-        lineShader->SetUniformMat4("u_ViewProjection",
-            GetActiveCamera().GetProjectionMat() * GetActiveCamera().GetViewMat());
+        m_RenderGraph.AddPass("Opaque",
+            [&](RenderGraphBuilder& builder) {
+                builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                builder.Write(sceneColor, AttachmentLoadOp::Clear, glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+                if (sceneDepth == InvalidRenderGraphResource) {
+                    sceneDepth = builder.CreateTexture("SceneDepth", depthDesc);
+                    builder.Write(sceneDepth, AttachmentLoadOp::Clear, glm::vec4(1.0f));
+                }
+                else {
+                    builder.Write(sceneDepth);
+                }
+            },
+            [this](const RenderGraph&) { RenderOpaqueObjects(); });
+
+        // 天空盒在透明物体之前绘制（透明物体不写深度，之后绘制会被天空盒覆盖）
+        if (m_EnableSkybox && m_Skybox) {
+            m_RenderGraph.AddPass("Skybox",
+                [&](RenderGraphBuilder& builder) {
+                    builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                    builder.Write(sceneColor);
+                    builder.Write(sceneDepth);
+                },
+                [this](const RenderGraph&) { RenderSkybox(); });
+        }
 
-        // ߿ɫɫʾײ壩
-        lineShader->SetUniformVec3("u_Color", glm::vec3(1.0f, 0.0f, 0.0f));
+        if (m_TransparencyMode == TransparencyMode::WeightedBlended) {
+            // 加权混合 OIT：一遍无序地累积到两个临时目标（深度只测试不写），再合成到场景颜色
+            if (!m_RenderQueue.transparent.empty()) {
+                RenderGraphResource accumulation = InvalidRenderGraphResource;
+                RenderGraphResource revealage = InvalidRenderGraphResource;
+                m_RenderGraph.AddPass("Transparent Accumulation",
+                    [&](RenderGraphBuilder& builder) {
+                        builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                        accumulation = builder.CreateTexture("OITAccumulation", { m_ViewportWidth, m_ViewportHeight, GL_RGBA16F });
+                        revealage = builder.CreateTexture("OITRevealage", { m_ViewportWidth, m_ViewportHeight, GL_R16F });
+                        builder.Write(accumulation, AttachmentLoadOp::Clear, glm::vec4(0.0f));
+                        builder.Write(revealage, AttachmentLoadOp::Clear, glm::vec4(1.0f));
+                        builder.Write(sceneDepth);
+                    },
+                    [this](const RenderGraph&) { RenderTransparentAccumulation(); });
+
+                m_RenderGraph.AddPass("Transparent Composite",
+                    [&](RenderGraphBuilder& builder) {
+                        builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                        builder.Read(accumulation);
+                        builder.Read(revealage);
+                        builder.Write(sceneColor);
+                    },
+                    [this, accumulation, revealage](const RenderGraph& graph) {
+                        CompositeTransparent(graph.GetTexture(accumulation), graph.GetTexture(revealage));
+                    });
+            }
+        }
+        else {
+            m_RenderGraph.AddPass("Transparent",
+                [&](RenderGraphBuilder& builder) {
+                    builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                    builder.Write(sceneColor);
+                    builder.Write(sceneDepth);
+                },
+                [this](const RenderGraph&) { RenderTransparentObjects(); });
+        }
 
-        // Ⱦ߿
-        glBindVertexArray(m_ColliderVAO);
-        glDrawArrays(GL_LINES, 0, (GLsizei)m_ColliderLines.size());
-        glBindVertexArray(0);
+        if (DebugDraw::HasPending()) {
+            m_RenderGraph.AddPass("Debug Lines",
+                [&](RenderGraphBuilder& builder) {
+                    builder.SetRenderArea(m_RenderSize.x, m_RenderSize.y);
+                    builder.Write(sceneColor);
+                    builder.Write(sceneDepth);
+                },
+                [this](const RenderGraph&) { RenderDebugLines(); });
+        }
+        else {
+            // 本帧没有调试图元：不添加通道，只让 DebugDraw 清掉上一帧留给 ImGui 的文字（不产生 GL 调用）
+            RenderDebugLines();
+        }
 
-        lineShader->UnBind();
+        if (m_UpscaleThisFrame) {
+            m_RenderGraph.AddPass("Upscale",
+                [&](RenderGraphBuilder& builder) {
+                    builder.Read(sceneColor);
+                    builder.Write(outputColor, AttachmentLoadOp::DontCare);
+                },
+                [this, sceneColor](const RenderGraph& graph) { UpscaleSceneColor(graph.GetTexture(sceneColor)); });
+        }
+    }
 
-        // ָ״̬
-        glPolygonMode(GL_FRONT_AND_BACK, prevPolygonMode[0]);
-        glLineWidth(1.0f);
-        if (!prevDepthTest) glDisable(GL_DEPTH_TEST);
-        if (prevBlend) glEnable(GL_BLEND);
+    void RendererLayer::RenderDebugLines() {
+        // 碰撞体线框、视锥体以及其它 DebugDraw 调用记录的图元一次性提交
+        Camera& activeCam = GetActiveCamera();
+        DebugDraw::Flush(activeCam.GetProjectionMat() * activeCam.GetViewMat());
     }
 
 
@@ -299,83 +424,153 @@ namespace Intro {
 
     }
 
+    void RendererLayer::RenderDepthPrepass() {
+        // 所有不透明物体共用一个只输出位置的 shader，由近到远提交，同一 mesh 仍会合并为实例化/间接绘制
+        SampleCounterScope samples(m_PrepassSamples);
+        for (const auto& key : m_RenderQueue.opaqueFrontToBack) {
+            const RenderItem& item = m_RenderQueue.GetItem(key);
+            Renderer::Submit(m_DepthPrepassShader, item.mesh, item.transform, item.lodFade);
+        }
+        Renderer::Flush();
+    }
+
     void RendererLayer::RenderOpaqueObjects() {
-        std::shared_ptr<Material> lastMaterial = nullptr;
-        bool lastIsPBR = false;
+        // 预通道已写好深度：只有深度与之相等的片元会着色，主通道不再写深度
+        GLenum prevDepthFunc = RenderState::GetDepthFunc();
+        bool prevDepthMask = RenderState::IsDepthMaskEnabled();
+        if (m_DepthPrepassThisFrame) {
+            RenderState::SetDepthFunc(GL_LEQUAL);
+            RenderState::SetDepthMask(false);
+        }
 
-        for (const auto& item : m_RenderQueue.opaque) {
-            auto& material = item.material ? item.material : m_DefaultMaterial;
-            bool currentIsPBR = item.isPBR;
+        {
+            SampleCounterScope samples(m_OpaqueSamples);
 
-            if (material != lastMaterial || currentIsPBR != lastIsPBR) {
-                // ɫ󶨲
-                SetupShaderUniforms(material->GetShader());
-                material->Bind();
+            // 材质绑定与实例合并由 Renderer::FlushBatch 完成，这里只负责提交
+            for (const auto& key : m_RenderQueue.opaque) {
+                const RenderItem& item = m_RenderQueue.GetItem(key);
+                const auto& material = item.material ? item.material : m_DefaultMaterial;
+                Renderer::Submit(material, item.mesh, item.transform, item.objectID, item.lodFade);
+            }
 
-                m_CameraUBO->BindBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING);
-                m_LightsUBO->BindBase(GL_UNIFORM_BUFFER, LIGHTS_UBO_BINDING);
+            // 在切换到天空盒/透明状态前把不透明批次画完
+            Renderer::Flush();
+        }
 
-                lastMaterial = material;
-                lastIsPBR = currentIsPBR;
-            }
+        RenderState::SetDepthFunc(prevDepthFunc);
+        RenderState::SetDepthMask(prevDepthMask);
 
-            // ı任ͨͨ UBO ݵģ
-            auto shader = material->GetShader();
-            if (shader) {
-                shader->SetUniformMat4("u_Transform", item.transform);
-            }
+        // 过度绘制统计：样本数除以实际渲染的像素数
+        float pixels = (float)std::max<uint64_t>(1, (uint64_t)m_RenderSize.x * m_RenderSize.y);
+        m_OverdrawStats.depthPrepass = m_DepthPrepassThisFrame;
+        m_OverdrawStats.prepassSamples = m_DepthPrepassThisFrame ? m_PrepassSamples.GetSamples() : 0;
+        m_OverdrawStats.shadedSamples = m_OpaqueSamples.GetSamples();
+        m_OverdrawStats.prepassPerPixel = (float)m_OverdrawStats.prepassSamples / pixels;
+        m_OverdrawStats.shadedPerPixel = (float)m_OverdrawStats.shadedSamples / pixels;
+    }
 
-            // ʹ Renderer ύ
-            Renderer::Submit(material->GetShader(), item.mesh, item.transform);
+    void RendererLayer::RenderTransparentObjects() {
+        // 保存状态
+        bool prevDepthMask = RenderState::IsDepthMaskEnabled();
+        bool prevBlend = RenderState::IsBlendEnabled();
+
+        // 设置透明物体渲染状态
+        RenderState::SetBlend(true);
+        RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::SetDepthMask(false);
+
+        for (const auto& key : m_RenderQueue.transparent) {
+            const RenderItem& item = m_RenderQueue.GetItem(key);
+            const auto& material = item.material ? item.material : m_DefaultMaterial;
+            Renderer::Submit(material, item.mesh, item.transform, item.objectID, item.lodFade);
         }
+
+        // 透明物体需要保持由远到近的顺序，只合并相邻的相同提交
+        Renderer::Flush(true);
+
+        // 恢复状态
+        RenderState::SetDepthMask(prevDepthMask);
+        RenderState::SetBlend(prevBlend);
     }
 
-    void RendererLayer::RenderTransparentObjects() {
-        // ״̬
-        GLboolean prevDepthMask;
-        glGetBooleanv(GL_DEPTH_WRITEMASK, &prevDepthMask);
-        GLboolean prevBlend = glIsEnabled(GL_BLEND);
+    void RendererLayer::RenderTransparentAccumulation() {
+        bool prevDepthMask = RenderState::IsDepthMaskEnabled();
+        bool prevBlend = RenderState::IsBlendEnabled();
+        bool prevCullFace = RenderState::IsCullFaceEnabled();
 
-        // ͸Ⱦ״̬
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDepthMask(GL_FALSE);
+        // 累积目标相加，透射率目标相乘（1 - alpha）；与绘制顺序无关，正反面都参与
+        RenderState::SetBlend(true);
+        RenderState::SetBlendFunci(0, GL_ONE, GL_ONE);
+        RenderState::SetBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR);
+        RenderState::SetDepthMask(false);
+        RenderState::SetCullFace(false);
 
-        std::shared_ptr<Material> lastMaterial = nullptr;
+        // 透明队列只按状态分组，相同 shader/材质/mesh 的物体合并为一次实例化/间接绘制
+        Renderer::SetWeightedBlendedOIT(true);
+        for (const auto& key : m_RenderQueue.transparent) {
+            const RenderItem& item = m_RenderQueue.GetItem(key);
+            const auto& material = item.material ? item.material : m_DefaultMaterial;
+            Renderer::Submit(material, item.mesh, item.transform, item.objectID, item.lodFade);
+        }
+        Renderer::SetWeightedBlendedOIT(false);
 
-        for (const auto& item : m_RenderQueue.transparent) {
-            auto& material = item.material ? item.material : m_DefaultMaterial;
+        RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        RenderState::SetCullFace(prevCullFace);
+        RenderState::SetDepthMask(prevDepthMask);
+        RenderState::SetBlend(prevBlend);
+    }
 
-            if (material != lastMaterial) {
-                // ɫ󶨲
-                SetupShaderUniforms(material->GetShader());
-                material->Bind();
+    void RendererLayer::DrawFullscreenTriangle() {
+        if (!m_FullscreenVAO) {
+            glGenVertexArrays(1, &m_FullscreenVAO);
+        }
+        RenderState::BindVertexArray(m_FullscreenVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
 
-                m_CameraUBO->BindBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING);
-                m_LightsUBO->BindBase(GL_UNIFORM_BUFFER, LIGHTS_UBO_BINDING);
+    void RendererLayer::CompositeTransparent(GLuint accumulation, GLuint revealage) {
+        bool prevDepthTest = RenderState::IsDepthTestEnabled();
+        bool prevBlend = RenderState::IsBlendEnabled();
 
-                lastMaterial = material;
-            }
+        RenderState::SetDepthTest(false);
+        RenderState::SetBlend(true);
+        RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-            // ı任
-            auto shader = material->GetShader();
-            if (shader) {
-                shader->SetUniformMat4("u_Transform", item.transform);
-            }
+        m_OITCompositeShader->Bind();
+        RenderState::BindTexture(0, GL_TEXTURE_2D, accumulation);
+        RenderState::BindTexture(1, GL_TEXTURE_2D, revealage);
+        DrawFullscreenTriangle();
 
-            // ʹ Renderer ύ
-            Renderer::Submit(material->GetShader(), item.mesh, item.transform);
-        }
+        RenderState::BindTexture(0, GL_TEXTURE_2D, 0);
+        RenderState::BindTexture(1, GL_TEXTURE_2D, 0);
+        RenderState::SetDepthTest(prevDepthTest);
+        RenderState::SetBlend(prevBlend);
+    }
+
+    void RendererLayer::UpscaleSceneColor(GLuint source) {
+        bool prevDepthTest = RenderState::IsDepthTestEnabled();
+        bool prevBlend = RenderState::IsBlendEnabled();
+
+        // 覆盖整个视口，不需要混合与深度
+        RenderState::SetDepthTest(false);
+        RenderState::SetBlend(false);
 
-        // ָ״̬
-        glDepthMask(prevDepthMask);
-        if (!prevBlend) glDisable(GL_BLEND);
+        m_UpscaleShader->Bind();
+        m_UpscaleShader->SetUniformVec2("u_RenderSize", glm::vec2(m_RenderSize));
+        m_UpscaleShader->SetUniformVec2("u_OutputSize", glm::vec2((float)m_ViewportWidth, (float)m_ViewportHeight));
+        m_UpscaleShader->SetUniformFloat("u_Sharpness", Renderer::GetConfig().upscaleSharpness);
+        RenderState::BindTexture(0, GL_TEXTURE_2D, source);
+        DrawFullscreenTriangle();
+
+        RenderState::BindTexture(0, GL_TEXTURE_2D, 0);
+        RenderState::SetDepthTest(prevDepthTest);
+        RenderState::SetBlend(prevBlend);
     }
 
     void RendererLayer::BindMaterial(const std::shared_ptr<Material>& material) {
         material->Bind();
 
-        // ȷUBO󶨣ʰ󶨿ܻлshader
+        // 确保UBO绑定（材质绑定可能会切换shader）
         m_CameraUBO->BindBase(GL_UNIFORM_BUFFER, CAMERA_UBO_BINDING);
         m_LightsUBO->BindBase(GL_UNIFORM_BUFFER, LIGHTS_UBO_BINDING);
     }
@@ -388,42 +583,40 @@ namespace Intro {
         m_ViewportHeight = height;
 
         glGenTextures(1, &m_ColorTexture);
-        glBindTexture(GL_TEXTURE_2D, m_ColorTexture);
+        RenderState::BindTexture(GL_TEXTURE_2D, m_ColorTexture);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, (GLsizei)width, (GLsizei)height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        glGenRenderbuffers(1, &m_RBO);
-        glBindRenderbuffer(GL_RENDERBUFFER, m_RBO);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, (GLsizei)width, (GLsizei)height);
-        glBindRenderbuffer(GL_RENDERBUFFER, 0);
-
-        glGenFramebuffers(1, &m_FBO);
-        glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorTexture, 0);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_RBO);
+        RenderState::BindTexture(GL_TEXTURE_2D, 0);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        // 动态分辨率的渲染目标按视口全尺寸分配，缩放只使用其左下角的子区域。
+        // 场景 shader 输出的已是 gamma 编码后的值，这里用线性格式保存，上采样读取时不再做 sRGB 解码
+        glGenTextures(1, &m_ScaledColorTexture);
+        RenderState::BindTexture(GL_TEXTURE_2D, m_ScaledColorTexture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, (GLsizei)width, (GLsizei)height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        RenderState::BindTexture(GL_TEXTURE_2D, 0);
 
-        
+        // 深度缓冲与 FBO 不再单独创建：深度是渲染图的临时纹理，FBO 由渲染图按附件组合缓存
     }
 
     void RendererLayer::DestroyFramebuffer()
     {
-        if (m_FBO) {
-            glDeleteFramebuffers(1, &m_FBO);
-            m_FBO = 0;
-        }
         if (m_ColorTexture) {
-            glDeleteTextures(1, &m_ColorTexture);
+            // 先销毁渲染图中引用该纹理的 FBO，纹理 ID 之后可能被复用
+            m_RenderGraph.ReleaseExternalTexture(m_ColorTexture);
+            RenderState::DeleteTextures(1, &m_ColorTexture);
             m_ColorTexture = 0;
         }
-        if (m_RBO) {
-            glDeleteRenderbuffers(1, &m_RBO);
-            m_RBO = 0;
+        if (m_ScaledColorTexture) {
+            m_RenderGraph.ReleaseExternalTexture(m_ScaledColorTexture);
+            RenderState::DeleteTextures(1, &m_ScaledColorTexture);
+            m_ScaledColorTexture = 0;
         }
     }
 
@@ -438,23 +631,23 @@ namespace Intro {
 
     void RendererLayer::BindRenderState()
     {
-        glGetIntegerv(GL_VIEWPORT, m_SavedState.viewport);
-        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_SavedState.framebuffer);
-        m_SavedState.depthTest = glIsEnabled(GL_DEPTH_TEST);
-        m_SavedState.cullFace = glIsEnabled(GL_CULL_FACE);
+        // 从 RenderState 缓存读取需要恢复的状态
+        m_SavedState.viewport = RenderState::GetViewport();
+        m_SavedState.framebuffer = RenderState::GetFramebuffer();
+        m_SavedState.depthTest = RenderState::IsDepthTestEnabled();
+        m_SavedState.cullFace = RenderState::IsCullFaceEnabled();
 
-        glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
-        glViewport(0, 0, (GLsizei)m_ViewportWidth, (GLsizei)m_ViewportHeight);
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_CULL_FACE);
+        // 帧缓冲与 viewport 由渲染图在每个通道开始时设置
+        RenderState::SetDepthTest(true);
+        RenderState::SetCullFace(true);
     }
 
     void RendererLayer::UnbindRenderState()
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_SavedState.framebuffer);
-        glViewport(m_SavedState.viewport[0], m_SavedState.viewport[1], m_SavedState.viewport[2], m_SavedState.viewport[3]);
-        if (!m_SavedState.depthTest) glDisable(GL_DEPTH_TEST);
-        if (!m_SavedState.cullFace) glDisable(GL_CULL_FACE);
+        RenderState::BindFramebuffer(m_SavedState.framebuffer);
+        RenderState::SetViewport(m_SavedState.viewport.x, m_SavedState.viewport.y, m_SavedState.viewport.z, m_SavedState.viewport.w);
+        RenderState::SetDepthTest(m_SavedState.depthTest);
+        RenderState::SetCullFace(m_SavedState.cullFace);
     }
 
     Camera& RendererLayer::GetActiveCamera() {
@@ -462,7 +655,7 @@ namespace Intro {
             return m_EditorCamera;
         }
         else {
-            // ӳȡȡʧʹñ༭
+            // 从场景获取主相机，如果获取失败则使用编辑器相机
             Camera* mainCam = GetMainCameraFromScene();
             return mainCam ? *mainCam : m_EditorCamera;
         }
@@ -487,31 +680,34 @@ namespace Intro {
         }
     }
 
-    // ȷбҪ
+    // 确保有必要的组件
     if (!mainCamera.HasComponent<CameraComponent>() ||
         !mainCamera.HasComponent<TransformComponent>()) {
         return nullptr;
     }
 
     auto& cameraComp = mainCamera.GetComponent<CameraComponent>();
-    auto& transform = mainCamera.GetComponent<TransformComponent>();
 
-    // ȷ m_GameCamera ڣȻѳͬ m_GameCamera
+    // 确保 m_GameCamera 存在，然后把场景相机组件的数据同步到 m_GameCamera
     if (!m_GameCamera) {
         m_GameCamera = std::make_unique<FreeCamera>(m_Window);
     }
 
-    // ͬλƺת
-    m_GameCamera->SetPosition(transform.transform.position);
-    m_GameCamera->SetRotation(transform.transform.rotation);
+    // 同步世界空间的位移和旋转
+    glm::vec3 position;
+    glm::quat rotation;
+    GetCameraWorldPose(mainCamera, position, rotation);
+    m_GameCamera->SetPosition(position);
+    m_GameCamera->SetRotation(rotation);
 
-    // ͬͶӰCameraComponent 洢Ƕ
+    // 同步投影参数（CameraComponent 存储的是度数）
     m_GameCamera->SetPerspective(
         glm::radians(cameraComp.fov),
         (float)m_ViewportWidth / (float)m_ViewportHeight,
         cameraComp.nearClip,
         cameraComp.farClip
     );
+    m_GameCamera->SetTransparencyMode(cameraComp.transparency);
 
     return m_GameCamera.get();
     }
@@ -522,22 +718,24 @@ namespace Intro {
             return nullptr;
         }
 
-        auto& transform = cameraObject.GetComponent<TransformComponent>();
-
-        // µ
+        // 创建新的自由相机
         auto camera = std::make_unique<FreeCamera>(m_Window);
 
-        // λúת
-        camera->SetPosition(transform.transform.position);
-        camera->SetRotation(transform.transform.rotation);
+        // 设置世界空间的位置和旋转
+        glm::vec3 position;
+        glm::quat rotation;
+        GetCameraWorldPose(cameraObject, position, rotation);
+        camera->SetPosition(position);
+        camera->SetRotation(rotation);
 
-        // ͶӰ
+        // 设置投影参数
         camera->SetPerspective(
             glm::radians(comp.fov),
             (float)m_ViewportWidth / (float)m_ViewportHeight,
             comp.nearClip,
             comp.farClip
         );
+        camera->SetTransparencyMode(comp.transparency);
 
         return camera;
     }
@@ -550,11 +748,11 @@ namespace Intro {
     void RendererLayer::SyncGameCameraFromScene() {
         Camera* mainCam = GetMainCameraFromScene();
         if (mainCam && m_GameCamera) {
-            // ͬλúת
+            // 同步位置和旋转
             m_GameCamera->SetPosition(mainCam->GetPosition());
             m_GameCamera->SetRotation(mainCam->GetRotation());
 
-            // ͬͶӰ
+            // 同步投影参数
             m_GameCamera->SetPerspective(
                 mainCam->GetFov(),
                 (float)m_ViewportWidth / (float)m_ViewportHeight,
@@ -571,90 +769,23 @@ namespace Intro {
         m_UseEditorCamera = useEditor;
 
         if (!useEditor) {
-            // лϷʱȷ
+            // 切换到游戏相机时，确保场景中有主相机
             auto* activeScene = Application::GetSceneManager().GetActiveScene();
             if (activeScene) {
                 GameObject mainCamera = activeScene->FindMainCamera();
                 if (!mainCamera.IsValid()) {
-                    // ûһĬϵ
+                    // 如果没有主相机，创建一个默认的
                     activeScene->CreateDefaultMainCamera();
                 }
             }
         }
     }
 
-    // RendererLayer.cpp - ޸׶Ⱦ߼
-    // RendererLayer.cpp - Ľ RenderFrustum 
-    void RendererLayer::RenderFrustum(const Frustum& frustum, const glm::vec3& color) {
-        const auto& corners = frustum.GetCorners();
-
-
-        auto lineShader = Application::GetShaderLibrary().Get("lineShader");
-        if (!lineShader) {
-            ITR_WARN("Line shader not found, frustum rendering skipped");
-            return;
-        }
-
-        lineShader->Bind();
-
-        // ʹûͼͶӰ
-        Camera& activeCam = GetActiveCamera();
-        glm::mat4 viewProj = activeCam.GetProjectionMat() * activeCam.GetViewMat();
-        lineShader->SetUniformMat4("u_ViewProjection", viewProj);
-        lineShader->SetUniformVec3("u_Color", color);
-
-        // ׶ߣ12ߣ
-        const std::vector<std::pair<int, int>> edges = {
-            // ƽ
-            {0, 1}, {1, 3}, {3, 2}, {2, 0},
-            // Զƽ  
-            {4, 5}, {5, 7}, {7, 6}, {6, 4},
-            // ӽԶƽ
-            {0, 4}, {1, 5}, {3, 7}, {2, 6}
-        };
-
-        // ռ߶ζ
-        std::vector<glm::vec3> lineVertices;
-        for (const auto& edge : edges) {
-            lineVertices.push_back(corners[edge.first]);
-            lineVertices.push_back(corners[edge.second]);
-        }
-
-        // ʱVAOVBO
-        unsigned int VAO, VBO;
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(glm::vec3),
-            lineVertices.data(), GL_STATIC_DRAW);
-
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
-        glEnableVertexAttribArray(0);
-
-        // ߿
-        glLineWidth(2.0f);
-
-        // Ⱦ߶
-        glDrawArrays(GL_LINES, 0, (GLsizei)lineVertices.size());
-
-        // ָ߿
-        glLineWidth(1.0f);
-
-        // 
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-
-        lineShader->UnBind();
-
-    }
-
     void RendererLayer::ReloadSkybox(const std::vector<std::string>& facePaths) {
 
 
         if (facePaths.empty()) {
-            // ʹĬ·򱣳ԭ·
+            // 使用默认路径或保持原有路径
             return;
         }
 
@@ -672,18 +803,18 @@ namespace Intro {
             return;
         }
 
-        // OpenGL״̬
+        // 检查OpenGL状态
         GLenum error = glGetError();
         if (error != GL_NO_ERROR) {
             ITR_WARN("OpenGL error before rendering skybox: 0x%x", error);
-            glGetError(); // ״̬
+            glGetError(); // 清除错误状态
         }
 
-        // Ⱦպ
+        // 渲染天空盒
         Camera& activeCam = GetActiveCamera();
         m_Skybox->Draw(activeCam.GetViewMat(), activeCam.GetProjectionMat());
 
-        // 
+        // 检查错误
         error = glGetError();
         if (error != GL_NO_ERROR) {
             ITR_ERROR("OpenGL error after rendering skybox: 0x%x", error);
@@ -10,6 +10,12 @@
 #include "Mesh.h"
 #include "Model.h"
 #include "Skybox.h"
+#include "RenderGraph.h"
+#include "SampleCounter.h"
+#include "OcclusionCuller.h"
+#include "LodSelector.h"
+#include "RenderWorld.h"
+#include "DynamicResolution.h"
 #include "ShapeGenerator.h"
 #include "Intro/ECS/System.h"
 #include "Intro/ECS/GameObject.h"
@@ -37,6 +43,29 @@ namespace Intro {
 
         void ResizeViewport(uint32_t width, uint32_t height);
         GLuint GetSceneTextureID() const { return m_ColorTexture; }
+        const RenderGraph& GetRenderGraph() const { return m_RenderGraph; }
+        const RenderWorld& GetRenderWorld() const { return m_RenderWorld; }
+        const LightClusters* GetLightClusters() const { return m_LightClusters.get(); }
+        const ShadowMaps* GetShadowMaps() const { return m_ShadowMaps.get(); }
+        const OcclusionCuller& GetOcclusionCuller() const { return m_OcclusionCuller; }
+        const LodSelector& GetLodSelector() const { return m_LodSelector; }
+        // 编辑器相机的设置（例如透明物体的绘制方式）；场景相机的设置在 CameraComponent 中
+        Camera& GetEditorCamera() { return m_EditorCamera; }
+        // 本帧实际使用的透明绘制方式（取自活动相机）
+        TransparencyMode GetTransparencyModeThisFrame() const { return m_TransparencyMode; }
+        const DynamicResolution& GetDynamicResolution() const { return m_DynamicResolution; }
+        // 本帧场景实际渲染的尺寸（动态分辨率关闭时等于视口尺寸）
+        glm::uvec2 GetRenderSize() const { return m_RenderSize; }
+
+        // 不透明通道的过度绘制统计（遮挡查询，延迟一到两帧）
+        struct OverdrawStats {
+            bool depthPrepass = false;      // 本帧是否执行了深度预通道
+            uint64_t prepassSamples = 0;    // 预通道通过深度测试的样本数
+            uint64_t shadedSamples = 0;     // 不透明主通道通过深度测试（即执行着色）的样本数
+            float prepassPerPixel = 0.0f;
+            float shadedPerPixel = 0.0f;    // 平均每个像素的着色次数
+        };
+        const OverdrawStats& GetOverdrawStats() const { return m_OverdrawStats; }
 
         void SetUseEditorCamera(bool useEditor);
         bool IsUsingEditorCamera() const { return m_UseEditorCamera; };
@@ -52,7 +81,6 @@ namespace Intro {
 
         bool GetShowColliders() const { return m_ShowColliders; }
         void SetShowColliders(bool show) { m_ShowColliders = show; }
-        void RenderColliderWireframes();
 
         void SetEnableSkybox(bool enable) { m_EnableSkybox = enable; }
         bool IsSkyboxEnabled() const { return m_EnableSkybox; }
@@ -67,15 +95,20 @@ namespace Intro {
         void BindRenderState();
         void UnbindRenderState();
 
+        void BuildRenderGraph();
+        void RenderDepthPrepass();
         void RenderOpaqueObjects();
         void RenderTransparentObjects();
+        void RenderTransparentAccumulation();
+        void CompositeTransparent(GLuint accumulation, GLuint revealage);
+        void UpscaleSceneColor(GLuint source);
+        void DrawFullscreenTriangle();
+        void RenderDebugLines();
         void BindMaterial(const std::shared_ptr<Material>& material);
         void SetupShaderUniforms(const std::shared_ptr<Shader>& shader);
 
 
         Camera* GetMainCameraFromScene();
-
-        void RenderFrustum(const Frustum& frustum, const glm::vec3& color = glm::vec3(1.0f, 0.5f, 0.0f));
     private:
         const Window& m_Window;
 
@@ -87,36 +120,58 @@ namespace Intro {
 
         std::vector<RenderSystem::RenderableData> m_RenderableData;
 
-        GLuint m_FBO = 0;
+        // 场景颜色（ImGui 视口显示），作为外部纹理导入渲染图
         GLuint m_ColorTexture = 0;
-        GLuint m_RBO = 0;
+        RenderGraph m_RenderGraph;
         uint32_t m_ViewportWidth = 1280;
         uint32_t m_ViewportHeight = 720;
 
-        struct RenderState {
-            GLint viewport[4];
-            GLint framebuffer;
-            GLboolean depthTest;
-            GLboolean cullFace;
+        // BindRenderState 时保存、UnbindRenderState 时恢复的状态
+        struct SavedRenderState {
+            glm::ivec4 viewport = glm::ivec4(0);
+            GLuint framebuffer = 0;
+            bool depthTest = true;
+            bool cullFace = true;
         } m_SavedState;
 
         std::unique_ptr<CameraUBO> m_CameraUBO;
         std::unique_ptr<LightsUBO> m_LightsUBO;
+        std::unique_ptr<LightClusters> m_LightClusters;
+        std::unique_ptr<ShadowMaps> m_ShadowMaps;
         RenderQueue m_RenderQueue;
+        RenderWorld m_RenderWorld;          // 渲染代理表，从 ECS 变化增量同步
+        OcclusionCuller m_OcclusionCuller;
+        LodSelector m_LodSelector;
         float m_Time = 0.0f;
 
+        // 深度预通道
+        std::shared_ptr<Shader> m_DepthPrepassShader;
+        bool m_DepthPrepassThisFrame = false;
+        SampleCounter m_PrepassSamples;
+        SampleCounter m_OpaqueSamples;
+        OverdrawStats m_OverdrawStats;
+
+        // 加权混合 OIT
+        TransparencyMode m_TransparencyMode = TransparencyMode::Sorted;
+        std::shared_ptr<Shader> m_OITCompositeShader;
+        GLuint m_FullscreenVAO = 0;		// 全屏三角形由 gl_VertexID 生成，只需要一个空 VAO
+
+        // 动态分辨率：缩放时场景渲染到 m_ScaledColorTexture（与视口同尺寸）左下角的子区域，再上采样到 m_ColorTexture
+        DynamicResolution m_DynamicResolution;
+        std::shared_ptr<Shader> m_UpscaleShader;
+        GLuint m_ScaledColorTexture = 0;
+        glm::uvec2 m_RenderSize = glm::uvec2(1);
+        bool m_UpscaleThisFrame = false;
+
         std::shared_ptr<Material> m_DefaultMaterial;
 
-        //׶
+        //视锥
         Frustum m_EditorFrustum;
         Frustum m_GameFrustum;
         bool m_ShowFrustum = true;
 
-        //
-        std::vector<glm::vec3> m_ColliderLines;
-        GLuint m_ColliderVAO = 0;
-        GLuint m_ColliderVBO = 0;
-        bool m_ShowColliders = true; // Ƿʾײ߿
+        //物理
+        bool m_ShowColliders = true; // 控制是否显示碰撞体线框
 
         //skybox
         std::unique_ptr<Skybox> m_Skybox;
@@ -0,0 +1,57 @@
+#include "itrpch.h"
+#include "SampleCounter.h"
+
+namespace Intro {
+
+	SampleCounter::~SampleCounter()
+	{
+		if (m_Queries[0]) {
+			glDeleteQueries((GLsizei)FrameLatency, m_Queries);
+		}
+	}
+
+	void SampleCounter::Begin()
+	{
+		if (m_Active) return;
+		if (!m_Queries[0]) {
+			glGenQueries((GLsizei)FrameLatency, m_Queries);
+		}
+
+		Resolve();
+
+		// 当前槽位的上一次结果还没回来：跳过本帧，不覆盖仍在使用的查询
+		if (m_Pending[m_Current]) return;
+
+		glBeginQuery(GL_SAMPLES_PASSED, m_Queries[m_Current]);
+		m_Active = true;
+	}
+
+	void SampleCounter::End()
+	{
+		if (!m_Active) return;
+
+		glEndQuery(GL_SAMPLES_PASSED);
+		m_Active = false;
+		m_Pending[m_Current] = true;
+		m_Current = (m_Current + 1) % FrameLatency;
+	}
+
+	void SampleCounter::Resolve()
+	{
+		// 从最早提交的槽位开始读取，保证 m_LastSamples 是最新的可用结果
+		for (uint32_t i = 0; i < FrameLatency; ++i) {
+			uint32_t slot = (m_Current + i) % FrameLatency;
+			if (!m_Pending[slot]) continue;
+
+			GLint available = 0;
+			glGetQueryObjectiv(m_Queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available) break;
+
+			GLuint64 samples = 0;
+			glGetQueryObjectui64v(m_Queries[slot], GL_QUERY_RESULT, &samples);
+			m_LastSamples = (uint64_t)samples;
+			m_Pending[slot] = false;
+		}
+	}
+
+}
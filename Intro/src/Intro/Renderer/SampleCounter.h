@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <cstdint>
+
+namespace Intro {
+
+	// 统计一段绘制通过深度测试的样本数（GL_SAMPLES_PASSED）。
+	// 与 GPUProfiler 相同，查询在 FrameLatency 个槽位中轮换，只读取已经可用的结果，不等待 GPU；
+	// GL_SAMPLES_PASSED 同一时间只能有一个活动查询，Begin/End 之间不能再开始另一个计数器。
+	class ITR_API SampleCounter
+	{
+	public:
+		static constexpr uint32_t FrameLatency = 3;
+
+		SampleCounter() = default;
+		~SampleCounter();
+
+		SampleCounter(const SampleCounter&) = delete;
+		SampleCounter& operator=(const SampleCounter&) = delete;
+
+		void Begin();
+		void End();
+
+		// 最近一次可用的结果（还没有结果时为 0）
+		uint64_t GetSamples() const { return m_LastSamples; }
+
+	private:
+		void Resolve();
+
+		GLuint m_Queries[FrameLatency] = {};
+		bool m_Pending[FrameLatency] = {};
+		uint32_t m_Current = 0;
+		bool m_Active = false;
+		uint64_t m_LastSamples = 0;
+	};
+
+	// 作用域辅助：构造时 Begin，析构时 End
+	class SampleCounterScope
+	{
+	public:
+		explicit SampleCounterScope(SampleCounter& counter) : m_Counter(counter) { m_Counter.Begin(); }
+		~SampleCounterScope() { m_Counter.End(); }
+
+		SampleCounterScope(const SampleCounterScope&) = delete;
+		SampleCounterScope& operator=(const SampleCounterScope&) = delete;
+
+	private:
+		SampleCounter& m_Counter;
+	};
+
+}
@@ -2,63 +2,292 @@
 #include "Shader.h"
 #include <fstream>
 #include <iostream>
+#include <cstring>
 #include "glm/gtc/packing.inl"
 #include "Texture.h"
+#include "RenderState.h"
+#include "ShaderCache.h"
+#include <chrono>
+#include <filesystem>
 
 namespace Intro {
 
+	namespace {
+
+		constexpr int MaxIncludeDepth = 8;
+
+		// 展开 #include "file"（相对于当前文件所在目录），用于在多个着色器之间共享函数。
+		// 被包含的文件不能带 #version；展开后的源码参与 ShaderCache 的键，修改被包含文件会使缓存失效
+		bool ResolveIncludes(std::string& source, const std::filesystem::path& directory, int depth = 0)
+		{
+			if (depth > MaxIncludeDepth) {
+				std::cout << "ERROR::SHADER::INCLUDE_TOO_DEEP: " << directory.string() << std::endl;
+				return false;
+			}
+
+			std::stringstream input(source);
+			std::string output, line;
+			while (std::getline(input, line)) {
+				size_t start = line.find_first_not_of(" \t");
+				if (start == std::string::npos || line.compare(start, 8, "#include") != 0) {
+					output += line;
+					output += '\n';
+					continue;
+				}
+
+				size_t open = line.find('"', start);
+				size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+				if (close == std::string::npos) {
+					std::cout << "ERROR::SHADER::BAD_INCLUDE: " << line << std::endl;
+					return false;
+				}
+
+				std::filesystem::path includePath = directory / line.substr(open + 1, close - open - 1);
+				std::ifstream file(includePath);
+				if (!file) {
+					std::cout << "ERROR::SHADER::INCLUDE_NOT_FOUND: " << includePath.string() << std::endl;
+					return false;
+				}
+				std::stringstream stream;
+				stream << file.rdbuf();
+				std::string included = stream.str();
+				if (!ResolveIncludes(included, includePath.parent_path(), depth + 1)) return false;
+
+				output += included;
+				if (!included.empty() && included.back() != '\n') output += '\n';
+			}
+			source = std::move(output);
+			return true;
+		}
+
+	}
+
 	void Shader::Bind() const
 	{
-		glUseProgram(m_ShaderID);
+		RenderState::UseProgram(m_ShaderID);
 	}
 
 	void Shader::UnBind() const
 	{
-		glUseProgram(0);
+		RenderState::UseProgram(0);
 	}
 
+	uint64_t Shader::s_SkippedUniformUpdates = 0;
+
 	void Shader::SetUniformMat4(const std::string& name, const glm::mat4& value) const
 	{
-		int location = GetUniformLocation(name);
-		if (location != -1) {
-			glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
-		}
-		//else {
-		//	ITR_WARN("Uniform '{}' not found in shader {}", name, m_ShaderID);
-		//}
+		SetUniformMat4(GetUniformHandle(name.c_str()), value);
 	}
 
 	void Shader::SetUniformInt(const std::string& name, int value) const
 	{
-		int location = GetUniformLocation(name);
-		if (location != -1) {
-			glUniform1i(location, value);
-		}
-		//else {
-		//	ITR_WARN("Uniform '{}' not found in shader {}", name, m_ShaderID);
-		//}
+		SetUniformInt(GetUniformHandle(name.c_str()), value);
 	}
 
 	void Shader::SetUniformFloat(const std::string& name, float value) const
 	{
-		int location = GetUniformLocation(name);
-		if (location != -1) {
-			glUniform1f(location, value);
-		}
-		//else {
-		//	ITR_WARN("Uniform '{}' not found in shader {}", name, m_ShaderID);
-		//}
+		SetUniformFloat(GetUniformHandle(name.c_str()), value);
+	}
+
+	void Shader::SetUniformVec2(const std::string& name, const glm::vec2& value) const
+	{
+		SetUniformVec2(GetUniformHandle(name.c_str()), value);
 	}
 
 	void Shader::SetUniformVec3(const std::string& name, const glm::vec3& value) const
 	{
-		int location = GetUniformLocation(name);
-		if (location != -1) {
-			glUniform3f(location, value.x, value.y, value.z);
+		SetUniformVec3(GetUniformHandle(name.c_str()), value);
+	}
+
+	// 注意：句柄 setter 假设对应的 shader 已经 Bind（与原来的字符串接口一致）
+	void Shader::SetUniformInt(UniformHandle handle, int value) const
+	{
+		if (!UpdateCache(handle, &value, sizeof(value))) return;
+		glUniform1i(m_Reflection->uniforms[handle.index].location, value);
+	}
+
+	void Shader::SetUniformFloat(UniformHandle handle, float value) const
+	{
+		if (!UpdateCache(handle, &value, sizeof(value))) return;
+		glUniform1f(m_Reflection->uniforms[handle.index].location, value);
+	}
+
+	void Shader::SetUniformVec2(UniformHandle handle, const glm::vec2& value) const
+	{
+		if (!UpdateCache(handle, glm::value_ptr(value), sizeof(glm::vec2))) return;
+		glUniform2f(m_Reflection->uniforms[handle.index].location, value.x, value.y);
+	}
+
+	void Shader::SetUniformVec3(UniformHandle handle, const glm::vec3& value) const
+	{
+		if (!UpdateCache(handle, glm::value_ptr(value), sizeof(glm::vec3))) return;
+		glUniform3f(m_Reflection->uniforms[handle.index].location, value.x, value.y, value.z);
+	}
+
+	void Shader::SetUniformMat4(UniformHandle handle, const glm::mat4& value) const
+	{
+		if (!UpdateCache(handle, glm::value_ptr(value), sizeof(glm::mat4))) return;
+		glUniformMatrix4fv(m_Reflection->uniforms[handle.index].location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	bool Shader::UpdateCache(UniformHandle handle, const void* data, uint32_t size) const
+	{
+		if (!handle.IsValid()) return false;
+
+		UniformInfo& info = m_Reflection->uniforms[handle.index];
+		if (info.hasValue && std::memcmp(info.value, data, size) == 0) {
+			s_SkippedUniformUpdates++;
+			return false;
+		}
+
+		std::memcpy(info.value, data, size);
+		info.hasValue = true;
+		return true;
+	}
+
+	UniformHandle Shader::GetUniformHandle(uint32_t nameHash, const char* name) const
+	{
+		auto& uniforms = m_Reflection->uniforms;
+		auto& slots = m_Reflection->slots;
+		UniformHandle handle;
+		handle.index = FindUniform(nameHash, name);
+		if (handle.index >= 0 || !name || m_ShaderID == 0)
+			return handle;
+
+		// 反射表里只有数组的首元素（"arr[0]" 以及 "arr"），其它元素在首次查询时补充
+		if (std::strchr(name, '[') == nullptr)
+			return handle;
+
+		GLint location = glGetUniformLocation(m_ShaderID, name);
+		if (location < 0)
+			return handle;
+
+		UniformInfo info;
+		info.hash = nameHash;
+		info.name = name;
+		info.location = location;
+		info.count = 1;
+		uniforms.push_back(std::move(info));
+		handle.index = (int32_t)uniforms.size() - 1;
+
+		// 负载因子超过 1/2 时重建槽位
+		if (uniforms.size() * 2 > slots.size()) {
+			size_t slotCount = slots.empty() ? 16 : slots.size() * 2;
+			slots.assign(slotCount, -1);
+			for (int32_t i = 0; i < (int32_t)uniforms.size(); ++i)
+				InsertUniformSlot(i);
+		}
+		else {
+			InsertUniformSlot(handle.index);
+		}
+		return handle;
+	}
+
+	int32_t Shader::FindUniform(uint32_t nameHash, const char* name) const
+	{
+		auto& uniforms = m_Reflection->uniforms;
+		auto& slots = m_Reflection->slots;
+		if (slots.empty()) return -1;
+
+		const size_t mask = slots.size() - 1;
+		for (size_t slot = nameHash & mask;; slot = (slot + 1) & mask) {
+			int32_t index = slots[slot];
+			if (index < 0) return -1;
+
+			const UniformInfo& info = uniforms[index];
+			if (info.hash == nameHash && (!name || info.name == name))
+				return index;
+		}
+	}
+
+	void Shader::InsertUniformSlot(int32_t index) const
+	{
+		auto& uniforms = m_Reflection->uniforms;
+		auto& slots = m_Reflection->slots;
+		const size_t mask = slots.size() - 1;
+		size_t slot = uniforms[index].hash & mask;
+		while (slots[slot] >= 0)
+			slot = (slot + 1) & mask;
+		slots[slot] = index;
+	}
+
+	int Shader::GetUniformBlockIndex(const char* name) const
+	{
+		uint32_t hash = HashName(name);
+		for (const auto& block : m_Reflection->blocks) {
+			if (block.hash == hash && block.name == name)
+				return block.index;
+		}
+		return -1;
+	}
+
+	void Shader::ReflectUniforms()
+	{
+		auto& uniforms = m_Reflection->uniforms;
+		auto& slots = m_Reflection->slots;
+		auto& blocks = m_Reflection->blocks;
+		uniforms.clear();
+		slots.clear();
+		blocks.clear();
+
+		GLint uniformCount = 0;
+		GLint maxNameLength = 0;
+		glGetProgramiv(m_ShaderID, GL_ACTIVE_UNIFORMS, &uniformCount);
+		glGetProgramiv(m_ShaderID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+		std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+		uniforms.reserve(uniformCount + 8);
+
+		auto addUniform = [&uniforms](const std::string& name, GLint location, GLenum type, GLint count) {
+			UniformInfo info;
+			info.hash = HashName(name.c_str());
+			info.name = name;
+			info.location = location;
+			info.type = type;
+			info.count = count;
+			uniforms.push_back(std::move(info));
+		};
+
+		for (GLint i = 0; i < uniformCount; ++i) {
+			GLsizei length = 0;
+			GLint count = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_ShaderID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &count, &type, nameBuffer.data());
+
+			std::string name(nameBuffer.data(), length);
+			GLint location = glGetUniformLocation(m_ShaderID, name.c_str());
+			if (location < 0) continue; // uniform block 成员没有 location
+
+			addUniform(name, location, type, count);
+
+			// 数组同时注册不带 "[0]" 的名字
+			if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+				addUniform(name.substr(0, name.size() - 3), location, type, count);
+		}
+
+		size_t slotCount = 16;
+		while (slotCount < uniforms.size() * 2)
+			slotCount *= 2;
+		slots.assign(slotCount, -1);
+		for (int32_t i = 0; i < (int32_t)uniforms.size(); ++i)
+			InsertUniformSlot(i);
+
+		GLint blockCount = 0;
+		GLint maxBlockNameLength = 0;
+		glGetProgramiv(m_ShaderID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+		glGetProgramiv(m_ShaderID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxBlockNameLength);
+		nameBuffer.resize(std::max(maxBlockNameLength, 1));
+
+		for (GLint i = 0; i < blockCount; ++i) {
+			GLsizei length = 0;
+			glGetActiveUniformBlockName(m_ShaderID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, nameBuffer.data());
+
+			UniformBlockInfo block;
+			block.name.assign(nameBuffer.data(), length);
+			block.hash = HashName(block.name.c_str());
+			block.index = i;
+			blocks.push_back(std::move(block));
 		}
-		//else {
-		//	ITR_WARN("Uniform '{}' not found in shader {}", name, m_ShaderID);
-		//}
 	}
 
 	void Shader::CompileShader(const char* vertexShaderPath, const char* fragmentShaderPath)
@@ -87,31 +316,46 @@ namespace Intro {
 		catch (std::ifstream::failure& e)
 		{
 			std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << e.what() << std::endl;
-			// ӸϸĴϢ
+			// 添加更详细的错误信息
 			std::cout << "Vertex shader path: " << vertexShaderPath << std::endl;
 			std::cout << "Fragment shader path: " << fragmentShaderPath << std::endl;
-			return; // Ҫļȡʧʱֱӷأմ
+			return; // 重要：文件读取失败时直接返回，避免后续编译空代码
 		}
 
-		// ļǷΪ
+		// 检查文件内容是否为空
 		if (VertexCode.empty() || FragmentCode.empty()) {
 			std::cout << "ERROR::SHADER::FILE_IS_EMPTY" << std::endl;
 			return;
 		}
 
+		if (!ResolveIncludes(VertexCode, std::filesystem::path(vertexShaderPath).parent_path()) ||
+			!ResolveIncludes(FragmentCode, std::filesystem::path(fragmentShaderPath).parent_path())) {
+			return;
+		}
+
+		// 先尝试磁盘缓存中链接好的二进制，命中时跳过编译与链接
+		const uint64_t cacheKey = ShaderCache::ComputeKey(VertexCode, FragmentCode);
+		m_ShaderID = glCreateProgram();
+		if (ShaderCache::Load(m_ShaderID, cacheKey)) {
+			ReflectUniforms();
+			return;
+		}
+		// 被拒绝的 program 处于链接失败状态，换一个新的 program 重新编译
+		glDeleteProgram(m_ShaderID);
+		auto compileStart = std::chrono::steady_clock::now();
+
 		const char* VertexShaderCode = VertexCode.c_str();
 		const char* FragmentShaderCode = FragmentCode.c_str();
 
-
 		unsigned int vertexID, fragmentID;
 		int success;
 		char infoLog[512];
 
-		//ɫ
+		//顶点着色器
 		vertexID = glCreateShader(GL_VERTEX_SHADER);
 		glShaderSource(vertexID, 1, &VertexShaderCode, NULL);
 		glCompileShader(vertexID);
-		//
+		//输出编译错误
 		glGetShaderiv(vertexID, GL_COMPILE_STATUS, &success);
 		if (!success)
 		{
@@ -119,11 +363,11 @@ namespace Intro {
 			std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 		}
 
-		//Ƭɫ
+		//片段着色器
 		fragmentID = glCreateShader(GL_FRAGMENT_SHADER);
 		glShaderSource(fragmentID, 1, &FragmentShaderCode, NULL);
 		glCompileShader(fragmentID);
-		//
+		//输出编译错误
 		glGetShaderiv(fragmentID, GL_COMPILE_STATUS, &success);
 		if (!success)
 		{
@@ -134,6 +378,7 @@ namespace Intro {
 		m_ShaderID = glCreateProgram();
 		glAttachShader(m_ShaderID, vertexID);
 		glAttachShader(m_ShaderID, fragmentID);
+		ShaderCache::PrepareForLink(m_ShaderID);
 		glLinkProgram(m_ShaderID);
 		glGetProgramiv(m_ShaderID, GL_LINK_STATUS, &success);
 		if (!success) {
@@ -143,6 +388,12 @@ namespace Intro {
 
 		glDeleteShader(vertexID);
 		glDeleteShader(fragmentID);
+
+		if (success) {
+			float compileMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - compileStart).count();
+			ShaderCache::Store(m_ShaderID, cacheKey, compileMs);
+			ReflectUniforms();
+		}
 	}
 
 	int Shader::GetUniformLocation(const std::string& name) const
@@ -151,6 +402,7 @@ namespace Intro {
 			ITR_ERROR("Attempting to get uniform location for invalid shader program: {}", name);
 			return -1;
 		}
-		return glGetUniformLocation(m_ShaderID, name.c_str());
+		UniformHandle handle = GetUniformHandle(name.c_str());
+		return handle.IsValid() ? m_Reflection->uniforms[handle.index].location : -1;
 	}
 }
\ No newline at end of file
@@ -1,15 +1,37 @@
 #pragma once
 #include "Intro/Core.h"
 #include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
 #include "glm/glm.hpp"
 #include <glad/glad.h>
 #include "Intro/Log.h"
 
 namespace Intro {
 
+	// uniform 句柄：反射表中的下标，-1 表示该 uniform 不存在（或未被使用而被编译器优化掉）
+	struct UniformHandle
+	{
+		int32_t index = -1;
+		bool IsValid() const { return index >= 0; }
+	};
+
 	class ITR_API Shader
 	{
 	public:
+		// FNV-1a 名称哈希，可在编译期预先计算（例如 static constexpr uint32_t h = Shader::HashName("u_Metallic")）
+		static constexpr uint32_t HashName(const char* name)
+		{
+			uint32_t hash = 2166136261u;
+			while (*name)
+			{
+				hash ^= static_cast<uint8_t>(*name++);
+				hash *= 16777619u;
+			}
+			return hash;
+		}
+
 		Shader(const char* vertexShaderPath, const char* fragmentShaderPath)
 		{ 
 			CompileShader(vertexShaderPath, fragmentShaderPath);
@@ -25,8 +47,26 @@ namespace Intro {
 		void SetUniformMat4(const std::string& name, const glm::mat4& value) const;
 		void SetUniformInt(const std::string& name, int value) const;
 		void SetUniformFloat(const std::string& name, float value) const;
+		void SetUniformVec2(const std::string& name, const glm::vec2& value) const;
 		void SetUniformVec3(const std::string& name, const glm::vec3& value) const;
 
+		// 基于反射表的句柄接口：查询只在哈希表中进行，不访问驱动
+		UniformHandle GetUniformHandle(uint32_t nameHash, const char* name = nullptr) const;
+		UniformHandle GetUniformHandle(const char* name) const { return GetUniformHandle(HashName(name), name); }
+
+		// 句柄 setter：值与缓存相同时跳过 glUniform* 调用
+		void SetUniformInt(UniformHandle handle, int value) const;
+		void SetUniformFloat(UniformHandle handle, float value) const;
+		void SetUniformVec2(UniformHandle handle, const glm::vec2& value) const;
+		void SetUniformVec3(UniformHandle handle, const glm::vec3& value) const;
+		void SetUniformMat4(UniformHandle handle, const glm::mat4& value) const;
+
+		// uniform block 索引（-1 表示不存在）
+		int GetUniformBlockIndex(const char* name) const;
+
+		// 被缓存过滤掉的冗余 glUniform* 调用次数
+		static uint64_t GetSkippedUniformUpdates() { return s_SkippedUniformUpdates; }
+
 		void CheckShaderCompileStatus(GLuint shader, const std::string& type) {
 			GLint success;
 			GLchar infoLog[1024];
@@ -50,8 +90,45 @@ namespace Intro {
 	private:
 		void CompileShader(const char* vertexShaderPath, const char* fragmentShaderPath);
 
+		// 链接后一次性反射所有活动 uniform 与 uniform block
+		void ReflectUniforms();
+		int32_t FindUniform(uint32_t nameHash, const char* name) const;
+		void InsertUniformSlot(int32_t index) const;
+		// 比较并更新缓存；返回 true 表示值发生变化需要提交给 GL
+		bool UpdateCache(UniformHandle handle, const void* data, uint32_t size) const;
+
+		struct UniformInfo
+		{
+			uint32_t hash = 0;
+			std::string name;
+			GLint location = -1;
+			GLenum type = 0;
+			GLint count = 0;
+			bool hasValue = false;
+			float value[16] = {};	// 最近一次设置的值（最大 mat4）
+		};
+
+		struct UniformBlockInfo
+		{
+			uint32_t hash = 0;
+			std::string name;
+			GLint index = -1;
+		};
+
 	private:
-		unsigned int m_ShaderID;
+		unsigned int m_ShaderID = 0;
+
+		// 扁平哈希表：slots 为开放寻址槽，存 uniforms 下标（-1 为空）
+		// 值缓存属于 GL program，Shader 被拷贝时共享同一份反射数据，避免缓存与实际状态不一致
+		struct ReflectionData
+		{
+			std::vector<UniformInfo> uniforms;
+			std::vector<int32_t> slots;
+			std::vector<UniformBlockInfo> blocks;
+		};
+		std::shared_ptr<ReflectionData> m_Reflection = std::make_shared<ReflectionData>();
+
+		static uint64_t s_SkippedUniformUpdates;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "itrpch.h"
+#include "ShaderCache.h"
+#include "Renderer.h"
+#include "Intro/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Intro {
+
+	namespace {
+
+		constexpr uint32_t CacheMagic = 0x53525449;	// "ITRS"
+		constexpr uint32_t CacheVersion = 1;
+
+		struct FileHeader {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t key;
+			uint32_t format;
+			uint32_t size;
+			float compileMs;
+			uint32_t reserved;
+		};
+		static_assert(sizeof(FileHeader) == 32, "ShaderCache file header layout changed");
+
+		struct ShaderCacheData {
+			std::string directory = ShaderCache::DefaultDirectory;
+			bool capabilityChecked = false;
+			bool supported = false;
+			std::string driver;		// 参与键计算的驱动标识
+			ShaderCache::Statistics stats;
+		};
+
+		ShaderCacheData s_Data;
+
+		uint64_t HashBytes(uint64_t hash, const char* data, size_t size)
+		{
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= static_cast<uint8_t>(data[i]);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		const char* GetGLString(GLenum name)
+		{
+			const GLubyte* value = glGetString(name);
+			return value ? reinterpret_cast<const char*>(value) : "";
+		}
+
+		void CheckCapability()
+		{
+			if (s_Data.capabilityChecked) return;
+			s_Data.capabilityChecked = true;
+
+			GLint formatCount = 0;
+			if (GLAD_GL_VERSION_4_1)
+				glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+			s_Data.supported = formatCount > 0;
+
+			s_Data.driver = std::string(GetGLString(GL_VENDOR)) + "|" + GetGLString(GL_RENDERER) + "|" + GetGLString(GL_VERSION);
+			if (!s_Data.supported)
+				ITR_WARN("ShaderCache: driver exposes no program binary formats, shader cache disabled");
+		}
+
+		std::filesystem::path GetCachePath(uint64_t key)
+		{
+			char name[32];
+			std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+			return std::filesystem::path(s_Data.directory) / name;
+		}
+
+		float ElapsedMs(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+	}
+
+	void ShaderCache::SetDirectory(const std::string& directory)
+	{
+		s_Data.directory = directory;
+	}
+
+	const std::string& ShaderCache::GetDirectory()
+	{
+		return s_Data.directory;
+	}
+
+	bool ShaderCache::IsEnabled()
+	{
+		if (!Renderer::GetConfig().enableShaderCache) return false;
+		CheckCapability();
+		return s_Data.supported;
+	}
+
+	uint64_t ShaderCache::ComputeKey(const std::string& vertexSource, const std::string& fragmentSource)
+	{
+		CheckCapability();
+
+		// 各段之间插入长度，避免不同切分方式拼出相同的字节序列
+		uint64_t hash = 14695981039346656037ull;
+		auto append = [&hash](const std::string& text) {
+			uint64_t length = text.size();
+			hash = HashBytes(hash, reinterpret_cast<const char*>(&length), sizeof(length));
+			hash = HashBytes(hash, text.data(), text.size());
+		};
+		append(vertexSource);
+		append(fragmentSource);
+		append(s_Data.driver);
+		hash = HashBytes(hash, reinterpret_cast<const char*>(&CacheVersion), sizeof(CacheVersion));
+		return hash;
+	}
+
+	bool ShaderCache::Load(GLuint program, uint64_t key)
+	{
+		if (!IsEnabled() || program == 0) return false;
+
+		auto start = std::chrono::steady_clock::now();
+		std::filesystem::path path = GetCachePath(key);
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			s_Data.stats.misses++;
+			return false;
+		}
+
+		FileHeader header{};
+		std::vector<char> binary;
+		bool valid = false;
+		if (file.read(reinterpret_cast<char*>(&header), sizeof(header))
+			&& header.magic == CacheMagic && header.version == CacheVersion && header.key == key && header.size > 0) {
+			binary.resize(header.size);
+			valid = (bool)file.read(binary.data(), header.size);
+		}
+		file.close();
+
+		if (!valid) {
+			ITR_WARN("ShaderCache: ignoring corrupt cache file {}", path.string());
+			s_Data.stats.misses++;
+			return false;
+		}
+
+		glProgramBinary(program, (GLenum)header.format, binary.data(), (GLsizei)header.size);
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (!linked) {
+			// 驱动更新后格式不再兼容等情况：回退到编译，随后 Store 覆盖该文件
+			ITR_WARN("ShaderCache: driver rejected cached binary {}, recompiling", path.string());
+			s_Data.stats.rejected++;
+			s_Data.stats.misses++;
+			return false;
+		}
+
+		float ms = ElapsedMs(start);
+		s_Data.stats.hits++;
+		s_Data.stats.loadMs += ms;
+		s_Data.stats.savedMs += std::max(header.compileMs - ms, 0.0f);
+		return true;
+	}
+
+	void ShaderCache::PrepareForLink(GLuint program)
+	{
+		if (!IsEnabled() || program == 0) return;
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	void ShaderCache::Store(GLuint program, uint64_t key, float compileMs)
+	{
+		s_Data.stats.compileMs += compileMs;
+		if (!IsEnabled() || program == 0) return;
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0) return;
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		GLsizei written = 0;
+		glGetProgramBinary(program, length, &written, &format, binary.data());
+		if (written <= 0) return;
+
+		std::error_code ec;
+		std::filesystem::create_directories(s_Data.directory, ec);
+		if (ec) {
+			ITR_WARN("ShaderCache: cannot create cache directory {}: {}", s_Data.directory, ec.message());
+			return;
+		}
+
+		FileHeader header{};
+		header.magic = CacheMagic;
+		header.version = CacheVersion;
+		header.key = key;
+		header.format = (uint32_t)format;
+		header.size = (uint32_t)written;
+		header.compileMs = compileMs;
+
+		// 先写临时文件再替换，进程中途退出不会留下截断的缓存
+		std::filesystem::path path = GetCachePath(key);
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) || !file.write(binary.data(), written)) {
+				ITR_WARN("ShaderCache: failed to write {}", tempPath.string());
+				file.close();
+				std::filesystem::remove(tempPath, ec);
+				return;
+			}
+		}
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec) {
+			ITR_WARN("ShaderCache: failed to store {}: {}", path.string(), ec.message());
+			std::filesystem::remove(tempPath, ec);
+			return;
+		}
+		s_Data.stats.stores++;
+	}
+
+	const ShaderCache::Statistics& ShaderCache::GetStats()
+	{
+		return s_Data.stats;
+	}
+
+	void ShaderCache::LogStatistics()
+	{
+		const Statistics& stats = s_Data.stats;
+		if (!IsEnabled()) {
+			ITR_INFO("ShaderCache: disabled, compiled shaders in {:.1f} ms", stats.compileMs);
+			return;
+		}
+		ITR_INFO("ShaderCache: {} hits, {} misses ({} rejected), {} stored; load {:.1f} ms, compile {:.1f} ms, saved ~{:.1f} ms",
+			stats.hits, stats.misses, stats.rejected, stats.stores, stats.loadMs, stats.compileMs, stats.savedMs);
+	}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+namespace Intro {
+
+	// 链接后程序二进制的磁盘缓存：
+	// - 键 = 着色器源码 + 驱动（GL_VENDOR / GL_RENDERER / GL_VERSION）的 64 位 FNV-1a 哈希，源码或驱动变化后自然失效
+	// - 每个程序一个文件 <目录>/<键>.bin，头部记录键、二进制格式与当初编译链接的耗时（用于估算节省的时间）
+	// - 驱动拒绝二进制（glProgramBinary 后链接状态为失败）时由调用方回退到编译，并用新结果覆盖缓存文件
+	// 需要 GL 4.1 且驱动至少支持一种二进制格式，否则整个缓存不生效
+	class ITR_API ShaderCache
+	{
+	public:
+		static constexpr const char* DefaultDirectory = "ShaderCache";
+
+		static void SetDirectory(const std::string& directory);
+		static const std::string& GetDirectory();
+
+		// 根据 RendererConfig::enableShaderCache 与驱动能力判断
+		static bool IsEnabled();
+
+		static uint64_t ComputeKey(const std::string& vertexSource, const std::string& fragmentSource);
+
+		// 尝试把缓存的二进制载入 program；返回 true 表示 program 已可用（已链接）
+		static bool Load(GLuint program, uint64_t key);
+		// 链接前调用，提示驱动保留可取回的二进制
+		static void PrepareForLink(GLuint program);
+		// 把已链接的 program 写入缓存；compileMs 为本次编译 + 链接的耗时
+		static void Store(GLuint program, uint64_t key, float compileMs);
+
+		struct Statistics {
+			uint32_t hits = 0;
+			uint32_t misses = 0;
+			uint32_t rejected = 0;		// 文件存在但被驱动拒绝（计入 misses）
+			uint32_t stores = 0;
+			float loadMs = 0.0f;		// 命中时载入二进制的总耗时
+			float compileMs = 0.0f;		// 未命中时编译链接的总耗时
+			float savedMs = 0.0f;		// 命中时 (当初编译耗时 - 载入耗时) 之和
+		};
+		static const Statistics& GetStats();
+		static void LogStatistics();
+	};
+
+}
@@ -0,0 +1,583 @@
+#include "itrpch.h"
+#include "ShadowMaps.h"
+#include "Renderer.h"
+#include "RenderState.h"
+#include "GPUProfiler.h"
+#include "Shader.h"
+#include "Mesh.h"
+#include "Model.h"
+#include "Cameras/Camera.h"
+#include "Cameras/Frustum.h"
+#include "Intro/Application.h"
+#include "Intro/RecourceManager/ShaderLibrary.h"
+#include "Intro/ECS/ECS.h"
+#include "Intro/ECS/Components.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Intro {
+
+	namespace {
+
+		// 图集中每块的分辨率（聚光灯 1 块，点光源每个面 1 块）
+		constexpr uint32_t AtlasTileSize = 512;
+		constexpr float LocalShadowNear = 0.05f;
+		constexpr float DepthBias = 0.0005f;
+		constexpr float NormalBiasTexels = 1.5f;
+
+		// 点光源六个面：+X -X +Y -Y +Z -Z（与 shader 中按主轴选面的顺序一致）
+		const glm::vec3 CubeFaceDirections[6] = {
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+		};
+		const glm::vec3 CubeFaceUps[6] = {
+			{ 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f },
+			{ 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }
+		};
+
+		const char* const CascadeScopeNames[MAX_SHADOW_CASCADES] = { "Cascade 0", "Cascade 1", "Cascade 2", "Cascade 3" };
+
+		uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		uint64_t CombineHash(uint64_t seed, uint64_t value)
+		{
+			return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+		}
+
+		glm::vec3 UpVectorFor(const glm::vec3& direction)
+		{
+			return std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+
+		// 深度比较纹理：线性过滤即硬件 2x2 PCF，超出范围按无阴影处理
+		void SetShadowSamplerParams(GLenum target)
+		{
+			const float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+			glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+			glTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, border);
+			glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+			glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+		}
+
+		bool IsTransparentCaster(entt::registry& reg, entt::entity entity)
+		{
+			if (auto* material = reg.try_get<MaterialComponent>(entity))
+				return !material->material || material->Transparent;
+			if (auto* pbr = reg.try_get<PBRMaterialComponent>(entity))
+				return !pbr->material || pbr->Transparent;
+			return true;	// 没有材质的物体不会被绘制，也不投射阴影
+		}
+	}
+
+	ShadowMaps::ShadowMaps()
+	{
+		m_DepthShader = Application::GetShaderLibrary().Get("shadowDepthShader");
+
+		glGenFramebuffers(1, &m_Framebuffer);
+		glGenBuffers(1, &m_UniformBuffer);
+		glGenBuffers(1, &m_LocalShadowBuffer);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, m_UniformBuffer);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(ShadowUBOData), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	ShadowMaps::~ShadowMaps()
+	{
+		DestroyTextures();
+		if (m_Framebuffer) RenderState::DeleteFramebuffers(1, &m_Framebuffer);
+		if (m_UniformBuffer) glDeleteBuffers(1, &m_UniformBuffer);
+		if (m_LocalShadowBuffer) glDeleteBuffers(1, &m_LocalShadowBuffer);
+	}
+
+	void ShadowMaps::EnsureTextures(uint32_t cascadeSize, uint32_t atlasSize)
+	{
+		atlasSize = std::max(atlasSize / AtlasTileSize, 1u) * AtlasTileSize;
+		if (cascadeSize == m_CascadeSize && atlasSize == m_AtlasSize) return;
+
+		DestroyTextures();
+
+		glGenTextures(1, &m_CascadeTexture);
+		RenderState::BindTexture(GL_TEXTURE_2D_ARRAY, m_CascadeTexture);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, (GLsizei)cascadeSize, (GLsizei)cascadeSize,
+			(GLsizei)MAX_SHADOW_CASCADES, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+		SetShadowSamplerParams(GL_TEXTURE_2D_ARRAY);
+		RenderState::BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		glGenTextures(1, &m_AtlasTexture);
+		RenderState::BindTexture(GL_TEXTURE_2D, m_AtlasTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, (GLsizei)atlasSize, (GLsizei)atlasSize,
+			0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+		SetShadowSamplerParams(GL_TEXTURE_2D);
+		RenderState::BindTexture(GL_TEXTURE_2D, 0);
+
+		// 只有深度附件
+		GLuint previous = RenderState::GetFramebuffer();
+		RenderState::BindFramebuffer(m_Framebuffer);
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+		RenderState::BindFramebuffer(previous);
+
+		m_CascadeSize = cascadeSize;
+		m_AtlasSize = atlasSize;
+		m_TilesPerRow = atlasSize / AtlasTileSize;
+
+		// 纹理重建后缓存的内容全部失效
+		for (auto& cascade : m_Cascades) cascade.valid = false;
+		m_LocalShadows.clear();
+		m_FreeTiles.clear();
+		uint32_t tileCount = m_TilesPerRow * m_TilesPerRow;
+		for (uint32_t tile = tileCount; tile-- > 0;)
+			m_FreeTiles.push_back(tile);
+
+		m_UBOData.texel = glm::vec4(1.0f / (float)cascadeSize, 1.0f / (float)atlasSize, DepthBias, NormalBiasTexels);
+	}
+
+	void ShadowMaps::DestroyTextures()
+	{
+		if (m_CascadeTexture) RenderState::DeleteTextures(1, &m_CascadeTexture);
+		if (m_AtlasTexture) RenderState::DeleteTextures(1, &m_AtlasTexture);
+		m_CascadeTexture = 0;
+		m_AtlasTexture = 0;
+		m_CascadeSize = 0;
+		m_AtlasSize = 0;
+	}
+
+	int32_t ShadowMaps::GetLocalShadowIndex(uint32_t entity) const
+	{
+		auto it = m_LocalShadows.find(entity);
+		return it != m_LocalShadows.end() ? it->second.gpuIndex : -1;
+	}
+
+	void ShadowMaps::Update(ECS& ecs, Camera& camera)
+	{
+		const RendererConfig& config = Renderer::GetConfig();
+		m_Frame++;
+		m_CascadeUpdates.clear();
+		m_LocalUpdates.clear();
+		m_LocalShadowData.clear();
+		m_Stats = Statistics();
+
+		EnsureTextures(config.shadowMapSize, config.shadowAtlasSize);
+		m_Stats.atlasTiles = m_TilesPerRow * m_TilesPerRow;
+
+		if (config.enableShadows) {
+			CollectCasters(ecs);
+			UpdateCascades(ecs, camera);
+			UpdateLocalShadows(ecs, camera);
+		}
+		else {
+			m_Casters.clear();
+			m_DirectionalEntity = UINT32_MAX;
+			m_UBOData.params = glm::ivec4(0);
+			for (auto& [entity, shadow] : m_LocalShadows) ReleaseTiles(shadow);
+			m_LocalShadows.clear();
+		}
+
+		m_Stats.casterCount = (uint32_t)m_Casters.size();
+		m_Stats.cascadeUpdates = (uint32_t)m_CascadeUpdates.size();
+		m_Stats.localUpdates = (uint32_t)m_LocalUpdates.size();
+		m_Stats.usedAtlasTiles = m_Stats.atlasTiles - (uint32_t)m_FreeTiles.size();
+		Upload();
+	}
+
+	void ShadowMaps::CollectCasters(ECS& ecs)
+	{
+		m_Casters.clear();
+		auto& reg = ecs.GetRegistry();
+
+		auto addCaster = [&](const std::shared_ptr<Mesh>& mesh, const glm::mat4& transform, const BoundingSphere& sphere) {
+			Caster caster;
+			caster.mesh = mesh;
+			caster.transform = transform;
+			caster.sphere = sphere;
+			const Mesh* meshPtr = mesh.get();
+			caster.hash = HashBytes(HashBytes(14695981039346656037ull, &meshPtr, sizeof(meshPtr)), &transform, sizeof(glm::mat4));
+			m_Casters.push_back(std::move(caster));
+		};
+
+		// 单个 Mesh 直接使用缓存的世界包围球（同时带 Model 时缓存的是 Model 的包围体）；Model 的子 Mesh 各自变换
+		auto meshView = reg.view<LocalToWorldComponent, MeshComponent>();
+		for (auto [entity, ltw, meshComp] : meshView.each()) {
+			if (!meshComp.mesh || IsTransparentCaster(reg, entity)) continue;
+			bool cachedSphere = !reg.all_of<ModelComponent>(entity);
+			addCaster(meshComp.mesh, ltw.matrix, cachedSphere ? ltw.worldSphere : meshComp.mesh->GetBoundingSphere().Transformed(ltw.matrix));
+		}
+
+		auto modelView = reg.view<LocalToWorldComponent, ModelComponent>();
+		for (auto [entity, ltw, modelComp] : modelView.each()) {
+			if (!modelComp.model || IsTransparentCaster(reg, entity)) continue;
+			const glm::mat4& transform = ltw.matrix;
+			for (const auto& mesh : modelComp.model->GetMeshes()) {
+				if (mesh) addCaster(mesh, transform, mesh->GetBoundingSphere().Transformed(transform));
+			}
+		}
+	}
+
+	void ShadowMaps::UpdateCascades(ECS& ecs, Camera& camera)
+	{
+		const RendererConfig& config = Renderer::GetConfig();
+
+		// 只有第一个投射阴影的方向光使用级联
+		m_DirectionalEntity = UINT32_MAX;
+		glm::vec3 lightDirection(0.0f, -1.0f, 0.0f);
+		auto view = ecs.GetRegistry().view<LocalToWorldComponent, LightComponent>();
+		for (auto [entity, ltw, light] : view.each()) {
+			if (light.Type != LightType::Directional || !light.CastShadows) continue;
+			m_DirectionalEntity = (uint32_t)entity;
+			lightDirection = ltw.TransformDirection(glm::normalize(light.Direction));
+			break;
+		}
+
+		uint32_t cascadeCount = std::clamp(config.shadowCascadeCount, 1u, MAX_SHADOW_CASCADES);
+		m_UBOData.params = glm::ivec4((int)cascadeCount, m_DirectionalEntity != UINT32_MAX ? 1 : 0, 0, 0);
+		m_Stats.cascadeCount = cascadeCount;
+		if (m_DirectionalEntity == UINT32_MAX) return;
+
+		// 划分方案：均匀划分与对数划分按 lambda 插值（practical split scheme）
+		float cameraNear = camera.GetNearClip();
+		float cameraFar = camera.GetFarClip();
+		float shadowFar = std::clamp(config.shadowDistance, cameraNear * 2.0f, cameraFar);
+		float lambda = std::clamp(config.shadowSplitLambda, 0.0f, 1.0f);
+
+		float splits[MAX_SHADOW_CASCADES] = {};
+		for (uint32_t i = 0; i < cascadeCount; ++i) {
+			float p = (float)(i + 1) / (float)cascadeCount;
+			float logSplit = cameraNear * std::pow(shadowFar / cameraNear, p);
+			float uniformSplit = cameraNear + (shadowFar - cameraNear) * p;
+			splits[i] = glm::mix(uniformSplit, logSplit, lambda);
+			m_Stats.cascadeSplits[i] = splits[i];
+		}
+
+		// 相机视锥的 8 个角；视线上的点与视图深度成线性关系，按深度插值得到各级联的角点
+		glm::mat4 inverseViewProj = glm::inverse(camera.GetProjectionMat() * camera.GetViewMat());
+		glm::vec3 nearCorners[4], farCorners[4];
+		for (int i = 0; i < 4; ++i) {
+			glm::vec2 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f);
+			glm::vec4 n = inverseViewProj * glm::vec4(ndc, -1.0f, 1.0f);
+			glm::vec4 f = inverseViewProj * glm::vec4(ndc, 1.0f, 1.0f);
+			nearCorners[i] = glm::vec3(n) / n.w;
+			farCorners[i] = glm::vec3(f) / f.w;
+		}
+		auto cornerAt = [&](int i, float depth) {
+			float t = (depth - cameraNear) / (cameraFar - cameraNear);
+			return nearCorners[i] + (farCorners[i] - nearCorners[i]) * t;
+		};
+
+		// 光源视图以原点为中心，级联中心在这个空间中按纹素对齐
+		glm::mat4 lightView = glm::lookAt(glm::vec3(0.0f), lightDirection, UpVectorFor(lightDirection));
+
+		for (uint32_t c = 0; c < cascadeCount; ++c) {
+			Cascade& cascade = m_Cascades[c];
+			float splitNear = c == 0 ? cameraNear : splits[c - 1];
+			float splitFar = splits[c];
+
+			glm::vec3 corners[8];
+			glm::vec3 center(0.0f);
+			for (int i = 0; i < 4; ++i) {
+				corners[i] = cornerAt(i, splitNear);
+				corners[i + 4] = cornerAt(i, splitFar);
+			}
+			for (const glm::vec3& corner : corners) center += corner;
+			center /= 8.0f;
+
+			// 包围球半径只取决于投影与划分，取整后相机旋转不会改变级联尺寸
+			float radius = 0.0f;
+			for (const glm::vec3& corner : corners) radius = std::max(radius, glm::length(corner - center));
+			radius = std::ceil(radius * 16.0f) / 16.0f;
+
+			float texelSize = 2.0f * radius / (float)m_CascadeSize;
+			glm::vec3 lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+			lightCenter = glm::floor(lightCenter / texelSize) * texelSize;
+
+			// 投射体剔除：xy 与级联相交，且不在接收体的背后（光源空间中光沿 -z 方向）
+			cascade.casters.clear();
+			uint64_t casterHash = 0;
+			float casterTop = lightCenter.z + radius;
+			for (uint32_t i = 0; i < (uint32_t)m_Casters.size(); ++i) {
+				const BoundingSphere& sphere = m_Casters[i].sphere;
+				glm::vec3 p = glm::vec3(lightView * glm::vec4(sphere.center, 1.0f));
+				float reach = radius + sphere.radius;
+				if (std::abs(p.x - lightCenter.x) > reach || std::abs(p.y - lightCenter.y) > reach) continue;
+				if (p.z + sphere.radius < lightCenter.z - radius) continue;
+
+				cascade.casters.push_back(i);
+				casterHash = CombineHash(casterHash, m_Casters[i].hash);
+				casterTop = std::max(casterTop, p.z + sphere.radius);
+			}
+
+			glm::mat4 projection = glm::ortho(lightCenter.x - radius, lightCenter.x + radius,
+				lightCenter.y - radius, lightCenter.y + radius, -casterTop, -(lightCenter.z - radius));
+			glm::mat4 viewProj = projection * lightView;
+
+			if (!cascade.valid || viewProj != cascade.viewProj || casterHash != cascade.casterHash) {
+				cascade.viewProj = viewProj;
+				cascade.casterHash = casterHash;
+				cascade.valid = true;
+				m_CascadeUpdates.push_back(c);
+			}
+
+			m_UBOData.cascadeViewProj[c] = viewProj;
+			m_UBOData.cascadeSplits[c] = splitFar;
+			m_UBOData.cascadeTexelSize[c] = texelSize;
+		}
+	}
+
+	void ShadowMaps::UpdateLocalShadows(ECS& ecs, Camera& camera)
+	{
+		const RendererConfig& config = Renderer::GetConfig();
+		glm::vec3 cameraPosition = camera.GetPosition();
+
+		struct Candidate {
+			uint32_t entity;
+			float distance;
+			uint32_t faceCount;
+			glm::vec3 position;
+			glm::vec3 direction;
+			float range;
+			float spotAngle;
+		};
+		std::vector<Candidate> candidates;
+
+		auto view = ecs.GetRegistry().view<LocalToWorldComponent, LightComponent>();
+		for (auto [entity, ltw, light] : view.each()) {
+			if (light.Type == LightType::Directional || !light.CastShadows || light.Range <= LocalShadowNear) continue;
+
+			Candidate candidate;
+			candidate.entity = (uint32_t)entity;
+			candidate.position = ltw.GetPosition();
+			candidate.direction = ltw.TransformDirection(glm::normalize(light.Direction));
+			candidate.range = light.Range;
+			candidate.spotAngle = light.SpotAngle;
+			candidate.faceCount = light.Type == LightType::Point ? 6u : 1u;
+			candidate.distance = std::max(glm::length(candidate.position - cameraPosition) - light.Range, 0.0f);
+			candidates.push_back(candidate);
+		}
+
+		// 离相机近的光源优先占用图集；放不下的光源没有阴影
+		std::sort(candidates.begin(), candidates.end(),
+			[](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+
+		uint32_t availableTiles = m_TilesPerRow * m_TilesPerRow;
+		std::vector<const Candidate*> selected;
+		for (const Candidate& candidate : candidates) {
+			if (candidate.faceCount > availableTiles) continue;
+			availableTiles -= candidate.faceCount;
+			selected.push_back(&candidate);
+		}
+
+		// 先释放不再需要阴影（或类型改变）的光源，再为新光源分配
+		for (const Candidate* candidate : selected) {
+			auto it = m_LocalShadows.find(candidate->entity);
+			if (it != m_LocalShadows.end() && it->second.faceCount == candidate->faceCount)
+				it->second.lastSeenFrame = m_Frame;
+		}
+		for (auto it = m_LocalShadows.begin(); it != m_LocalShadows.end();) {
+			if (it->second.lastSeenFrame != m_Frame) {
+				ReleaseTiles(it->second);
+				it = m_LocalShadows.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
+		struct PendingUpdate {
+			LocalUpdate update;
+			bool neverRendered;
+			float distance;
+		};
+		std::vector<PendingUpdate> pending;
+
+		for (const Candidate* candidate : selected) {
+			LocalShadow& shadow = m_LocalShadows[candidate->entity];
+			if (shadow.lastSeenFrame != m_Frame) {
+				shadow.faceCount = candidate->faceCount;
+				for (uint32_t f = 0; f < shadow.faceCount; ++f) {
+					shadow.tiles[f] = m_FreeTiles.back();
+					m_FreeTiles.pop_back();
+				}
+				shadow.lastSeenFrame = m_Frame;
+			}
+			shadow.position = candidate->position;
+			shadow.range = candidate->range;
+
+			// 目标矩阵
+			if (shadow.faceCount == 6) {
+				glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, LocalShadowNear, candidate->range);
+				for (uint32_t f = 0; f < 6; ++f) {
+					shadow.targetViewProj[f] = projection *
+						glm::lookAt(candidate->position, candidate->position + CubeFaceDirections[f], CubeFaceUps[f]);
+				}
+			}
+			else {
+				float fov = std::clamp(candidate->spotAngle * 2.0f, 1.0f, 170.0f);
+				glm::mat4 projection = glm::perspective(glm::radians(fov), 1.0f, LocalShadowNear, candidate->range);
+				shadow.targetViewProj[0] = projection *
+					glm::lookAt(candidate->position, candidate->position + candidate->direction, UpVectorFor(candidate->direction));
+			}
+
+			// 光源范围内的投射体
+			shadow.casters.clear();
+			shadow.casterHash = 0;
+			for (uint32_t i = 0; i < (uint32_t)m_Casters.size(); ++i) {
+				const BoundingSphere& sphere = m_Casters[i].sphere;
+				float reach = candidate->range + sphere.radius;
+				glm::vec3 offset = sphere.center - candidate->position;
+				if (glm::dot(offset, offset) > reach * reach) continue;
+				shadow.casters.push_back(i);
+				shadow.casterHash = CombineHash(shadow.casterHash, m_Casters[i].hash);
+			}
+
+			for (uint32_t f = 0; f < shadow.faceCount; ++f) {
+				bool dirty = !shadow.rendered[f] || shadow.renderedViewProj[f] != shadow.targetViewProj[f] ||
+					shadow.renderedHash[f] != shadow.casterHash;
+				if (dirty)
+					pending.push_back({ { candidate->entity, f }, !shadow.rendered[f], candidate->distance });
+			}
+		}
+
+		// 预算内按优先级更新：还没有内容的块优先，其次是离相机近的光源
+		std::sort(pending.begin(), pending.end(), [](const PendingUpdate& a, const PendingUpdate& b) {
+			if (a.neverRendered != b.neverRendered) return a.neverRendered;
+			return a.distance < b.distance;
+		});
+
+		uint32_t budget = std::min((uint32_t)pending.size(), config.shadowUpdateBudget);
+		for (uint32_t i = 0; i < budget; ++i) {
+			const LocalUpdate& update = pending[i].update;
+			LocalShadow& shadow = m_LocalShadows[update.entity];
+			shadow.renderedViewProj[update.face] = shadow.targetViewProj[update.face];
+			shadow.renderedHash[update.face] = shadow.casterHash;
+			shadow.rendered[update.face] = true;
+			m_LocalUpdates.push_back(update);
+		}
+		m_Stats.pendingLocalUpdates = (uint32_t)pending.size() - budget;
+		m_Stats.shadowedLocalLights = (uint32_t)m_LocalShadows.size();
+
+		// GPU 数据使用图集中实际内容对应的矩阵（推迟更新的块继续使用旧矩阵，阴影与内容保持一致）
+		for (auto& [entity, shadow] : m_LocalShadows) {
+			shadow.gpuIndex = (int32_t)m_LocalShadowData.size();
+			for (uint32_t f = 0; f < shadow.faceCount; ++f) {
+				LocalShadowGPU gpu;
+				gpu.viewProj = shadow.renderedViewProj[f];
+				gpu.atlasRect = shadow.rendered[f] ? GetTileRect(shadow.tiles[f]) : glm::vec4(0.0f);
+				m_LocalShadowData.push_back(gpu);
+			}
+		}
+	}
+
+	void ShadowMaps::ReleaseTiles(LocalShadow& shadow)
+	{
+		for (uint32_t f = 0; f < shadow.faceCount; ++f)
+			m_FreeTiles.push_back(shadow.tiles[f]);
+		shadow.faceCount = 0;
+	}
+
+	glm::vec4 ShadowMaps::GetTileRect(uint32_t tile) const
+	{
+		float scale = 1.0f / (float)m_TilesPerRow;
+		return glm::vec4((float)(tile % m_TilesPerRow) * scale, (float)(tile / m_TilesPerRow) * scale, scale, scale);
+	}
+
+	void ShadowMaps::Upload()
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_UniformBuffer);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ShadowUBOData), &m_UBOData);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		size_t bytes = m_LocalShadowData.size() * sizeof(LocalShadowGPU);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_LocalShadowBuffer);
+		if (bytes > m_LocalShadowCapacity) m_LocalShadowCapacity = std::max(bytes, m_LocalShadowCapacity * 2);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizeiptr)std::max<size_t>(m_LocalShadowCapacity, sizeof(LocalShadowGPU)), nullptr, GL_STREAM_DRAW);
+		if (bytes > 0) glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, (GLsizeiptr)bytes, m_LocalShadowData.data());
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	}
+
+	void ShadowMaps::Bind() const
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, SHADOW_UBO_BINDING, m_UniformBuffer);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LOCAL_SHADOW_SSBO_BINDING, m_LocalShadowBuffer);
+		RenderState::BindTexture(SHADOW_CASCADE_TEXTURE_UNIT, GL_TEXTURE_2D_ARRAY, m_CascadeTexture);
+		RenderState::BindTexture(SHADOW_ATLAS_TEXTURE_UNIT, GL_TEXTURE_2D, m_AtlasTexture);
+	}
+
+	void ShadowMaps::DrawCasters(const std::vector<uint32_t>& casters, const glm::mat4& viewProj)
+	{
+		constexpr uint32_t kLightViewProj = Shader::HashName("u_LightViewProj");
+
+		m_DepthShader->Bind();
+		m_DepthShader->SetUniformMat4(m_DepthShader->GetUniformHandle(kLightViewProj, "u_LightViewProj"), viewProj);
+
+		Frustum frustum;
+		frustum.UpdateFromMatrix(viewProj);
+		for (uint32_t index : casters) {
+			const Caster& caster = m_Casters[index];
+			if (!frustum.ContainsSphere(caster.sphere.center, caster.sphere.radius)) continue;
+			Renderer::Submit(m_DepthShader, caster.mesh, caster.transform);
+		}
+		Renderer::Flush();
+	}
+
+	void ShadowMaps::Render()
+	{
+		if (!HasPendingWork() || !m_DepthShader) return;
+
+		bool prevDepthTest = RenderState::IsDepthTestEnabled();
+		bool prevDepthMask = RenderState::IsDepthMaskEnabled();
+		RenderState::SetDepthTest(true);
+		RenderState::SetDepthMask(true);
+		RenderState::BindFramebuffer(m_Framebuffer);
+
+		// RenderState 不跟踪多边形偏移与裁剪，在本函数内开启并在结束前关闭
+		glEnable(GL_POLYGON_OFFSET_FILL);
+		glPolygonOffset(1.5f, 2.0f);
+
+		const float clearDepth = 1.0f;
+		if (!m_CascadeUpdates.empty()) {
+			GPUProfileScope scope("Shadow Cascades");
+			RenderState::SetViewport(0, 0, (GLsizei)m_CascadeSize, (GLsizei)m_CascadeSize);
+			for (uint32_t c : m_CascadeUpdates) {
+				GPUProfileScope cascadeScope(CascadeScopeNames[c]);
+				glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_CascadeTexture, 0, (GLint)c);
+				glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+				DrawCasters(m_Cascades[c].casters, m_Cascades[c].viewProj);
+			}
+		}
+
+		if (!m_LocalUpdates.empty()) {
+			GPUProfileScope scope("Shadow Atlas");
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_AtlasTexture, 0);
+			glEnable(GL_SCISSOR_TEST);
+			for (const LocalUpdate& update : m_LocalUpdates) {
+				const LocalShadow& shadow = m_LocalShadows[update.entity];
+				uint32_t tile = shadow.tiles[update.face];
+				GLint x = (GLint)((tile % m_TilesPerRow) * AtlasTileSize);
+				GLint y = (GLint)((tile / m_TilesPerRow) * AtlasTileSize);
+
+				RenderState::SetViewport(x, y, (GLsizei)AtlasTileSize, (GLsizei)AtlasTileSize);
+				glScissor(x, y, (GLsizei)AtlasTileSize, (GLsizei)AtlasTileSize);
+				glClearBufferfv(GL_DEPTH, 0, &clearDepth);
+				DrawCasters(shadow.casters, shadow.renderedViewProj[update.face]);
+			}
+			glDisable(GL_SCISSOR_TEST);
+		}
+
+		glDisable(GL_POLYGON_OFFSET_FILL);
+		RenderState::SetDepthTest(prevDepthTest);
+		RenderState::SetDepthMask(prevDepthMask);
+	}
+
+}
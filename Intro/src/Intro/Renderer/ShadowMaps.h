@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include "RenderConstant.h"
+#include "Bounds.h"
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Intro {
+
+	class ECS;
+	class Camera;
+	class Mesh;
+	class Shader;
+
+	// 方向光级联阴影参数（与 shader 中 std140 的 ShadowUBO 布局一致）
+	struct alignas(16) ShadowUBOData
+	{
+		glm::mat4 cascadeViewProj[MAX_SHADOW_CASCADES];
+		glm::vec4 cascadeSplits;	// 各级联远端的视图空间深度
+		glm::vec4 cascadeTexelSize;	// 各级联一个纹素对应的世界空间尺寸（法线偏移用）
+		glm::ivec4 params;			// x = 级联数, y = 是否有方向光阴影
+		glm::vec4 texel;			// x = 1 / 级联分辨率, y = 1 / 图集分辨率, z = 深度偏移, w = 法线偏移（纹素倍数）
+	};
+	static_assert(sizeof(ShadowUBOData) == 320, "ShadowUBOData must match the std140 layout in the shaders");
+
+	// 点光源/聚光灯阴影（std430），点光源占 6 个连续条目（+X -X +Y -Y +Z -Z）
+	struct LocalShadowGPU
+	{
+		glm::mat4 viewProj;
+		glm::vec4 atlasRect;		// xy = 图集中的偏移, zw = 尺寸（z 为 0 表示这一块还没有内容）
+	};
+	static_assert(sizeof(LocalShadowGPU) == 80, "LocalShadowGPU must match the std430 layout in the shaders");
+
+	// 阴影贴图：
+	// - 第一个 CastShadows 的方向光使用级联阴影（深度纹理数组，每级联一层）。级联按视图深度划分，
+	//   包围球的中心在光源空间按纹素对齐；只有对齐后的矩阵变化、或级联内投射体的变换/集合变化时才重绘
+	// - 点光源/聚光灯的阴影放在一张深度图集中（固定大小的块，聚光灯 1 块，点光源 6 块），
+	//   按与相机的距离分配块；需要更新的块按优先级排序，每帧最多更新 shadowUpdateBudget 块，其余保留上次的内容
+	// Update 在 CPU 上决定本帧要重绘哪些阴影，Render 在渲染图的阴影通道中执行
+	class ITR_API ShadowMaps
+	{
+	public:
+		ShadowMaps();
+		~ShadowMaps();
+
+		ShadowMaps(const ShadowMaps&) = delete;
+		ShadowMaps& operator=(const ShadowMaps&) = delete;
+
+		void Update(ECS& ecs, Camera& camera);
+		void Render();
+		// 绑定 UBO / SSBO 与两张阴影纹理
+		void Bind() const;
+
+		bool HasPendingWork() const { return !m_CascadeUpdates.empty() || !m_LocalUpdates.empty(); }
+
+		// 使用级联阴影的方向光实体（没有时为 UINT32_MAX）
+		uint32_t GetDirectionalShadowEntity() const { return m_DirectionalEntity; }
+		// 点光源/聚光灯在 LocalShadowGPU 数组中的起始下标（没有分配到阴影时为 -1）
+		int32_t GetLocalShadowIndex(uint32_t entity) const;
+
+		struct Statistics {
+			uint32_t cascadeCount = 0;
+			float cascadeSplits[MAX_SHADOW_CASCADES] = {};
+			uint32_t cascadeUpdates = 0;		// 本帧重绘的级联
+			uint32_t localUpdates = 0;			// 本帧重绘的图集块
+			uint32_t pendingLocalUpdates = 0;	// 超出预算、推迟到之后帧的图集块
+			uint32_t shadowedLocalLights = 0;
+			uint32_t usedAtlasTiles = 0;
+			uint32_t atlasTiles = 0;
+			uint32_t casterCount = 0;
+		};
+		const Statistics& GetStats() const { return m_Stats; }
+
+	private:
+		struct Caster {
+			std::shared_ptr<Mesh> mesh;
+			glm::mat4 transform;
+			BoundingSphere sphere;		// 世界空间
+			uint64_t hash;				// Mesh + 变换，用于检测投射体是否变化
+		};
+
+		struct Cascade {
+			glm::mat4 viewProj = glm::mat4(0.0f);
+			uint64_t casterHash = 0;
+			bool valid = false;
+			std::vector<uint32_t> casters;
+		};
+
+		struct LocalShadow {
+			uint32_t faceCount = 0;
+			std::array<uint32_t, 6> tiles{};
+			std::array<glm::mat4, 6> targetViewProj;		// 本帧应有的矩阵
+			std::array<glm::mat4, 6> renderedViewProj;		// 图集中当前内容对应的矩阵
+			std::array<uint64_t, 6> renderedHash{};
+			std::array<bool, 6> rendered{};
+			uint64_t casterHash = 0;
+			std::vector<uint32_t> casters;				// 与光源范围相交的投射体
+			glm::vec3 position = glm::vec3(0.0f);
+			float range = 0.0f;
+			int32_t gpuIndex = -1;
+			uint64_t lastSeenFrame = 0;
+		};
+
+		struct LocalUpdate {
+			uint32_t entity;
+			uint32_t face;
+		};
+
+		void EnsureTextures(uint32_t cascadeSize, uint32_t atlasSize);
+		void DestroyTextures();
+		void CollectCasters(ECS& ecs);
+		void UpdateCascades(ECS& ecs, Camera& camera);
+		void UpdateLocalShadows(ECS& ecs, Camera& camera);
+		void ReleaseTiles(LocalShadow& shadow);
+		glm::vec4 GetTileRect(uint32_t tile) const;
+		void DrawCasters(const std::vector<uint32_t>& casters, const glm::mat4& viewProj);
+		void Upload();
+
+		std::shared_ptr<Shader> m_DepthShader;
+		std::vector<Caster> m_Casters;
+
+		// 方向光级联
+		GLuint m_CascadeTexture = 0;
+		uint32_t m_CascadeSize = 0;
+		uint32_t m_DirectionalEntity = UINT32_MAX;
+		std::array<Cascade, MAX_SHADOW_CASCADES> m_Cascades;
+		std::vector<uint32_t> m_CascadeUpdates;
+
+		// 点光源/聚光灯图集
+		GLuint m_AtlasTexture = 0;
+		uint32_t m_AtlasSize = 0;
+		uint32_t m_TilesPerRow = 0;
+		std::vector<uint32_t> m_FreeTiles;
+		std::unordered_map<uint32_t, LocalShadow> m_LocalShadows;
+		std::vector<LocalUpdate> m_LocalUpdates;
+		std::vector<LocalShadowGPU> m_LocalShadowData;
+
+		GLuint m_Framebuffer = 0;
+		GLuint m_UniformBuffer = 0;
+		GLuint m_LocalShadowBuffer = 0;
+		size_t m_LocalShadowCapacity = 0;
+		ShadowUBOData m_UBOData{};
+		uint64_t m_Frame = 0;
+
+		Statistics m_Stats;
+	};
+
+}
@@ -12,7 +12,7 @@ namespace Intro {
 
         float h = size / 2.0f;
 
-        // ÿ 4 㣨24 㣩ÿ㶼ȷķ
+        // 每个面独立 4 顶点（24 顶点），每顶点都有正确的法线
         vertices = {
             // front (+Z)
             Vertex(glm::vec3(-h, -h,  h), glm::vec3(0,0,1), glm::vec2(0,0)),
@@ -51,7 +51,7 @@ namespace Intro {
             Vertex(glm::vec3(-h, -h,  h), glm::vec3(0,-1,0), glm::vec2(0,1)),
         };
 
-        // ÿ 2 Σ֤ CCW泯⣩
+        // 每面 2 三角形，保证 CCW（面朝外）
         indices = {
             0,1,2, 2,3,0,       // front
             4,5,6, 6,7,4,       // back
@@ -74,7 +74,7 @@ namespace Intro {
         float stackStep = glm::pi<float>() / stacks;
         float sectorAngle, stackAngle;
 
-        // ɶ
+        // 生成顶点
         for (int i = 0; i <= stacks; ++i) {
             stackAngle = glm::pi<float>() / 2.0f - i * stackStep;
             float xy = radius * cosf(stackAngle);
@@ -95,7 +95,7 @@ namespace Intro {
             }
         }
 
-        // 
+        // 生成索引
         unsigned int k1, k2;
         for (int i = 0; i < stacks; ++i) {
             k1 = i * (sectors + 1);
@@ -129,7 +129,7 @@ namespace Intro {
         float halfWidth = width / 2.0f;
         float halfHeight = height / 2.0f;
 
-        // ɶ
+        // 生成顶点
         for (int y = 0; y <= ySegments; ++y) {
             for (int x = 0; x <= xSegments; ++x) {
                 float xPos = -halfWidth + x * xStep;
@@ -143,7 +143,7 @@ namespace Intro {
             }
         }
 
-        // 
+        // 生成索引
         unsigned int vertexCountX = xSegments + 1;
         for (int y = 0; y < ySegments; ++y) {
             for (int x = 0; x < xSegments; ++x) {
@@ -152,7 +152,7 @@ namespace Intro {
                 unsigned int bottomLeft = (y + 1) * vertexCountX + x;
                 unsigned int bottomRight = bottomLeft + 1;
 
-                // Ϸ (normal = +Y) Ϊ CCW
+                // 从上方 (normal = +Y) 看为 CCW
                 indices.push_back(topLeft);
                 indices.push_back(topRight);
                 indices.push_back(bottomRight);
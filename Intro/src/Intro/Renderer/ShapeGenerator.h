@@ -10,13 +10,13 @@ namespace Intro {
     class ITR_API ShapeGenerator
     {
     public:
-        // 
+        // 生成立方体
         static std::pair<std::vector<Vertex>, std::vector<unsigned int>> GenerateCube(float size = 1.0f);
 
-        // 
+        // 生成球体
         static std::pair<std::vector<Vertex>, std::vector<unsigned int>> GenerateSphere(float radius = 1.0f, int sectors = 36, int stacks = 18);
 
-        // ƽ
+        // 生成平面
         static std::pair<std::vector<Vertex>, std::vector<unsigned int>> GeneratePlane(float width = 1.0f, float height = 1.0f, int xSegments = 1, int ySegments = 1);
     };
 
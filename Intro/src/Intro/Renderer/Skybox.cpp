@@ -1,12 +1,13 @@
 #include "itrpch.h"
 #include "Skybox.h"
+#include "RenderState.h"
 #include <glad/glad.h>
 #include "stb_image.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace Intro {
 
-    // պж
+    // 天空盒顶点数据
     float skyboxVertices[] = {
         -1.0f,  1.0f, -1.0f,
         -1.0f, -1.0f, -1.0f,
@@ -52,15 +53,15 @@ namespace Intro {
     };
 
     Skybox::Skybox(const std::vector<std::string>& facePaths) {
-        // facePathsǷЧ
+        // 检查facePaths是否有效
         if (facePaths.size() != 6) {
             ITR_ERROR("Skybox requires exactly 6 face paths, got {}", facePaths.size());
             throw std::runtime_error("Invalid number of skybox face paths");
         }
 
-        // պɫ
+        // 创建天空盒着色器
         try {
-            // ȷɫļ
+            // 确保着色器文件存在
             std::string vertexPath = "E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/skyboxShader.vert";
             std::string fragmentPath = "E:/MyEngine/Intro/Intro/src/Intro/assets/shaders/skyboxShader.frag";
 
@@ -77,30 +78,30 @@ namespace Intro {
             throw;
         }
 
-        // ͼ
+        // 加载立方体贴图
         LoadCubemap(facePaths);
 
-        // պм
+        // 设置天空盒几何体
         SetupSkybox();
 
         ITR_INFO("Skybox initialized successfully with texture: {}", m_CubemapTexture);
     }
 
     Skybox::~Skybox() {
-        glDeleteVertexArrays(1, &m_VAO);
+        RenderState::DeleteVertexArrays(1, &m_VAO);
         glDeleteBuffers(1, &m_VBO);
-        glDeleteTextures(1, &m_CubemapTexture);
+        RenderState::DeleteTextures(1, &m_CubemapTexture);
     }
 
     void Skybox::LoadCubemap(const std::vector<std::string>& facePaths) {
         glGenTextures(1, &m_CubemapTexture);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_CubemapTexture);
+        RenderState::BindTexture(GL_TEXTURE_CUBE_MAP, m_CubemapTexture);
 
         int width, height, nrChannels;
-        stbi_set_flip_vertically_on_load(false); // պͨҪת
+        stbi_set_flip_vertically_on_load(false); // 天空盒通常不需要翻转
 
         for (unsigned int i = 0; i < facePaths.size(); i++) {
-            // ļǷ
+            // 检查文件是否存在
             if (!std::filesystem::exists(facePaths[i])) {
                 ITR_ERROR("Skybox texture not found: {}", facePaths[i]);
                 continue;
@@ -124,14 +125,14 @@ namespace Intro {
             }
         }
 
-        // 
+        // 设置纹理参数
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        RenderState::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
         ITR_INFO("Skybox cubemap created: {}", m_CubemapTexture);
     }
 
@@ -139,14 +140,14 @@ namespace Intro {
         glGenVertexArrays(1, &m_VAO);
         glGenBuffers(1, &m_VBO);
 
-        glBindVertexArray(m_VAO);
+        RenderState::BindVertexArray(m_VAO);
         glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(skyboxVertices), &skyboxVertices, GL_STATIC_DRAW);
 
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
 
-        glBindVertexArray(0);
+        RenderState::BindVertexArray(0);
     }
 
     void Skybox::Draw(const glm::mat4& view, const glm::mat4& projection) {
@@ -160,44 +161,40 @@ namespace Intro {
             return;
         }
 
-        // 浱ǰ״̬
-        GLint oldDepthFunc;
-        glGetIntegerv(GL_DEPTH_FUNC, &oldDepthFunc);
-        GLboolean oldDepthMask;
-        glGetBooleanv(GL_DEPTH_WRITEMASK, &oldDepthMask);
+        // 保存当前状态（读取 RenderState 缓存，不访问驱动）
+        GLenum oldDepthFunc = RenderState::GetDepthFunc();
+        bool oldDepthMask = RenderState::IsDepthMaskEnabled();
 
-        // պȾ״̬
-        glDepthFunc(GL_LEQUAL);  // ȷȲͨ
-        glDepthMask(GL_FALSE);   // д
+        // 设置天空盒渲染状态
+        RenderState::SetDepthFunc(GL_LEQUAL);  // 确保深度测试通过
+        RenderState::SetDepthMask(false);      // 禁用深度写入
 
         m_Shader->Bind();
 
-        // ɫ
+        // 检查着色器程序
         GLuint program = m_Shader->GetShaderID();
         if (program == 0) {
             ITR_ERROR("Skybox shader program is invalid");
             return;
         }
 
-        // uniform
+        // 设置uniform
         m_Shader->SetUniformMat4("view", view);
         m_Shader->SetUniformMat4("projection", projection);
 
-        // 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, m_CubemapTexture);
+        // 绑定纹理
+        RenderState::BindTexture(0, GL_TEXTURE_CUBE_MAP, m_CubemapTexture);
         m_Shader->SetUniformInt("skybox", 0);
 
-        // պ
-        glBindVertexArray(m_VAO);
+        // 绘制天空盒
+        RenderState::BindVertexArray(m_VAO);
         glDrawArrays(GL_TRIANGLES, 0, 36);
-        glBindVertexArray(0);
 
-        // ָ״̬
-        glDepthFunc(oldDepthFunc);
-        glDepthMask(oldDepthMask);
+        // 恢复状态
+        RenderState::SetDepthFunc(oldDepthFunc);
+        RenderState::SetDepthMask(oldDepthMask);
 
-        // OpenGL
+        // 检查OpenGL错误
         GLenum error = glGetError();
         if (error != GL_NO_ERROR) {
             ITR_ERROR("OpenGL error in Skybox::Draw: 0x%x", error);
@@ -1,5 +1,6 @@
 #include "itrpch.h"
 #include "Texture.h"
+#include "RenderState.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -11,17 +12,17 @@ namespace Intro {
 	{
 
 		if (!std::filesystem::exists(filepath)) {
-			std::cout << "ļ: " << filepath << std::endl;
-			throw std::runtime_error("ļ: " + filepath);
+			std::cout << "纹理文件不存在: " << filepath << std::endl;
+			throw std::runtime_error("纹理文件不存在: " + filepath);
 		}
 
 		glGenTextures(1, &m_TextureID);
 		
-		stbi_set_flip_vertically_on_load(true);  // ؼ޸ת
+		stbi_set_flip_vertically_on_load(true);  // 关键修复：翻转纹理坐标
 		unsigned char* imageData = stbi_load(filepath.c_str(), &m_Width, &m_Height, &m_BPP, 0);
 		if (imageData)
 		{
-			GLenum format;
+			GLenum format = GL_RGBA;
 			if (m_BPP == 1)
 				format = GL_RED;
 			else if (m_BPP == 3)
@@ -29,9 +30,16 @@ namespace Intro {
 			else if (m_BPP == 4)
 				format = GL_RGBA;
 
+			// 使用带尺寸的内部格式，便于复制到 TextureArrayPool 的纹理数组中
+			if (m_BPP == 1)
+				m_InternalFormat = GL_R8;
+			else if (m_BPP == 3)
+				m_InternalFormat = GL_RGB8;
+			else if (m_BPP == 4)
+				m_InternalFormat = GL_RGBA8;
 
-			glBindTexture(GL_TEXTURE_2D, m_TextureID);
-			glTexImage2D(GL_TEXTURE_2D, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, imageData);
+			RenderState::BindTexture(GL_TEXTURE_2D, m_TextureID);
+			glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat ? m_InternalFormat : format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, imageData);
 			glGenerateMipmap(GL_TEXTURE_2D);
 
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -46,22 +54,22 @@ namespace Intro {
 
 		stbi_image_free(imageData);
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderState::BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	Texture::~Texture()
 	{
-		glDeleteTextures(1, &m_TextureID);
+		RenderState::DeleteTextures(1, &m_TextureID);
 	}
 
 	void Texture::Bind(unsigned int slot) const
 	{
-		glBindTexture(GL_TEXTURE_2D, m_TextureID);
+		RenderState::BindTexture(slot, GL_TEXTURE_2D, m_TextureID);
 	}
 
 	void Texture::UnBind() const
 	{
-		glBindTexture(GL_TEXTURE_2D, 0);
+		RenderState::BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 
@@ -19,6 +19,8 @@ namespace Intro {
 		inline int GetWidth() const { return m_Width; }
 		inline int GetHeight() const { return m_Height; }
 		inline unsigned int GetID() const { return m_TextureID; }
+		// 带尺寸的内部格式（R8/RGB8/RGBA8），加载失败时为 0
+		inline GLenum GetInternalFormat() const { return m_InternalFormat; }
 		inline const std::string& GetType() const { return m_Type; }
 		inline void SetType(const std::string& type) { m_Type = type; }
 
@@ -27,6 +29,7 @@ namespace Intro {
 		std::string m_FilePath;
 		unsigned char* m_LocalBuffer;
 		int m_Width, m_Height, m_BPP;
+		GLenum m_InternalFormat = 0;
 		std::string m_Type;
 	};
 
@@ -0,0 +1,166 @@
+#include "itrpch.h"
+#include "TextureArrayPool.h"
+#include "Texture.h"
+#include "RenderState.h"
+#include "Intro/Log.h"
+#include <cmath>
+
+namespace Intro {
+
+	namespace {
+
+		struct ArrayBucket
+		{
+			GLsizei width = 0;
+			GLsizei height = 0;
+			GLenum internalFormat = 0;
+			GLsizei levels = 1;
+			GLuint texture = 0;
+			uint32_t capacity = 0;
+			uint32_t nextLayer = 0;
+			std::vector<int32_t> freeLayers;
+		};
+
+		struct PoolEntry
+		{
+			TextureArraySlot slot;
+			uint32_t refCount = 0;
+		};
+
+		std::vector<ArrayBucket> s_Buckets;
+		std::unordered_map<GLuint, PoolEntry> s_Entries;	// 源纹理 ID -> 所在层
+
+		GLuint CreateArrayTexture(const ArrayBucket& bucket, uint32_t capacity)
+		{
+			GLuint texture = 0;
+			glGenTextures(1, &texture);
+			RenderState::BindTexture(GL_TEXTURE_2D_ARRAY, texture);
+			glTexStorage3D(GL_TEXTURE_2D_ARRAY, bucket.levels, bucket.internalFormat, bucket.width, bucket.height, (GLsizei)capacity);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			RenderState::BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+			return texture;
+		}
+
+		// 层数用完：创建两倍容量的新数组，把已有各层（含所有 mip）复制过去
+		void GrowBucket(ArrayBucket& bucket)
+		{
+			uint32_t newCapacity = std::max(bucket.capacity * 2, 4u);
+			GLuint newTexture = CreateArrayTexture(bucket, newCapacity);
+
+			if (bucket.texture) {
+				for (GLsizei level = 0; level < bucket.levels; ++level) {
+					GLsizei w = std::max(bucket.width >> level, 1);
+					GLsizei h = std::max(bucket.height >> level, 1);
+					glCopyImageSubData(bucket.texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+						newTexture, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, w, h, (GLsizei)bucket.capacity);
+				}
+				RenderState::DeleteTextures(1, &bucket.texture);
+			}
+
+			bucket.texture = newTexture;
+			bucket.capacity = newCapacity;
+		}
+
+		int32_t FindOrCreateBucket(GLsizei width, GLsizei height, GLenum internalFormat)
+		{
+			for (size_t i = 0; i < s_Buckets.size(); ++i) {
+				const ArrayBucket& bucket = s_Buckets[i];
+				if (bucket.width == width && bucket.height == height && bucket.internalFormat == internalFormat)
+					return (int32_t)i;
+			}
+
+			ArrayBucket bucket;
+			bucket.width = width;
+			bucket.height = height;
+			bucket.internalFormat = internalFormat;
+			// 与 glGenerateMipmap 生成的完整 mip 链一致
+			bucket.levels = 1 + (GLsizei)std::floor(std::log2((float)std::max(width, height)));
+			s_Buckets.push_back(bucket);
+			return (int32_t)(s_Buckets.size() - 1);
+		}
+	}
+
+	TextureArraySlot TextureArrayPool::Acquire(const Texture& texture)
+	{
+		auto it = s_Entries.find(texture.GetID());
+		if (it != s_Entries.end()) {
+			it->second.refCount++;
+			return it->second.slot;
+		}
+
+		// 加载失败的纹理或不支持 glCopyImageSubData（GL 4.3）时不进入数组池
+		if (texture.GetWidth() <= 0 || texture.GetHeight() <= 0 || texture.GetInternalFormat() == 0 || !GLAD_GL_VERSION_4_3)
+			return TextureArraySlot();
+
+		int32_t bucketIndex = FindOrCreateBucket(texture.GetWidth(), texture.GetHeight(), texture.GetInternalFormat());
+		ArrayBucket& bucket = s_Buckets[bucketIndex];
+
+		int32_t layer;
+		if (!bucket.freeLayers.empty()) {
+			layer = bucket.freeLayers.back();
+			bucket.freeLayers.pop_back();
+		}
+		else {
+			if (bucket.nextLayer >= bucket.capacity)
+				GrowBucket(bucket);
+			layer = (int32_t)bucket.nextLayer++;
+		}
+
+		// 逐级复制源纹理的 mip 到目标层（GPU 端拷贝，不经过 CPU）
+		for (GLsizei level = 0; level < bucket.levels; ++level) {
+			GLsizei w = std::max(bucket.width >> level, 1);
+			GLsizei h = std::max(bucket.height >> level, 1);
+			glCopyImageSubData(texture.GetID(), GL_TEXTURE_2D, level, 0, 0, 0,
+				bucket.texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, w, h, 1);
+		}
+
+		PoolEntry entry;
+		entry.slot.bucket = bucketIndex;
+		entry.slot.layer = layer;
+		entry.refCount = 1;
+		s_Entries[texture.GetID()] = entry;
+		return entry.slot;
+	}
+
+	void TextureArrayPool::Release(const Texture& texture)
+	{
+		auto it = s_Entries.find(texture.GetID());
+		if (it == s_Entries.end()) return;
+
+		if (--it->second.refCount == 0) {
+			const TextureArraySlot& slot = it->second.slot;
+			if (slot.bucket < (int32_t)s_Buckets.size())
+				s_Buckets[slot.bucket].freeLayers.push_back(slot.layer);
+			s_Entries.erase(it);
+		}
+	}
+
+	GLuint TextureArrayPool::GetTexture(int32_t bucket)
+	{
+		if (bucket < 0 || bucket >= (int32_t)s_Buckets.size()) return 0;
+		return s_Buckets[bucket].texture;
+	}
+
+	void TextureArrayPool::Shutdown()
+	{
+		for (auto& bucket : s_Buckets) {
+			if (bucket.texture) RenderState::DeleteTextures(1, &bucket.texture);
+		}
+		s_Buckets.clear();
+		s_Entries.clear();
+	}
+
+	uint32_t TextureArrayPool::GetArrayCount()
+	{
+		return (uint32_t)s_Buckets.size();
+	}
+
+	uint32_t TextureArrayPool::GetLayerCount()
+	{
+		return (uint32_t)s_Entries.size();
+	}
+
+}
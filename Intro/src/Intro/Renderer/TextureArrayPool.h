@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Intro/Core.h"
+#include <glad/glad.h>
+#include <cstdint>
+
+namespace Intro {
+
+	class Texture;
+
+	// 纹理在数组池中的位置：bucket 为数组编号（扩容后保持不变），layer 为层号
+	struct TextureArraySlot
+	{
+		int32_t bucket = -1;
+		int32_t layer = -1;
+
+		bool IsValid() const { return bucket >= 0 && layer >= 0; }
+	};
+
+	// 纹理数组池：尺寸与格式相同的 2D 纹理复制到同一个 GL_TEXTURE_2D_ARRAY 的不同层。
+	// 材质只需记录层号，共享同一组数组的材质之间切换时无需重新绑定纹理。
+	// 同一个 Texture 被多个材质使用时只占一层（按引用计数释放）。
+	class ITR_API TextureArrayPool
+	{
+	public:
+		static TextureArraySlot Acquire(const Texture& texture);
+		static void Release(const Texture& texture);
+
+		// bucket 当前对应的数组纹理（扩容会替换纹理对象，因此每次绑定时查询）
+		static GLuint GetTexture(int32_t bucket);
+
+		static void Shutdown();
+
+		static uint32_t GetArrayCount();
+		static uint32_t GetLayerCount();
+	};
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "UBO.h"
 #include "RenderConstant.h"
+#include "LightClusters.h"
+#include "ShadowMaps.h"
 #include "Cameras/Camera.h"
 #include "Intro/ECS/Components.h"
 #include "Intro/ECS/ECS.h"
@@ -18,53 +20,30 @@ namespace Intro{
         float _pad2;       // 4   // fill to 16 bytes block
     };
     static_assert(sizeof(CameraUBOData) == 160, "");
-    // ʹʽ벢ȷ std140 
+    // 使用显式对齐并确保 std140 语义
     struct alignas(16) DirLightGPU {
         glm::vec4 direction; // 16 bytes
-        glm::vec4 color;     // 16 bytes (rgb=color, w=intensity)
+        glm::vec4 color;     // 16 bytes (rgb=color*intensity, w=1 使用级联阴影)
         // total 32
     };
 
-    struct alignas(16) PointLightGPU {
-        glm::vec4 position;  // xyz=pos, w=range
-        glm::vec4 color;     // rgb=color, w=intensity
-        // total 32
-    };
-
-    struct alignas(16) SpotLightGPU {
-        glm::vec4 position;  // xyz=pos, w=range
-        glm::vec4 direction; // xyz=direction, w=outerCos (semantic)
-        glm::vec4 color;     // rgb=color, w=intensity
-        glm::vec4 params;    // x=innerCos, y=unused, z=unused, w=unused (or as you like)
-        // total 64
-    };
-
     struct alignas(16) LightsUBOData
     {
-        // GLSL: int numDir; int numPoint; int numSpot; vec2 pad;
-        // std140 ǰ int ǰ 12 ֽڣΪú vec2  8 ֽڶ벢 next array ʼ 16 ıϣ
-        // ʽ 4 ֽ䣬ʹǰ 16 ֽ롣
-        int numDir;    // 4
-        int numPoint;  // 4
-        int numSpot;   // 4
-        int _pad0;     // 4  <-- explicit pad to make next member start at offset 16
-
-        // shader had vec2 pad; in std140 it will occupy 8 bytes within a 16-byte slot.
-        // We store it in a vec4 to occupy the full slot and keep alignment explicit and stable.
-        glm::vec4 pad; // use .xy if you need only vec2, but occupy 16 bytes for safety.
-
-        // Now the lights arrays begin at offset 32 (std140 expectation).
-        std::array<DirLightGPU, MAX_DIR_LIGHTS> dirLights;   // 4 * 32 = 128
-        std::array<PointLightGPU, MAX_POINT_LIGHTS> pointLights; // 8 * 32 = 256
-        std::array<SpotLightGPU, MAX_SPOT_LIGHTS> spotLights; // 4 * 64 = 256
-        // Total expected size: 32 (header) + 128 + 256 + 256 = 672 bytes
+        // GLSL: int numDir; int numLights; int pad0; int pad1;（前 16 字节）
+        int numDir;
+        int numLights;      // 点光源 + 聚光灯总数（数据在 LIGHT_SSBO_BINDING）
+        int _pad0;
+        int _pad1;
 
+        glm::uvec4 clusterDims;     // xyz = 簇网格尺寸
+        glm::vec4 clusterParams;    // x = scale, y = bias（slice = log(viewZ) * scale + bias）, z = near, w = far
+        glm::vec4 viewportSize;     // xy = 渲染目标尺寸, zw = 倒数
 
+        std::array<DirLightGPU, MAX_DIR_LIGHTS> dirLights;   // 4 * 32 = 128
+        // Total expected size: 64 (header) + 128 = 192 bytes
     };
         static_assert(sizeof(DirLightGPU) == 32, "DirLightGPU must be 32 bytes (std140)");
-        static_assert(sizeof(PointLightGPU) == 32, "PointLightGPU must be 32 bytes (std140)");
-        static_assert(sizeof(SpotLightGPU) == 64, "SpotLightGPU must be 64 bytes (std140)");
-        static_assert(sizeof(LightsUBOData) == 672, "LightsUBOData must be 672 bytes to match shader std140 layout");
+        static_assert(sizeof(LightsUBOData) == 192, "LightsUBOData must be 192 bytes to match shader std140 layout");
 
     class ITR_API CameraUBO : public UBO
     {
@@ -94,41 +73,47 @@ namespace Intro{
         LightsUBO() : UBO(GL_UNIFORM_BUFFER, sizeof(LightsUBOData)) {
             BindBase(GL_UNIFORM_BUFFER, LIGHTS_UBO_BINDING);
         }
-        void LightsUBO::OnUpdate(ECS& ecs) {
+        // 方向光直接写入 UBO；点光源/聚光灯由 LightClusters 分簇上传，这里只写数量与网格参数
+        // shadows 非空时，使用级联阴影的方向光在 color.w 上标记为 1
+        void OnUpdate(ECS& ecs, const LightClusters& clusters, const ShadowMaps* shadows = nullptr) {
             LightsUBOData data{};
-            auto view = ecs.GetRegistry().view<TransformComponent, LightComponent>();
+            auto view = ecs.GetRegistry().view<LocalToWorldComponent, LightComponent>();
 
-            // ü
+            // 重置计数器
             data.numDir = 0;
-            data.numPoint = 0;
-            data.numSpot = 0;
+            data.numLights = (int)clusters.GetLightCount();
+            data.clusterDims = glm::uvec4(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y, LIGHT_CLUSTER_Z, 0);
+            data.clusterParams = clusters.GetClusterParams();
+            glm::vec2 viewport = clusters.GetViewportSize();
+            data.viewportSize = glm::vec4(viewport, 1.0f / viewport.x, 1.0f / viewport.y);
 
-            for (auto [entity, tf, light] : view.each()) {
+            for (auto [entity, ltw, light] : view.each()) {
                 switch (light.Type) {
                 case LightType::Directional:
                     if (data.numDir < MAX_DIR_LIGHTS) {
                         auto& dirLight = data.dirLights[data.numDir];
 
-                        // ռ䷽
+                        // 计算世界空间方向
                         glm::vec3 localDirection = glm::normalize(light.Direction);
-                        glm::vec3 worldDirection = tf.transform.rotation * localDirection;
+                        glm::vec3 worldDirection = ltw.TransformDirection(localDirection);
                         dirLight.direction = glm::vec4(worldDirection, 0.0f);
 
-                        // **ؼԣϸɫϢ**
+                        // **关键调试：详细输出颜色信息**
                         //ITR_INFO("=== Light Color Debug ===");
                         //ITR_INFO("Original Color: ({},{},{})", light.Color.r, light.Color.g, light.Color.b);
                         //ITR_INFO("Intensity: {}", light.Intensity);
 
-                        // Բͬɫ
+                        // 测试不同的颜色组合
                         glm::vec3 testColor = light.Color * light.Intensity;
                         //ITR_INFO("Final Color (Color * Intensity): ({},{},{})",
                         //    testColor.r, testColor.g, testColor.b);
 
-                        // ǿΪɫв
+                        // 强制设置为纯白色进行测试
                         // dirLight.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
-                        // ʹԭʼ
-                        dirLight.color = glm::vec4(testColor, 1.0f);
+                        // 或者使用原始设置
+                        bool castsCascades = shadows && shadows->GetDirectionalShadowEntity() == (uint32_t)entity;
+                        dirLight.color = glm::vec4(testColor, castsCascades ? 1.0f : 0.0f);
 
                         //ITR_INFO("UBO Color: ({},{},{},{})",
                         //    dirLight.color.r, dirLight.color.g, dirLight.color.b, dirLight.color.a);
@@ -136,29 +121,7 @@ namespace Intro{
                         data.numDir++;
                     }
                     break;
-                case LightType::Point:
-                    if (data.numPoint < MAX_POINT_LIGHTS) {
-                        auto& pointLight = data.pointLights[data.numPoint];
-                        pointLight.position = glm::vec4(tf.transform.position, light.Range);
-                        pointLight.color = glm::vec4(light.Color * light.Intensity, 1.0f);
-                        data.numPoint++;
-                    }
-                    break;
-                case LightType::Spot:
-                    if (data.numSpot < MAX_SPOT_LIGHTS) {
-                        auto& spotLight = data.spotLights[data.numSpot];
-                        spotLight.position = glm::vec4(tf.transform.position, light.Range);
-
-                        glm::vec3 worldDirection = tf.transform.rotation * glm::normalize(light.Direction);
-                        spotLight.direction = glm::vec4(worldDirection, 0.0f);
-                        spotLight.color = glm::vec4(light.Color * light.Intensity, 1.0f);
-                        spotLight.params = glm::vec4(
-                            glm::cos(glm::radians(light.SpotAngle)),
-                            glm::cos(glm::radians(light.InnerSpotAngle)),
-                            light.Range, 0.0f
-                        );
-                        data.numSpot++;
-                    }
+                default:
                     break;
                 }
             }
@@ -0,0 +1,14 @@
+#version 410 core
+
+// DebugDraw 的流式顶点：位置 + RGBA8 颜色（归一化为 [0, 1]）
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+
+uniform mat4 u_ViewProjection;
+
+out vec4 vColor;
+
+void main() {
+    vColor = aColor;
+    gl_Position = u_ViewProjection * vec4(aPos, 1.0);
+}
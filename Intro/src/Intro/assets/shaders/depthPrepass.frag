@@ -0,0 +1,10 @@
+#version 430 core
+
+flat in uint vLodFade;
+
+#include "lodFade.glsl"
+
+// 只写深度；LOD 淡化期间与主通道丢弃相同的片元，预通道深度与主通道保持一致
+void main() {
+    if (LodFadeDiscard(vLodFade)) discard;
+}
@@ -0,0 +1,37 @@
+#version 430 core
+
+layout(std140, binding = 0) uniform CameraUBO {
+    mat4 view;
+    mat4 proj;
+    vec4 viewPos;
+    float time;
+    vec3 pad;
+} camera;
+
+layout(location = 0) in vec3 aPos;
+
+flat out uint vLodFade;
+
+// 每帧对象数据（Renderer 的环形缓冲，binding = 2）
+struct ObjectData {
+    mat4 model;
+    mat3 normalMatrix;
+    uvec4 ids;
+};
+
+layout(std430, binding = 2) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
+
+// 每实例对象索引（由 baseInstance 偏移）
+layout(location = 5) in uint aObjectIndex;
+
+// 深度预通道：与 tempShader/pbrShader 的顶点着色器使用完全相同的位置计算并声明 invariant，
+// 保证两遍写出的深度逐位一致，主通道用 GL_LEQUAL 测试时不会出现 z-fighting
+invariant gl_Position;
+
+void main() {
+    vec4 worldPos = objects[aObjectIndex].model * vec4(aPos, 1.0);
+    vLodFade = objects[aObjectIndex].ids.z;
+    gl_Position = camera.proj * camera.view * worldPos;
+}
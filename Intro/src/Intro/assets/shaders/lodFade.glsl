@@ -0,0 +1,17 @@
+// lodFade.glsl：由 depthPrepass / tempShader / pbrShader 通过 #include "lodFade.glsl" 引入
+
+// LOD 交叉淡化：ids.z 低 16 位为可见比例，第 16 位表示淡出。
+// 新旧两级按 4x4 Bayer 矩阵互补地丢弃片元，合起来每个像素恰好绘制一次
+bool LodFadeDiscard(uint lodFade) {
+    if (lodFade == 0u) return false;
+    const float bayer[16] = float[16](
+         0.0,  8.0,  2.0, 10.0,
+        12.0,  4.0, 14.0,  6.0,
+         3.0, 11.0,  1.0,  9.0,
+        15.0,  7.0, 13.0,  5.0);
+    ivec2 pixel = ivec2(gl_FragCoord.xy) & 3;
+    float threshold = (bayer[pixel.y * 4 + pixel.x] + 0.5) / 16.0;
+    float visible = float(lodFade & 0xFFFFu) / 65535.0;
+    bool fadingOut = (lodFade & 0x10000u) != 0u;
+    return fadingOut ? threshold < visible : threshold >= visible;
+}
@@ -0,0 +1,23 @@
+#version 430 core
+
+// 加权混合 OIT 合成：累积颜色除以累积权重得到平均颜色，透射率决定覆盖度。
+// 以 (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) 混合到场景颜色上
+layout(binding = 0) uniform sampler2D u_Accumulation;
+layout(binding = 1) uniform sampler2D u_Revealage;
+
+out vec4 FragColor;
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    float revealage = texelFetch(u_Revealage, pixel, 0).r;
+    // 没有透明物体覆盖的像素
+    if (revealage >= 1.0) discard;
+
+    vec4 accumulation = texelFetch(u_Accumulation, pixel, 0);
+    // 权重过大溢出时退化为按覆盖度的平均
+    if (isinf(max(max(abs(accumulation.r), abs(accumulation.g)), abs(accumulation.b))))
+        accumulation.rgb = vec3(accumulation.a);
+
+    vec3 average = accumulation.rgb / max(accumulation.a, 1e-5);
+    FragColor = vec4(average, 1.0 - revealage);
+}
@@ -1,4 +1,4 @@
-#version 420 core
+#version 430 core
 
 layout(std140, binding = 0) uniform CameraUBO {
     mat4 view;
@@ -10,81 +10,112 @@ layout(std140, binding = 0) uniform CameraUBO {
 
 struct DirLight {
     vec4 direction;
-    vec4 color;
-    vec4 intensity; // x=intensity, yzw=pad
-};
-
-struct PointLight {
-    vec4 position;  // xyz=pos, w=range
-    vec4 color;     // rgb=color, w=intensity
-};
-
-struct SpotLight {
-    vec4 position;  // xyz=pos, w=range
-    vec4 direction; // xyz=direction, w=outerCos
-    vec4 color;     // rgb=color, w=intensity
-    vec4 params;    // x=innerCos, y=unused, z=unused, w=unused
+    vec4 color;     // rgb = color * intensity, w = 1 使用级联阴影
 };
 
 layout(std140, binding = 1) uniform LightsUBO {
     int numDir;
-    int numPoint;
-    int numSpot;
-    vec2 pad;
-    
+    int numLights;
+    int pad0;
+    int pad1;
+
+    uvec4 clusterDims;   // xyz = 簇网格尺寸
+    vec4 clusterParams;  // x = scale, y = bias, z = near, w = far
+    vec4 viewportSize;   // xy = 尺寸, zw = 倒数
+
     DirLight dirLights[4];
-    PointLight pointLights[8];
-    SpotLight spotLights[4];
 } lights;
 
+// 点光源 / 聚光灯（分簇光照，binding 4/5/6）
+struct Light {
+    vec4 positionRange;      // xyz = pos, w = range
+    vec4 colorType;          // rgb = color * intensity, w = 0 点光源 / 1 聚光灯
+    vec4 directionOuterCos;  // xyz = direction, w = outerCos
+    vec4 params;             // x = innerCos, y = 阴影下标（-1 无阴影）
+};
+
+layout(std430, binding = 4) readonly buffer LightBuffer {
+    Light lightData[];
+};
+
+layout(std430, binding = 5) readonly buffer LightClusterBuffer {
+    uvec2 lightClusters[];   // x = offset, y = count
+};
+
+layout(std430, binding = 6) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+
+// 阴影（ShadowMaps）：方向光级联参数 binding 2，点光源/聚光灯图集 binding 7
+layout(std140, binding = 2) uniform ShadowUBO {
+    mat4 cascadeViewProj[4];
+    vec4 cascadeSplits;      // 各级联远端的视图深度
+    vec4 cascadeTexelSize;   // 各级联一个纹素的世界空间尺寸
+    ivec4 params;            // x = 级联数, y = 是否有方向光阴影
+    vec4 texel;              // x = 1/级联分辨率, y = 1/图集分辨率, z = 深度偏移, w = 法线偏移（纹素倍数）
+} shadows;
+
+struct LocalShadow {
+    mat4 viewProj;
+    vec4 atlasRect;          // xy = 偏移, zw = 尺寸（z 为 0 表示还没有内容）
+};
+
+layout(std430, binding = 7) readonly buffer LocalShadowBuffer {
+    LocalShadow localShadows[];
+};
+
+layout(binding = 10) uniform sampler2DArrayShadow u_ShadowCascades;
+layout(binding = 11) uniform sampler2DShadow u_ShadowAtlas;
+
 in vec3 vFragPos;
 in vec3 vNormal;
 in vec2 vUV;
 in mat3 vTBN;
+flat in uint vMaterialIndex;
+flat in uint vLodFade;
+flat in uint vObjectFlags;
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out float FragReveal;
 
-out vec4 FragColor;
+// 材质参数表（MaterialTable，binding = 3），由对象数据中的材质索引访问
+struct MaterialData {
+    vec4 albedoMetallic;    // rgb = albedo, a = metallic
+    vec4 emissiveRoughness; // rgb = emissive, a = roughness
+    vec4 params;            // x = ao, y = exposure, z = opacity
+    ivec4 layers0;          // albedo/normal/metallic/roughness 贴图层，-1 表示不使用
+    ivec4 layers1;          // ao/emissive 贴图层
+};
+
+layout(std430, binding = 3) readonly buffer MaterialBuffer {
+    MaterialData materials[];
+};
 
-// PBRͼ
-uniform sampler2D material_albedo;
-uniform sampler2D material_normal;
-uniform sampler2D material_metallic;
-uniform sampler2D material_roughness;
-uniform sampler2D material_ao;
-uniform sampler2D material_emissive;
+// PBR材质贴图（纹理数组，层号来自材质参数表）
+uniform sampler2DArray material_albedo;
+uniform sampler2DArray material_normal;
+uniform sampler2DArray material_metallic;
+uniform sampler2DArray material_roughness;
+uniform sampler2DArray material_ao;
+uniform sampler2DArray material_emissive;
 
-// IBLͼ
+// IBL贴图
 uniform samplerCube u_IrradianceMap;
 uniform samplerCube u_PrefilterMap;
 uniform sampler2D u_BRDFLUT;
 
-uniform vec3 u_AlbedoColor;
-uniform float u_Metallic;
-uniform float u_Roughness; 
-uniform float u_AO;
-uniform vec3 u_EmissiveColor;
-
-// ʹñ־
-uniform int u_UseAlbedoMap;
-uniform int u_UseNormalMap;
-uniform int u_UseMetallicMap;
-uniform int u_UseRoughnessMap;
-uniform int u_UseAOMap;
-uniform int u_UseEmissiveMap;
-
-uniform vec3 u_AmbientColor;
-uniform float u_Exposure;
 
 const float PI = 3.14159265359;
 
-// ٤У
+// 伽马校正
 vec3 gammaCorrect(vec3 color) {
     return pow(color, vec3(1.0/2.2));
 }
 
-// ɫӳ
-vec3 toneMapping(vec3 color) {
-    // ACESɫӳ
-    color *= u_Exposure;
+// 色调映射
+vec3 toneMapping(vec3 color, float exposure) {
+    // ACES色调映射
+    color *= exposure;
     float a = 2.51;
     float b = 0.03;
     float c = 2.43;
@@ -93,7 +124,7 @@ vec3 toneMapping(vec3 color) {
     return clamp((color * (a * color + b)) / (color * (c * color + d) + e), 0.0, 1.0);
 }
 
-// ߷ֲ (Trowbridge-Reitz GGX)
+// 法线分布函数 (Trowbridge-Reitz GGX)
 float DistributionGGX(vec3 N, vec3 H, float roughness) {
     float a = roughness * roughness;
     float a2 = a * a;
@@ -107,7 +138,7 @@ float DistributionGGX(vec3 N, vec3 H, float roughness) {
     return nom / denom;
 }
 
-// κ (Schlick GGX)
+// 几何函数 (Schlick GGX)
 float GeometrySchlickGGX(float NdotV, float roughness) {
     float r = (roughness + 1.0);
     float k = (r * r) / 8.0;
@@ -118,7 +149,7 @@ float GeometrySchlickGGX(float NdotV, float roughness) {
     return nom / denom;
 }
 
-// κ (Smith)
+// 几何函数 (Smith)
 float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
     float NdotV = max(dot(N, V), 0.0);
     float NdotL = max(dot(N, L), 0.0);
@@ -128,154 +159,203 @@ float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
     return ggx1 * ggx2;
 }
 
-//  (Fresnel-Schlick)
+// 菲涅尔方程 (Fresnel-Schlick)
 vec3 fresnelSchlick(float cosTheta, vec3 F0) {
     return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 
-// ̴ֲڶ
+// 菲涅尔方程带粗糙度
 vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness) {
     return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
 }
 
-// ˥
+// 点光衰减
 float CalculateAttenuation(float distance, float range) {
     float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
     return clamp(attenuation, 0.0, 1.0) * smoothstep(range, range * 0.5, distance);
 }
 
-// ۹ǿ
+// 聚光灯强度
 float CalculateSpotIntensity(vec3 lightDir, vec3 spotDir, float outerCos, float innerCos) {
     float theta = dot(lightDir, spotDir);
     float epsilon = innerCos - outerCos;
     return clamp((theta - outerCos) / epsilon, 0.0, 1.0);
 }
 
+// 方向光级联阴影（3x3 PCF）：1 = 无遮挡，0 = 完全遮挡
+float CascadeShadow(vec3 worldPos, vec3 N) {
+    if (shadows.params.y == 0) return 1.0;
+
+    float viewZ = -(camera.view * vec4(worldPos, 1.0)).z;
+    int cascade = 0;
+    while (cascade < shadows.params.x && viewZ > shadows.cascadeSplits[cascade]) cascade++;
+    if (cascade >= shadows.params.x) return 1.0;
+
+    vec3 offsetPos = worldPos + N * shadows.cascadeTexelSize[cascade] * shadows.texel.w;
+    vec4 lightPos = shadows.cascadeViewProj[cascade] * vec4(offsetPos, 1.0);
+    vec3 coord = lightPos.xyz / lightPos.w * 0.5 + 0.5;
+    if (coord.z > 1.0) return 1.0;
+
+    float shadow = 0.0;
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            vec2 uv = coord.xy + vec2(x, y) * shadows.texel.x;
+            shadow += texture(u_ShadowCascades, vec4(uv, float(cascade), coord.z - shadows.texel.z));
+        }
+    }
+    return shadow / 9.0;
+}
+
+// 点光源/聚光灯阴影（图集）：点光源按主轴选择立方体的面（+X -X +Y -Y +Z -Z）
+float LocalLightShadow(Light light, vec3 worldPos, vec3 N) {
+    int index = int(light.params.y);
+    if (index < 0) return 1.0;
+
+    vec3 toFrag = worldPos - light.positionRange.xyz;
+    if (light.colorType.w < 0.5) {
+        vec3 a = abs(toFrag);
+        if (a.x >= a.y && a.x >= a.z) index += toFrag.x > 0.0 ? 0 : 1;
+        else if (a.y >= a.z) index += toFrag.y > 0.0 ? 2 : 3;
+        else index += toFrag.z > 0.0 ? 4 : 5;
+    }
+
+    LocalShadow s = localShadows[index];
+    if (s.atlasRect.z == 0.0) return 1.0;
+
+    // 透视投影下纹素的世界尺寸随距离增大
+    float texelWorld = 2.0 * length(toFrag) * shadows.texel.y / s.atlasRect.z;
+    vec4 lightPos = s.viewProj * vec4(worldPos + N * texelWorld * shadows.texel.w, 1.0);
+    vec3 coord = lightPos.xyz / lightPos.w * 0.5 + 0.5;
+    if (any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0)))) return 1.0;
+
+    // 限制在块内，避免线性过滤采到相邻块
+    vec2 halfTexel = vec2(0.5 * shadows.texel.y);
+    vec2 uv = clamp(s.atlasRect.xy + coord.xy * s.atlasRect.zw, s.atlasRect.xy + halfTexel, s.atlasRect.xy + s.atlasRect.zw - halfTexel);
+    return texture(u_ShadowAtlas, vec3(uv, coord.z - shadows.texel.z));
+}
+
+// 当前片元所在的光照簇（屏幕块 + 视图空间深度的指数切片）
+uint GetClusterIndex(vec3 worldPos) {
+    float viewZ = max(-(camera.view * vec4(worldPos, 1.0)).z, lights.clusterParams.z);
+    uint slice = uint(max(log(viewZ) * lights.clusterParams.x + lights.clusterParams.y, 0.0));
+    slice = min(slice, lights.clusterDims.z - 1u);
+
+    uvec2 tile = uvec2(gl_FragCoord.xy * lights.viewportSize.zw * vec2(lights.clusterDims.xy));
+    tile = min(tile, lights.clusterDims.xy - 1u);
+    return (slice * lights.clusterDims.y + tile.y) * lights.clusterDims.x + tile.x;
+}
+
+// 单个光源的 Cook-Torrance 反射（radiance 已包含衰减）
+vec3 EvaluateLight(vec3 N, vec3 V, vec3 L, vec3 radiance, vec3 albedo, float metallic, float roughness, vec3 F0) {
+    vec3 H = normalize(V + L);
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular = numerator / denominator;
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    float NdotL = max(dot(N, L), 0.0);
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
+// 输出颜色。对象标志带 OBJECT_FLAG_WEIGHTED_OIT 时按加权混合 OIT 输出（McGuire & Bavoil 2013）：
+// location 0 累积按视距加权的预乘颜色（混合 ONE, ONE），location 1 累积透射率（混合 ZERO, ONE_MINUS_SRC_COLOR）
+const uint OBJECT_FLAG_WEIGHTED_OIT = 1u;
+
+void WriteColor(vec3 color, float alpha) {
+    if ((vObjectFlags & OBJECT_FLAG_WEIGHTED_OIT) != 0u) {
+        float viewZ = -(camera.view * vec4(vFragPos, 1.0)).z;
+        float weight = clamp(alpha * max(1e-2, min(3e3, 10.0 / (1e-5 + pow(viewZ / 5.0, 2.0) + pow(viewZ / 200.0, 6.0)))), 1e-2, 3e3);
+        FragColor = vec4(color * alpha, alpha) * weight;
+        FragReveal = alpha;
+    }
+    else {
+        FragColor = vec4(color, alpha);
+        FragReveal = 0.0;
+    }
+}
+
+#include "lodFade.glsl"
+
 void main() {
-    // ȡ
-   vec3 albedo = u_UseAlbedoMap == 1 ? 
-        pow(texture(material_albedo, vUV).rgb, vec3(2.2)) : 
-        u_AlbedoColor;
+    if (LodFadeDiscard(vLodFade)) discard;
+
+    // 读取材质属性
+    MaterialData material = materials[vMaterialIndex];
+
+    vec3 albedo = material.layers0.x >= 0 ? 
+        pow(texture(material_albedo, vec3(vUV, material.layers0.x)).rgb, vec3(2.2)) : 
+        material.albedoMetallic.rgb;
     
-    float metallic = u_UseMetallicMap == 1 ? 
-        texture(material_metallic, vUV).r : 
-        u_Metallic;
+    float metallic = material.layers0.z >= 0 ? 
+        texture(material_metallic, vec3(vUV, material.layers0.z)).r : 
+        material.albedoMetallic.a;
         
-    float roughness = u_UseRoughnessMap == 1 ? 
-        texture(material_roughness, vUV).r : 
-        u_Roughness;
+    float roughness = material.layers0.w >= 0 ? 
+        texture(material_roughness, vec3(vUV, material.layers0.w)).r : 
+        material.emissiveRoughness.a;
         
-    float ao = u_UseAOMap == 1 ? 
-        texture(material_ao, vUV).r : 
-        u_AO;
+    float ao = material.layers1.x >= 0 ? 
+        texture(material_ao, vec3(vUV, material.layers1.x)).r : 
+        material.params.x;
         
-    vec3 emissive = u_UseEmissiveMap == 1 ? 
-        texture(material_emissive, vUV).rgb : 
-        u_EmissiveColor;
-    
+    vec3 emissive = material.layers1.y >= 0 ? 
+        texture(material_emissive, vec3(vUV, material.layers1.y)).rgb : 
+        material.emissiveRoughness.rgb;
     
-    // ͼ
-    vec3 normal = texture(material_normal, vUV).rgb;
-    normal = normalize(normal * 2.0 - 1.0);
-    normal = normalize(vTBN * normal);
     
-    vec3 N = normal;
+    // 法线贴图（未使用时直接取插值法线）
+    vec3 N = normalize(vNormal);
+    if (material.layers0.y >= 0) {
+        vec3 normal = texture(material_normal, vec3(vUV, material.layers0.y)).rgb;
+        normal = normalize(normal * 2.0 - 1.0);
+        N = normalize(vTBN * normal);
+    }
+
     vec3 V = normalize(camera.viewPos.xyz - vFragPos);
     vec3 R = reflect(-V, N);
     
-    // 
+    // 计算基础反射率
     vec3 F0 = vec3(0.04);
     F0 = mix(F0, albedo, metallic);
     
-    // ䷽
+    // 反射方程
     vec3 Lo = vec3(0.0);
     
-    // 
+    // 方向光
     for (int i = 0; i < lights.numDir && i < 4; i++) {
         vec3 L = normalize(-lights.dirLights[i].direction.xyz);
-        vec3 H = normalize(V + L);
-        float distance = 1.0;
-        float attenuation = 1.0;
-        vec3 radiance = lights.dirLights[i].color.rgb * lights.dirLights[i].intensity.x;
-        
-        // Cook-Torrance BRDF
-        float NDF = DistributionGGX(N, H, roughness);
-        float G = GeometrySmith(N, V, L, roughness);
-        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
-        
-        vec3 numerator = NDF * G * F;
-        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
-        vec3 specular = numerator / denominator;
-        
-        vec3 kS = F;
-        vec3 kD = vec3(1.0) - kS;
-        kD *= 1.0 - metallic;
-        
-        float NdotL = max(dot(N, L), 0.0);
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL * attenuation;
+        vec3 radiance = lights.dirLights[i].color.rgb;
+        if (lights.dirLights[i].color.w > 0.5) radiance *= CascadeShadow(vFragPos, N);
+        Lo += EvaluateLight(N, V, L, radiance, albedo, metallic, roughness, F0);
     }
     
-    // Դ
-    for (int i = 0; i < lights.numPoint && i < 8; i++) {
-        vec3 lightPos = lights.pointLights[i].position.xyz;
-        float lightRange = lights.pointLights[i].position.w;
+    // 点光源 / 聚光灯：只计算当前簇内的光源
+    uvec2 cluster = lightClusters[GetClusterIndex(vFragPos)];
+    for (uint i = 0u; i < cluster.y; i++) {
+        Light light = lightData[lightIndices[cluster.x + i]];
+        vec3 lightPos = light.positionRange.xyz;
+        float lightRange = light.positionRange.w;
         
         vec3 L = normalize(lightPos - vFragPos);
-        vec3 H = normalize(V + L);
         float distance = length(lightPos - vFragPos);
         float attenuation = CalculateAttenuation(distance, lightRange);
-        vec3 radiance = lights.pointLights[i].color.rgb * lights.pointLights[i].color.w * attenuation;
-        
-        // Cook-Torrance BRDF
-        float NDF = DistributionGGX(N, H, roughness);
-        float G = GeometrySmith(N, V, L, roughness);
-        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
-        
-        vec3 numerator = NDF * G * F;
-        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
-        vec3 specular = numerator / denominator;
-        
-        vec3 kS = F;
-        vec3 kD = vec3(1.0) - kS;
-        kD *= 1.0 - metallic;
-        
-        float NdotL = max(dot(N, L), 0.0);
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
-    }
-    
-    // ۹
-    for (int i = 0; i < lights.numSpot && i < 4; i++) {
-        vec3 lightPos = lights.spotLights[i].position.xyz;
-        float lightRange = lights.spotLights[i].position.w;
-        vec3 spotDir = normalize(-lights.spotLights[i].direction.xyz);
-        float outerCos = lights.spotLights[i].direction.w;
-        float innerCos = lights.spotLights[i].params.x;
-        
-        vec3 L = normalize(lightPos - vFragPos);
-        vec3 H = normalize(V + L);
-        float distance = length(lightPos - vFragPos);
-        float attenuation = CalculateAttenuation(distance, lightRange);
-        float spotIntensity = CalculateSpotIntensity(L, spotDir, outerCos, innerCos);
-        vec3 radiance = lights.spotLights[i].color.rgb * lights.spotLights[i].color.w * attenuation * spotIntensity;
-        
-        // Cook-Torrance BRDF
-        float NDF = DistributionGGX(N, H, roughness);
-        float G = GeometrySmith(N, V, L, roughness);
-        vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
-        
-        vec3 numerator = NDF * G * F;
-        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
-        vec3 specular = numerator / denominator;
-        
-        vec3 kS = F;
-        vec3 kD = vec3(1.0) - kS;
-        kD *= 1.0 - metallic;
+        if (light.colorType.w > 0.5) {
+            vec3 spotDir = normalize(-light.directionOuterCos.xyz);
+            attenuation *= CalculateSpotIntensity(L, spotDir, light.directionOuterCos.w, light.params.x);
+        }
+        if (attenuation > 0.0) attenuation *= LocalLightShadow(light, vFragPos, N);
         
-        float NdotL = max(dot(N, L), 0.0);
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
+        Lo += EvaluateLight(N, V, L, light.colorType.rgb * attenuation, albedo, metallic, roughness, F0);
     }
     
-    //  (IBL)
+    // 环境光照 (IBL)
     vec3 F = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
     vec3 kS = F;
     vec3 kD = 1.0 - kS;
@@ -291,12 +371,12 @@ void main() {
     
     vec3 ambient = (kD * diffuse + specular) * ao;
     
-    // ɫ
+    // 最终颜色
     vec3 color = ambient + Lo + emissive;
     
-    // ɫӳ٤У
-    color = toneMapping(color);
+    // 色调映射和伽马校正
+    color = toneMapping(color, material.params.y);
     color = gammaCorrect(color);
     
-    FragColor = vec4(color, 1.0);
+    WriteColor(color, material.params.z);
 }
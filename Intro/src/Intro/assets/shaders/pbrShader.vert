@@ -1,4 +1,4 @@
-#version 420 core
+#version 430 core
 
 layout(std140, binding = 0) uniform CameraUBO {
     mat4 view;
@@ -18,23 +18,45 @@ out vec3 vFragPos;
 out vec3 vNormal;
 out vec2 vUV;
 out mat3 vTBN;
+flat out uint vMaterialIndex;
+flat out uint vLodFade;
+flat out uint vObjectFlags;
 
-uniform mat4 u_Transform;
+// 每帧对象数据（Renderer 的环形缓冲，binding = 2）
+struct ObjectData {
+    mat4 model;
+    mat3 normalMatrix;
+    uvec4 ids;
+};
+
+layout(std430, binding = 2) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
+
+// 每实例对象索引（由 baseInstance 偏移）
+layout(location = 5) in uint aObjectIndex;
+
+// 与深度预通道（depthPrepass.vert）的位置计算保持一致
+invariant gl_Position;
 
 void main() {
-    vec4 worldPos = u_Transform * vec4(aPos, 1.0);
+    ObjectData object = objects[aObjectIndex];
+    vec4 worldPos = object.model * vec4(aPos, 1.0);
     vFragPos = worldPos.xyz;
     
-    // ߾任
-    mat3 normalMat = transpose(inverse(mat3(u_Transform)));
+    // 法线矩阵变换
+    mat3 normalMat = object.normalMatrix;
     vNormal = normalize(normalMat * aNormal);
     
-    // TBNڷͼ
+    // 计算TBN矩阵用于法线贴图
     vec3 T = normalize(normalMat * aTangent);
     vec3 B = normalize(normalMat * aBitangent);
     vec3 N = normalize(normalMat * aNormal);
     vTBN = mat3(T, B, N);
     
+    vMaterialIndex = object.ids.y;
+    vLodFade = object.ids.z;
+    vObjectFlags = object.ids.w;
     vUV = aUV;
     gl_Position = camera.proj * camera.view * worldPos;
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+#version 430 core
+
+layout(location = 0) in vec3 aPos;
+
+// 每帧对象数据（Renderer 的环形缓冲，binding = 2）
+struct ObjectData {
+    mat4 model;
+    mat3 normalMatrix;
+    uvec4 ids;
+};
+
+layout(std430, binding = 2) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+};
+
+// 每实例对象索引（由 baseInstance 偏移）
+layout(location = 5) in uint aObjectIndex;
+
+// 级联或图集块的光源视图投影矩阵（ShadowMaps）
+uniform mat4 u_LightViewProj;
+
+void main() {
+    gl_Position = u_LightViewProj * objects[aObjectIndex].model * vec4(aPos, 1.0);
+}
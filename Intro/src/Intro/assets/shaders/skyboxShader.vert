@@ -8,8 +8,8 @@ uniform mat4 view;
 
 void main() {
     TexCoords = aPos;
-    // ƳƽƲֻ֣ת
+    // 移除平移部分，只保留旋转
     mat4 viewWithoutTranslation = mat4(mat3(view));
     vec4 pos = projection * viewWithoutTranslation * vec4(aPos, 1.0);
-    gl_Position = pos.xyww;  // z=wȷΪ1.0
+    gl_Position = pos.xyww;  // 设置z=w确保深度为1.0
 }
\ No newline at end of file
@@ -1,4 +1,4 @@
-#version 420 core
+#version 430 core
 
 layout(std140, binding = 0) uniform CameraUBO {
     mat4 view;
@@ -10,37 +10,71 @@ layout(std140, binding = 0) uniform CameraUBO {
 
 struct DirLight {
     vec4 direction;
-    vec4 color;
-};
-
-struct PointLight {
-    vec4 position;  // xyz=pos, w=range
-    vec4 color;     // rgb=color, w=intensity
-};
-
-struct SpotLight {
-    vec4 position;  // xyz=pos, w=range
-    vec4 direction; // xyz=direction, w=outerCos
-    vec4 color;     // rgb=color, w=intensity
-    vec4 params;    // x=innerCos, y=unused, z=unused, w=unused
+    vec4 color;     // rgb = color * intensity, w = 1 使用级联阴影
 };
 
 layout(std140, binding = 1) uniform LightsUBO {
     int numDir;
-    int numPoint;
-    int numSpot;
-    vec2 pad;
-    
+    int numLights;
+    int pad0;
+    int pad1;
+
+    uvec4 clusterDims;   // xyz = 簇网格尺寸
+    vec4 clusterParams;  // x = scale, y = bias, z = near, w = far
+    vec4 viewportSize;   // xy = 尺寸, zw = 倒数
+
     DirLight dirLights[4];
-    PointLight pointLights[8];
-    SpotLight spotLights[4];
 } lights;
 
+// 点光源 / 聚光灯（分簇光照，binding 4/5/6）
+struct Light {
+    vec4 positionRange;      // xyz = pos, w = range
+    vec4 colorType;          // rgb = color * intensity, w = 0 点光源 / 1 聚光灯
+    vec4 directionOuterCos;  // xyz = direction, w = outerCos
+    vec4 params;             // x = innerCos, y = 阴影下标（-1 无阴影）
+};
+
+layout(std430, binding = 4) readonly buffer LightBuffer {
+    Light lightData[];
+};
+
+layout(std430, binding = 5) readonly buffer LightClusterBuffer {
+    uvec2 lightClusters[];   // x = offset, y = count
+};
+
+layout(std430, binding = 6) readonly buffer LightIndexBuffer {
+    uint lightIndices[];
+};
+
+// 阴影（ShadowMaps）：方向光级联参数 binding 2，点光源/聚光灯图集 binding 7
+layout(std140, binding = 2) uniform ShadowUBO {
+    mat4 cascadeViewProj[4];
+    vec4 cascadeSplits;      // 各级联远端的视图深度
+    vec4 cascadeTexelSize;   // 各级联一个纹素的世界空间尺寸
+    ivec4 params;            // x = 级联数, y = 是否有方向光阴影
+    vec4 texel;              // x = 1/级联分辨率, y = 1/图集分辨率, z = 深度偏移, w = 法线偏移（纹素倍数）
+} shadows;
+
+struct LocalShadow {
+    mat4 viewProj;
+    vec4 atlasRect;          // xy = 偏移, zw = 尺寸（z 为 0 表示还没有内容）
+};
+
+layout(std430, binding = 7) readonly buffer LocalShadowBuffer {
+    LocalShadow localShadows[];
+};
+
+layout(binding = 10) uniform sampler2DArrayShadow u_ShadowCascades;
+layout(binding = 11) uniform sampler2DShadow u_ShadowAtlas;
+
 in vec3 vFragPos;
 in vec3 vNormal;
 in vec2 vUV;
+flat in uint vLodFade;
+flat in uint vObjectFlags;
 
-out vec4 FragColor;
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out float FragReveal;
 
 uniform sampler2D material_diffuse;
 uniform sampler2D material_specular;
@@ -51,13 +85,95 @@ vec3 gammaCorrect(vec3 color) {
     return pow(color, vec3(1.0/2.2));
 }
 
-// Դ˥
+// 方向光级联阴影（3x3 PCF）：1 = 无遮挡，0 = 完全遮挡
+float CascadeShadow(vec3 worldPos, vec3 N) {
+    if (shadows.params.y == 0) return 1.0;
+
+    float viewZ = -(camera.view * vec4(worldPos, 1.0)).z;
+    int cascade = 0;
+    while (cascade < shadows.params.x && viewZ > shadows.cascadeSplits[cascade]) cascade++;
+    if (cascade >= shadows.params.x) return 1.0;
+
+    vec3 offsetPos = worldPos + N * shadows.cascadeTexelSize[cascade] * shadows.texel.w;
+    vec4 lightPos = shadows.cascadeViewProj[cascade] * vec4(offsetPos, 1.0);
+    vec3 coord = lightPos.xyz / lightPos.w * 0.5 + 0.5;
+    if (coord.z > 1.0) return 1.0;
+
+    float shadow = 0.0;
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            vec2 uv = coord.xy + vec2(x, y) * shadows.texel.x;
+            shadow += texture(u_ShadowCascades, vec4(uv, float(cascade), coord.z - shadows.texel.z));
+        }
+    }
+    return shadow / 9.0;
+}
+
+// 点光源/聚光灯阴影（图集）：点光源按主轴选择立方体的面（+X -X +Y -Y +Z -Z）
+float LocalLightShadow(Light light, vec3 worldPos, vec3 N) {
+    int index = int(light.params.y);
+    if (index < 0) return 1.0;
+
+    vec3 toFrag = worldPos - light.positionRange.xyz;
+    if (light.colorType.w < 0.5) {
+        vec3 a = abs(toFrag);
+        if (a.x >= a.y && a.x >= a.z) index += toFrag.x > 0.0 ? 0 : 1;
+        else if (a.y >= a.z) index += toFrag.y > 0.0 ? 2 : 3;
+        else index += toFrag.z > 0.0 ? 4 : 5;
+    }
+
+    LocalShadow s = localShadows[index];
+    if (s.atlasRect.z == 0.0) return 1.0;
+
+    // 透视投影下纹素的世界尺寸随距离增大
+    float texelWorld = 2.0 * length(toFrag) * shadows.texel.y / s.atlasRect.z;
+    vec4 lightPos = s.viewProj * vec4(worldPos + N * texelWorld * shadows.texel.w, 1.0);
+    vec3 coord = lightPos.xyz / lightPos.w * 0.5 + 0.5;
+    if (any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0)))) return 1.0;
+
+    // 限制在块内，避免线性过滤采到相邻块
+    vec2 halfTexel = vec2(0.5 * shadows.texel.y);
+    vec2 uv = clamp(s.atlasRect.xy + coord.xy * s.atlasRect.zw, s.atlasRect.xy + halfTexel, s.atlasRect.xy + s.atlasRect.zw - halfTexel);
+    return texture(u_ShadowAtlas, vec3(uv, coord.z - shadows.texel.z));
+}
+
+// 当前片元所在的光照簇（屏幕块 + 视图空间深度的指数切片）
+uint GetClusterIndex(vec3 worldPos) {
+    float viewZ = max(-(camera.view * vec4(worldPos, 1.0)).z, lights.clusterParams.z);
+    uint slice = uint(max(log(viewZ) * lights.clusterParams.x + lights.clusterParams.y, 0.0));
+    slice = min(slice, lights.clusterDims.z - 1u);
+
+    uvec2 tile = uvec2(gl_FragCoord.xy * lights.viewportSize.zw * vec2(lights.clusterDims.xy));
+    tile = min(tile, lights.clusterDims.xy - 1u);
+    return (slice * lights.clusterDims.y + tile.y) * lights.clusterDims.x + tile.x;
+}
+
+// 点光源衰减函数
 float CalculateAttenuation(float distance, float range) {
     float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
     return clamp(attenuation, 0.0, 1.0) * smoothstep(range, range * 0.5, distance);
 }
 
-// ۹ǿȼ
+// 输出颜色。对象标志带 OBJECT_FLAG_WEIGHTED_OIT 时按加权混合 OIT 输出（McGuire & Bavoil 2013）：
+// location 0 累积按视距加权的预乘颜色（混合 ONE, ONE），location 1 累积透射率（混合 ZERO, ONE_MINUS_SRC_COLOR）
+const uint OBJECT_FLAG_WEIGHTED_OIT = 1u;
+
+void WriteColor(vec3 color, float alpha) {
+    if ((vObjectFlags & OBJECT_FLAG_WEIGHTED_OIT) != 0u) {
+        float viewZ = -(camera.view * vec4(vFragPos, 1.0)).z;
+        float weight = clamp(alpha * max(1e-2, min(3e3, 10.0 / (1e-5 + pow(viewZ / 5.0, 2.0) + pow(viewZ / 200.0, 6.0)))), 1e-2, 3e3);
+        FragColor = vec4(color * alpha, alpha) * weight;
+        FragReveal = alpha;
+    }
+    else {
+        FragColor = vec4(color, alpha);
+        FragReveal = 0.0;
+    }
+}
+
+#include "lodFade.glsl"
+
+// 聚光灯强度计算
 float CalculateSpotIntensity(vec3 lightDir, vec3 spotDir, float outerCos, float innerCos) {
     float theta = dot(lightDir, spotDir);
     float epsilon = innerCos - outerCos;
@@ -65,64 +181,50 @@ float CalculateSpotIntensity(vec3 lightDir, vec3 spotDir, float outerCos, float
 }
 
 void main() {
+    if (LodFadeDiscard(vLodFade)) discard;
 
-    
-    // Ⱦ߼
+    // 正常的渲染逻辑
     vec3 diffuseMap = texture(material_diffuse, vUV).rgb;
     vec3 normal = normalize(vNormal);
     vec3 viewDir = normalize(camera.viewPos.xyz - vFragPos);
     vec3 result = vec3(0.0);
 
-    // 
+    // 环境光
     result += u_AmbientColor * diffuseMap;
 
-    // 
+    // 方向光
     for (int i = 0; i < lights.numDir && i < 4; i++) {
         vec3 lightDir = normalize(-lights.dirLights[i].direction.xyz);
         float diff = max(dot(normal, lightDir), 0.0);
         
         vec3 lightColor = lights.dirLights[i].color.rgb;
+        if (lights.dirLights[i].color.w > 0.5) lightColor *= CascadeShadow(vFragPos, normal);
         vec3 diffuse = diff * diffuseMap * lightColor;
         result += diffuse;
     }
 
-    // Դ
-    for (int i = 0; i < lights.numPoint && i < 8; i++) {
-        vec3 lightPos = lights.pointLights[i].position.xyz;
-        float lightRange = lights.pointLights[i].position.w;
-        
-        vec3 lightDir = normalize(lightPos - vFragPos);
-        float diff = max(dot(normal, lightDir), 0.0);
-        
-        // ˥
-        float distance = length(lightPos - vFragPos);
-        float attenuation = CalculateAttenuation(distance, lightRange);
-        
-        vec3 lightColor = lights.pointLights[i].color.rgb;
-        vec3 diffuse = diff * diffuseMap * lightColor * attenuation;
-        result += diffuse;
-    }
+    // 点光源 / 聚光灯：只计算当前簇内的光源
+    uvec2 cluster = lightClusters[GetClusterIndex(vFragPos)];
+    for (uint i = 0u; i < cluster.y; i++) {
+        Light light = lightData[lightIndices[cluster.x + i]];
+        vec3 lightPos = light.positionRange.xyz;
+        float lightRange = light.positionRange.w;
 
-    // ۹
-    for (int i = 0; i < lights.numSpot && i < 4; i++) {
-        vec3 lightPos = lights.spotLights[i].position.xyz;
-        float lightRange = lights.spotLights[i].position.w;
-        vec3 spotDir = normalize(-lights.spotLights[i].direction.xyz);
-        float outerCos = lights.spotLights[i].direction.w;
-        float innerCos = lights.spotLights[i].params.x;
-        
         vec3 lightDir = normalize(lightPos - vFragPos);
         float diff = max(dot(normal, lightDir), 0.0);
-        
-        // ˥
+
+        // 计算衰减
         float distance = length(lightPos - vFragPos);
         float attenuation = CalculateAttenuation(distance, lightRange);
-        
-        // ۹ǿ
-        float spotIntensity = CalculateSpotIntensity(lightDir, spotDir, outerCos, innerCos);
-        
-        vec3 lightColor = lights.spotLights[i].color.rgb;
-        vec3 diffuse = diff * diffuseMap * lightColor * attenuation * spotIntensity;
+
+        // 聚光灯强度
+        if (light.colorType.w > 0.5) {
+            vec3 spotDir = normalize(-light.directionOuterCos.xyz);
+            attenuation *= CalculateSpotIntensity(lightDir, spotDir, light.directionOuterCos.w, light.params.x);
+        }
+        if (attenuation > 0.0) attenuation *= LocalLightShadow(light, vFragPos, normal);
+
+        vec3 diffuse = diff * diffuseMap * light.colorType.rgb * attenuation;
         result += diffuse;
     }
 
@@ -130,5 +232,5 @@ void main() {
 
     result = gammaCorrect(result);
 
-    FragColor = vec4(result, 1.0);
+    WriteColor(result, 1.0);
 }
\ No newline at end of file
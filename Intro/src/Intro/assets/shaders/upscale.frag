@@ -0,0 +1,58 @@
+#version 430 core
+
+// 动态分辨率上采样：场景以缩放后的尺寸渲染在纹理左下角的子区域，
+// 这里用 Catmull-Rom 双三次（9 次双线性采样实现）放大到整个视口，再按 u_Sharpness 做一次非锐化掩模
+layout(binding = 0) uniform sampler2D u_Source;
+
+uniform vec2 u_RenderSize;      // 子区域尺寸（像素）
+uniform vec2 u_OutputSize;      // 视口尺寸（像素）
+uniform float u_Sharpness;      // 0 = 只做双三次插值
+
+out vec4 FragColor;
+
+// 以源像素为单位采样，限制在子区域内，避免读到子区域之外的旧内容
+vec3 SampleSource(vec2 pixel) {
+    vec2 texelSize = 1.0 / vec2(textureSize(u_Source, 0));
+    return texture(u_Source, clamp(pixel, vec2(0.5), u_RenderSize - 0.5) * texelSize).rgb;
+}
+
+vec3 CatmullRom(vec2 pixel) {
+    vec2 center = floor(pixel - 0.5) + 0.5;
+    vec2 f = pixel - center;
+
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+
+    // 中间两个权重合并为一次双线性采样
+    vec2 w12 = w1 + w2;
+    vec2 p0 = center - 1.0;
+    vec2 p12 = center + w2 / w12;
+    vec2 p3 = center + 2.0;
+
+    vec3 result = vec3(0.0);
+    result += SampleSource(vec2(p0.x,  p0.y))  * w0.x  * w0.y;
+    result += SampleSource(vec2(p12.x, p0.y))  * w12.x * w0.y;
+    result += SampleSource(vec2(p3.x,  p0.y))  * w3.x  * w0.y;
+    result += SampleSource(vec2(p0.x,  p12.y)) * w0.x  * w12.y;
+    result += SampleSource(vec2(p12.x, p12.y)) * w12.x * w12.y;
+    result += SampleSource(vec2(p3.x,  p12.y)) * w3.x  * w12.y;
+    result += SampleSource(vec2(p0.x,  p3.y))  * w0.x  * w3.y;
+    result += SampleSource(vec2(p12.x, p3.y))  * w12.x * w3.y;
+    result += SampleSource(vec2(p3.x,  p3.y))  * w3.x  * w3.y;
+    return result;
+}
+
+void main() {
+    vec2 pixel = gl_FragCoord.xy / u_OutputSize * u_RenderSize;
+    vec3 color = CatmullRom(pixel);
+
+    if (u_Sharpness > 0.0) {
+        vec3 blur = (SampleSource(pixel + vec2(1.0, 0.0)) + SampleSource(pixel - vec2(1.0, 0.0)) +
+                     SampleSource(pixel + vec2(0.0, 1.0)) + SampleSource(pixel - vec2(0.0, 1.0))) * 0.25;
+        color += (color - blur) * u_Sharpness;
+    }
+
+    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
@@ -8,7 +8,7 @@ namespace Intro {
 
     Input* Input::s_Instance = new WindowsInput();
 
-    // ԭеʵֱֲ
+    // 原有的实现保持不变
     bool WindowsInput::IsKeyPressedImpl(int keycode) {
         auto window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
         auto state = glfwGetKey(window, keycode);
@@ -38,7 +38,7 @@ namespace Intro {
         return y;
     }
 
-    // === ʵ ===
+    // === 新增实现 ===
 
     bool WindowsInput::IsKeyJustPressedImpl(int keycode) {
         auto currentIt = m_KeyCurrentState.find(keycode);
@@ -126,21 +126,21 @@ namespace Intro {
     }
 
     void WindowsInput::UpdateImpl() {
-        // °״̬ǰ״̬Ƶһ֡״̬
+        // 更新按键状态：将当前状态复制到上一帧状态
         m_KeyPreviousState = m_KeyCurrentState;
         m_MousePreviousState = m_MouseCurrentState;
 
-        // µǰ״̬
+        // 更新当前按键状态
         for (auto& [keycode, _] : m_KeyCurrentState) {
             m_KeyCurrentState[keycode] = IsKeyPressedImpl(keycode);
         }
 
-        // µǰ갴ť״̬
+        // 更新当前鼠标按钮状态
         for (auto& [button, _] : m_MouseCurrentState) {
             m_MouseCurrentState[button] = IsMouseButtonPressedImpl(button);
         }
 
-        // 
+        // 重置鼠标滚动增量
         m_MouseScrollDelta = 0.0f;
     }
 
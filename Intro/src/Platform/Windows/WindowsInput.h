@@ -7,14 +7,14 @@ namespace Intro {
 
     class WindowsInput : public Input {
     protected:
-        // ԭеʵ
+        // 原有的实现
         virtual bool IsKeyPressedImpl(int keycode) override;
         virtual bool IsMouseButtonPressedImpl(int button) override;
         virtual std::pair<float, float> GetMousePositionImpl() override;
         virtual float GetMouseXImpl() override;
         virtual float GetMouseYImpl() override;
 
-        // === ʵ ===
+        // === 新增实现 ===
         virtual bool IsKeyJustPressedImpl(int keycode) override;
         virtual bool IsKeyJustReleasedImpl(int keycode) override;
         virtual bool IsMouseButtonJustPressedImpl(int button) override;
@@ -30,7 +30,7 @@ namespace Intro {
         virtual void UpdateImpl() override;
 
     private:
-        // ״̬洢
+        // 状态存储
         std::unordered_map<int, bool> m_KeyCurrentState;
         std::unordered_map<int, bool> m_KeyPreviousState;
         std::unordered_map<int, bool> m_MouseCurrentState;
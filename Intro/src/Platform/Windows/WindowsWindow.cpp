@@ -61,7 +61,7 @@ namespace Intro {
 		glfwSetWindowUserPointer(m_Window, &m_Data);
 		SetVSync(true);
 
-		//¼ص
+		//事件回调
 		glfwSetWindowSizeCallback(m_Window, [](GLFWwindow* window, int width, int height)
 			{
 			WindowData& data = *(WindowData*)glfwGetWindowUserPointer(window);